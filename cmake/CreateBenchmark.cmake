@@ -0,0 +1,68 @@
+# Macro which contains all bits and pieces to create the benchmark targets.
+# This creates a standalone target 'benchmark', which runs every benchmark
+# savegame for a fixed number of ticks with the null drivers. It is not part
+# of 'ctest', as the timings are not a pass or fail result.
+#
+# Savegames are taken from the 'benchmark' folder and from the folder given
+# in BENCHMARK_SAVEGAME_DIR, for reference savegames that are too big for the
+# repository. When a savegame 'name.sav' has a 'name_<ticks>.hash' file next
+# to it, the state of the game after running that many ticks has to match the
+# hash in that file.
+#
+# create_benchmark()
+#
+macro(create_benchmark)
+    set(BENCHMARK_SAVEGAME_DIR "" CACHE PATH "Folder with additional savegames for the benchmark target")
+    set(BENCHMARK_TICKS "10000" CACHE STRING "Number of ticks every savegame is run for by the benchmark target")
+
+    add_custom_command(OUTPUT ${CMAKE_BINARY_DIR}/benchmark/benchmark.cfg
+            COMMAND ${CMAKE_COMMAND} -E copy
+                    ${CMAKE_SOURCE_DIR}/benchmark/benchmark.cfg
+                    ${CMAKE_BINARY_DIR}/benchmark/benchmark.cfg
+            MAIN_DEPENDENCY ${CMAKE_SOURCE_DIR}/benchmark/benchmark.cfg
+            COMMENT "Copying benchmark.cfg benchmark file"
+    )
+    add_custom_target(benchmark_files
+            DEPENDS
+            ${CMAKE_BINARY_DIR}/benchmark/benchmark.cfg
+    )
+
+    file(GLOB BENCHMARK_SAVEGAMES ${CMAKE_SOURCE_DIR}/benchmark/*.sav)
+    if(BENCHMARK_SAVEGAME_DIR)
+        file(GLOB BENCHMARK_EXTRA_SAVEGAMES ${BENCHMARK_SAVEGAME_DIR}/*.sav)
+        list(APPEND BENCHMARK_SAVEGAMES ${BENCHMARK_EXTRA_SAVEGAMES})
+    endif()
+
+    foreach(BENCHMARK_SAVEGAME IN LISTS BENCHMARK_SAVEGAMES)
+        get_filename_component(BENCHMARK_NAME "${BENCHMARK_SAVEGAME}" NAME_WE)
+
+        add_custom_target(benchmark_${BENCHMARK_NAME}
+                COMMAND ${CMAKE_COMMAND}
+                        -DOPENTTD_EXECUTABLE=$<TARGET_FILE:openttd>
+                        -DEDITBIN_EXECUTABLE=${EDITBIN_EXECUTABLE}
+                        -DBENCHMARK_SAVEGAME=${BENCHMARK_SAVEGAME}
+                        -DBENCHMARK_TICKS=${BENCHMARK_TICKS}
+                        -P "${CMAKE_SOURCE_DIR}/cmake/scripts/Benchmark.cmake"
+                DEPENDS openttd benchmark_files
+                WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+                COMMENT "Running benchmark ${BENCHMARK_NAME}"
+                USES_TERMINAL
+                )
+
+        list(APPEND BENCHMARK_TARGETS benchmark_${BENCHMARK_NAME})
+    endforeach()
+
+    # Create a new target which runs all benchmarks, one after the other so
+    # they do not influence each other's timings.
+    add_custom_target(benchmark)
+    set(BENCHMARK_PREVIOUS_TARGET "")
+    foreach(BENCHMARK_TARGET IN LISTS BENCHMARK_TARGETS)
+        if(BENCHMARK_PREVIOUS_TARGET)
+            add_dependencies(${BENCHMARK_TARGET} ${BENCHMARK_PREVIOUS_TARGET})
+        endif()
+        set(BENCHMARK_PREVIOUS_TARGET ${BENCHMARK_TARGET})
+    endforeach()
+    if(BENCHMARK_PREVIOUS_TARGET)
+        add_dependencies(benchmark ${BENCHMARK_PREVIOUS_TARGET})
+    endif()
+endmacro()
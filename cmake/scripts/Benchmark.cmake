@@ -0,0 +1,72 @@
+cmake_minimum_required(VERSION 3.5)
+
+#
+# Runs a single benchmark savegame
+#
+
+if(NOT BENCHMARK_SAVEGAME)
+    message(FATAL_ERROR "Script needs BENCHMARK_SAVEGAME defined (tip: use -DBENCHMARK_SAVEGAME=..)")
+endif()
+if(NOT BENCHMARK_TICKS)
+    message(FATAL_ERROR "Script needs BENCHMARK_TICKS defined (tip: use -DBENCHMARK_TICKS=..)")
+endif()
+if(NOT OPENTTD_EXECUTABLE)
+    message(FATAL_ERROR "Script needs OPENTTD_EXECUTABLE defined (tip: use -DOPENTTD_EXECUTABLE=..)")
+endif()
+
+if(NOT EXISTS ${BENCHMARK_SAVEGAME})
+    message(FATAL_ERROR "Benchmark savegame ${BENCHMARK_SAVEGAME} does not exist")
+endif()
+
+get_filename_component(BENCHMARK_NAME "${BENCHMARK_SAVEGAME}" NAME_WE)
+
+# If editbin is given, copy the executable to a new folder, and change the
+# subsystem to console.
+if(EDITBIN_EXECUTABLE)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${OPENTTD_EXECUTABLE} benchmark_${BENCHMARK_NAME}.exe)
+    set(OPENTTD_EXECUTABLE "benchmark_${BENCHMARK_NAME}.exe")
+
+    execute_process(COMMAND ${EDITBIN_EXECUTABLE} /nologo /subsystem:console ${OPENTTD_EXECUTABLE})
+endif()
+
+# Run the benchmark; the null video driver reports the results on the
+# 'driver' debug level.
+execute_process(COMMAND ${OPENTTD_EXECUTABLE}
+                        -x
+                        -c benchmark/benchmark.cfg
+                        -g ${BENCHMARK_SAVEGAME}
+                        -snull
+                        -mnull
+                        -vnull:ticks=${BENCHMARK_TICKS},simulation
+                        -d driver=0
+                OUTPUT_QUIET
+                ERROR_VARIABLE BENCHMARK_RESULT
+                RESULT_VARIABLE BENCHMARK_EXIT_CODE
+)
+
+if(NOT BENCHMARK_EXIT_CODE EQUAL 0)
+    message(FATAL_ERROR "Benchmark ${BENCHMARK_NAME} failed (exit code ${BENCHMARK_EXIT_CODE}):\n${BENCHMARK_RESULT}")
+endif()
+
+# Remove the debug prefixes, and timestamps if any
+string(REGEX REPLACE "\[[0-9-]+ [0-9:]+\] " "" BENCHMARK_RESULT "${BENCHMARK_RESULT}")
+string(REPLACE "dbg: [driver] " "" BENCHMARK_RESULT "${BENCHMARK_RESULT}")
+
+string(REGEX MATCH "Simulated [^\n]*" BENCHMARK_RATE "${BENCHMARK_RESULT}")
+if(NOT BENCHMARK_RATE)
+    message(FATAL_ERROR "Benchmark ${BENCHMARK_NAME} did not simulate anything; did the savegame load?\n${BENCHMARK_RESULT}")
+endif()
+
+message("${BENCHMARK_NAME}: ${BENCHMARK_RESULT}")
+
+# Verify the state of the game after the run, when a reference is known
+string(REGEX MATCH "Game state hash: ([0-9a-f]+)" BENCHMARK_HASH "${BENCHMARK_RESULT}")
+set(BENCHMARK_HASH "${CMAKE_MATCH_1}")
+
+string(REGEX REPLACE "\\.sav$" "_${BENCHMARK_TICKS}.hash" BENCHMARK_HASH_FILE "${BENCHMARK_SAVEGAME}")
+if(EXISTS ${BENCHMARK_HASH_FILE})
+    file(STRINGS ${BENCHMARK_HASH_FILE} BENCHMARK_EXPECTED_HASH LIMIT_COUNT 1)
+    if(NOT BENCHMARK_HASH STREQUAL BENCHMARK_EXPECTED_HASH)
+        message(FATAL_ERROR "Benchmark ${BENCHMARK_NAME} ended in game state ${BENCHMARK_HASH}, but ${BENCHMARK_EXPECTED_HASH} was expected; the simulation changed")
+    endif()
+endif()
@@ -74,6 +74,9 @@
 	assert(_settings_game.difficulty.competitor_speed <= 4);
 	if ((AI::frame_counter & ((1 << (4 - _settings_game.difficulty.competitor_speed)) - 1)) != 0) return;
 
+	/* The AIs are run one after the other; they read the game state directly and
+	 * test their commands by running them, both of which use global state such
+	 * as _current_company and the active script instance. */
 	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
 	for (const Company *c : Company::Iterate()) {
 		if (c->is_ai) {
@@ -1033,6 +1033,21 @@ static bool AircraftController(Aircraft *v)
 
 	if (v->turn_counter != 0) v->turn_counter--;
 
+	/* NewGRF airports (like a rotated intercontinental from OpenGFX+Airports) can be non-rectangular
+	 * and their primary (north-most) tile does not have to be part of the airport.
+	 * As such, the height of the primary tile can be different from the rest of the airport.
+	 * Given we are landing/breaking, and as such are not a helicopter, we know that there has to be a hangar.
+	 * We also know that the airport itself has to be completely flat (otherwise it is not a valid airport).
+	 * Therefore, use the height of this hangar to calculate our z-value.
+	 * The hangar does not change while moving, so look it up once for the whole loop. */
+	const bool use_hangar_z = (amd.flag & (AMED_LAND | AMED_BRAKE)) && st != nullptr;
+	int hangar_z = 0;
+	if (use_hangar_z) {
+		assert(st->airport.HasHangar());
+		TileIndex hangar_tile = st->airport.GetHangarTile(0);
+		hangar_z = GetTileMaxPixelZ(hangar_tile) + 1; // To avoid clashing with the shadow
+	}
+
 	do {
 
 		GetNewVehiclePosResult gp;
@@ -1104,18 +1119,7 @@ static bool AircraftController(Aircraft *v)
 			z = GetAircraftFlightLevel(v);
 		}
 
-		/* NewGRF airports (like a rotated intercontinental from OpenGFX+Airports) can be non-rectangular
-		 * and their primary (north-most) tile does not have to be part of the airport.
-		 * As such, the height of the primary tile can be different from the rest of the airport.
-		 * Given we are landing/breaking, and as such are not a helicopter, we know that there has to be a hangar.
-		 * We also know that the airport itself has to be completely flat (otherwise it is not a valid airport).
-		 * Therefore, use the height of this hangar to calculate our z-value. */
-		int airport_z = v->z_pos;
-		if ((amd.flag & (AMED_LAND | AMED_BRAKE)) && st != nullptr) {
-			assert(st->airport.HasHangar());
-			TileIndex hangar_tile = st->airport.GetHangarTile(0);
-			airport_z = GetTileMaxPixelZ(hangar_tile) + 1; // To avoid clashing with the shadow
-		}
+		int airport_z = use_hangar_z ? hangar_z : v->z_pos;
 
 		if (amd.flag & AMED_LAND) {
 			if (st->airport.tile == INVALID_TILE) {
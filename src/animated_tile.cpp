@@ -19,6 +19,9 @@
 /** The table/list with animated tiles. */
 std::vector<TileIndex> _animated_tiles;
 
+/** Whether AnimateAnimatedTiles is walking #_animated_tiles, so removed tiles have to be left in place. */
+static bool _animating_tiles = false;
+
 /**
  * Removes the given tile from the animated tile table.
  * @param tile the tile to remove
@@ -27,8 +30,13 @@ void DeleteAnimatedTile(TileIndex tile)
 {
 	auto to_remove = std::find(_animated_tiles.begin(), _animated_tiles.end(), tile);
 	if (to_remove != _animated_tiles.end()) {
-		/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile. */
-		_animated_tiles.erase(to_remove);
+		if (_animating_tiles) {
+			/* Don't shift the tiles that still have to be animated; the slot is removed once the animation loop is done. */
+			*to_remove = INVALID_TILE;
+		} else {
+			/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile. */
+			_animated_tiles.erase(to_remove);
+		}
 		MarkTileDirtyByTile(tile);
 	}
 }
@@ -51,21 +59,19 @@ void AnimateAnimatedTiles()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-	const TileIndex *ti = _animated_tiles.data();
-	while (ti < _animated_tiles.data() + _animated_tiles.size()) {
-		const TileIndex curr = *ti;
-		AnimateTile(curr);
-		/* During the AnimateTile call, DeleteAnimatedTile could have been called,
-		 * deleting an element we've already processed and pushing the rest one
-		 * slot to the left. We can detect this by checking whether the index
-		 * in the current slot has changed - if it has, an element has been deleted,
-		 * and we should process the current slot again instead of going forward.
-		 * NOTE: this will still break if more than one animated tile is being
-		 *       deleted during the same AnimateTile call, but no code seems to
-		 *       be doing this anyway.
-		 */
-		if (*ti == curr) ++ti;
+	/* Tiles removed during an AnimateTile call are only marked as invalid, so
+	 * no tile has to be moved while animating and every remaining tile is
+	 * visited exactly once, however many tiles are removed by a single call.
+	 * Tiles added during the loop are appended and animated in the same loop. */
+	_animating_tiles = true;
+	for (size_t i = 0; i < _animated_tiles.size(); i++) {
+		const TileIndex curr = _animated_tiles[i];
+		if (curr != INVALID_TILE) AnimateTile(curr);
 	}
+	_animating_tiles = false;
+
+	/* Remove the slots of the tiles that were removed in one go. */
+	_animated_tiles.erase(std::remove(_animated_tiles.begin(), _animated_tiles.end(), INVALID_TILE), _animated_tiles.end());
 }
 
 /**
@@ -500,16 +500,34 @@ void Blitter_32bppAnim::PaletteAnimate(const Palette &palette)
 	const int width = this->anim_buf_width;
 	const int pitch_offset = _screen.pitch - width;
 	const int anim_pitch_offset = this->anim_buf_pitch - width;
+	static_assert(PALETTE_ANIM_START > 0 && PALETTE_ANIM_START < 256);
 	for (int y = this->anim_buf_height; y != 0 ; y--) {
-		for (int x = width; x != 0 ; x--) {
-			uint16 value = *anim;
-			uint8 colour = GB(value, 0, 8);
-			if (colour >= PALETTE_ANIM_START) {
-				/* Update this pixel */
-				*dst = this->AdjustBrightness(LookupColourInPalette(colour), GB(value, 8, 8));
+		for (int x = width; x != 0 ;) {
+			/* Look at four pixels at a time and skip them when none is animated.
+			 * Adding 256 - PALETTE_ANIM_START to the colour of a pixel carries
+			 * into the 9th bit of that pixel if, and only if, it is animated. */
+			int count = std::min(x, 4);
+			if (count == 4) {
+				uint64 values;
+				memcpy(&values, anim, sizeof(values));
+				if ((((values & 0x00FF00FF00FF00FFULL) + 0x0001000100010001ULL * (256 - PALETTE_ANIM_START)) & 0x0100010001000100ULL) == 0) {
+					dst += 4;
+					anim += 4;
+					x -= 4;
+					continue;
+				}
+			}
+
+			for (x -= count; count != 0; count--) {
+				uint16 value = *anim;
+				uint8 colour = GB(value, 0, 8);
+				if (colour >= PALETTE_ANIM_START) {
+					/* Update this pixel */
+					*dst = this->AdjustBrightness(LookupColourInPalette(colour), GB(value, 8, 8));
+				}
+				dst++;
+				anim++;
 			}
-			dst++;
-			anim++;
 		}
 		dst += pitch_offset;
 		anim += anim_pitch_offset;
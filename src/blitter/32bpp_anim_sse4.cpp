@@ -19,6 +19,8 @@
 
 /** Instantiation of the SSE4 32bpp blitter factory. */
 static FBlitter_32bppSSE4_Anim iFBlitter_32bppSSE4_Anim;
+/** Instantiation of the SSE4 32bpp blitter with AVX2 palette animation factory. */
+static FBlitter_32bppAVX2_Anim iFBlitter_32bppAVX2_Anim;
 
 /**
  * Draws a sprite to a (screen) buffer. It is templated to allow faster operation.
@@ -411,4 +413,13 @@ bm_normal:
 	}
 }
 
+void Blitter_32bppSSE4_Anim::PaletteAnimate(const Palette &palette)
+{
+	if (this->avx2_palette_animation) {
+		this->PaletteAnimateAVX2(palette);
+	} else {
+		this->Blitter_32bppSSE2_Anim::PaletteAnimate(palette);
+	}
+}
+
 #endif /* WITH_SSE */
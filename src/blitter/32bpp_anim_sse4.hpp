@@ -30,15 +30,25 @@
 /** The SSE4 32 bpp blitter with palette animation. */
 class Blitter_32bppSSE4_Anim FINAL : public Blitter_32bppSSE2_Anim, public Blitter_32bppSSE_Base {
 private:
+	bool avx2_palette_animation; ///< Whether the palette is animated with AVX2.
+
+	void PaletteAnimateAVX2(const Palette &palette);
 
 public:
+	/**
+	 * Create the blitter.
+	 * @param avx2_palette_animation Animate the palette with AVX2; only when the CPU supports it.
+	 */
+	Blitter_32bppSSE4_Anim(bool avx2_palette_animation = false) : avx2_palette_animation(avx2_palette_animation) {}
+
 	template <BlitterMode mode, Blitter_32bppSSE_Base::ReadMode read_mode, Blitter_32bppSSE_Base::BlockType bt_last, bool translucent, bool animated>
 	void Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom);
 	void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) override;
 	Sprite *Encode(const SpriteLoader::Sprite *sprite, AllocatorProc *allocator) override {
 		return Blitter_32bppSSE_Base::Encode(sprite, allocator);
 	}
-	const char *GetName() override { return "32bpp-sse4-anim"; }
+	void PaletteAnimate(const Palette &palette) override;
+	const char *GetName() override { return this->avx2_palette_animation ? "32bpp-avx2-anim" : "32bpp-sse4-anim"; }
 };
 
 /** Factory for the SSE4 32 bpp blitter (with palette animation). */
@@ -48,5 +58,12 @@ public:
 	Blitter *CreateInstance() override { return new Blitter_32bppSSE4_Anim(); }
 };
 
+/** Factory for the SSE4 32 bpp blitter (with palette animation using AVX2). */
+class FBlitter_32bppAVX2_Anim: public BlitterFactory {
+public:
+	FBlitter_32bppAVX2_Anim() : BlitterFactory("32bpp-avx2-anim", "32bpp SSE4 Blitter (palette animation with AVX2)", HasCPUIDFlag(1, 2, 19) && HasAVX2Support()) {}
+	Blitter *CreateInstance() override { return new Blitter_32bppSSE4_Anim(true); }
+};
+
 #endif /* WITH_SSE */
 #endif /* BLITTER_32BPP_SSE4_ANIM_HPP */
@@ -59,7 +59,13 @@ TileIndex GetSouthernBridgeEnd(TileIndex t)
 TileIndex GetOtherBridgeEnd(TileIndex tile)
 {
 	assert(IsBridgeTile(tile));
-	return GetBridgeEnd(tile, GetTunnelBridgeDirection(tile));
+
+	TileIndex other = GetIndexedTunnelBridgeEnd(tile);
+	if (other != INVALID_TILE) return other;
+
+	other = GetBridgeEnd(tile, GetTunnelBridgeDirection(tile));
+	AddTunnelBridgeEnds(tile, other);
+	return other;
 }
 
 /**
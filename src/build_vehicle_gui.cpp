@@ -183,8 +183,8 @@ static bool EngineReliabilitySorter(const EngineID &a, const EngineID &b)
  */
 static bool EngineCostSorter(const EngineID &a, const EngineID &b)
 {
-	Money va = Engine::Get(a)->GetCost();
-	Money vb = Engine::Get(b)->GetCost();
+	Money va = GetEngineSortValue(a, ESV_COST);
+	Money vb = GetEngineSortValue(b, ESV_COST);
 	int r = ClampToI32(va - vb);
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -200,8 +200,8 @@ static bool EngineCostSorter(const EngineID &a, const EngineID &b)
  */
 static bool EngineSpeedSorter(const EngineID &a, const EngineID &b)
 {
-	int va = Engine::Get(a)->GetDisplayMaxSpeed();
-	int vb = Engine::Get(b)->GetDisplayMaxSpeed();
+	int va = (int)GetEngineSortValue(a, ESV_SPEED);
+	int vb = (int)GetEngineSortValue(b, ESV_SPEED);
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -217,8 +217,8 @@ static bool EngineSpeedSorter(const EngineID &a, const EngineID &b)
  */
 static bool EnginePowerSorter(const EngineID &a, const EngineID &b)
 {
-	int va = Engine::Get(a)->GetPower();
-	int vb = Engine::Get(b)->GetPower();
+	int va = (int)GetEngineSortValue(a, ESV_POWER);
+	int vb = (int)GetEngineSortValue(b, ESV_POWER);
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -234,8 +234,8 @@ static bool EnginePowerSorter(const EngineID &a, const EngineID &b)
  */
 static bool EngineTractiveEffortSorter(const EngineID &a, const EngineID &b)
 {
-	int va = Engine::Get(a)->GetDisplayMaxTractiveEffort();
-	int vb = Engine::Get(b)->GetDisplayMaxTractiveEffort();
+	int va = (int)GetEngineSortValue(a, ESV_TRACTIVE_EFFORT);
+	int vb = (int)GetEngineSortValue(b, ESV_TRACTIVE_EFFORT);
 	int r = va - vb;
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -251,8 +251,8 @@ static bool EngineTractiveEffortSorter(const EngineID &a, const EngineID &b)
  */
 static bool EngineRunningCostSorter(const EngineID &a, const EngineID &b)
 {
-	Money va = Engine::Get(a)->GetRunningCost();
-	Money vb = Engine::Get(b)->GetRunningCost();
+	Money va = GetEngineSortValue(a, ESV_RUNNING_COST);
+	Money vb = GetEngineSortValue(b, ESV_RUNNING_COST);
 	int r = ClampToI32(va - vb);
 
 	/* Use EngineID to sort instead since we want consistent sorting */
@@ -268,12 +268,10 @@ static bool EngineRunningCostSorter(const EngineID &a, const EngineID &b)
  */
 static bool EnginePowerVsRunningCostSorter(const EngineID &a, const EngineID &b)
 {
-	const Engine *e_a = Engine::Get(a);
-	const Engine *e_b = Engine::Get(b);
-	uint p_a = e_a->GetPower();
-	uint p_b = e_b->GetPower();
-	Money r_a = e_a->GetRunningCost();
-	Money r_b = e_b->GetRunningCost();
+	uint p_a = (uint)GetEngineSortValue(a, ESV_POWER);
+	uint p_b = (uint)GetEngineSortValue(b, ESV_POWER);
+	Money r_a = GetEngineSortValue(a, ESV_RUNNING_COST);
+	Money r_b = GetEngineSortValue(b, ESV_RUNNING_COST);
 	/* Check if running cost is zero in one or both engines.
 	 * If only one of them is zero then that one has higher value,
 	 * else if both have zero cost then compare powers. */
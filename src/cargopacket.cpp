@@ -380,14 +380,16 @@ void VehicleCargoList::AddToMeta(const CargoPacket *cp, MoveToAction action)
  */
 void VehicleCargoList::AgeCargo()
 {
+	uint aged = 0;
 	for (ConstIterator it(this->packets.begin()); it != this->packets.end(); it++) {
 		CargoPacket *cp = *it;
 		/* If we're at the maximum, then we can't increase no more. */
 		if (cp->days_in_transit == 0xFF) continue;
 
 		cp->days_in_transit++;
-		this->cargo_days_in_transit += cp->count;
+		aged += cp->count;
 	}
+	this->cargo_days_in_transit += aged;
 }
 
 /**
@@ -24,7 +24,13 @@
 typedef uint32 CargoPacketID;
 struct CargoPacket;
 
-/** Type of the pool for cargo packets for a little over 16 million packets. */
+/**
+ * Type of the pool for cargo packets for a little over 16 million packets.
+ * Freed packets are cached for reuse instead of being returned to the heap,
+ * and packets are merged on append when they only differ in their amount.
+ * Merging packets of different age is not an option: days_in_transit
+ * determines the payment on delivery.
+ */
 typedef Pool<CargoPacket, CargoPacketID, 1024, 0xFFF000, PT_NORMAL, true, false> CargoPacketPool;
 /** The actual pool with cargo packets. */
 extern CargoPacketPool _cargopacket_pool;
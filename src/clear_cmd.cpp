@@ -245,6 +245,15 @@ static void TileLoopClearDesert(TileIndex tile)
 	MarkTileDirtyByTile(tile);
 }
 
+/**
+ * Tile loop of clear tiles.
+ * Even grass that has fully grown is not guaranteed to be settled: the snow line
+ * and the desert zone can change, tiles at freeform edges may get flooded, and
+ * the ambient sound callback draws from the game's random generator whenever a
+ * NewGRF enables it. So every clear tile has to be visited, as skipping one would
+ * change the random sequence and desync the game.
+ * @param tile The tile to process.
+ */
 static void TileLoop_Clear(TileIndex tile)
 {
 	/* If the tile is at any edge flood it to prevent maps without water. */
@@ -236,7 +236,7 @@ static const Command _command_proc_table[] = {
 	DEF_CMD(CmdBuildRoadStop,            CMD_NO_WATER | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_BUILD_ROAD_STOP
 	DEF_CMD(CmdRemoveRoadStop,                                 0, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_REMOVE_ROAD_STOP
 	DEF_CMD(CmdBuildLongRoad,CMD_DEITY | CMD_NO_WATER | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_BUILD_LONG_ROAD
-	DEF_CMD(CmdRemoveLongRoad,            CMD_NO_TEST | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_REMOVE_LONG_ROAD; towns may disallow removing road bits (as they are connected) in test, but in exec they're removed and thus removing is allowed.
+	DEF_CMD(CmdRemoveLongRoad, CMD_NO_TEST | CMD_SKIP_TEST | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_REMOVE_LONG_ROAD; towns may disallow removing road bits (as they are connected) in test, but in exec they're removed and thus removing is allowed.
 	DEF_CMD(CmdBuildRoad,    CMD_DEITY | CMD_NO_WATER | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_BUILD_ROAD
 	DEF_CMD(CmdBuildRoadDepot,           CMD_NO_WATER | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_BUILD_ROAD_DEPOT
 	DEF_CMD(CmdConvertRoad,                                    0, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_CONVERT_ROAD
@@ -310,7 +310,7 @@ static const Command _command_proc_table[] = {
 	DEF_CMD(CmdOrderRefit,                                     0, CMDT_ROUTE_MANAGEMENT      ), // CMD_ORDER_REFIT
 	DEF_CMD(CmdCloneOrder,                                     0, CMDT_ROUTE_MANAGEMENT      ), // CMD_CLONE_ORDER
 
-	DEF_CMD(CmdClearArea,                            CMD_NO_TEST, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_CLEAR_AREA; destroying multi-tile houses makes town rating differ between test and execution
+	DEF_CMD(CmdClearArea,            CMD_NO_TEST | CMD_SKIP_TEST, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_CLEAR_AREA; destroying multi-tile houses makes town rating differ between test and execution
 
 	DEF_CMD(CmdMoneyCheat,                           CMD_OFFLINE, CMDT_CHEAT                 ), // CMD_MONEY_CHEAT
 	DEF_CMD(CmdChangeBankBalance,                      CMD_DEITY, CMDT_MONEY_MANAGEMENT      ), // CMD_CHANGE_BANK_BALANCE
@@ -336,7 +336,7 @@ static const Command _command_proc_table[] = {
 	DEF_CMD(CmdScrollViewport,                         CMD_DEITY, CMDT_OTHER_MANAGEMENT      ), // CMD_SCROLL_VIEWPORT
 	DEF_CMD(CmdStoryPageButton,                        CMD_DEITY, CMDT_OTHER_MANAGEMENT      ), // CMD_STORY_PAGE_BUTTON
 
-	DEF_CMD(CmdLevelLand, CMD_ALL_TILES | CMD_NO_TEST | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_LEVEL_LAND; test run might clear tiles multiple times, in execution that only happens once
+	DEF_CMD(CmdLevelLand, CMD_ALL_TILES | CMD_NO_TEST | CMD_SKIP_TEST | CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_LEVEL_LAND; test run might clear tiles multiple times, in execution that only happens once
 
 	DEF_CMD(CmdBuildLock,                               CMD_AUTO, CMDT_LANDSCAPE_CONSTRUCTION), // CMD_BUILD_LOCK
 
@@ -674,17 +674,26 @@ CommandCost DoCommandPInternal(TileIndex tile, uint32 p1, uint32 p2, uint32 cmd,
 	if (exec_as_spectator) cur_company.Change(COMPANY_SPECTATOR);
 
 	bool test_and_exec_can_differ = (cmd_flags & CMD_NO_TEST) != 0;
+	assert(test_and_exec_can_differ || (cmd_flags & CMD_SKIP_TEST) == 0);
 
-	/* Test the command. */
-	_cleared_object_areas.clear();
-	SetTownRatingTestMode(true);
-	BasePersistentStorageArray::SwitchMode(PSM_ENTER_TESTMODE);
-	CommandCost res = proc(tile, flags, p1, p2, text);
-	BasePersistentStorageArray::SwitchMode(PSM_LEAVE_TESTMODE);
-	SetTownRatingTestMode(false);
-
-	/* Make sure we're not messing things up here. */
-	assert(exec_as_spectator ? _current_company == COMPANY_SPECTATOR : cur_company.Verify());
+	/* Commands that test every step while executing do not need a separate test
+	 * run, unless we only want the estimate or the command must be sent over
+	 * the network first. The result of the execution is then used instead. */
+	bool skip_test = (cmd_flags & CMD_SKIP_TEST) != 0 && !estimate_only && (!_networking || _generating_world || (cmd & CMD_NETWORK_COMMAND) != 0);
+
+	CommandCost res;
+	if (!skip_test) {
+		/* Test the command. */
+		_cleared_object_areas.clear();
+		SetTownRatingTestMode(true);
+		BasePersistentStorageArray::SwitchMode(PSM_ENTER_TESTMODE);
+		res = proc(tile, flags, p1, p2, text);
+		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_TESTMODE);
+		SetTownRatingTestMode(false);
+
+		/* Make sure we're not messing things up here. */
+		assert(exec_as_spectator ? _current_company == COMPANY_SPECTATOR : cur_company.Verify());
+	}
 
 	/* If the command fails, we're doing an estimate
 	 * or the player does not have enough money
@@ -399,6 +399,7 @@ enum CommandFlags {
 	CMD_DEITY     = 0x100, ///< the command may be executed by COMPANY_DEITY
 	CMD_STR_CTRL  = 0x200, ///< the command's string may contain control strings
 	CMD_NO_EST    = 0x400, ///< the command is never estimated.
+	CMD_SKIP_TEST = 0x800, ///< the command tests every step itself when executing and fails without side effects, so the separate test run may be skipped; implies #CMD_NO_TEST.
 };
 DECLARE_ENUM_AS_BIT_SET(CommandFlags)
 
@@ -42,6 +42,9 @@
 #include "game/game.hpp"
 #include "table/strings.h"
 #include "walltime_func.h"
+#include "framerate_type.h"
+#include "pathfinder/yapf/yapf.h"
+#include "blitter/factory.hpp"
 
 #include "safeguards.h"
 
@@ -694,6 +697,29 @@ DEF_CONSOLE_CMD(ConStatus)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConTraffic)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "List the network traffic and handling time per packet type and per client. Usage 'traffic'.");
+		return true;
+	}
+
+	NetworkServerShowTrafficToConsole();
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConLag)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "List the lag in frames of all clients, as seen from their acknowledgements. Usage 'lag'.");
+		IConsolePrint(CC_HELP, "The histogram counts acknowledgements with a lag below 8, 16, 32, 64, 128 and 256 frames, and of 256 frames or more.");
+		return true;
+	}
+
+	NetworkServerShowLagToConsole();
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConServerInfo)
 {
 	if (argc == 0) {
@@ -2109,6 +2135,43 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 	return false;
 }
 
+DEF_CONSOLE_CMD(ConNewGRFSample)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Sample the time taken by NewGRF sprite requests and callbacks of all GRFs, with little overhead. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_sample start [<interval>]':");
+		IConsolePrint(CC_HELP, "  Measure one in <interval> (default 100) requests, discarding earlier samples.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_sample stop':");
+		IConsolePrint(CC_HELP, "  Stop sampling, keeping the samples.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_sample [top [<count>]]':");
+		IConsolePrint(CC_HELP, "  Show the <count> (default 10) GRF features and callbacks that took most time according to the samples.");
+		return true;
+	}
+
+	/* "top" sub-command */
+	if (argc == 1 || strncasecmp(argv[1], "top", 3) == 0) {
+		NewGRFSampler::ShowTop(argc >= 3 ? std::max(atoi(argv[2]), 1) : 10);
+		return true;
+	}
+
+	/* "start" sub-command */
+	if (strncasecmp(argv[1], "sta", 3) == 0) {
+		uint interval = argc >= 3 ? std::max(atoi(argv[2]), 1) : 100;
+		NewGRFSampler::Start(interval);
+		IConsolePrint(CC_DEBUG, "Started sampling one in {} NewGRF requests.", interval);
+		return true;
+	}
+
+	/* "stop" sub-command */
+	if (strncasecmp(argv[1], "sto", 3) == 0) {
+		NewGRFSampler::Start(0);
+		IConsolePrint(CC_DEBUG, "Stopped sampling NewGRF requests.");
+		return true;
+	}
+
+	return false;
+}
+
 #ifdef _DEBUG
 /******************
  *  debug commands
@@ -2125,16 +2188,89 @@ static void IConsoleDebugLibRegister()
 DEF_CONSOLE_CMD(ConFramerate)
 {
 	extern void ConPrintFramerate(); // framerate_gui.cpp
+	extern void ConPrintFramerateTree(bool reset); // framerate_gui.cpp
 
 	if (argc == 0) {
-		IConsolePrint(CC_HELP, "Show frame rate and game speed information.");
+		IConsolePrint(CC_HELP, "Show frame rate and game speed information. Usage: 'fps [tree [reset]]'.");
+		IConsolePrint(CC_HELP, "  'tree' shows the time spent in each nested part of the game loop since the last 'fps tree reset'.");
+		return true;
+	}
+
+	if (argc >= 2 && strcmp(argv[1], "tree") == 0) {
+		if (argc > 3 || (argc == 3 && strcmp(argv[2], "reset") != 0)) return false;
+		ConPrintFramerateTree(argc == 3);
 		return true;
 	}
+	if (argc != 1) return false;
 
 	ConPrintFramerate();
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConFramerateTrace)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Write the recent performance measurements as a Chrome trace file to your personal directory. Usage: 'fps_trace [<filename>]'.");
+		return true;
+	}
+
+	if (argc > 2) return false;
+
+	std::string filename = _personal_dir + (argc == 2 ? argv[1] : "trace.json");
+	if (WritePerformanceTrace(filename.c_str())) {
+		IConsolePrint(CC_DEFAULT, "Trace written to {}.", filename);
+	} else {
+		IConsolePrint(CC_ERROR, "Writing trace to {} failed.", filename);
+	}
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConBenchmarkViewport)
+{
+	extern void BenchmarkViewportDrawing(uint iterations); // viewport.cpp
+
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Redraw the screen a number of times with each sprite sorter and show how long each stage of drawing the viewports took. Usage: 'benchmark_viewport [<iterations>]'.");
+		IConsolePrint(CC_HELP, "Only the current blitter, resolution and zoom level are used; change those and run it again to compare them.");
+		return true;
+	}
+
+	if (argc > 2) return false;
+
+	uint32 iterations = 100;
+	if (argc == 2 && (!GetArgumentInteger(&iterations, argv[1]) || iterations == 0)) return false;
+
+	if (_network_dedicated || BlitterFactory::GetCurrentBlitter()->GetScreenDepth() == 0) {
+		IConsolePrint(CC_ERROR, "There is nothing drawn to benchmark.");
+		return true;
+	}
+
+	BenchmarkViewportDrawing(iterations);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConSimulate)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Run the game for a number of ticks as fast as possible, without updating windows and viewports. Usage: 'simulate <ticks>'.");
+		return true;
+	}
+
+	if (argc != 2) return false;
+
+	uint32 ticks;
+	if (!GetArgumentInteger(&ticks, argv[1])) return false;
+
+	if (_game_mode != GM_NORMAL && _game_mode != GM_EDITOR) {
+		IConsolePrint(CC_ERROR, "There is no game to simulate.");
+		return true;
+	}
+
+	double rate = SimulateTicks(ticks);
+	IConsolePrint(CC_DEFAULT, "Simulated {} ticks at {:.2f} ticks per second.", ticks, rate);
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConFramerateWindow)
 {
 	extern void ShowFramerateWindow();
@@ -2153,6 +2289,38 @@ DEF_CONSOLE_CMD(ConFramerateWindow)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConPathfinderStats)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Show the vehicles whose recent pathfinder searches took the most time. Usage: 'pf_stats [<count>]'.");
+		return true;
+	}
+
+	if (argc > 2) return false;
+
+	uint32 count = 10;
+	if (argc == 2 && !GetArgumentInteger(&count, argv[1])) return false;
+
+	YapfPrintSearchStats(count);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConPathfinderBenchmark)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Replay the pathfinder searches of all vehicles and show their latency percentiles. Usage: 'pf_bench [<rounds>]'.");
+		return true;
+	}
+
+	if (argc > 2) return false;
+
+	uint32 rounds = 1;
+	if (argc == 2 && (!GetArgumentInteger(&rounds, argv[1]) || rounds == 0)) return false;
+
+	YapfBenchmarkSearches(rounds);
+	return true;
+}
+
 static void ConDumpRoadTypes()
 {
 	IConsolePrint(CC_DEFAULT, "  Flags:");
@@ -2389,6 +2557,8 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("connect",                 ConNetworkConnect,   ConHookClientOnly);
 	IConsole::CmdRegister("clients",                 ConNetworkClients,   ConHookNeedNetwork);
 	IConsole::CmdRegister("status",                  ConStatus,           ConHookServerOnly);
+	IConsole::CmdRegister("traffic",                 ConTraffic,          ConHookServerOnly);
+	IConsole::CmdRegister("lag",                     ConLag,              ConHookServerOnly);
 	IConsole::CmdRegister("server_info",             ConServerInfo,       ConHookServerOnly);
 	IConsole::AliasRegister("info",                  "server_info");
 	IConsole::CmdRegister("reconnect",               ConNetworkReconnect, ConHookClientOnly);
@@ -2438,10 +2608,16 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("fps_trace",               ConFramerateTrace);
+	IConsole::CmdRegister("benchmark_viewport",      ConBenchmarkViewport);
+	IConsole::CmdRegister("pf_stats",                ConPathfinderStats);
+	IConsole::CmdRegister("pf_bench",                ConPathfinderBenchmark);
+	IConsole::CmdRegister("simulate",                ConSimulate,         ConHookNoNetwork);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
 	IConsole::CmdRegister("newgrf_profile",          ConNewGRFProfile,    ConHookNewGRFDeveloperTool);
+	IConsole::CmdRegister("newgrf_sample",           ConNewGRFSample);
 
 	IConsole::CmdRegister("dump_info",               ConDumpInfo);
 }
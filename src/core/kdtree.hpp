@@ -13,6 +13,7 @@
 #include "../stdafx.h"
 #include <vector>
 #include <limits>
+#include "../thread.h"
 
 /**
  * K-dimensional tree, specialised for 2-dimensional space.
@@ -45,6 +46,8 @@ class Kdtree {
 	};
 
 	static const size_t INVALID_NODE = SIZE_MAX; ///< Index value indicating no-such-node
+	static const ptrdiff_t PARALLEL_BUILD_MIN_COUNT = 8192; ///< Minimum number of elements of a sub-tree to build its halves on two threads
+	static const int PARALLEL_BUILD_MAX_LEVEL = 2; ///< Sub-trees below this level are built on the thread of their parent
 
 	std::vector<node> nodes;       ///< Pool of all nodes in the tree
 	std::vector<size_t> free_list; ///< List of dead indices in the nodes vector
@@ -97,6 +100,52 @@ class Kdtree {
 		}
 	}
 
+	/**
+	 * Construct a subtree from elements between begin and end iterators, return index of root.
+	 * Unlike #BuildSubtree, the node of each element is placed at the position the element ends up at
+	 * in the sequence, so the halves of big sub-trees can be built on separate threads. The shape of
+	 * the tree is the same as built by #BuildSubtree.
+	 * @param first First element of the whole sequence; its node is at index 0.
+	 */
+	template <typename It>
+	size_t BuildSubtreeInPlace(It first, It begin, It end, int level)
+	{
+		ptrdiff_t count = end - begin;
+		if (count == 0) return INVALID_NODE;
+
+		It split = begin;
+		if (count > 1) {
+			CoordT split_coord = SelectSplitCoord(begin, end, level);
+			split = std::partition(begin, end, [&](T v) { return this->xyfunc(v, level % 2) < split_coord; });
+		}
+
+		size_t newidx = split - first;
+		this->nodes[newidx].element = *split;
+		if (count == 1) return newidx;
+
+		size_t left = INVALID_NODE;
+		size_t right = INVALID_NODE;
+#ifndef NO_THREADS
+		if (count >= PARALLEL_BUILD_MIN_COUNT && level < PARALLEL_BUILD_MAX_LEVEL) {
+			/* Both halves only touch their own elements and nodes. When no thread
+			 * can be started, the left half is built here too. */
+			std::thread left_builder;
+			if (StartNewThread(&left_builder, "ottd:kdtree", [&]() { left = this->BuildSubtreeInPlace(first, begin, split, level + 1); })) {
+				right = this->BuildSubtreeInPlace(first, split + 1, end, level + 1);
+				left_builder.join();
+				this->nodes[newidx].left = left;
+				this->nodes[newidx].right = right;
+				return newidx;
+			}
+		}
+#endif
+		left = this->BuildSubtreeInPlace(first, begin, split, level + 1);
+		right = this->BuildSubtreeInPlace(first, split + 1, end, level + 1);
+		this->nodes[newidx].left = left;
+		this->nodes[newidx].right = right;
+		return newidx;
+	}
+
 	/** Rebuild the tree with all existing elements, optionally adding or removing one more */
 	bool Rebuild(const T *include_element, const T *exclude_element)
 	{
@@ -122,32 +171,82 @@ class Kdtree {
 		return true;
 	}
 
-	/** Insert one element in the tree somewhere below node_idx */
-	void InsertRecursive(const T &element, size_t node_idx, int level)
+	/**
+	 * Insert one element in the tree as a new leaf. When the leaf ends up deeper than
+	 * a balanced tree of this size would be, the smallest sub-tree on its path where one
+	 * side holds more than three quarters of the elements is rebuilt, so only the part
+	 * of the tree that became unbalanced is rebuilt.
+	 */
+	void InsertBalanced(const T &element)
 	{
-		/* Dimension index of current level */
-		int dim = level % 2;
-		/* Node reference */
-		node &n = this->nodes[node_idx];
+		/* Nodes from the root down to the parent of the new leaf; the level of a node is its index in here. */
+		std::vector<size_t> path;
+		size_t node_idx = this->root;
+		bool left;
+		for (;;) {
+			path.push_back(node_idx);
+			const node &n = this->nodes[node_idx];
+			int dim = (path.size() - 1) % 2;
+			left = this->xyfunc(element, dim) < this->xyfunc(n.element, dim);
+			size_t next = left ? n.left : n.right;
+			if (next == INVALID_NODE) break;
+			node_idx = next;
+		}
 
-		/* Coordinate of element splitting at this node */
-		CoordT nc = this->xyfunc(n.element, dim);
-		/* Coordinate of the new element */
-		CoordT ec = this->xyfunc(element, dim);
-		/* Which side to insert on */
-		size_t &next = (ec < nc) ? n.left : n.right;
-
-		if (next == INVALID_NODE) {
-			/* New leaf */
-			size_t newidx = this->AddNode(element);
-			/* Vector may have been reallocated at this point, n and next are invalid */
-			node &nn = this->nodes[node_idx];
-			if (ec < nc) nn.left = newidx; else nn.right = newidx;
-		} else {
-			this->InsertRecursive(element, next, level + 1);
+		/* New leaf; the vector may be reallocated by adding the node */
+		size_t newidx = this->AddNode(element);
+		node &parent = this->nodes[path.back()];
+		if (left) parent.left = newidx; else parent.right = newidx;
+
+		/* Depth of a tree where no side of any sub-tree holds more than three quarters of its elements */
+		size_t max_depth = 0;
+		for (size_t count = this->Count(); count > 1; count = count * 3 / 4) max_depth++;
+		if (path.size() <= max_depth) return;
+
+		/* Walk back up to find the sub-tree to rebuild */
+		size_t child = newidx;
+		size_t child_count = 1;
+		for (size_t i = path.size(); i-- > 0;) {
+			const node &n = this->nodes[path[i]];
+			size_t count = child_count + 1 + this->CountSubtree(n.left == child ? n.right : n.left);
+			if (child_count * 4 > count * 3) {
+				size_t new_subtree = this->RebuildSubtree(path[i], (int)i);
+				if (i == 0) {
+					this->root = new_subtree;
+				} else {
+					node &p = this->nodes[path[i - 1]];
+					if (p.left == path[i]) p.left = new_subtree; else p.right = new_subtree;
+				}
+				return;
+			}
+			child = path[i];
+			child_count = count;
 		}
 	}
 
+	/** Count the elements in a sub-tree */
+	size_t CountSubtree(size_t node_idx) const
+	{
+		if (node_idx == INVALID_NODE) return 0;
+		const node &n = this->nodes[node_idx];
+		return 1 + this->CountSubtree(n.left) + this->CountSubtree(n.right);
+	}
+
+	/**
+	 * Rebuild a sub-tree to be balanced.
+	 * @param node_idx Root of the sub-tree.
+	 * @param level    Depth of the root of the sub-tree in the tree.
+	 * @return New root node index of the sub-tree.
+	 */
+	size_t RebuildSubtree(size_t node_idx, int level)
+	{
+		T root_element = this->nodes[node_idx].element;
+		std::vector<T> elements = this->FreeSubtree(node_idx);
+		elements.push_back(root_element);
+		this->free_list.push_back(node_idx);
+		return this->BuildSubtree(elements.begin(), elements.end(), level);
+	}
+
 	/**
 	 * Free all children of the given node
 	 * @return Collection of elements that were removed from tree.
@@ -368,8 +467,10 @@ public:
 		this->unbalanced = 0;
 		if (begin == end) return;
 		this->nodes.reserve(end - begin);
+		/* Every node is filled in by BuildSubtreeInPlace */
+		for (It it = begin; it != end; ++it) this->nodes.emplace_back(*it);
 
-		this->root = this->BuildSubtree(begin, end, 0);
+		this->root = this->BuildSubtreeInPlace(begin, begin, end, 0);
 		CheckInvariant();
 	}
 
@@ -394,7 +495,7 @@ public:
 
 	/**
 	 * Insert a single element in the tree.
-	 * Repeatedly inserting single elements may cause the tree to become unbalanced.
+	 * Sub-trees that become unbalanced by inserting are rebuilt on the fly.
 	 * Undefined behaviour if the element already exists in the tree.
 	 */
 	void Insert(const T &element)
@@ -402,9 +503,9 @@ public:
 		if (this->Count() == 0) {
 			this->root = this->AddNode(element);
 		} else {
+			/* Removals are not rebalanced on the fly, rebuild the whole tree when they made it unbalanced */
 			if (!this->IsUnbalanced() || !this->Rebuild(&element, nullptr)) {
-				this->InsertRecursive(element, this->root, 0);
-				this->IncrementUnbalanced();
+				this->InsertBalanced(element);
 			}
 			CheckInvariant();
 		}
@@ -33,3 +33,16 @@
 		if (pool->type & pt) pool->CleanPool();
 	}
 }
+
+/**
+ * Finish the allocation statistics of the current game tick for all pools.
+ * The number of allocations made during the tick becomes available
+ * in #tick_allocations and counting starts again for the next tick.
+ */
+/* static */ void PoolBase::EndTick()
+{
+	for (PoolBase *pool : *PoolBase::GetPools()) {
+		pool->tick_allocations = pool->allocations;
+		pool->allocations = 0;
+	}
+}
@@ -27,8 +27,7 @@
  * @param name The name for the pool.
  */
 DEFINE_POOL_METHOD(inline)::Pool(const char *name) :
-		PoolBase(Tpool_type),
-		name(name),
+		PoolBase(Tpool_type, name),
 		size(0),
 		first_free(0),
 		first_unused(0),
@@ -56,6 +55,7 @@ DEFINE_POOL_METHOD(inline void)::ResizeFor(size_t index)
 
 	this->data = ReallocT(this->data, new_size);
 	MemSetT(this->data + this->size, 0, new_size - this->size);
+	this->used_bitmap.resize(CeilDiv(new_size, 64));
 
 	this->size = new_size;
 }
@@ -68,9 +68,17 @@ DEFINE_POOL_METHOD(inline size_t)::FindFirstFree()
 {
 	size_t index = this->first_free;
 
-	for (; index < this->first_unused; index++) {
-		if (this->data[index] == nullptr) return index;
+	/* Skip a whole word of used indexes at a time. */
+	for (size_t word = index / 64; word * 64 < this->first_unused; word++) {
+		uint64 bits = ~this->used_bitmap[word];
+		if (word == index / 64) bits &= UINT64_MAX << (index % 64);
+		if (bits == 0) continue;
+
+		size_t found = word * 64 + FindFirstBitInWord(bits);
+		if (found < this->first_unused) return found;
+		break;
 	}
+	index = std::max(index, this->first_unused);
 
 	if (index < this->size) {
 		return index;
@@ -102,6 +110,7 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 
 	this->first_unused = std::max(this->first_unused, index + 1);
 	this->items++;
+	this->allocations++;
 
 	Titem *item;
 	if (Tcache && this->alloc_cache != nullptr) {
@@ -119,6 +128,7 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 		item = (Titem *)MallocT<byte>(size);
 	}
 	this->data[index] = item;
+	SetBit(this->used_bitmap[index / 64], index % 64);
 	item->index = (Tindex)(uint)index;
 	return item;
 }
@@ -187,6 +197,7 @@ DEFINE_POOL_METHOD(void)::FreeItem(size_t index)
 		free(this->data[index]);
 	}
 	this->data[index] = nullptr;
+	ClrBit(this->used_bitmap[index / 64], index % 64);
 	this->first_free = std::min(this->first_free, index);
 	this->items--;
 	if (!this->cleaning) Titem::PostDestructor(index);
@@ -201,6 +212,7 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	}
 	assert(this->items == 0);
 	free(this->data);
+	this->used_bitmap.clear();
 	this->first_unused = this->first_free = this->size = 0;
 	this->data = nullptr;
 	this->cleaning = false;
@@ -12,6 +12,7 @@
 
 #include "smallvec_type.hpp"
 #include "enum_type.hpp"
+#include "bitmath_func.hpp"
 
 /** Various types of a pool. */
 enum PoolType {
@@ -28,7 +29,11 @@ typedef std::vector<struct PoolBase *> PoolVector; ///< Vector of pointers to Po
 
 /** Base class for base of all pools. */
 struct PoolBase {
-	const PoolType type; ///< Type of this pool.
+	const PoolType type;     ///< Type of this pool.
+	const char * const name; ///< Name of this pool
+
+	size_t allocations;      ///< Number of items allocated during the current game tick.
+	size_t tick_allocations; ///< Number of items allocated during the last game tick.
 
 	/**
 	 * Function used to access the vector of all pools.
@@ -41,12 +46,14 @@ struct PoolBase {
 	}
 
 	static void Clean(PoolType);
+	static void EndTick();
 
 	/**
 	 * Constructor registers this object in the pool vector.
 	 * @param pt type of this pool.
+	 * @param name name of this pool.
 	 */
-	PoolBase(PoolType pt) : type(pt)
+	PoolBase(PoolType pt, const char *name) : type(pt), name(name), allocations(0), tick_allocations(0)
 	{
 		PoolBase::GetPools()->push_back(this);
 	}
@@ -84,8 +91,6 @@ struct Pool : PoolBase {
 
 	static constexpr size_t MAX_SIZE = Tmax_size; ///< Make template parameter accessible from outside
 
-	const char * const name; ///< Name of this pool
-
 	size_t size;         ///< Current allocated size
 	size_t first_free;   ///< No item with index lower than this is free (doesn't say anything about this one!)
 	size_t first_unused; ///< This and all higher indexes are free (doesn't say anything about first_unused-1 !)
@@ -96,6 +101,7 @@ struct Pool : PoolBase {
 	bool cleaning;       ///< True if cleaning pool (deleting all items)
 
 	Titem **data;        ///< Pointer to array of pointers to Titem
+	std::vector<uint64> used_bitmap; ///< Bit for every index telling whether it is used, so free and used indexes can be found a word at a time
 
 	Pool(const char *name);
 	virtual void CleanPool();
@@ -122,6 +128,34 @@ struct Pool : PoolBase {
 		return index < this->first_unused && this->Get(index) != nullptr;
 	}
 
+	/**
+	 * Find the first used index at or after the given index.
+	 * @param index The index to start looking at.
+	 * @return The first used index, or #first_unused if there is none.
+	 */
+	inline size_t FindNextUsed(size_t index) const
+	{
+		if (index >= this->first_unused) return this->first_unused;
+
+		size_t word = index / 64;
+		uint64 bits = this->used_bitmap[word] & (UINT64_MAX << (index % 64));
+		while (bits == 0) {
+			if (++word * 64 >= this->first_unused) return this->first_unused;
+			bits = this->used_bitmap[word];
+		}
+		return std::min(word * 64 + FindFirstBitInWord(bits), this->first_unused);
+	}
+
+	/**
+	 * Search the first set bit in a word of #used_bitmap.
+	 * @param bits The word to search; must not be zero.
+	 * @return The position of the first set bit.
+	 */
+	static inline uint FindFirstBitInWord(uint64 bits)
+	{
+		return GB(bits, 0, 32) != 0 ? FindFirstBit(GB(bits, 0, 32)) : 32 + FindFirstBit(GB(bits, 32, 32));
+	}
+
 	/**
 	 * Tests whether we can allocate 'n' items
 	 * @param n number of items we want to allocate
@@ -160,7 +194,11 @@ struct Pool : PoolBase {
 
 	private:
 		size_t index;
-		void ValidateIndex() { while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index))) this->index++; }
+		void ValidateIndex()
+		{
+			this->index = T::GetNextUsedIndex(this->index);
+			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index))) this->index = T::GetNextUsedIndex(this->index + 1);
+		}
 	};
 
 	/*
@@ -201,7 +239,11 @@ struct Pool : PoolBase {
 	private:
 		size_t index;
 		F filter;
-		void ValidateIndex() { while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index) && this->filter(this->index))) this->index++; }
+		void ValidateIndex()
+		{
+			this->index = T::GetNextUsedIndex(this->index);
+			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index) && this->filter(this->index))) this->index = T::GetNextUsedIndex(this->index + 1);
+		}
 	};
 
 	/*
@@ -352,6 +394,16 @@ struct Pool : PoolBase {
 			return Tpool->first_unused;
 		}
 
+		/**
+		 * Returns the first used index at or after the given index.
+		 * @param index index to start looking at
+		 * @return first used index, or #GetPoolSize() if there is none
+		 */
+		static inline size_t GetNextUsedIndex(size_t index)
+		{
+			return Tpool->FindNextUsed(index);
+		}
+
 		/**
 		 * Returns number of valid items in the pool
 		 * @return number of valid items in the pool
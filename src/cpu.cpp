@@ -101,7 +101,7 @@ uint64 ottd_rdtsc() {return 0;}
 #if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
 void ottd_cpuid(int info[4], int type)
 {
-	__cpuid(info, type);
+	__cpuidex(info, type, 0);
 }
 #elif defined(__x86_64__) || defined(__i386)
 void ottd_cpuid(int info[4], int type)
@@ -121,13 +121,13 @@ void ottd_cpuid(int info[4], int type)
 			/* It is safe to write "=r" for (info[1]) as in case that PIC is enabled for i386,
 			 * the compiler will not choose EBX as target register (but something else).
 			 */
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #else
 	__asm__ __volatile__ (
 			"cpuid           \n\t"
 			: "=a" (info[0]), "=b" (info[1]), "=c" (info[2]), "=d" (info[3])
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #endif /* i386 PIC */
 }
@@ -148,3 +148,35 @@ bool HasCPUIDFlag(uint type, uint index, uint bit)
 	ottd_cpuid(cpu_info, type);
 	return HasBit(cpu_info[index], bit);
 }
+
+/**
+ * Read the extended control register that tells which register states the
+ * operating system saves on a context switch.
+ * @return The lower 32 bits of XCR0.
+ */
+static uint32 GetExtendedControlRegister()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	return (uint32)_xgetbv(0);
+#elif defined(__x86_64__) || defined(__i386)
+	uint32 low, high;
+	__asm__ __volatile__ ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+	return low;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Check whether AVX2 instructions can be used, i.e. whether the CPU supports
+ * them and the operating system saves the AVX registers.
+ * @return True iff AVX2 can be used.
+ */
+bool HasAVX2Support()
+{
+	/* The CPU supports XGETBV and AVX. */
+	if (!HasCPUIDFlag(1, 2, 27) || !HasCPUIDFlag(1, 2, 28)) return false;
+	/* The operating system saves the SSE and AVX registers. */
+	if ((GetExtendedControlRegister() & 0x6) != 0x6) return false;
+	return HasCPUIDFlag(7, 1, 5);
+}
@@ -17,7 +17,8 @@
 uint64 ottd_rdtsc();
 
 /**
- * Get the CPUID information from the CPU.
+ * Get the CPUID information from the CPU. For types with sub-leaves, the
+ * first sub-leaf is retrieved.
  * @param info The retrieved info. All zeros on architectures without CPUID.
  * @param type The information this instruction should retrieve.
  */
@@ -32,4 +33,6 @@ void ottd_cpuid(int info[4], int type);
  */
 bool HasCPUIDFlag(uint type, uint index, uint bit);
 
+bool HasAVX2Support();
+
 #endif /* CPU_H */
@@ -33,6 +33,7 @@
 #include "company_base.h"
 #include "company_func.h"
 #include "walltime_func.h"
+#include "framerate_type.h"
 
 #ifdef WITH_ALLEGRO
 #	include <allegro.h>
@@ -324,6 +325,20 @@ char *CrashLog::LogRecentNews(char *buffer, const char *last) const
 	return buffer;
 }
 
+/**
+ * Writes the most recent 64 measurements of the tick trace to the buffer, with the most recent last.
+ * @param buffer The begin where to write at.
+ * @param last   The last position in the buffer to write to.
+ * @return the position of the \c '\0' character after the buffer.
+ */
+char *CrashLog::LogTickTrace(char *buffer, const char *last) const
+{
+	buffer += seprintf(buffer, last, "Recent performance measurements (start and duration in microseconds):\n");
+	buffer = PerformanceTraceToText(buffer, last, 64);
+	buffer += seprintf(buffer, last, "\n");
+	return buffer;
+}
+
 /**
  * Fill the crash log buffer with all data of a crash log.
  * @param buffer The begin where to write at.
@@ -350,6 +365,7 @@ char *CrashLog::FillCrashLog(char *buffer, const char *last) const
 	buffer = this->LogModules(buffer, last);
 	buffer = this->LogGamelog(buffer, last);
 	buffer = this->LogRecentNews(buffer, last);
+	buffer = this->LogTickTrace(buffer, last);
 
 	buffer += seprintf(buffer, last, "*** End of OpenTTD Crash Report ***\n");
 	return buffer;
@@ -428,6 +444,20 @@ bool CrashLog::WriteScreenshot(char *filename, const char *filename_last) const
 	return res;
 }
 
+/**
+ * Write the complete tick trace to a file.
+ * @note On success the filename will be filled with the full path of the
+ *       trace file. Make sure filename is at least \c MAX_PATH big.
+ * @param filename      Output for the filename of the written file.
+ * @param filename_last The last position in the filename buffer.
+ * @return true when the tick trace was successfully written.
+ */
+bool CrashLog::WriteTickTrace(char *filename, const char *filename_last) const
+{
+	seprintf(filename, filename_last, "%scrash_trace.json", _personal_dir.c_str());
+	return WritePerformanceTrace(filename);
+}
+
 /**
  * Makes the crash log, writes it to a file and then subsequently tries
  * to make a crash dump and crash savegame. It uses DEBUG to write
@@ -468,6 +498,15 @@ bool CrashLog::MakeCrashLog() const
 		printf("Crash dump written to %s. Please add this file to any bug reports.\n\n", filename);
 	}
 
+	printf("Writing crash tick trace...\n");
+	bret = this->WriteTickTrace(filename, lastof(filename));
+	if (bret) {
+		printf("Crash tick trace written to %s. Please add this file to any bug reports about slowdowns.\n\n", filename);
+	} else {
+		ret = false;
+		printf("Writing crash tick trace failed.\n\n");
+	}
+
 	printf("Writing crash savegame...\n");
 	bret = this->WriteSavegame(filename, lastof(filename));
 	if (bret) {
@@ -84,6 +84,7 @@ protected:
 	char *LogLibraries(char *buffer, const char *last) const;
 	char *LogGamelog(char *buffer, const char *last) const;
 	char *LogRecentNews(char *buffer, const char *list) const;
+	char *LogTickTrace(char *buffer, const char *last) const;
 
 public:
 	/** Stub destructor to silence some compilers. */
@@ -102,6 +103,7 @@ public:
 	 *         was successful (not all OSes support dumping files).
 	 */
 	virtual int WriteCrashDump(char *filename, const char *filename_last) const;
+	bool WriteTickTrace(char *filename, const char *filename_last) const;
 	bool WriteSavegame(char *filename, const char *filename_last) const;
 	bool WriteScreenshot(char *filename, const char *filename_last) const;
 
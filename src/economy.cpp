@@ -48,6 +48,7 @@
 #include "goal_base.h"
 #include "story_base.h"
 #include "linkgraph/refresh.h"
+#include "framerate_type.h"
 
 #include "table/strings.h"
 #include "table/pricebase.h"
@@ -99,37 +100,70 @@ Prices _price;
 Money _additional_cash_required;
 static PriceMultipliers _price_base_multiplier;
 
+/** Stations which have at least one vehicle in their loading_vehicles list, sorted by index. */
+static std::set<StationID> _loading_stations;
+
+/** Assets of a company that are used for its value and performance rating. */
+struct CompanyAssets {
+	uint station_facilities = 0;          ///< Number of facilities of all stations.
+	uint serviced_station_facilities = 0; ///< Number of facilities of the stations that were serviced recently.
+	uint profitable_vehicles = 0;         ///< Number of primary vehicles that made a profit last year.
+	Money min_profit = 0;                 ///< Lowest profit last year of the primary vehicles older than two years.
+	bool min_profit_first = true;         ///< Whether no vehicle has been found for #min_profit yet.
+	Money vehicle_value = 0;              ///< Value of all vehicles that count towards the company value.
+};
+
 /**
- * Calculate the value of the company. That is the value of all
- * assets (vehicles, stations, etc) and money minus the loan,
- * except when including_loan is \c false which is useful when
- * we want to calculate the value for bankruptcy.
- * @param c              the company to get the value of.
- * @param including_loan include the loan in the company value.
- * @return the value of the company.
+ * Count the assets of all companies in a single pass over the stations and vehicles.
+ * @param[out] assets The assets of each company, indexed by company.
  */
-Money CalculateCompanyValue(const Company *c, bool including_loan)
+static void CountCompanyAssets(CompanyAssets (&assets)[MAX_COMPANIES])
 {
-	Owner owner = c->index;
-
-	uint num = 0;
-
 	for (const Station *st : Station::Iterate()) {
-		if (st->owner == owner) num += CountBits((byte)st->facilities);
-	}
+		if (st->owner >= MAX_COMPANIES) continue;
 
-	Money value = num * _price[PR_STATION_VALUE] * 25;
+		CompanyAssets &a = assets[st->owner];
+		uint facilities = CountBits((byte)st->facilities);
+		a.station_facilities += facilities;
+		/* Only count stations that are actually serviced */
+		if (st->time_since_load <= 20 || st->time_since_unload <= 20) a.serviced_station_facilities += facilities;
+	}
 
 	for (const Vehicle *v : Vehicle::Iterate()) {
-		if (v->owner != owner) continue;
+		if (v->owner >= MAX_COMPANIES) continue;
 
+		CompanyAssets &a = assets[v->owner];
 		if (v->type == VEH_TRAIN ||
 				v->type == VEH_ROAD ||
 				(v->type == VEH_AIRCRAFT && Aircraft::From(v)->IsNormalAircraft()) ||
 				v->type == VEH_SHIP) {
-			value += v->value * 3 >> 1;
+			a.vehicle_value += v->value * 3 >> 1;
+		}
+
+		if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
+			if (v->profit_last_year > 0) a.profitable_vehicles++; // For the vehicle score only count profitable vehicles
+			if (v->age > 730) {
+				/* Find the vehicle with the lowest amount of profit */
+				if (a.min_profit_first || a.min_profit > v->profit_last_year) {
+					a.min_profit = v->profit_last_year;
+					a.min_profit_first = false;
+				}
+			}
 		}
 	}
+}
+
+/**
+ * Calculate the value of the company from its already counted assets.
+ * @param c              the company to get the value of.
+ * @param assets         the assets of the company.
+ * @param including_loan include the loan in the company value.
+ * @return the value of the company.
+ */
+static Money CalculateCompanyValue(const Company *c, const CompanyAssets &assets, bool including_loan)
+{
+	Money value = assets.station_facilities * _price[PR_STATION_VALUE] * 25;
+	value += assets.vehicle_value;
 
 	/* Add real money value */
 	if (including_loan) value -= c->current_loan;
@@ -139,14 +173,31 @@ Money CalculateCompanyValue(const Company *c, bool including_loan)
 }
 
 /**
- * if update is set to true, the economy is updated with this score
+ * Calculate the value of the company. That is the value of all
+ * assets (vehicles, stations, etc) and money minus the loan,
+ * except when including_loan is \c false which is useful when
+ * we want to calculate the value for bankruptcy.
+ * @param c              the company to get the value of.
+ * @param including_loan include the loan in the company value.
+ * @return the value of the company.
+ */
+Money CalculateCompanyValue(const Company *c, bool including_loan)
+{
+	CompanyAssets assets[MAX_COMPANIES];
+	CountCompanyAssets(assets);
+	return CalculateCompanyValue(c, assets[c->index], including_loan);
+}
+
+/**
+ * Calculate the performance rating of a company from its already counted assets.
+ * If update is set to true, the economy is updated with this score
  *  (also the house is updated, should only be true in the on-tick event)
- * @param update the economy with calculated score
  * @param c company been evaluated
+ * @param assets the assets of the company
+ * @param update the economy with calculated score
  * @return actual score of this company
- *
  */
-int UpdateCompanyRatingAndValue(Company *c, bool update)
+static int UpdateCompanyRatingAndValue(Company *c, const CompanyAssets &assets, bool update)
 {
 	Owner owner = c->index;
 	int score = 0;
@@ -155,27 +206,9 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count vehicles */
 	{
-		Money min_profit = 0;
-		bool min_profit_first = true;
-		uint num = 0;
-
-		for (const Vehicle *v : Vehicle::Iterate()) {
-			if (v->owner != owner) continue;
-			if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
-				if (v->profit_last_year > 0) num++; // For the vehicle score only count profitable vehicles
-				if (v->age > 730) {
-					/* Find the vehicle with the lowest amount of profit */
-					if (min_profit_first || min_profit > v->profit_last_year) {
-						min_profit = v->profit_last_year;
-						min_profit_first = false;
-					}
-				}
-			}
-		}
+		Money min_profit = assets.min_profit >> 8; // remove the fract part
 
-		min_profit >>= 8; // remove the fract part
-
-		_score_part[owner][SCORE_VEHICLES] = num;
+		_score_part[owner][SCORE_VEHICLES] = assets.profitable_vehicles;
 		/* Don't allow negative min_profit to show */
 		if (min_profit > 0) {
 			_score_part[owner][SCORE_MIN_PROFIT] = min_profit;
@@ -184,12 +217,7 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count stations */
 	{
-		uint num = 0;
-		for (const Station *st : Station::Iterate()) {
-			/* Only count stations that are actually serviced */
-			if (st->owner == owner && (st->time_since_load <= 20 || st->time_since_unload <= 20)) num += CountBits((byte)st->facilities);
-		}
-		_score_part[owner][SCORE_STATIONS] = num;
+		_score_part[owner][SCORE_STATIONS] = assets.serviced_station_facilities;
 	}
 
 	/* Generate statistics depending on recent income statistics */
@@ -267,13 +295,28 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 	if (update) {
 		c->old_economy[0].performance_history = score;
 		UpdateCompanyHQ(c->location_of_HQ, score);
-		c->old_economy[0].company_value = CalculateCompanyValue(c);
+		c->old_economy[0].company_value = CalculateCompanyValue(c, assets, true);
 	}
 
 	SetWindowDirty(WC_PERFORMANCE_DETAIL, 0);
 	return score;
 }
 
+/**
+ * if update is set to true, the economy is updated with this score
+ *  (also the house is updated, should only be true in the on-tick event)
+ * @param update the economy with calculated score
+ * @param c company been evaluated
+ * @return actual score of this company
+ *
+ */
+int UpdateCompanyRatingAndValue(Company *c, bool update)
+{
+	CompanyAssets assets[MAX_COMPANIES];
+	CountCompanyAssets(assets);
+	return UpdateCompanyRatingAndValue(c, assets[c->index], update);
+}
+
 /**
  * Change the ownership of all the items of a company.
  * @param old_owner The company that gets removed.
@@ -475,12 +518,17 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 
 	/*  Change ownership of tiles */
 	{
+		/* Without any rail pieces the old company had no signals or level crossings, so no
+		 * signal segments or crossings change when the tiles are merged into the new owner.
+		 * Remember that before the infrastructure counts are moved by ChangeTileOwner. */
+		bool had_rail = Company::Get(old_owner)->infrastructure.GetRailTotal() != 0;
+
 		TileIndex tile = 0;
 		do {
 			ChangeTileOwner(tile, old_owner, new_owner);
 		} while (++tile != MapSize());
 
-		if (new_owner != INVALID_OWNER) {
+		if (new_owner != INVALID_OWNER && had_rail) {
 			/* Update all signals because there can be new segment that was owned by two companies
 			 * and signals were not propagated
 			 * Similar with crossings - it is needed to bar crossings that weren't before
@@ -684,6 +732,10 @@ static void CompaniesGenStatistics()
 	/* Only run the economic statics and update company stats every 3rd month (1st of quarter). */
 	if (!HasBit(1 << 0 | 1 << 3 | 1 << 6 | 1 << 9, _cur_month)) return;
 
+	/* Count the assets of all companies at once instead of walking all vehicles and stations for each company. */
+	CompanyAssets assets[MAX_COMPANIES];
+	CountCompanyAssets(assets);
+
 	for (Company *c : Company::Iterate()) {
 		/* Drop the oldest history off the end */
 		std::copy_backward(c->old_economy, c->old_economy + MAX_HISTORY_QUARTERS - 1, c->old_economy + MAX_HISTORY_QUARTERS);
@@ -692,7 +744,7 @@ static void CompaniesGenStatistics()
 
 		if (c->num_valid_stat_ent != MAX_HISTORY_QUARTERS) c->num_valid_stat_ent++;
 
-		UpdateCompanyRatingAndValue(c, true);
+		UpdateCompanyRatingAndValue(c, assets[c->index], true);
 		if (c->block_preview != 0) c->block_preview--;
 	}
 
@@ -938,6 +990,7 @@ void StartupEconomy()
 void InitializeEconomy()
 {
 	_economy.inflation_prices = _economy.inflation_payment = 1 << 16;
+	_loading_stations.clear();
 	ClearCargoPickupMonitoring();
 	ClearCargoDeliveryMonitoring();
 }
@@ -974,6 +1027,9 @@ Money GetTransportedGoodsIncome(uint num_pieces, uint dist, byte transit_days, C
 		return 0;
 	}
 
+	/* Nothing was accepted, so there is nothing to pay; don't bother running the callback. */
+	if (num_pieces == 0) return 0;
+
 	/* Use callback to calculate cargo profit, if available */
 	if (HasBit(cs->callback_mask, CBM_CARGO_PROFIT_CALC)) {
 		uint32 var18 = std::min(dist, 0xFFFFu) | (std::min(num_pieces, 0xFFu) << 16) | (transit_days << 24);
@@ -1251,6 +1307,7 @@ void PrepareUnload(Vehicle *front_v)
 {
 	Station *curr_station = Station::Get(front_v->last_station_visited);
 	curr_station->loading_vehicles.push_back(front_v);
+	_loading_stations.insert(curr_station->index);
 
 	/* At this moment loading cannot be finished */
 	ClrBit(front_v->vehicle_flags, VF_LOADING_FINISHED);
@@ -1457,6 +1514,35 @@ struct FinalizeRefitAction
 	}
 };
 
+/**
+ * Get the speed of a vehicle as recorded in the station statistics.
+ * @param front Front vehicle of the consist.
+ * @return Speed in the units used for station ratings, capped at 255.
+ */
+static byte GetLastSpeed(const Vehicle *front)
+{
+	int t;
+	switch (front->type) {
+		case VEH_TRAIN:
+		case VEH_SHIP:
+			t = front->vcache.cached_max_speed;
+			break;
+
+		case VEH_ROAD:
+			t = front->vcache.cached_max_speed / 2;
+			break;
+
+		case VEH_AIRCRAFT:
+			t = Aircraft::From(front)->GetSpeedOldUnits(); // Convert to old units.
+			break;
+
+		default: NOT_REACHED();
+	}
+
+	/* if last speed is 0, we treat that as if no vehicle has ever visited the station. */
+	return std::min(t, 255);
+}
+
 /**
  * Refit a vehicle in a station.
  * @param v Vehicle to be refitted.
@@ -1649,6 +1735,10 @@ static void LoadUnloadVehicle(Vehicle *front)
 
 	CargoPayment *payment = front->cargo_payment;
 
+	/* Station statistics are the same for all parts of the consist. */
+	byte last_speed = GetLastSpeed(front);
+	byte last_age = std::min(_cur_year - front->build_year, 255);
+
 	uint artic_part = 0; // Articulated part we are currently trying to load. (not counting parts without capacity)
 	for (Vehicle *v = front; v != nullptr; v = v->Next()) {
 		if (v == front || !v->Previous()->HasArticulatedPart()) artic_part = 0;
@@ -1730,33 +1820,16 @@ static void LoadUnloadVehicle(Vehicle *front)
 		if (front->current_order.IsRefit() && artic_part == 1) {
 			HandleStationRefit(v, consist_capleft, st, next_station, front->current_order.GetRefitCargo());
 			ge = &st->goods[v->cargo_type];
+			/* Refitting may change the speed of the consist. */
+			last_speed = GetLastSpeed(front);
 		}
 
 		/* As we're loading here the following link can carry the full capacity of the vehicle. */
 		v->refit_cap = v->cargo_cap;
 
 		/* update stats */
-		int t;
-		switch (front->type) {
-			case VEH_TRAIN:
-			case VEH_SHIP:
-				t = front->vcache.cached_max_speed;
-				break;
-
-			case VEH_ROAD:
-				t = front->vcache.cached_max_speed / 2;
-				break;
-
-			case VEH_AIRCRAFT:
-				t = Aircraft::From(front)->GetSpeedOldUnits(); // Convert to old units.
-				break;
-
-			default: NOT_REACHED();
-		}
-
-		/* if last speed is 0, we treat that as if no vehicle has ever visited the station. */
-		ge->last_speed = std::min(t, 255);
-		ge->last_age = std::min(_cur_year - front->build_year, 255);
+		ge->last_speed = last_speed;
+		ge->last_age = last_age;
 
 		assert(v->cargo_cap >= v->cargo.StoredCount());
 		/* Capacity available for loading more cargo. */
@@ -1910,12 +1983,34 @@ static void LoadUnloadVehicle(Vehicle *front)
 	}
 }
 
+/**
+ * Remove a vehicle from the list of vehicles loading at a station.
+ * @param st the station the vehicle is loading at
+ * @param v the vehicle to remove
+ */
+void RemoveLoadingVehicle(Station *st, Vehicle *v)
+{
+	st->loading_vehicles.remove(v);
+	if (st->loading_vehicles.empty()) _loading_stations.erase(st->index);
+}
+
+/**
+ * Rebuild the set of stations that have vehicles loading, e.g. after loading a game.
+ */
+void RebuildLoadingStations()
+{
+	_loading_stations.clear();
+	for (const Station *st : Station::Iterate()) {
+		if (!st->loading_vehicles.empty()) _loading_stations.insert(st->index);
+	}
+}
+
 /**
  * Load/unload the vehicles in this station according to the order
  * they entered.
  * @param st the station to do the loading/unloading for
  */
-void LoadUnloadStation(Station *st)
+static void LoadUnloadStation(Station *st)
 {
 	/* No vehicle is here... */
 	if (st->loading_vehicles.empty()) return;
@@ -1955,6 +2050,23 @@ void LoadUnloadStation(Station *st)
 	_cargo_delivery_destinations.clear();
 }
 
+/**
+ * Load/unload the vehicles at all stations that have vehicles loading.
+ * The stations are handled in order of their index, just like iterating
+ * over all stations would, but without visiting the idle ones.
+ */
+void LoadUnloadStations()
+{
+	static const PerformanceScopeID scope = RegisterPerformanceScope("Cargo loading and unloading");
+	PerformanceScope profile(scope);
+
+	for (auto it = _loading_stations.begin(); it != _loading_stations.end(); /* nothing */) {
+		/* Advance first; loading never removes other stations from the set. */
+		Station *st = Station::Get(*it++);
+		LoadUnloadStation(st);
+	}
+}
+
 /**
  * Monthly update of the economic data (of the companies as well as economic fluctuations).
  */
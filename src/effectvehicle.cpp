@@ -16,6 +16,9 @@
 #include "animated_tile_func.h"
 #include "effectvehicle_func.h"
 #include "effectvehicle_base.h"
+#include "spritecache.h"
+#include "viewport_func.h"
+#include "window_gui.h"
 
 #include "safeguards.h"
 
@@ -583,16 +586,252 @@ static const TransparencyOption _effect_transparency_options[] = {
 static_assert(lengthof(_effect_transparency_options) == EV_END);
 
 
+/** Animation of an effect that is simulated as particle instead of as effect vehicle. */
+struct ParticleAnimation {
+	SpriteID first_sprite; ///< Sprite the particle starts with.
+	SpriteID last_sprite;  ///< Last sprite; the particle disappears when it would advance beyond it.
+	byte progress;         ///< Initial progress.
+	byte rise_period;      ///< The particle rises a pixel whenever the progress is a multiple of this, or never when 0.
+	byte frame_period;     ///< The particle advances a sprite whenever the progress modulo this ...
+	byte frame_phase;      ///< ... equals this.
+};
+
+/**
+ * Animations of the effects that are simulated as particles. These mirror the
+ * tick procs of the corresponding effect vehicles, so old savegames with such
+ * effect vehicles look the same as the particles created now.
+ */
+static const ParticleAnimation _particle_animations[] = {
+	{ 0,                    0,                    0, 0,  0, 0 }, // EV_CHIMNEY_SMOKE
+	{ SPR_STEAM_SMOKE_0,    SPR_STEAM_SMOKE_4,   12, 8, 16, 4 }, // EV_STEAM_SMOKE
+	{ SPR_DIESEL_SMOKE_0,   SPR_DIESEL_SMOKE_5,   0, 4,  8, 1 }, // EV_DIESEL_SMOKE
+	{ SPR_ELECTRIC_SPARK_0, SPR_ELECTRIC_SPARK_5, 1, 0,  3, 0 }, // EV_ELECTRIC_SPARK
+	{ SPR_SMOKE_0,          SPR_SMOKE_4,         12, 4, 16, 4 }, // EV_CRASH_SMOKE
+	{ 0,                    0,                    0, 0,  0, 0 }, // EV_EXPLOSION_LARGE
+	{ 0,                    0,                    0, 0,  0, 0 }, // EV_BREAKDOWN_SMOKE
+	{ 0,                    0,                    0, 0,  0, 0 }, // EV_EXPLOSION_SMALL
+	{ 0,                    0,                    0, 0,  0, 0 }, // EV_BULLDOZER
+	{ 0,                    0,                    0, 0,  0, 0 }, // EV_BUBBLE
+	{ SPR_SMOKE_0,          SPR_SMOKE_4,         12, 4, 16, 4 }, // EV_BREAKDOWN_SMOKE_AIRCRAFT
+	{ SPR_SMOKE_0,          SPR_SMOKE_4,         12, 4, 16, 4 }, // EV_COPPER_MINE_SMOKE
+};
+static_assert(lengthof(_particle_animations) == EV_END);
+
+/**
+ * Is the effect simulated as particle? Only effects that are purely visual,
+ * do not use the game's random numbers and live shortly can be particles;
+ * the others are game state and must stay effect vehicles.
+ * @param type The type of effect.
+ * @return True iff the effect is a particle.
+ */
+static inline bool IsParticleEffect(EffectVehicleType type)
+{
+	return _particle_animations[type].frame_period != 0;
+}
+
+/** Maximum number of particles alive at the same time. */
+static const size_t MAX_PARTICLES = 1 << 16;
+
+/**
+ * All particles, stored as structure of arrays so the tick loop only touches the data it needs.
+ * Particles are not part of the game state: they are not saved and every client only
+ * creates the particles it can see.
+ */
+static struct Particles {
+	std::vector<int32> x;              ///< X position in world coordinates.
+	std::vector<int32> y;              ///< Y position in world coordinates.
+	std::vector<int32> z;              ///< Z position in world coordinates.
+	std::vector<SpriteID> sprite;      ///< Current sprite.
+	std::vector<byte> progress;        ///< Progress of the animation.
+	std::vector<byte> type;            ///< #EffectVehicleType of the particle.
+	std::vector<Rect> coord;           ///< Bounds in viewport coordinates.
+
+	size_t Count() const { return this->x.size(); }
+
+	void Clear()
+	{
+		this->x.clear();
+		this->y.clear();
+		this->z.clear();
+		this->sprite.clear();
+		this->progress.clear();
+		this->type.clear();
+		this->coord.clear();
+	}
+
+	/**
+	 * Remove a particle by moving the last particle into its place.
+	 * @param i Index of the particle.
+	 */
+	void Remove(size_t i)
+	{
+		this->x[i] = this->x.back();               this->x.pop_back();
+		this->y[i] = this->y.back();               this->y.pop_back();
+		this->z[i] = this->z.back();               this->z.pop_back();
+		this->sprite[i] = this->sprite.back();     this->sprite.pop_back();
+		this->progress[i] = this->progress.back(); this->progress.pop_back();
+		this->type[i] = this->type.back();         this->type.pop_back();
+		this->coord[i] = this->coord.back();       this->coord.pop_back();
+	}
+} _particles;
+
+/**
+ * Get the bounds of a particle in viewport coordinates.
+ * @param x The x location on the map.
+ * @param y The y location on the map.
+ * @param z The z location on the map.
+ * @param sprite The sprite of the particle.
+ * @return The bounds, like those of a vehicle.
+ */
+static Rect GetParticleBounds(int x, int y, int z, SpriteID sprite)
+{
+	const Sprite *spr = GetSprite(sprite, ST_NORMAL);
+	Point pt = RemapCoords(x, y, z);
+
+	Rect r;
+	r.left   = pt.x + spr->x_offs;
+	r.top    = pt.y + spr->y_offs;
+	r.right  = pt.x + spr->x_offs + spr->width - 1 + 2 * ZOOM_LVL_BASE;
+	r.bottom = pt.y + spr->y_offs + spr->height - 1 + 2 * ZOOM_LVL_BASE;
+	return r;
+}
+
+/**
+ * Is an area shown by any viewport at a zoom level that draws effects?
+ * @param r The area in viewport coordinates.
+ * @return True iff any viewport may draw something in the area.
+ */
+static bool IsVisibleForEffects(const Rect &r)
+{
+	/* Particles rise a bit during their lifetime, so be a bit lenient. */
+	const int margin = MAX_VEHICLE_PIXEL_Y * ZOOM_LVL_BASE;
+
+	for (const Window *w : Window::Iterate()) {
+		const Viewport *vp = w->viewport;
+		if (vp == nullptr || vp->zoom > ZOOM_LVL_DETAIL) continue;
+
+		if (r.right >= vp->virtual_left && r.left < vp->virtual_left + vp->virtual_width &&
+				r.bottom >= vp->virtual_top - margin && r.top < vp->virtual_top + vp->virtual_height + margin) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Create a particle, unless nobody can see it.
+ * @param x The x location on the map.
+ * @param y The y location on the map.
+ * @param z The z location on the map.
+ * @param type The type of effect, must be a particle effect.
+ */
+static void CreateParticle(int x, int y, int z, EffectVehicleType type)
+{
+	assert(IsParticleEffect(type));
+	if (_particles.Count() >= MAX_PARTICLES) return;
+
+	const ParticleAnimation &anim = _particle_animations[type];
+	Rect coord = GetParticleBounds(x, y, z, anim.first_sprite);
+	if (!IsVisibleForEffects(coord)) return;
+
+	_particles.x.push_back(x);
+	_particles.y.push_back(y);
+	_particles.z.push_back(z);
+	_particles.sprite.push_back(anim.first_sprite);
+	_particles.progress.push_back(anim.progress);
+	_particles.type.push_back(type);
+	_particles.coord.push_back(coord);
+
+	MarkAllViewportsDirty(coord.left, coord.top, coord.right, coord.bottom);
+}
+
+/** Advance all particles by one tick. */
+void TickParticles()
+{
+	if (_particles.Count() == 0) return;
+
+	/* Advancing the progress does not depend on the type, so do it for all particles at once. */
+	for (byte &progress : _particles.progress) progress++;
+
+	for (size_t i = 0; i < _particles.Count(); /* nothing */) {
+		const ParticleAnimation &anim = _particle_animations[_particles.type[i]];
+		byte progress = _particles.progress[i];
+		bool moved = false;
+
+		if (anim.rise_period != 0 && progress % anim.rise_period == 0) {
+			_particles.z[i]++;
+			moved = true;
+		}
+
+		if (progress % anim.frame_period == anim.frame_phase) {
+			const Rect &old = _particles.coord[i];
+			if (_particles.sprite[i] == anim.last_sprite) {
+				MarkAllViewportsDirty(old.left, old.top, old.right, old.bottom);
+				_particles.Remove(i);
+				continue;
+			}
+			_particles.sprite[i]++;
+			moved = true;
+		}
+
+		if (moved) {
+			Rect &coord = _particles.coord[i];
+			Rect old = coord;
+			coord = GetParticleBounds(_particles.x[i], _particles.y[i], _particles.z[i], _particles.sprite[i]);
+			MarkAllViewportsDirty(std::min(old.left, coord.left), std::min(old.top, coord.top), std::max(old.right, coord.right), std::max(old.bottom, coord.bottom));
+		}
+
+		i++;
+	}
+}
+
+/**
+ * Add the particle sprites that should be drawn at a part of the screen.
+ * @param dpi Rectangle being drawn.
+ */
+void ViewportAddParticles(const DrawPixelInfo *dpi)
+{
+	const int l = dpi->left;
+	const int r = dpi->left + dpi->width;
+	const int t = dpi->top;
+	const int b = dpi->top + dpi->height;
+
+	for (size_t i = 0; i < _particles.Count(); i++) {
+		const Rect &coord = _particles.coord[i];
+		if (l > coord.right || t > coord.bottom || r < coord.left || b < coord.top) continue;
+
+		/* Transparent smoke looks weird, so hide it instead; just like effect vehicles. */
+		TransparencyOption to = _effect_transparency_options[_particles.type[i]];
+		if (to != TO_INVALID && (IsTransparencySet(to) || IsInvisibilitySet(to))) continue;
+
+		AddSortableSpriteToDraw(_particles.sprite[i], PAL_NONE, _particles.x[i], _particles.y[i], 1, 1, 1, _particles.z[i]);
+	}
+}
+
+/** Remove all particles. */
+void ClearParticles()
+{
+	_particles.Clear();
+}
+
+
 /**
  * Create an effect vehicle at a particular location.
  * @param x The x location on the map.
  * @param y The y location on the map.
  * @param z The z location on the map.
  * @param type The type of effect vehicle.
- * @return The effect vehicle.
+ * @return The effect vehicle, or \c nullptr if none was created. Purely visual effects
+ *         are always created as particles, for which \c nullptr is returned as well.
  */
 EffectVehicle *CreateEffectVehicle(int x, int y, int z, EffectVehicleType type)
 {
+	if (IsParticleEffect(type)) {
+		CreateParticle(x, y, z, type);
+		return nullptr;
+	}
+
 	if (!Vehicle::CanAllocateItem()) return nullptr;
 
 	EffectVehicle *v = new EffectVehicle();
@@ -617,7 +856,7 @@ EffectVehicle *CreateEffectVehicle(int x, int y, int z, EffectVehicleType type)
  * @param y The y location on the map.
  * @param z The offset from the ground.
  * @param type The type of effect vehicle.
- * @return The effect vehicle.
+ * @return The effect vehicle, or \c nullptr if none was created.
  */
 EffectVehicle *CreateEffectVehicleAbove(int x, int y, int z, EffectVehicleType type)
 {
@@ -633,7 +872,7 @@ EffectVehicle *CreateEffectVehicleAbove(int x, int y, int z, EffectVehicleType t
  * @param y The y offset to the vehicle.
  * @param z The z offset to the vehicle.
  * @param type The type of effect vehicle.
- * @return The effect vehicle.
+ * @return The effect vehicle, or \c nullptr if none was created.
  */
 EffectVehicle *CreateEffectVehicleRel(const Vehicle *v, int x, int y, int z, EffectVehicleType type)
 {
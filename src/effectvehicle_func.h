@@ -11,6 +11,7 @@
 #define EFFECTVEHICLE_FUNC_H
 
 #include "vehicle_type.h"
+#include "gfx_type.h"
 
 /** Effect vehicle types */
 enum EffectVehicleType {
@@ -33,4 +34,8 @@ EffectVehicle *CreateEffectVehicle(int x, int y, int z, EffectVehicleType type);
 EffectVehicle *CreateEffectVehicleAbove(int x, int y, int z, EffectVehicleType type);
 EffectVehicle *CreateEffectVehicleRel(const Vehicle *v, int x, int y, int z, EffectVehicleType type);
 
+void TickParticles();
+void ViewportAddParticles(const DrawPixelInfo *dpi);
+void ClearParticles();
+
 #endif /* EFFECTVEHICLE_FUNC_H */
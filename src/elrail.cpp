@@ -65,8 +65,53 @@
 
 #include "table/elrail_data.h"
 
+#include <unordered_map>
+
 #include "safeguards.h"
 
+/** A pylon or wire of the catenary of a tile. */
+struct CatenarySprite {
+	bool wire;         ///< Whether this is a wire, otherwise it is a pylon.
+	bool halftile;     ///< Whether the sprite is taken from the upper halftile sprites.
+	uint16 offset;     ///< Offset of the sprite from the first pylon or wire sprite.
+	int8 x;            ///< X offset of the sprite from the tile.
+	int8 y;            ///< Y offset of the sprite from the tile.
+	int8 w;            ///< Width of the bounding box.
+	int8 h;            ///< Height of the bounding box.
+	int8 dz;           ///< Vertical extent of the bounding box.
+	int z;             ///< Height of the sprite.
+};
+
+/** The catenary of a tile, as placed by #ResolveRailCatenaryRailway. */
+struct CatenaryCacheEntry {
+	bool bridges_transparent;            ///< Whether bridges were transparent when the catenary was placed.
+	std::vector<CatenarySprite> sprites; ///< The pylons and wires to draw.
+};
+
+static const size_t MAX_CATENARY_CACHE_SIZE = 1 << 16; ///< Number of tiles after which the catenary cache is emptied.
+static std::unordered_map<TileIndex, CatenaryCacheEntry> _catenary_cache; ///< Placed catenary per tile.
+
+/**
+ * Forget the placed catenary of a tile and its neighbours, as the placement
+ * of pylons depends on the tracks of the neighbouring tiles.
+ * @param tile The tile that has changed.
+ */
+void InvalidateCatenaryCache(TileIndex tile)
+{
+	if (_catenary_cache.empty()) return;
+
+	_catenary_cache.erase(tile);
+	for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+		_catenary_cache.erase(tile + TileOffsByDiagDir(dir));
+	}
+}
+
+/** Forget the placed catenary of all tiles. */
+void ClearCatenaryCache()
+{
+	_catenary_cache.clear();
+}
+
 /**
  * Get the tile location group of a tile.
  * @param t The tile to get the tile location group of.
@@ -270,10 +315,11 @@ void DrawRailCatenaryOnTunnel(const TileInfo *ti)
 }
 
 /**
- * Draws wires and, if required, pylons on a given tile
+ * Determine the wires and, if required, pylons of a given tile
  * @param ti The Tileinfo to draw the tile for
+ * @param[out] sprites The pylons and wires to draw.
  */
-static void DrawRailCatenaryRailway(const TileInfo *ti)
+static void ResolveRailCatenaryRailway(const TileInfo *ti, std::vector<CatenarySprite> &sprites)
 {
 	/* Pylons are placed on a tile edge, so we need to take into account
 	 * the track configuration of 2 adjacent tiles. trackconfig[0] stores the
@@ -311,9 +357,6 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 
 	AdjustTileh(ti->tile, &tileh[TS_HOME]);
 
-	SpriteID pylon_normal = GetPylonBase(ti->tile);
-	SpriteID pylon_halftile = (halftile_corner != CORNER_INVALID) ? GetPylonBase(ti->tile, TCX_UPPER_HALFTILE) : pylon_normal;
-
 	for (DiagDirection i = DIAGDIR_BEGIN; i < DIAGDIR_END; i++) {
 		static const uint edge_corners[] = {
 			1 << CORNER_N | 1 << CORNER_E, // DIAGDIR_NE
@@ -321,7 +364,7 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 			1 << CORNER_S | 1 << CORNER_W, // DIAGDIR_SW
 			1 << CORNER_N | 1 << CORNER_W, // DIAGDIR_NW
 		};
-		SpriteID pylon_base = (halftile_corner != CORNER_INVALID && HasBit(edge_corners[i], halftile_corner)) ? pylon_halftile : pylon_normal;
+		bool pylon_halftile = halftile_corner != CORNER_INVALID && HasBit(edge_corners[i], halftile_corner);
 		TileIndex neighbour = ti->tile + TileOffsByDiagDir(i);
 		int elevation = GetPCPElevation(ti->tile, i);
 
@@ -426,8 +469,8 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 				byte temp = PPPorder[i][GetTLG(ti->tile)][k];
 
 				if (HasBit(PPPallowed[i], temp)) {
-					uint x  = ti->x + x_pcp_offsets[i] + x_ppp_offsets[temp];
-					uint y  = ti->y + y_pcp_offsets[i] + y_ppp_offsets[temp];
+					int x = x_pcp_offsets[i] + x_ppp_offsets[temp];
+					int y = y_pcp_offsets[i] + y_ppp_offsets[temp];
 
 					/* Don't build the pylon if it would be outside the tile */
 					if (!HasBit(OwnedPPPonPCP[i], temp)) {
@@ -436,8 +479,7 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 						continue; // No neighbour, go looking for a better position
 					}
 
-					AddSortableSpriteToDraw(pylon_base + pylon_sprites[temp], PAL_NONE, x, y, 1, 1, BB_HEIGHT_UNDER_BRIDGE,
-						elevation, IsTransparencySet(TO_CATENARY), -1, -1);
+					sprites.push_back({false, pylon_halftile, (uint16)pylon_sprites[temp], (int8)x, (int8)y, 1, 1, BB_HEIGHT_UNDER_BRIDGE, elevation});
 
 					break; // We already have drawn a pylon, bail out
 				}
@@ -458,8 +500,6 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 	/* Don't draw a wire if the station tile does not want any */
 	if (IsRailStationTile(ti->tile) && !CanStationTileHaveWires(ti->tile)) return;
 
-	SpriteID wire_normal = GetWireBase(ti->tile);
-	SpriteID wire_halftile = (halftile_corner != CORNER_INVALID) ? GetWireBase(ti->tile, TCX_UPPER_HALFTILE) : wire_normal;
 	Track halftile_track;
 	switch (halftile_corner) {
 		case CORNER_W: halftile_track = TRACK_LEFT; break;
@@ -471,7 +511,6 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 
 	/* Drawing of pylons is finished, now draw the wires */
 	for (Track t : SetTrackBitIterator(wireconfig[TS_HOME])) {
-		SpriteID wire_base = (t == halftile_track) ? wire_halftile : wire_normal;
 		byte PCPconfig = HasBit(PCPstatus, PCPpositions[t][0]) +
 			(HasBit(PCPstatus, PCPpositions[t][1]) << 1);
 
@@ -487,9 +526,44 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 		 * Therefore it is safe to use GetSlopePixelZ() for the elevation.
 		 * Also note that the result of GetSlopePixelZ() is very special for bridge-ramps.
 		 */
-		AddSortableSpriteToDraw(wire_base + sss->image_offset, PAL_NONE, ti->x + sss->x_offset, ti->y + sss->y_offset,
-			sss->x_size, sss->y_size, sss->z_size, GetSlopePixelZ(ti->x + sss->x_offset, ti->y + sss->y_offset) + sss->z_offset,
-			IsTransparencySet(TO_CATENARY));
+		sprites.push_back({true, t == halftile_track, (uint16)sss->image_offset, sss->x_offset, sss->y_offset,
+			sss->x_size, sss->y_size, sss->z_size, GetSlopePixelZ(ti->x + sss->x_offset, ti->y + sss->y_offset) + sss->z_offset});
+	}
+}
+
+/**
+ * Draws wires and, if required, pylons on a given tile.
+ * The placement of the pylons and wires is cached per tile; the sprites
+ * themselves are resolved on every draw, as NewGRFs may vary them.
+ * @param ti The Tileinfo to draw the tile for
+ */
+static void DrawRailCatenaryRailway(const TileInfo *ti)
+{
+	bool bridges_transparent = IsTransparencySet(TO_BRIDGES);
+	auto it = _catenary_cache.find(ti->tile);
+	if (it == _catenary_cache.end() || it->second.bridges_transparent != bridges_transparent) {
+		if (_catenary_cache.size() >= MAX_CATENARY_CACHE_SIZE) _catenary_cache.clear();
+
+		it = _catenary_cache.emplace(ti->tile, CatenaryCacheEntry()).first;
+		it->second.bridges_transparent = bridges_transparent;
+		it->second.sprites.clear();
+		ResolveRailCatenaryRailway(ti, it->second.sprites);
+	}
+
+	SpriteID pylon_base[2] = { 0, 0 }; ///< Normal and upper halftile pylon sprites, resolved when needed.
+	SpriteID wire_base[2] = { 0, 0 };  ///< Normal and upper halftile wire sprites, resolved when needed.
+	for (const CatenarySprite &cs : it->second.sprites) {
+		if (cs.wire) {
+			SpriteID &base = wire_base[cs.halftile];
+			if (base == 0) base = GetWireBase(ti->tile, cs.halftile ? TCX_UPPER_HALFTILE : TCX_NORMAL);
+			AddSortableSpriteToDraw(base + cs.offset, PAL_NONE, ti->x + cs.x, ti->y + cs.y,
+				cs.w, cs.h, cs.dz, cs.z, IsTransparencySet(TO_CATENARY));
+		} else {
+			SpriteID &base = pylon_base[cs.halftile];
+			if (base == 0) base = GetPylonBase(ti->tile, cs.halftile ? TCX_UPPER_HALFTILE : TCX_NORMAL);
+			AddSortableSpriteToDraw(base + cs.offset, PAL_NONE, ti->x + cs.x, ti->y + cs.y,
+				cs.w, cs.h, cs.dz, cs.z, IsTransparencySet(TO_CATENARY), -1, -1);
+		}
 	}
 }
 
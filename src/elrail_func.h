@@ -35,6 +35,8 @@ static inline bool HasRailCatenaryDrawn(RailType rt)
 void DrawRailCatenary(const TileInfo *ti);
 void DrawRailCatenaryOnTunnel(const TileInfo *ti);
 void DrawRailCatenaryOnBridge(const TileInfo *ti);
+void InvalidateCatenaryCache(TileIndex tile);
+void ClearCatenaryCache();
 
 void SettingsDisableElrail(int32 new_value); ///< _settings_game.disable_elrail callback
 
@@ -64,6 +64,7 @@ struct Engine : EnginePool::PoolItem<&_engine_pool> {
 	GRFFilePropsBase<NUM_CARGO + 2> grf_prop;
 	std::vector<WagonOverride> overrides;
 	uint16 list_position;
+	bool static_sprites;        ///< The sprites of vehicles of this engine only depend on their direction, cargo and the front engine. @see EngineHasStaticSprites
 
 	Engine() {}
 	Engine(VehicleType type, EngineID base);
@@ -23,6 +23,7 @@
 #include "roadveh.h"
 #include "ship.h"
 #include "aircraft.h"
+#include <map>
 
 #include "widgets/engine_widget.h"
 
@@ -318,6 +319,36 @@ void DrawVehicleEngine(int left, int right, int preferred_x, int y, EngineID eng
 	}
 }
 
+/** Values of engines determined while sorting the current list, see #GetEngineSortValue. */
+static std::map<std::pair<EngineID, EngineSortValue>, int64> _engine_sort_values;
+
+/**
+ * Get a value of an engine to sort on. The value is determined only once per sort, as
+ * it may involve NewGRF callbacks and the sorting compares every engine many times.
+ * @param engine Engine to get the value of.
+ * @param value  The value to get.
+ * @return The value of the engine.
+ */
+int64 GetEngineSortValue(EngineID engine, EngineSortValue value)
+{
+	auto key = std::make_pair(engine, value);
+	auto it = _engine_sort_values.find(key);
+	if (it != _engine_sort_values.end()) return it->second;
+
+	const Engine *e = Engine::Get(engine);
+	int64 result;
+	switch (value) {
+		case ESV_COST:            result = e->GetCost(); break;
+		case ESV_SPEED:           result = e->GetDisplayMaxSpeed(); break;
+		case ESV_POWER:           result = e->GetPower(); break;
+		case ESV_TRACTIVE_EFFORT: result = e->GetDisplayMaxTractiveEffort(); break;
+		case ESV_RUNNING_COST:    result = e->GetRunningCost(); break;
+		default: NOT_REACHED();
+	}
+	_engine_sort_values.emplace(key, result);
+	return result;
+}
+
 /**
  * Sort all items using quick sort and given 'CompareItems' function
  * @param el list to be sorted
@@ -327,6 +358,7 @@ void EngList_Sort(GUIEngineList *el, EngList_SortTypeFunction compare)
 {
 	if (el->size() < 2) return;
 	std::sort(el->begin(), el->end(), compare);
+	_engine_sort_values.clear();
 }
 
 /**
@@ -342,5 +374,6 @@ void EngList_SortPartial(GUIEngineList *el, EngList_SortTypeFunction compare, ui
 	assert(begin < el->size());
 	assert(begin + num_items <= el->size());
 	std::sort(el->begin() + begin, el->begin() + begin + num_items, compare);
+	_engine_sort_values.clear();
 }
 
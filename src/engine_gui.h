@@ -18,6 +18,17 @@
 typedef GUIList<EngineID, CargoID> GUIEngineList;
 
 typedef bool EngList_SortTypeFunction(const EngineID&, const EngineID&); ///< argument type for #EngList_Sort.
+
+/** Values of engines that may be determined by NewGRF callbacks, and are cached while sorting. */
+enum EngineSortValue {
+	ESV_COST,             ///< Purchase cost, see #Engine::GetCost.
+	ESV_SPEED,            ///< Maximum speed, see #Engine::GetDisplayMaxSpeed.
+	ESV_POWER,            ///< Power, see #Engine::GetPower.
+	ESV_TRACTIVE_EFFORT,  ///< Tractive effort, see #Engine::GetDisplayMaxTractiveEffort.
+	ESV_RUNNING_COST,     ///< Running cost, see #Engine::GetRunningCost.
+};
+
+int64 GetEngineSortValue(EngineID engine, EngineSortValue value);
 void EngList_Sort(GUIEngineList *el, EngList_SortTypeFunction compare);
 void EngList_SortPartial(GUIEngineList *el, EngList_SortTypeFunction compare, uint begin, uint num_items);
 
@@ -23,6 +23,8 @@
 #include <functional>
 #include <optional>
 #include <charconv>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifndef _WIN32
 # include <unistd.h>
@@ -261,6 +263,23 @@ bool FiosDelete(const char *name)
 
 typedef FiosType fios_getlist_callback_proc(SaveLoadOperation fop, const std::string &filename, const char *ext, char *title, const char *last);
 
+/**
+ * What is known about a file from an earlier scan. Files in the save and
+ * scenario directories rarely change, so as long as the modification time and
+ * size are the same there is no need to read the title of the file again.
+ */
+struct FiosFileCacheEntry {
+	fios_getlist_callback_proc *callback_proc; ///< The callback that checked the file.
+	SaveLoadOperation fop; ///< Purpose of the list the file was checked for.
+	uint64 mtime;          ///< Modification time of the file when it was checked.
+	uint64 size;           ///< Size of the file when it was checked.
+	FiosType type;         ///< Type the callback returned.
+	std::string title;     ///< Title the callback returned.
+};
+
+/** The files seen by earlier scans, by their full path. */
+static std::unordered_map<std::string, FiosFileCacheEntry> _fios_file_cache;
+
 /**
  * Scanner to scan for a particular type of FIOS file.
  */
@@ -268,6 +287,7 @@ class FiosFileScanner : public FileScanner {
 	SaveLoadOperation fop;   ///< The kind of file we are looking for.
 	fios_getlist_callback_proc *callback_proc; ///< Callback to check whether the file may be added
 	FileList &file_list;     ///< Destination of the found files.
+	std::unordered_set<std::string> added; ///< Names of the files that are added already.
 public:
 	/**
 	 * Create the scanner
@@ -282,6 +302,45 @@ public:
 	bool AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename) override;
 };
 
+/**
+ * Get the modification time and size of a file.
+ * @param filename The full path to the file.
+ * @param[out] mtime The modification time, in seconds since 01/01/1970.
+ * @param[out] size The size in bytes.
+ * @return True iff the file could be inspected.
+ */
+static bool GetFileTimeAndSize(const std::string &filename, uint64 *mtime, uint64 *size)
+{
+#ifdef _WIN32
+	// Retrieve the file modified date using GetFileTime rather than stat to work around an obscure MSVC bug that affects Windows XP
+	HANDLE fh = CreateFile(OTTD2FS(filename).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+	if (fh == INVALID_HANDLE_VALUE) return false;
+
+	FILETIME ft;
+	LARGE_INTEGER fs;
+	bool found = GetFileTime(fh, nullptr, nullptr, &ft) != 0 && GetFileSizeEx(fh, &fs) != 0;
+	if (found) {
+		ULARGE_INTEGER ft_int64;
+		ft_int64.HighPart = ft.dwHighDateTime;
+		ft_int64.LowPart = ft.dwLowDateTime;
+
+		// Convert from hectonanoseconds since 01/01/1601 to seconds since 01/01/1970
+		*mtime = ft_int64.QuadPart / 10000000ULL - 11644473600ULL;
+		*size = fs.QuadPart;
+	}
+
+	CloseHandle(fh);
+	return found;
+#else
+	struct stat sb;
+	if (stat(filename.c_str(), &sb) != 0) return false;
+
+	*mtime = sb.st_mtime;
+	*size = sb.st_size;
+	return true;
+#endif
+}
+
 /**
  * Try to add a fios item set with the given filename.
  * @param filename        the full path to the file to read
@@ -294,51 +353,37 @@ bool FiosFileScanner::AddFile(const std::string &filename, size_t basepath_lengt
 	if (sep == std::string::npos) return false;
 	std::string ext = filename.substr(sep);
 
-	char fios_title[64];
-	fios_title[0] = '\0'; // reset the title;
-
-	FiosType type = this->callback_proc(this->fop, filename, ext.c_str(), fios_title, lastof(fios_title));
-	if (type == FIOS_TYPE_INVALID) return false;
+	uint64 mtime = 0;
+	uint64 size = 0;
+	bool on_disk = GetFileTimeAndSize(filename, &mtime, &size);
 
-	for (const auto &fios : file_list) {
-		if (filename == fios.name) return false;
-	}
-
-	FiosItem *fios = &file_list.emplace_back();
-#ifdef _WIN32
-	// Retrieve the file modified date using GetFileTime rather than stat to work around an obscure MSVC bug that affects Windows XP
-	HANDLE fh = CreateFile(OTTD2FS(filename).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
-
-	if (fh != INVALID_HANDLE_VALUE) {
-		FILETIME ft;
-		ULARGE_INTEGER ft_int64;
-
-		if (GetFileTime(fh, nullptr, nullptr, &ft) != 0) {
-			ft_int64.HighPart = ft.dwHighDateTime;
-			ft_int64.LowPart = ft.dwLowDateTime;
+	FiosFileCacheEntry entry;
+	auto it = _fios_file_cache.find(filename);
+	if (on_disk && it != _fios_file_cache.end() && it->second.callback_proc == this->callback_proc && it->second.fop == this->fop &&
+			it->second.mtime == mtime && it->second.size == size) {
+		entry = it->second;
+	} else {
+		char fios_title[64];
+		fios_title[0] = '\0'; // reset the title;
 
-			// Convert from hectonanoseconds since 01/01/1601 to seconds since 01/01/1970
-			fios->mtime = ft_int64.QuadPart / 10000000ULL - 11644473600ULL;
-		} else {
-			fios->mtime = 0;
-		}
+		FiosType type = this->callback_proc(this->fop, filename, ext.c_str(), fios_title, lastof(fios_title));
+		entry = { this->callback_proc, this->fop, mtime, size, type, fios_title };
 
-		CloseHandle(fh);
-#else
-	struct stat sb;
-	if (stat(filename.c_str(), &sb) == 0) {
-		fios->mtime = sb.st_mtime;
-#endif
-	} else {
-		fios->mtime = 0;
+		/* Files inside tars can not be inspected, so those are checked every time. */
+		if (on_disk) _fios_file_cache[filename] = entry;
 	}
 
-	fios->type = type;
+	if (entry.type == FIOS_TYPE_INVALID) return false;
+	if (!this->added.insert(filename).second) return false;
+
+	FiosItem *fios = &file_list.emplace_back();
+	fios->mtime = mtime;
+	fios->type = entry.type;
 	strecpy(fios->name, filename.c_str(), lastof(fios->name));
 
 	/* If the file doesn't have a title, use its filename */
-	const char *t = fios_title;
-	if (StrEmpty(fios_title)) {
+	const char *t = entry.title.c_str();
+	if (entry.title.empty()) {
 		auto ps = filename.rfind(PATHSEPCHAR);
 		t = filename.c_str() + (ps == std::string::npos ? 0 : ps + 1);
 	}
@@ -9,6 +9,7 @@
 
 #include "framerate_type.h"
 #include <chrono>
+#include <atomic>
 #include "gfx_func.h"
 #include "window_gui.h"
 #include "window_func.h"
@@ -23,6 +24,8 @@
 #include "ai/ai_instance.hpp"
 #include "game/game.hpp"
 #include "game/game_instance.hpp"
+#include "spritecache.h"
+#include "fileio_func.h"
 
 #include "widgets/framerate_widget.h"
 #include "safeguards.h"
@@ -193,6 +196,7 @@ namespace {
 		PerformanceData(1),                     // PFE_ACC_DRAWWORLD
 		PerformanceData(60.0),                  // PFE_VIDEO
 		PerformanceData(1000.0 * 8192 / 44100), // PFE_SOUND
+		PerformanceData(1),                     // PFE_NETWORK
 		PerformanceData(1),                     // PFE_ALLSCRIPTS
 		PerformanceData(1),                     // PFE_GAMESCRIPT
 		PerformanceData(1),                     // PFE_AI0 ...
@@ -212,6 +216,121 @@ namespace {
 		PerformanceData(1),                     // PFE_AI14
 	};
 
+	/** Number of measurements kept in the tick trace. */
+	const uint NUM_TRACE_EVENTS = 4096;
+
+	/** A single measured block of a performance element, as kept in the tick trace. */
+	struct TraceEvent {
+		PerformanceElement elem;      ///< The element that was measured.
+		TimingMeasurement start_time; ///< Start time of the measured block.
+		TimingMeasurement duration;   ///< Time spent in the measured block.
+	};
+
+	/**
+	 * Circular buffer with the most recent measurements of all performance elements, in the order they finished.
+	 * Slots are claimed without locking, so the sound and video threads can record as well; a crash handler
+	 * reading the buffer at worst sees one half-written event.
+	 */
+	TraceEvent _pf_trace[NUM_TRACE_EVENTS];
+	/** Number of events ever recorded into \c _pf_trace; the next slot to write is this modulo \c NUM_TRACE_EVENTS. */
+	std::atomic<uint32> _pf_trace_count;
+
+	/** Record a measured block in the tick trace. */
+	void AddTraceEvent(PerformanceElement elem, TimingMeasurement start_time, TimingMeasurement duration)
+	{
+		TraceEvent &event = _pf_trace[_pf_trace_count.fetch_add(1, std::memory_order_relaxed) % NUM_TRACE_EVENTS];
+		event.elem = elem;
+		event.start_time = start_time;
+		event.duration = duration;
+	}
+
+	/** Name of each performance element in the tick trace; the AIs are numbered instead. */
+	static const char * const TRACE_NAMES[PFE_AI0] = {
+		"Game loop",
+		"GL station ticks",
+		"GL train ticks",
+		"GL road vehicle ticks",
+		"GL ship ticks",
+		"GL aircraft ticks",
+		"GL landscape ticks",
+		"GL link graph delays",
+		"Drawing",
+		"Viewport drawing",
+		"Video output",
+		"Sound mixing",
+		"Network packet handling",
+		"AI/GS scripts total",
+		"Game script",
+	};
+
+	/** A node in the call tree of nested performance measurements. */
+	struct ProfileNode {
+		uint scope;                  ///< The performance element, or \c PFE_MAX plus the registered scope, measured by this node.
+		uint parent;                 ///< Index of the parent node in \c _pf_tree.
+		TimingMeasurement duration;  ///< Time spent in this node since the last reset, including its children.
+		uint64 calls;                ///< Number of times this node was entered since the last reset.
+		std::vector<uint> children;  ///< Indices of the child nodes in \c _pf_tree.
+	};
+
+	/** Call tree of all nested measurements; the first node is the root and is never measured itself. */
+	std::vector<ProfileNode> _pf_tree = { { UINT_MAX, 0, 0, 0, {} } };
+	/** Index of the node in \c _pf_tree currently being measured. */
+	uint _pf_tree_current = 0;
+	/** Names of the scopes registered with #RegisterPerformanceScope. */
+	std::vector<const char *> _pf_scope_names;
+
+	/**
+	 * Whether measurements of an element are added to the call tree.
+	 * Video output and sound mixing run in their own threads, so they stay out of it.
+	 */
+	inline bool IsInCallTree(PerformanceElement elem)
+	{
+		return elem != PFE_VIDEO && elem != PFE_SOUND;
+	}
+
+	/**
+	 * Make the child node for a scope of the current node the current node, creating it when needed.
+	 * @param scope The performance element or scope to enter.
+	 * @return The node that was current before, to pass to #LeaveProfileNode.
+	 */
+	uint EnterProfileNode(uint scope)
+	{
+		uint parent = _pf_tree_current;
+		for (uint child : _pf_tree[parent].children) {
+			if (_pf_tree[child].scope == scope) {
+				_pf_tree_current = child;
+				return parent;
+			}
+		}
+
+		uint child = (uint)_pf_tree.size();
+		_pf_tree.push_back({ scope, parent, 0, 0, {} });
+		_pf_tree[parent].children.push_back(child);
+		_pf_tree_current = child;
+		return parent;
+	}
+
+	/**
+	 * Add a measurement to the current node and return to its parent.
+	 * @param parent The node returned by #EnterProfileNode.
+	 * @param duration The time spent in the current node.
+	 */
+	void LeaveProfileNode(uint parent, TimingMeasurement duration)
+	{
+		ProfileNode &node = _pf_tree[_pf_tree_current];
+		node.duration += duration;
+		node.calls++;
+		_pf_tree_current = parent;
+	}
+
+	/** Get the name of a performance element for the tick trace. */
+	const char *GetTraceName(PerformanceElement elem, char *buf, const char *last)
+	{
+		if (elem < PFE_AI0) return TRACE_NAMES[elem];
+		seprintf(buf, last, "AI %d", elem - PFE_AI0 + 1);
+		return buf;
+	}
+
 }
 
 
@@ -236,12 +355,16 @@ PerformanceMeasurer::PerformanceMeasurer(PerformanceElement elem)
 	assert(elem < PFE_MAX);
 
 	this->elem = elem;
+	if (IsInCallTree(elem)) this->tree_parent = EnterProfileNode(elem);
 	this->start_time = GetPerformanceTimer();
 }
 
 /** Finish a cycle of a measured element and store the measurement taken. */
 PerformanceMeasurer::~PerformanceMeasurer()
 {
+	TimingMeasurement end_time = GetPerformanceTimer();
+	if (IsInCallTree(this->elem)) LeaveProfileNode(this->tree_parent, end_time - this->start_time);
+
 	if (this->elem == PFE_ALLSCRIPTS) {
 		/* Hack to not record scripts total when no scripts are active */
 		bool any_active = _pf_data[PFE_GAMESCRIPT].num_valid > 0;
@@ -251,7 +374,8 @@ PerformanceMeasurer::~PerformanceMeasurer()
 			return;
 		}
 	}
-	_pf_data[this->elem].Add(this->start_time, GetPerformanceTimer());
+	_pf_data[this->elem].Add(this->start_time, end_time);
+	AddTraceEvent(this->elem, this->start_time, end_time - this->start_time);
 }
 
 /** Set the rate of expected cycles per second of a performance element. */
@@ -278,6 +402,17 @@ void PerformanceMeasurer::SetExpectedRate(double rate)
 	_pf_data[elem].AddPause(GetPerformanceTimer());
 }
 
+/**
+ * Get the average duration of the most recent cycles of a performance element.
+ * @param elem Performance element to query.
+ * @param count Number of cycles to average over.
+ * @return Average duration in milliseconds, or 0 if nothing was measured.
+ */
+/* static */ double PerformanceMeasurer::GetAverageDurationMilliseconds(PerformanceElement elem, int count)
+{
+	return _pf_data[elem].GetAverageDurationMilliseconds(count);
+}
+
 
 /**
  * Begin measuring one block of the accumulating value.
@@ -288,13 +423,16 @@ PerformanceAccumulator::PerformanceAccumulator(PerformanceElement elem)
 	assert(elem < PFE_MAX);
 
 	this->elem = elem;
+	if (IsInCallTree(elem)) this->tree_parent = EnterProfileNode(elem);
 	this->start_time = GetPerformanceTimer();
 }
 
 /** Finish and add one block of the accumulating value. */
 PerformanceAccumulator::~PerformanceAccumulator()
 {
-	_pf_data[this->elem].AddAccumulate(GetPerformanceTimer() - this->start_time);
+	TimingMeasurement duration = GetPerformanceTimer() - this->start_time;
+	if (IsInCallTree(this->elem)) LeaveProfileNode(this->tree_parent, duration);
+	_pf_data[this->elem].AddAccumulate(duration);
 }
 
 /**
@@ -304,9 +442,102 @@ PerformanceAccumulator::~PerformanceAccumulator()
  */
 void PerformanceAccumulator::Reset(PerformanceElement elem)
 {
+	/* Only the sum of a cycle goes in the tick trace; individual blocks (e.g. every single train) would flood it. */
+	if (_pf_data[elem].acc_duration != 0) AddTraceEvent(elem, _pf_data[elem].acc_timestamp, _pf_data[elem].acc_duration);
 	_pf_data[elem].BeginAccumulate(GetPerformanceTimer());
 }
 
+/**
+ * Register a scope for measuring a sub-phase of the game loop.
+ * @param name Name of the scope in the call tree; must stay valid for the whole run.
+ * @return The identifier to construct #PerformanceScope objects with.
+ */
+PerformanceScopeID RegisterPerformanceScope(const char *name)
+{
+	_pf_scope_names.push_back(name);
+	return (PerformanceScopeID)_pf_scope_names.size() - 1;
+}
+
+/**
+ * Begin measuring a registered scope.
+ * @param scope The scope to be measured.
+ */
+PerformanceScope::PerformanceScope(PerformanceScopeID scope)
+{
+	assert(scope < _pf_scope_names.size());
+
+	this->tree_parent = EnterProfileNode(PFE_MAX + scope);
+	this->start_time = GetPerformanceTimer();
+}
+
+/** Finish measuring a registered scope and add it to the call tree. */
+PerformanceScope::~PerformanceScope()
+{
+	LeaveProfileNode(this->tree_parent, GetPerformanceTimer() - this->start_time);
+}
+
+/**
+ * Write the most recent events of the tick trace as text, e.g. for a crash log.
+ * Times are in microseconds, relative to the end of the most recent event.
+ * @param buffer The begin where to write at.
+ * @param last   The last position in the buffer to write to.
+ * @param count  Maximum number of events to write.
+ * @return the position of the \c '\0' character after the buffer.
+ */
+char *PerformanceTraceToText(char *buffer, const char *last, uint count)
+{
+	uint32 total = _pf_trace_count.load(std::memory_order_relaxed);
+	count = std::min({ count, total, NUM_TRACE_EVENTS });
+	if (count == 0) return buffer;
+
+	const TraceEvent &newest = _pf_trace[(total - 1) % NUM_TRACE_EVENTS];
+	TimingMeasurement now = newest.start_time + newest.duration;
+
+	char name_buf[32];
+	for (uint32 i = total - count; i != total; i++) {
+		const TraceEvent &event = _pf_trace[i % NUM_TRACE_EVENTS];
+		if (event.elem >= PFE_MAX) continue;
+		buffer += seprintf(buffer, last, " %10d %8u  %s\n",
+				(int)(event.start_time - now), (uint)event.duration, GetTraceName(event.elem, name_buf, lastof(name_buf)));
+	}
+	return buffer;
+}
+
+/**
+ * Write the complete tick trace to a file in the Chrome trace event format (JSON).
+ * Every performance element gets its own track, so hitches can be matched with what caused them.
+ * @param filename The file to write to.
+ * @return true when the trace was written successfully.
+ */
+bool WritePerformanceTrace(const char *filename)
+{
+	FILE *f = FioFOpenFile(filename, "w", NO_DIRECTORY);
+	if (f == nullptr) return false;
+
+	uint32 total = _pf_trace_count.load(std::memory_order_relaxed);
+	uint32 count = std::min(total, NUM_TRACE_EVENTS);
+
+	/* Timestamps are written relative to the earliest start, which the viewer does not mind. */
+	TimingMeasurement base = UINT64_MAX;
+	for (uint32 i = total - count; i != total; i++) base = std::min(base, _pf_trace[i % NUM_TRACE_EVENTS].start_time);
+
+	char name_buf[32];
+	const char *separator = "";
+	fprintf(f, "{\"traceEvents\":[\n");
+	for (uint32 i = total - count; i != total; i++) {
+		const TraceEvent &event = _pf_trace[i % NUM_TRACE_EVENTS];
+		if (event.elem >= PFE_MAX) continue;
+		fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%d,\"dur\":%u,\"pid\":1,\"tid\":%d}",
+				separator, GetTraceName(event.elem, name_buf, lastof(name_buf)), (int)(event.start_time - base), (uint)event.duration, event.elem);
+		separator = ",\n";
+	}
+	fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	bool ret = ferror(f) == 0;
+	FioFCloseFile(f);
+	return ret;
+}
+
 
 void ShowFrametimeGraphWindow(PerformanceElement elem);
 
@@ -341,6 +572,7 @@ static const PerformanceElement DISPLAY_ORDER_PFE[PFE_MAX] = {
 	PFE_DRAWWORLD,
 	PFE_VIDEO,
 	PFE_SOUND,
+	PFE_NETWORK,
 };
 
 static const char * GetAIName(int ai_index)
@@ -1038,6 +1270,7 @@ void ConPrintFramerate()
 		"  Viewport drawing",
 		"Video output",
 		"Sound mixing",
+		"Network packet handling",
 		"AI/GS scripts total",
 		"Game script",
 	};
@@ -1075,7 +1308,98 @@ void ConPrintFramerate()
 		printed_anything = true;
 	}
 
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		if (pool->tick_allocations == 0) continue;
+		IConsolePrint(TC_LIGHT_BLUE, "{} pool allocations in last tick: {}", pool->name, pool->tick_allocations);
+		printed_anything = true;
+	}
+
+	SpriteCacheStats sc = GetSpriteCacheStats();
+	if (sc.hits + sc.misses != 0) {
+		IConsolePrint(TC_LIGHT_BLUE, "Sprite cache: {} hits, {} misses ({:.1f}% hits), {} of {} KiB in use",
+			sc.hits, sc.misses, 100.0 * sc.hits / (sc.hits + sc.misses), sc.used / 1024, sc.total / 1024);
+		printed_anything = true;
+	}
+
 	if (!printed_anything) {
 		IConsolePrint(CC_ERROR, "No performance measurements have been taken yet.");
 	}
 }
+
+/**
+ * Print a node of the call tree and all its children.
+ * @param index Index of the node in \c _pf_tree.
+ * @param depth Nesting depth of the node, for indenting.
+ * @param print Function to print each line with.
+ */
+static void PrintPerformanceTreeNode(uint index, int depth, void (*print)(const std::string &line))
+{
+	const ProfileNode &node = _pf_tree[index];
+	const ProfileNode &parent = _pf_tree[node.parent];
+
+	char name_buf[32];
+	std::string indent(depth * 2, ' ');
+	const char *name = node.scope < PFE_MAX ? GetTraceName((PerformanceElement)node.scope, name_buf, lastof(name_buf)) : _pf_scope_names[node.scope - PFE_MAX];
+	if (node.parent == 0 || parent.duration == 0) {
+		print(fmt::format("{}{}: {} calls, {:.2f}ms", indent, name, node.calls, (double)node.duration * 1000 / TIMESTAMP_PRECISION));
+	} else {
+		print(fmt::format("{}{}: {} calls, {:.2f}ms ({:.1f}%)", indent, name, node.calls, (double)node.duration * 1000 / TIMESTAMP_PRECISION,
+			100.0 * node.duration / parent.duration));
+	}
+
+	for (uint child : node.children) PrintPerformanceTreeNode(child, depth + 1, print);
+}
+
+/**
+ * Print the call tree of the nested performance measurements.
+ * All times are totals since the call tree was last reset.
+ * @param print Function to print each line with.
+ * @return false when nothing has been measured yet.
+ */
+bool PrintPerformanceTree(void (*print)(const std::string &line))
+{
+	if (_pf_tree[0].children.empty()) return false;
+
+	for (uint child : _pf_tree[0].children) PrintPerformanceTreeNode(child, 0, print);
+	return true;
+}
+
+/**
+ * Get the total time spent in a registered scope, wherever in the call tree it was measured.
+ * @param scope The scope to get the time of.
+ * @return The time since the call tree was last reset, in milliseconds.
+ */
+double GetPerformanceScopeMilliseconds(PerformanceScopeID scope)
+{
+	TimingMeasurement total = 0;
+	for (const ProfileNode &node : _pf_tree) {
+		if (node.scope == PFE_MAX + scope) total += node.duration;
+	}
+	return (double)total * 1000 / TIMESTAMP_PRECISION;
+}
+
+/** Reset all times in the call tree of the nested performance measurements to zero. */
+void ResetPerformanceTree()
+{
+	for (ProfileNode &node : _pf_tree) {
+		node.duration = 0;
+		node.calls = 0;
+	}
+}
+
+/**
+ * Print the call tree of the nested performance measurements to the console.
+ * @param reset Reset all times of the call tree to zero instead.
+ */
+void ConPrintFramerateTree(bool reset)
+{
+	if (reset) {
+		ResetPerformanceTree();
+		IConsolePrint(CC_DEFAULT, "Performance call tree reset.");
+		return;
+	}
+
+	if (!PrintPerformanceTree([](const std::string &line) { IConsolePrint(TC_LIGHT_BLUE, line); })) {
+		IConsolePrint(CC_ERROR, "No performance measurements have been taken yet.");
+	}
+}
@@ -18,7 +18,8 @@
  * Second is adding a member to the \link anonymous_namespace{framerate_gui.cpp}::_pf_data _pf_data \endlink array, in the same position as the new #PerformanceElement member.
  *
  * @par
- * Third is adding strings for the new element. There is an array in #ConPrintFramerate with strings used for the console command.
+ * Third is adding strings for the new element. There is an array in #ConPrintFramerate with strings used for the console command,
+ * and \link anonymous_namespace{framerate_gui.cpp}::TRACE_NAMES TRACE_NAMES \endlink for the tick trace.
  * Additionally, there are two sets of strings in \c english.txt for two GUI uses, also in the #PerformanceElement order.
  * Search for \c STR_FRAMERATE_GAMELOOP and \c STR_FRAMETIME_CAPTION_GAMELOOP in \c english.txt to find those.
  *
@@ -58,6 +59,7 @@ enum PerformanceElement {
 	PFE_DRAWWORLD,     ///< Time spent drawing world viewports in GUI
 	PFE_VIDEO,         ///< Speed of painting drawn video buffer.
 	PFE_SOUND,         ///< Speed of mixing audio samples
+	PFE_NETWORK,       ///< Time spent sending and receiving network packets
 	PFE_ALLSCRIPTS,    ///< Sum of all GS/AI scripts
 	PFE_GAMESCRIPT,    ///< Game script execution
 	PFE_AI0,           ///< AI execution for player slot 1
@@ -92,12 +94,14 @@ typedef uint64 TimingMeasurement;
 class PerformanceMeasurer {
 	PerformanceElement elem;
 	TimingMeasurement start_time;
+	uint tree_parent;
 public:
 	PerformanceMeasurer(PerformanceElement elem);
 	~PerformanceMeasurer();
 	void SetExpectedRate(double rate);
 	static void SetInactive(PerformanceElement elem);
 	static void Paused(PerformanceElement elem);
+	static double GetAverageDurationMilliseconds(PerformanceElement elem, int count);
 };
 
 /**
@@ -114,12 +118,43 @@ public:
 class PerformanceAccumulator {
 	PerformanceElement elem;
 	TimingMeasurement start_time;
+	uint tree_parent;
 public:
 	PerformanceAccumulator(PerformanceElement elem);
 	~PerformanceAccumulator();
 	static void Reset(PerformanceElement elem);
 };
 
+/** Identifier of a performance scope registered with #RegisterPerformanceScope. */
+typedef uint PerformanceScopeID;
+
+PerformanceScopeID RegisterPerformanceScope(const char *name);
+
+/**
+ * RAII class for measuring a sub-phase of the game loop in the call tree shown by the \c "fps tree" console command.
+ * Unlike performance elements, scopes need no entries in the GUI; register one once and measure with it wherever needed:
+ * @code
+ * static const PerformanceScopeID scope = RegisterPerformanceScope("Train pathfinding");
+ * PerformanceScope profile(scope);
+ * @endcode
+ * Scopes nest with each other and with the measured performance elements of the game loop.
+ * @note Only use this from the game loop or drawing, as the call tree is not thread safe.
+ */
+class PerformanceScope {
+	TimingMeasurement start_time;
+	uint tree_parent;
+public:
+	PerformanceScope(PerformanceScopeID scope);
+	~PerformanceScope();
+};
+
+bool PrintPerformanceTree(void (*print)(const std::string &line));
+void ResetPerformanceTree();
+double GetPerformanceScopeMilliseconds(PerformanceScopeID scope);
+
 void ShowFramerateWindow();
 
+char *PerformanceTraceToText(char *buffer, const char *last, uint count);
+bool WritePerformanceTrace(const char *filename);
+
 #endif /* FRAMERATE_TYPE_H */
@@ -18,6 +18,8 @@
 #include "rev.h"
 
 #include <stdarg.h>
+#include <set>
+#include <tuple>
 
 #include "safeguards.h"
 
@@ -72,6 +74,94 @@ void GamelogStartAction(GamelogActionType at)
 	_gamelog_action_type = at;
 }
 
+/**
+ * Removes an action from the gamelog, and frees its changes.
+ * @param index Index of the action in the gamelog.
+ */
+static void GamelogRemoveAction(uint index)
+{
+	assert(_current_action == nullptr);
+	assert(index < _gamelog_actions);
+
+	LoggedAction *la = &_gamelog_action[index];
+	for (uint i = 0; i < la->changes; i++) {
+		if (la->change[i].ct == GLCT_SETTING) free(la->change[i].setting.name);
+	}
+	free(la->change);
+
+	_gamelog_actions--;
+	memmove(la, la + 1, (_gamelog_actions - index) * sizeof(LoggedAction));
+}
+
+/**
+ * Merges an action that changed a single setting with the last earlier change
+ * of that setting, as long as only settings were changed in between. When the
+ * setting got back to its old value, the action is removed altogether.
+ * @param[in,out] index Index of the action; lowered when an earlier action is removed.
+ * @return True iff the action is still in the gamelog.
+ */
+static bool GamelogMergeSetting(uint &index)
+{
+	LoggedAction *la = &_gamelog_action[index];
+	if (la->at != GLAT_SETTING || la->changes != 1 || la->change[0].ct != GLCT_SETTING) return true;
+
+	const char *name = la->change[0].setting.name;
+	if (name == nullptr) return true;
+
+	for (uint i = index; i-- > 0;) {
+		const LoggedAction *prev = &_gamelog_action[i];
+		if (prev->at != GLAT_SETTING) break;
+
+		bool same = false;
+		for (uint j = 0; j < prev->changes; j++) {
+			const LoggedChange *lc = &prev->change[j];
+			if (lc->ct == GLCT_SETTING && lc->setting.name != nullptr && strcmp(lc->setting.name, name) == 0) same = true;
+		}
+		if (!same) continue;
+
+		/* Only merge with actions that changed just this setting, otherwise stop looking. */
+		if (prev->changes == 1) {
+			la->change[0].setting.oldval = prev->change[0].setting.oldval;
+			GamelogRemoveAction(i);
+			la = &_gamelog_action[--index];
+		}
+		break;
+	}
+
+	if (la->change[0].setting.oldval != la->change[0].setting.newval) return true;
+
+	GamelogRemoveAction(index);
+	return false;
+}
+
+/**
+ * Compacts the gamelog, e.g. after loading it from a savegame. Repeated changes
+ * of a setting are merged, and GRF bugs logged more than once are removed.
+ */
+void GamelogCompact()
+{
+	assert(_gamelog_action_type == GLAT_NONE);
+
+	std::set<std::tuple<uint32, byte, uint64>> grf_bugs;
+	for (uint i = 0; i < _gamelog_actions;) {
+		LoggedAction *la = &_gamelog_action[i];
+
+		uint changes = 0;
+		for (uint j = 0; j < la->changes; j++) {
+			const LoggedChange *lc = &la->change[j];
+			if (lc->ct == GLCT_GRFBUG && !grf_bugs.insert(std::make_tuple(lc->grfbug.grfid, lc->grfbug.bug, lc->grfbug.data)).second) continue;
+			la->change[changes++] = *lc;
+		}
+		la->changes = changes;
+
+		if (changes == 0) {
+			GamelogRemoveAction(i);
+		} else if (GamelogMergeSetting(i)) {
+			i++;
+		}
+	}
+}
+
 /**
  * Stops logging of any changes
  */
@@ -84,6 +174,12 @@ void GamelogStopAction()
 	_current_action = nullptr;
 	_gamelog_action_type = GLAT_NONE;
 
+	/* Keep changing a setting back and forth from growing the gamelog. */
+	if (print) {
+		uint index = _gamelog_actions - 1;
+		GamelogMergeSetting(index);
+	}
+
 	if (print) GamelogPrintDebug(5);
 }
 
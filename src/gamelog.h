@@ -31,6 +31,7 @@ void GamelogStopAnyAction();
 
 void GamelogFree(struct LoggedAction *gamelog_action, uint gamelog_actions);
 void GamelogReset();
+void GamelogCompact();
 
 /**
  * Callback for printing text.
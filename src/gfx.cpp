@@ -20,6 +20,7 @@
 #include "window_func.h"
 #include "newgrf_debug.h"
 #include "thread.h"
+#include "elrail_func.h"
 
 #include "table/palettes.h"
 #include "table/string_colours.h"
@@ -1434,6 +1435,11 @@ void ScreenSizeChanged()
 	if (_invalid_rect.right >= _screen.width) _invalid_rect.right = _screen.width;
 	if (_invalid_rect.bottom >= _screen.height) _invalid_rect.bottom = _screen.height;
 
+	/* The layout of the dirty blocks changed, so mark the whole dirty rect dirty again.
+	 * DrawDirtyBlocks only looks at the blocks within the dirty rect. */
+	memset(_dirty_blocks, 0, _dirty_bytes_per_line * CeilDiv(_screen.height, DIRTY_BLOCK_HEIGHT));
+	AddDirtyBlock(_invalid_rect.left, _invalid_rect.top, _invalid_rect.right, _invalid_rect.bottom);
+
 	/* screen size changed and the old bitmap is invalid now, so we don't want to undraw it */
 	_cursor.visible = false;
 }
@@ -1556,16 +1562,20 @@ void RedrawScreenRect(int left, int top, int right, int bottom)
  */
 void DrawDirtyBlocks()
 {
-	byte *b = _dirty_blocks;
 	const int w = Align(_screen.width,  DIRTY_BLOCK_WIDTH);
 	const int h = Align(_screen.height, DIRTY_BLOCK_HEIGHT);
+
+	/* Only blocks within the dirty rect can be dirty, so do not look at the others. */
+	const int scan_left   = std::min<int>(_invalid_rect.left, w) / DIRTY_BLOCK_WIDTH * DIRTY_BLOCK_WIDTH;
+	const int scan_top    = std::min<int>(_invalid_rect.top, h) / DIRTY_BLOCK_HEIGHT * DIRTY_BLOCK_HEIGHT;
+	const int scan_right  = Align(_invalid_rect.right, DIRTY_BLOCK_WIDTH);
+	const int scan_bottom = Align(_invalid_rect.bottom, DIRTY_BLOCK_HEIGHT);
+	byte *b = _dirty_blocks + (scan_top / DIRTY_BLOCK_HEIGHT) * _dirty_bytes_per_line + scan_left / DIRTY_BLOCK_WIDTH;
 	int x;
 	int y;
 
-	y = 0;
-	do {
-		x = 0;
-		do {
+	for (y = scan_top; y < scan_bottom; y += DIRTY_BLOCK_HEIGHT, b += -(int)((scan_right - scan_left) / DIRTY_BLOCK_WIDTH) + _dirty_bytes_per_line) {
+		for (x = scan_left; x < scan_right; x += DIRTY_BLOCK_WIDTH, b++) {
 			if (*b != 0) {
 				int left;
 				int top;
@@ -1621,8 +1631,8 @@ void DrawDirtyBlocks()
 				}
 
 			}
-		} while (b++, (x += DIRTY_BLOCK_WIDTH) != w);
-	} while (b += -(int)(w / DIRTY_BLOCK_WIDTH) + _dirty_bytes_per_line, (y += DIRTY_BLOCK_HEIGHT) != h);
+		}
+	}
 
 	++_dirty_block_colour;
 	_invalid_rect.left = w;
@@ -1688,6 +1698,8 @@ void AddDirtyBlock(int left, int top, int right, int bottom)
  */
 void MarkWholeScreenDirty()
 {
+	/* Everything may have changed, e.g. a game was loaded or NewGRFs were reloaded. */
+	ClearCatenaryCache();
 	AddDirtyBlock(0, 0, _screen.width, _screen.height);
 }
 
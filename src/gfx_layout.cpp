@@ -32,6 +32,7 @@
 
 /** Cache of ParagraphLayout lines. */
 Layouter::LineCache *Layouter::linecache;
+uint64 Layouter::linecache_lookups = 0;
 
 /** Cache of Font instances. */
 Layouter::FontColourMap Layouter::fonts[FS_END];
@@ -891,7 +892,9 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(const char *str, siz
 	LineCacheKey key;
 	key.state_before = state;
 	key.str.assign(str, len);
-	return (*linecache)[key];
+	LineCacheItem &item = (*linecache)[key];
+	item.last_use = ++linecache_lookups;
+	return item;
 }
 
 /**
@@ -907,8 +910,16 @@ void Layouter::ResetLineCache()
  */
 void Layouter::ReduceLineCache()
 {
-	if (linecache != nullptr) {
-		/* TODO LRU cache would be fancy, but not exactly necessary */
-		if (linecache->size() > 4096) ResetLineCache();
+	if (linecache == nullptr || linecache->size() <= MAX_LINECACHE_SIZE) return;
+
+	/* Only keep the lines used in the last MAX_LINECACHE_SIZE / 2 lookups, so lines
+	 * that are drawn continuously do not have to be laid out again. */
+	uint64 threshold = linecache_lookups - MAX_LINECACHE_SIZE / 2;
+	for (auto it = linecache->begin(); it != linecache->end(); /* nothing */) {
+		if (it->second.last_use <= threshold) {
+			it = linecache->erase(it);
+		} else {
+			++it;
+		}
 	}
 }
@@ -174,13 +174,16 @@ public:
 
 		FontState state_after;     ///< Font state after the line.
 		ParagraphLayouter *layout; ///< Layout of the line.
+		uint64 last_use;           ///< Value of Layouter::linecache_lookups when the line was last used.
 
-		LineCacheItem() : buffer(nullptr), layout(nullptr) {}
+		LineCacheItem() : buffer(nullptr), layout(nullptr), last_use(0) {}
 		~LineCacheItem() { delete layout; free(buffer); }
 	};
 private:
 	typedef std::map<LineCacheKey, LineCacheItem> LineCache;
 	static LineCache *linecache;
+	static uint64 linecache_lookups; ///< Number of lookups in the linecache, used to find the least recently used lines.
+	static const size_t MAX_LINECACHE_SIZE = 4096; ///< Number of lines in the linecache after which the least recently used lines are removed.
 
 	static LineCacheItem &GetCachedParagraphLayout(const char *str, size_t len, const FontState &state);
 
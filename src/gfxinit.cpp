@@ -155,6 +155,33 @@ void CheckExternalFiles()
 	if (add_pos != error_msg) ShowInfoF("%s", error_msg);
 }
 
+/** Details of a NewGRF that is loaded before the other NewGRFs, see #CreateBaseGRFConfig. */
+struct BaseGRFConfigCache {
+	std::unique_ptr<GRFConfig> config; ///< The configuration with its details filled.
+	uint8 palette;                     ///< Palette flags the configuration was created with.
+};
+
+/**
+ * Create the configuration of one of the NewGRFs that are loaded before the other NewGRFs.
+ * Filling the details of a NewGRF scans the whole file and calculates its MD5 sum, which
+ * only has to be done once as these files do not change while running.
+ * @param cache    The previously created configuration for this NewGRF.
+ * @param filename Name of the NewGRF file.
+ * @param palette  Palette flags to use when the NewGRF does not define one.
+ * @return A new configuration, that is freed by the caller.
+ */
+static GRFConfig *CreateBaseGRFConfig(BaseGRFConfigCache &cache, const char *filename, uint8 palette)
+{
+	if (cache.config == nullptr || strcmp(cache.config->filename, filename) != 0 || cache.palette != palette) {
+		cache.config.reset(new GRFConfig(filename));
+		cache.config->palette |= palette;
+		cache.palette = palette;
+		FillGRFDetails(cache.config.get(), false, BASESET_DIR);
+		ClrBit(cache.config->flags, GCF_INIT_ONLY);
+	}
+	return new GRFConfig(*cache.config);
+}
+
 /** Actually load the sprite tables. */
 static void LoadSpriteTables()
 {
@@ -195,25 +222,23 @@ static void LoadSpriteTables()
 
 	/* Default extra graphics */
 	static const char *master_filename = "OPENTTD.GRF";
-	GRFConfig *master = new GRFConfig(master_filename);
-	master->palette |= GRFP_GRF_DOS;
-	FillGRFDetails(master, false, BASESET_DIR);
-	ClrBit(master->flags, GCF_INIT_ONLY);
+	static BaseGRFConfigCache master_cache;
+	GRFConfig *master = CreateBaseGRFConfig(master_cache, master_filename, GRFP_GRF_DOS);
 
 	/* Baseset extra graphics */
-	GRFConfig *extra = new GRFConfig(used_set->files[GFT_EXTRA].filename);
+	static BaseGRFConfigCache extra_cache;
 
 	/* We know the palette of the base set, so if the base NewGRF is not
 	 * setting one, use the palette of the base set and not the global
 	 * one which might be the wrong palette for this base NewGRF.
 	 * The value set here might be overridden via action14 later. */
+	uint8 extra_palette = 0;
 	switch (used_set->palette) {
-		case PAL_DOS:     extra->palette |= GRFP_GRF_DOS;     break;
-		case PAL_WINDOWS: extra->palette |= GRFP_GRF_WINDOWS; break;
+		case PAL_DOS:     extra_palette = GRFP_GRF_DOS;     break;
+		case PAL_WINDOWS: extra_palette = GRFP_GRF_WINDOWS; break;
 		default: break;
 	}
-	FillGRFDetails(extra, false, BASESET_DIR);
-	ClrBit(extra->flags, GCF_INIT_ONLY);
+	GRFConfig *extra = CreateBaseGRFConfig(extra_cache, used_set->files[GFT_EXTRA].filename, extra_palette);
 
 	extra->next = top;
 	master->next = extra;
@@ -297,6 +322,7 @@ static bool SwitchNewGRFBlitter()
 		{ "32bpp-sse4",      0, 32, 32,  8, 32 },
 		{ "32bpp-ssse3",     0, 32, 32,  8, 32 },
 		{ "32bpp-sse2",      0, 32, 32,  8, 32 },
+		{ "32bpp-avx2-anim", 1, 32, 32,  8, 32 },
 		{ "32bpp-sse4-anim", 1, 32, 32,  8, 32 },
 #endif
 		{ "32bpp-optimized", 0,  8, 32,  8, 32 },
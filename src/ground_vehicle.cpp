@@ -80,14 +80,19 @@ void GroundVehicle<T, Type>::CargoChanged()
 {
 	assert(this->First() == this);
 	uint32 weight = 0;
+	int64 slope_resistance = 0;
 
 	for (T *u = T::From(this); u != nullptr; u = u->Next()) {
 		uint32 current_weight = u->GetWeight();
 		weight += current_weight;
 		/* Slope steepness is in percent, result in N. */
 		u->gcache.cached_slope_resistance = current_weight * u->GetSlopeSteepness() * 100;
+		slope_resistance += u->GetPartSlopeResistance();
 	}
 
+	/* Store the slope resistance of the parts currently on a slope; kept up to date by SetInclination. */
+	this->gcache.cached_total_slope_resistance = slope_resistance;
+
 	/* Store consist weight in cache. */
 	this->gcache.cached_weight = std::max(1u, weight);
 	/* Friction in bearings and other mechanical parts is 0.1% of the weight (result in N). */
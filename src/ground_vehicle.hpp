@@ -11,6 +11,7 @@
 #define GROUND_VEHICLE_HPP
 
 #include "vehicle_base.h"
+#include "engine_base.h"
 #include "vehicle_gui.h"
 #include "landscape.h"
 #include "window_func.h"
@@ -30,6 +31,7 @@ struct GroundVehicleCache {
 	/* Cached acceleration values, recalculated when the cargo on a vehicle changes (in addition to the conditions below) */
 	uint32 cached_weight;           ///< Total weight of the consist (valid only for the first engine).
 	uint32 cached_slope_resistance; ///< Resistance caused by weight when this vehicle part is at a slope.
+	int64 cached_total_slope_resistance; ///< Slope resistance of all parts going uphill minus that of all parts going downhill (valid only for the first engine, also updated when a part changes inclination).
 	uint32 cached_max_te;           ///< Maximum tractive effort of consist (valid only for the first engine).
 	uint16 cached_axle_resistance;  ///< Resistance caused by the axles of the vehicle (valid only for the first engine).
 
@@ -52,6 +54,8 @@ enum GroundVehicleFlags {
 	GVF_GOINGUP_BIT              = 0,  ///< Vehicle is currently going uphill. (Cached track information for acceleration)
 	GVF_GOINGDOWN_BIT            = 1,  ///< Vehicle is currently going downhill. (Cached track information for acceleration)
 	GVF_SUPPRESS_IMPLICIT_ORDERS = 2,  ///< Disable insertion and removal of automatic orders until the vehicle completes the real order.
+
+	GVF_INCLINATION_MASK         = (1 << GVF_GOINGUP_BIT) | (1 << GVF_GOINGDOWN_BIT), ///< Mask of the flags telling whether the vehicle is going uphill or downhill.
 };
 
 /**
@@ -92,6 +96,25 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	int GetAcceleration() const;
 	bool IsChainInDepot() const override;
 
+	/**
+	 * Get the state the sprites of this vehicle depend on, if they do not depend on anything else but the direction.
+	 * @param[out] state The state of the vehicle.
+	 * @return True iff the vehicle has static sprites and \a state is filled.
+	 */
+	inline bool GetSpriteState(VehicleSpriteState *state) const
+	{
+		if (!this->GetEngine()->static_sprites) return false;
+
+		state->cargo_count = this->cargo.StoredCount();
+		state->cargo_cap = this->cargo_cap;
+		state->cargo_type = this->cargo_type;
+		state->spritenum = this->spritenum;
+		state->first_engine = this->gcache.first_engine;
+		state->in_motion = !this->First()->current_order.IsType(OT_LOADING);
+		state->reversed = false;
+		return true;
+	}
+
 	/**
 	 * Common code executed for crashed ground vehicles
 	 * @param flooded was this vehicle flooded?
@@ -101,29 +124,42 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	{
 		/* Crashed vehicles aren't going up or down */
 		for (T *v = T::From(this); v != nullptr; v = v->Next()) {
-			ClrBit(v->gv_flags, GVF_GOINGUP_BIT);
-			ClrBit(v->gv_flags, GVF_GOINGDOWN_BIT);
+			v->SetInclination(0);
 		}
 		return this->Vehicle::Crash(flooded);
 	}
 
 	/**
-	 * Calculates the total slope resistance for this vehicle.
-	 * @return Slope resistance.
+	 * Calculates the slope resistance this vehicle part adds to its consist.
+	 * @return Slope resistance; negative when going downhill.
 	 */
-	inline int64 GetSlopeResistance() const
+	inline int64 GetPartSlopeResistance() const
 	{
-		int64 incl = 0;
+		if (HasBit(this->gv_flags, GVF_GOINGUP_BIT)) return this->gcache.cached_slope_resistance;
+		if (HasBit(this->gv_flags, GVF_GOINGDOWN_BIT)) return -(int64)this->gcache.cached_slope_resistance;
+		return 0;
+	}
 
-		for (const T *u = T::From(this); u != nullptr; u = u->Next()) {
-			if (HasBit(u->gv_flags, GVF_GOINGUP_BIT)) {
-				incl += u->gcache.cached_slope_resistance;
-			} else if (HasBit(u->gv_flags, GVF_GOINGDOWN_BIT)) {
-				incl -= u->gcache.cached_slope_resistance;
-			}
-		}
+	/**
+	 * Set whether this vehicle part is going uphill or downhill, and update
+	 * the total slope resistance of its consist accordingly.
+	 * @param inclination The new #GVF_GOINGUP_BIT and #GVF_GOINGDOWN_BIT flags; other bits are ignored.
+	 */
+	inline void SetInclination(uint16 inclination)
+	{
+		int64 old_resistance = this->GetPartSlopeResistance();
+		this->gv_flags = (this->gv_flags & ~GVF_INCLINATION_MASK) | (inclination & GVF_INCLINATION_MASK);
+		this->First()->gcache.cached_total_slope_resistance += this->GetPartSlopeResistance() - old_resistance;
+	}
 
-		return incl;
+	/**
+	 * Gets the total slope resistance for this vehicle.
+	 * @return Slope resistance.
+	 * @pre The vehicle is the first part of its consist.
+	 */
+	inline int64 GetSlopeResistance() const
+	{
+		return this->gcache.cached_total_slope_resistance;
 	}
 
 	/**
@@ -135,8 +171,7 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	inline void UpdateZPositionAndInclination()
 	{
 		this->z_pos = GetSlopePixelZ(this->x_pos, this->y_pos);
-		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
-		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
+		uint16 inclination = 0;
 
 		if (T::From(this)->TileMayHaveSlopedTrack()) {
 			/* To check whether the current tile is sloped, and in which
@@ -146,9 +181,11 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 			int middle_z = GetSlopePixelZ((this->x_pos & ~TILE_UNIT_MASK) | (TILE_SIZE / 2), (this->y_pos & ~TILE_UNIT_MASK) | (TILE_SIZE / 2));
 
 			if (middle_z != this->z_pos) {
-				SetBit(this->gv_flags, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
+				SetBit(inclination, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
 			}
 		}
+
+		this->SetInclination(inclination);
 	}
 
 	/**
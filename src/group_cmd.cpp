@@ -175,9 +175,10 @@ void GroupStatistics::Clear()
 }
 
 /**
- * Recompute the profits for all groups.
+ * Clear the profits of all groups, before the vehicles are added
+ * again with #VehicleReachedProfitAge.
  */
-/* static */ void GroupStatistics::UpdateProfits()
+/* static */ void GroupStatistics::ClearAllProfits()
 {
 	/* Set up the engine count for all companies */
 	for (Company *c : Company::Iterate()) {
@@ -187,14 +188,9 @@ void GroupStatistics::Clear()
 		}
 	}
 
-	/* Recalculate */
 	for (Group *g : Group::Iterate()) {
 		g->statistics.ClearProfits();
 	}
-
-	for (const Vehicle *v : Vehicle::Iterate()) {
-		if (v->IsPrimaryVehicle() && v->age > VEHICLE_PROFIT_MIN_AGE) GroupStatistics::VehicleReachedProfitAge(v);
-	}
 }
 
 /**
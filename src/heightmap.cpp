@@ -74,14 +74,24 @@ static inline byte RGBToGrayscale(byte red, byte green, byte blue)
 
 /**
  * The PNG Heightmap loader.
+ * The image is decoded one row at a time and every row is converted to grayscale
+ * right away, so only the rows that are still needed for de-interlacing are kept
+ * in memory next to the grayscale map.
+ * @param map The grayscale map to fill.
+ * @param rows Buffer for the decoded rows; one row for non-interlaced images, otherwise the whole image.
+ * @param passes The number of interlacing passes of the image.
+ * @param png_ptr The PNG reader.
+ * @param info_ptr The PNG image information.
  */
-static void ReadHeightmapPNGImageData(byte *map, png_structp png_ptr, png_infop info_ptr)
+static void ReadHeightmapPNGImageData(byte *map, png_bytep rows, int passes, png_structp png_ptr, png_infop info_ptr)
 {
 	uint x, y;
 	byte gray_palette[256];
-	png_bytep *row_pointers = nullptr;
 	bool has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
 	uint channels = png_get_channels(png_ptr, info_ptr);
+	uint width = png_get_image_width(png_ptr, info_ptr);
+	uint height = png_get_image_height(png_ptr, info_ptr);
+	size_t row_bytes = png_get_rowbytes(png_ptr, info_ptr);
 
 	/* Get palette and convert it to grayscale */
 	if (has_palette) {
@@ -109,21 +119,26 @@ static void ReadHeightmapPNGImageData(byte *map, png_structp png_ptr, png_infop
 		}
 	}
 
-	row_pointers = png_get_rows(png_ptr, info_ptr);
-
-	/* Read the raw image data and convert in 8-bit grayscale */
-	for (x = 0; x < png_get_image_width(png_ptr, info_ptr); x++) {
-		for (y = 0; y < png_get_image_height(png_ptr, info_ptr); y++) {
-			byte *pixel = &map[y * png_get_image_width(png_ptr, info_ptr) + x];
-			uint x_offset = x * channels;
-
-			if (has_palette) {
-				*pixel = gray_palette[row_pointers[y][x_offset]];
-			} else if (channels == 3) {
-				*pixel = RGBToGrayscale(row_pointers[y][x_offset + 0],
-						row_pointers[y][x_offset + 1], row_pointers[y][x_offset + 2]);
-			} else {
-				*pixel = row_pointers[y][x_offset];
+	for (int pass = 0; pass < passes; pass++) {
+		for (y = 0; y < height; y++) {
+			png_bytep row = passes > 1 ? &rows[y * row_bytes] : rows;
+			png_read_row(png_ptr, row, nullptr);
+
+			/* Only the last pass completes the row. */
+			if (pass != passes - 1) continue;
+
+			/* Convert the raw image data in 8-bit grayscale */
+			byte *pixel = &map[y * width];
+			for (x = 0; x < width; x++) {
+				uint x_offset = x * channels;
+
+				if (has_palette) {
+					*pixel++ = gray_palette[row[x_offset]];
+				} else if (channels == 3) {
+					*pixel++ = RGBToGrayscale(row[x_offset + 0], row[x_offset + 1], row[x_offset + 2]);
+				} else {
+					*pixel++ = row[x_offset];
+				}
 			}
 		}
 	}
@@ -139,6 +154,8 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 	FILE *fp;
 	png_structp png_ptr = nullptr;
 	png_infop info_ptr  = nullptr;
+	/* Volatile as it is changed after setjmp and needs to be freed when libpng jumps back on an error. */
+	png_bytep volatile rows = nullptr;
 
 	fp = FioFOpenFile(filename, "rb", HEIGHTMAP_DIR);
 	if (fp == nullptr) {
@@ -156,6 +173,7 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 	info_ptr = png_create_info_struct(png_ptr);
 	if (info_ptr == nullptr || setjmp(png_jmpbuf(png_ptr))) {
 		ShowErrorMessage(STR_ERROR_PNGMAP, STR_ERROR_PNGMAP_MISC, WL_ERROR);
+		free(rows);
 		fclose(fp);
 		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
 		return false;
@@ -163,10 +181,14 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 
 	png_init_io(png_ptr, fp);
 
-	/* Allocate memory and read image, without alpha or 16-bit samples
+	/* Read the image information and set up the decoder without alpha or 16-bit samples
 	 * (result is either 8-bit indexed/grayscale or 24-bit RGB) */
+	png_read_info(png_ptr, info_ptr);
 	png_set_packing(png_ptr);
-	png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_PACKING | PNG_TRANSFORM_STRIP_ALPHA | PNG_TRANSFORM_STRIP_16, nullptr);
+	png_set_strip_alpha(png_ptr);
+	png_set_strip_16(png_ptr);
+	int passes = png_set_interlace_handling(png_ptr);
+	png_read_update_info(png_ptr, info_ptr);
 
 	/* Maps of wrong colour-depth are not used.
 	 * (this should have been taken care of by stripping alpha and 16-bit samples on load) */
@@ -189,7 +211,10 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, byte **map)
 
 	if (map != nullptr) {
 		*map = MallocT<byte>(width * height);
-		ReadHeightmapPNGImageData(*map, png_ptr, info_ptr);
+		rows = MallocT<png_byte>(png_get_rowbytes(png_ptr, info_ptr) * (passes > 1 ? height : 1));
+		ReadHeightmapPNGImageData(*map, rows, passes, png_ptr, info_ptr);
+		png_read_end(png_ptr, nullptr);
+		free(rows);
 	}
 
 	*x = width;
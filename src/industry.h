@@ -21,6 +21,8 @@
 typedef Pool<Industry, IndustryID, 64, 64000> IndustryPool;
 extern IndustryPool _industry_pool;
 
+extern uint16 _industry_counter_ticks;
+
 /**
  * Production level maximum, minimum and default values.
  * It is not a value been really used in order to change, but rather an indicator
@@ -78,7 +80,7 @@ struct Industry : IndustryPool::PoolItem<&_industry_pool> {
 	byte last_month_pct_transported[INDUSTRY_NUM_OUTPUTS]; ///< percentage transported per cargo in the last full month
 	uint16 last_month_production[INDUSTRY_NUM_OUTPUTS];    ///< total units produced per cargo in the last full month
 	uint16 last_month_transported[INDUSTRY_NUM_OUTPUTS];   ///< total units transported per cargo in the last full month
-	uint16 counter;                                        ///< used for animation and/or production (if available cargo)
+	uint16 counter;                                        ///< used for animation and/or production (if available cargo), offset by #_industry_counter_ticks; use #GetCounter
 
 	IndustryType type;             ///< type of industry.
 	Owner owner;                   ///< owner of the industry.  Which SHOULD always be (imho) OWNER_NONE
@@ -109,6 +111,17 @@ struct Industry : IndustryPool::PoolItem<&_industry_pool> {
 
 	void RecomputeProductionMultipliers();
 
+	/**
+	 * Get the counter used for animation and production.
+	 * The counters of all industries count down together each tick, so
+	 * rather than decrementing each of them the ticks are tracked globally.
+	 * @return The current value of the counter.
+	 */
+	inline uint16 GetCounter() const
+	{
+		return this->counter - _industry_counter_ticks;
+	}
+
 	/**
 	 * Check if a given tile belongs to this industry.
 	 * @param tile The tile to check.
@@ -202,6 +215,9 @@ protected:
 };
 
 void ClearAllIndustryCachedNames();
+void NormaliseIndustryCounters();
+void RebuildIndustrySchedule();
+void RebuildIndustryKdtree();
 
 void PlantRandomFarmField(const Industry *i);
 
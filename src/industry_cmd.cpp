@@ -10,6 +10,7 @@
 #include "stdafx.h"
 #include "clear_map.h"
 #include "industry.h"
+#include "industry_kdtree.h"
 #include "station_base.h"
 #include "landscape.h"
 #include "viewport_func.h"
@@ -52,12 +53,90 @@
 IndustryPool _industry_pool("Industry");
 INSTANTIATE_POOL_METHODS(Industry)
 
+IndustryKdtree _industry_kdtree(&Kdtree_IndustryXYFunc);
+
+void RebuildIndustryKdtree()
+{
+	std::vector<IndustryID> industryids;
+	for (const Industry *ind : Industry::Iterate()) {
+		industryids.push_back(ind->index);
+	}
+	_industry_kdtree.Build(industryids.begin(), industryids.end());
+}
+
 void ShowIndustryViewWindow(int industry);
 void BuildOilRig(TileIndex tile);
 
 static byte _industry_sound_ctr;
 static TileIndex _industry_sound_tile;
 
+/**
+ * Number of ticks all industry counters have been decremented by since they were last normalised.
+ * @see Industry::GetCounter
+ */
+uint16 _industry_counter_ticks;
+
+/**
+ * Industries only need to be looked at every this many ticks, depending on the phase of their counter.
+ * That is for the ambient sound, which uses the game's random generator, and for the production.
+ */
+static const uint INDUSTRY_SCHEDULE_PHASES = 64;
+static_assert(INDUSTRY_PRODUCE_TICKS % INDUSTRY_SCHEDULE_PHASES == 0);
+
+/** Industries sorted by index, bucketed by the phase of their stored counter. */
+static std::vector<IndustryID> _industry_schedule[INDUSTRY_SCHEDULE_PHASES];
+
+/**
+ * Get the bucket of the schedule the industry belongs to.
+ * @param i The industry.
+ * @return The bucket; it does not change over the lifetime of the industry.
+ */
+static std::vector<IndustryID> &GetIndustryScheduleBucket(const Industry *i)
+{
+	return _industry_schedule[i->counter % INDUSTRY_SCHEDULE_PHASES];
+}
+
+/**
+ * Add an industry to the tick schedule.
+ * @param i The industry to add.
+ */
+static void ScheduleIndustry(const Industry *i)
+{
+	std::vector<IndustryID> &bucket = GetIndustryScheduleBucket(i);
+	bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), i->index), i->index);
+}
+
+/**
+ * Remove an industry from the tick schedule.
+ * @param i The industry to remove.
+ */
+static void UnscheduleIndustry(const Industry *i)
+{
+	std::vector<IndustryID> &bucket = GetIndustryScheduleBucket(i);
+	auto it = std::lower_bound(bucket.begin(), bucket.end(), i->index);
+	if (it != bucket.end() && *it == i->index) bucket.erase(it);
+}
+
+/** Rebuild the tick schedule of industries, e.g. after loading a game. */
+void RebuildIndustrySchedule()
+{
+	for (auto &bucket : _industry_schedule) bucket.clear();
+	for (const Industry *i : Industry::Iterate()) ScheduleIndustry(i);
+}
+
+/**
+ * Fold the globally tracked ticks into the stored counters of the industries,
+ * so the stored counter of each industry is its actual counter.
+ */
+void NormaliseIndustryCounters()
+{
+	for (Industry *i : Industry::Iterate()) i->counter = i->GetCounter();
+
+	/* Every stored counter moved by the same amount, so the buckets just shift. */
+	std::rotate(std::begin(_industry_schedule), std::begin(_industry_schedule) + _industry_counter_ticks % INDUSTRY_SCHEDULE_PHASES, std::end(_industry_schedule));
+	_industry_counter_ticks = 0;
+}
+
 uint16 Industry::counts[NUM_INDUSTRYTYPES];
 
 IndustrySpec _industry_specs[NUM_INDUSTRYTYPES];
@@ -147,6 +226,9 @@ Industry::~Industry()
 	 * Also we must not decrement industry counts in that case. */
 	if (this->location.w == 0) return;
 
+	UnscheduleIndustry(this);
+	_industry_kdtree.Remove(this->index);
+
 	const bool has_neutral_station = this->neutral_station != nullptr;
 
 	for (TileIndex tile_cur : this->location) {
@@ -1131,8 +1213,11 @@ static void ProduceIndustryGoods(Industry *i)
 {
 	const IndustrySpec *indsp = GetIndustrySpec(i->type);
 
+	/* The counter has already been decremented for this tick by OnTick_Industry. */
+	uint16 counter = i->GetCounter();
+
 	/* play a sound? */
-	if ((i->counter & 0x3F) == 0) {
+	if (((counter + 1) & 0x3F) == 0) {
 		uint32 r;
 		if (Chance16R(1, 14, r) && indsp->number_of_sounds != 0 && _settings_client.sound.ambient) {
 			for (size_t j = 0; j < lengthof(i->last_month_production); j++) {
@@ -1147,10 +1232,8 @@ static void ProduceIndustryGoods(Industry *i)
 		}
 	}
 
-	i->counter--;
-
 	/* produce some cargo */
-	if ((i->counter % INDUSTRY_PRODUCE_TICKS) == 0) {
+	if ((counter % INDUSTRY_PRODUCE_TICKS) == 0) {
 		if (HasBit(indsp->callback_mask, CBM_IND_PRODUCTION_256_TICKS)) IndustryProductionCallback(i, 1);
 
 		IndustryBehaviour indbehav = indsp->behaviour;
@@ -1183,7 +1266,7 @@ static void ProduceIndustryGoods(Industry *i)
 			if (cb_res != CALLBACK_FAILED) {
 				cut = ConvertBooleanCallback(indsp->grf_prop.grffile, CBID_INDUSTRY_SPECIAL_EFFECT, cb_res);
 			} else {
-				cut = ((i->counter % INDUSTRY_CUT_TREE_TICKS) == 0);
+				cut = ((counter % INDUSTRY_CUT_TREE_TICKS) == 0);
 			}
 
 			if (cut) ChopLumberMillTrees(i);
@@ -1209,8 +1292,25 @@ void OnTick_Industry()
 
 	if (_game_mode == GM_EDITOR) return;
 
-	for (Industry *i : Industry::Iterate()) {
-		ProduceIndustryGoods(i);
+	/* Only industries whose counter was a multiple of 64 (ambient sound) or
+	 * becomes a multiple of 256 (production) need to be looked at. These are
+	 * in two buckets of the schedule; merge them to keep the index order. */
+	const std::vector<IndustryID> &sound = _industry_schedule[_industry_counter_ticks % INDUSTRY_SCHEDULE_PHASES];
+	const std::vector<IndustryID> &produce = _industry_schedule[(_industry_counter_ticks + 1) % INDUSTRY_SCHEDULE_PHASES];
+
+	/* Decrement the counters of all industries. */
+	_industry_counter_ticks++;
+
+	auto it_sound = sound.begin();
+	auto it_produce = produce.begin();
+	while (it_sound != sound.end() || it_produce != produce.end()) {
+		IndustryID index;
+		if (it_produce == produce.end() || (it_sound != sound.end() && *it_sound < *it_produce)) {
+			index = *it_sound++;
+		} else {
+			index = *it_produce++;
+		}
+		ProduceIndustryGoods(Industry::Get(index));
 	}
 }
 
@@ -1634,38 +1734,18 @@ static CommandCost CheckIfFarEnoughFromConflictingIndustry(TileIndex tile, int t
 {
 	const IndustrySpec *indspec = GetIndustrySpec(type);
 
-	/* On a large map with many industries, it may be faster to check an area. */
-	static const int dmax = 14;
-	if (Industry::GetNumItems() > (size_t) (dmax * dmax * 2)) {
-		const Industry* i = nullptr;
-		TileArea tile_area = TileArea(tile, 1, 1).Expand(dmax);
-		for (TileIndex atile : tile_area) {
-			if (GetTileType(atile) == MP_INDUSTRY) {
-				const Industry *i2 = Industry::GetByTile(atile);
-				if (i == i2) continue;
-				i = i2;
-				if (DistanceMax(tile, i->location.tile) > (uint)dmax) continue;
-				if (i->type == indspec->conflicting[0] ||
-						i->type == indspec->conflicting[1] ||
-						i->type == indspec->conflicting[2]) {
-					return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
-				}
-			}
-		}
-		return CommandCost();
-	}
-
-	for (const Industry *i : Industry::Iterate()) {
-		/* Within 14 tiles from another industry is considered close */
-		if (DistanceMax(tile, i->location.tile) > 14) continue;
-
+	/* Within 14 tiles from another industry is considered close */
+	bool conflict = false;
+	ForAllIndustriesRadius(tile, 14, [&](const Industry *i) {
 		/* check if there are any conflicting industry types around */
 		if (i->type == indspec->conflicting[0] ||
 				i->type == indspec->conflicting[1] ||
 				i->type == indspec->conflicting[2]) {
-			return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
+			conflict = true;
 		}
-	}
+	});
+	if (conflict) return_cmd_error(STR_ERROR_INDUSTRY_TOO_CLOSE);
+
 	return CommandCost();
 }
 
@@ -1754,7 +1834,8 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 
 	uint16 r = Random();
 	i->random_colour = GB(r, 0, 4);
-	i->counter = GB(r, 4, 12);
+	i->counter = GB(r, 4, 12) + _industry_counter_ticks;
+	ScheduleIndustry(i);
 	i->random = initial_random_bits;
 	i->was_cargo_delivered = false;
 	i->last_prod_year = _cur_year;
@@ -1899,6 +1980,9 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 		}
 	}
 
+	/* The north tile is final once all tiles have been planted. */
+	_industry_kdtree.Insert(i->index);
+
 	if (GetIndustrySpec(i->type)->behaviour & INDUSTRYBEH_PLANT_ON_BUILT) {
 		for (uint j = 0; j != 50; j++) PlantRandomFarmField(i);
 	}
@@ -2139,6 +2223,8 @@ static Industry *CreateNewIndustry(TileIndex tile, IndustryType type, IndustryAv
 	uint32 seed2 = Random();
 	Industry *i = nullptr;
 	size_t layout_index = RandomRange((uint32)indspec->layouts.size());
+	/* Reject random sites near conflicting industries before testing all tiles of the layout. */
+	if (CheckIfFarEnoughFromConflictingIndustry(tile, type).Failed()) return nullptr;
 	[[maybe_unused]] CommandCost ret = CreateNewIndustryHelper(tile, type, DC_EXEC, indspec, layout_index, seed, GB(seed2, 0, 16), OWNER_NONE, creation_type, &i);
 	assert(i != nullptr || ret.Failed());
 	return i;
@@ -2950,6 +3036,9 @@ void InitializeIndustries()
 	Industry::ResetIndustryCounts();
 	_industry_sound_tile = 0;
 
+	_industry_counter_ticks = 0;
+	for (auto &bucket : _industry_schedule) bucket.clear();
+
 	_industry_builder.Reset();
 }
 
@@ -26,6 +26,7 @@ IniItem::IniItem(IniGroup *parent, const std::string &name) : next(nullptr)
 
 	*parent->last_item = this;
 	parent->last_item = &this->next;
+	parent->item_index.emplace(this->name, this);
 }
 
 /** Free everything we loaded. */
@@ -55,6 +56,7 @@ IniGroup::IniGroup(IniLoadFile *parent, const std::string &name) : next(nullptr)
 	this->last_item = &this->item;
 	*parent->last_group = this;
 	parent->last_group = &this->next;
+	parent->group_index.emplace(this->name, this);
 
 	if (parent->list_group_names != nullptr) {
 		for (uint i = 0; parent->list_group_names[i] != nullptr; i++) {
@@ -90,9 +92,8 @@ IniGroup::~IniGroup()
  */
 IniItem *IniGroup::GetItem(const std::string &name, bool create)
 {
-	for (IniItem *item = this->item; item != nullptr; item = item->next) {
-		if (item->name == name) return item;
-	}
+	auto it = this->item_index.find(name);
+	if (it != this->item_index.end()) return it->second;
 
 	if (!create) return nullptr;
 
@@ -117,6 +118,15 @@ void IniGroup::RemoveItem(const std::string &name)
 			this->last_item = prev;
 		}
 
+		this->item_index.erase(name);
+		/* An ini file can contain the same name twice; the next one becomes the one to find. */
+		for (IniItem *other = item->next; other != nullptr; other = other->next) {
+			if (other->name == name) {
+				this->item_index.emplace(other->name, other);
+				break;
+			}
+		}
+
 		item->next = nullptr;
 		delete item;
 
@@ -132,6 +142,7 @@ void IniGroup::Clear()
 	delete this->item;
 	this->item = nullptr;
 	this->last_item = &this->item;
+	this->item_index.clear();
 }
 
 /**
@@ -163,9 +174,8 @@ IniLoadFile::~IniLoadFile()
 IniGroup *IniLoadFile::GetGroup(const std::string &name, bool create_new)
 {
 	/* does it exist already? */
-	for (IniGroup *group = this->group; group != nullptr; group = group->next) {
-		if (group->name == name) return group;
-	}
+	auto it = this->group_index.find(name);
+	if (it != this->group_index.end()) return it->second;
 
 	if (!create_new) return nullptr;
 
@@ -202,6 +212,18 @@ void IniLoadFile::RemoveGroup(const char *name)
 		if (this->last_group == &group->next) this->last_group = &this->group;
 	}
 
+	auto it = this->group_index.find(group->name);
+	if (it != this->group_index.end() && it->second == group) {
+		this->group_index.erase(it);
+		/* An ini file can contain the same group twice; the next one becomes the one to find. */
+		for (IniGroup *other = group->next; other != nullptr; other = other->next) {
+			if (other->name == group->name) {
+				this->group_index.emplace(other->name, other);
+				break;
+			}
+		}
+	}
+
 	group->next = nullptr;
 	delete group;
 }
@@ -13,6 +13,7 @@
 #include "fileio_type.h"
 #include <string>
 #include <optional>
+#include <unordered_map>
 
 /** Types of groups */
 enum IniGroupType {
@@ -42,6 +43,7 @@ struct IniGroup {
 	IniItem **last_item; ///< the last item in the group
 	std::string name;    ///< name of group
 	std::string comment; ///< comment for group
+	std::unordered_map<std::string_view, IniItem *> item_index; ///< first item of each name, keyed by a view on the item's name
 
 	IniGroup(struct IniLoadFile *parent, const std::string &name);
 	~IniGroup();
@@ -58,6 +60,7 @@ struct IniLoadFile {
 	std::string comment;                  ///< last comment in file
 	const char * const *list_group_names; ///< nullptr terminated list with group names that are lists
 	const char * const *seq_group_names;  ///< nullptr terminated list with group names that are sequences.
+	std::unordered_map<std::string_view, IniGroup *> group_index; ///< first group of each name, keyed by a view on the group's name
 
 	IniLoadFile(const char * const *list_group_names = nullptr, const char * const *seq_group_names = nullptr);
 	virtual ~IniLoadFile();
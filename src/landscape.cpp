@@ -88,6 +88,11 @@ extern const byte _slope_to_sprite_offset[32] = {
  */
 static SnowLine *_snow_line = nullptr;
 
+/** Date for which #_snow_line_cache holds the variable snow line; the lookup is done for every tile loop visit of a snowy tile. */
+static Date _snow_line_cache_date = INVALID_DATE;
+/** Height of the variable snow line at #_snow_line_cache_date. */
+static byte _snow_line_cache;
+
 /**
  * Map 2D viewport or smallmap coordinate to 3D world or tile coordinate.
  * Function takes into account height of tiles and foundations.
@@ -627,6 +632,7 @@ void SetSnowLine(byte table[SNOW_LINE_MONTHS][SNOW_LINE_DAYS])
 {
 	_snow_line = CallocT<SnowLine>(1);
 	_snow_line->lowest_value = 0xFF;
+	_snow_line_cache_date = INVALID_DATE;
 	memcpy(_snow_line->table, table, sizeof(_snow_line->table));
 
 	for (uint i = 0; i < SNOW_LINE_MONTHS; i++) {
@@ -646,9 +652,13 @@ byte GetSnowLine()
 {
 	if (_snow_line == nullptr) return _settings_game.game_creation.snow_line_height;
 
-	YearMonthDay ymd;
-	ConvertDateToYMD(_date, &ymd);
-	return _snow_line->table[ymd.month][ymd.day];
+	if (_snow_line_cache_date != _date) {
+		YearMonthDay ymd;
+		ConvertDateToYMD(_date, &ymd);
+		_snow_line_cache = _snow_line->table[ymd.month][ymd.day];
+		_snow_line_cache_date = _date;
+	}
+	return _snow_line_cache;
 }
 
 /**
@@ -828,7 +838,22 @@ void RunTileLoop()
 		count--;
 	}
 
+	/* The tiles are visited in a pseudorandom order, so on large maps nearly
+	 * every tile is a cache miss. The tile loop procs use the game's random
+	 * generator and modify neighbouring tiles, so they cannot be run in
+	 * parallel without changing the outcome. Instead run a second LFSR a few
+	 * steps ahead of the one being processed and prefetch its map data. */
+	static const uint PREFETCH_DISTANCE = 8;
+	TileIndex ahead = tile;
+	for (uint i = 0; i < PREFETCH_DISTANCE; i++) ahead = (ahead >> 1) ^ (-(int32)(ahead & 1) & feedback);
+
 	while (count--) {
+		prefetch(&_m_type[ahead]);
+		prefetch(&_m_height[ahead]);
+		prefetch(&_m[ahead]);
+		prefetch(&_me[ahead]);
+		ahead = (ahead >> 1) ^ (-(int32)(ahead & 1) & feedback);
+
 		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
 
 		/* Get the next tile in sequence using a Galois LFSR. */
@@ -1143,17 +1168,21 @@ static void River_FoundEndNode(AyStar *aystar, OpenListNode *current)
 	}
 }
 
-static const uint RIVER_HASH_SIZE = 8; ///< The number of bits the hash for river finding should have.
+static const uint RIVER_HASH_SIZE = 12; ///< The number of bits the hash for river finding should have.
+static const uint RIVER_HASH_HALFBITS = RIVER_HASH_SIZE / 2; ///< The number of bits of each coordinate used for the hash.
 
 /**
  * Simple hash function for river tiles to be used by AyStar.
+ * The low bits of both coordinates are used, so neighbouring tiles of a river
+ * never share a bucket. The generic TileHash only changes every 16 tiles,
+ * which would put whole stretches of a river in the same bucket.
  * @param tile The tile to hash.
  * @param dir The unused direction.
  * @return The hash for the tile.
  */
 static uint River_Hash(uint tile, uint dir)
 {
-	return GB(TileHash(TileX(tile), TileY(tile)), 0, RIVER_HASH_SIZE);
+	return GB(TileX(tile), 0, RIVER_HASH_HALFBITS) << RIVER_HASH_HALFBITS | GB(TileY(tile), 0, RIVER_HASH_HALFBITS);
 }
 
 /**
@@ -188,6 +188,9 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 	scaler.SetDemandPerNode(num_demands);
 	uint chance = 0;
 
+	/* The distance independent part of the accuracy divisor, the same for all pairs. */
+	const int32 base_divisor = this->accuracy * (this->mod_dist - 50) / 100 + 1;
+
 	while (!supplies.empty() && !demands.empty()) {
 		NodeID from_id = supplies.front();
 		supplies.pop();
@@ -213,8 +216,7 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 					this->mod_dist / 100;
 
 			/* Scale the accuracy by distance around accuracy / 2 */
-			int32 divisor = this->accuracy * (this->mod_dist - 50) / 100 +
-					this->accuracy * distance / this->max_distance + 1;
+			int32 divisor = base_divisor + this->accuracy * distance / this->max_distance;
 
 			assert(divisor > 0);
 
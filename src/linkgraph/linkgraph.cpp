@@ -55,8 +55,10 @@ void LinkGraph::ShiftDates(int interval)
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
 		BaseNode &source = this->nodes[node1];
 		if (source.last_update != INVALID_DATE) source.last_update += interval;
-		for (NodeID node2 = 0; node2 < this->Size(); ++node2) {
-			BaseEdge &edge = this->edges[node1][node2];
+		BaseEdge *node_edges = this->edges[node1];
+		/* Only linked edges carry dates; walk the list instead of the whole row. */
+		for (NodeID node2 = node_edges[node1].next_edge; node2 != INVALID_NODE; node2 = node_edges[node2].next_edge) {
+			BaseEdge &edge = node_edges[node2];
 			if (edge.last_unrestricted_update != INVALID_DATE) edge.last_unrestricted_update += interval;
 			if (edge.last_restricted_update != INVALID_DATE) edge.last_restricted_update += interval;
 		}
@@ -68,8 +70,10 @@ void LinkGraph::Compress()
 	this->last_compression = (_date + this->last_compression) / 2;
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
 		this->nodes[node1].supply /= 2;
-		for (NodeID node2 = 0; node2 < this->Size(); ++node2) {
-			BaseEdge &edge = this->edges[node1][node2];
+		BaseEdge *node_edges = this->edges[node1];
+		/* Edges with capacity are always linked from the node's own entry. */
+		for (NodeID node2 = node_edges[node1].next_edge; node2 != INVALID_NODE; node2 = node_edges[node2].next_edge) {
+			BaseEdge &edge = node_edges[node2];
 			if (edge.capacity > 0) {
 				edge.capacity = std::max(1U, edge.capacity / 2);
 				edge.usage /= 2;
@@ -167,7 +167,8 @@ LinkGraphJob::~LinkGraphJob()
 				++it;
 			}
 		}
-		ge.flows.insert(flows.begin(), flows.end());
+		/* Splice the new flows over instead of copying their shares. */
+		ge.flows.merge(flows);
 		InvalidateWindowData(WC_STATION_VIEW, st->index, this->Cargo());
 	}
 }
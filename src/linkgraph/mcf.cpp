@@ -3,7 +3,7 @@
 #include "../stdafx.h"
 #include "../core/math_func.hpp"
 #include "mcf.h"
-#include <set>
+#include <algorithm>
 
 #include "../safeguards.h"
 
@@ -38,11 +38,14 @@ public:
 	inline void UpdateAnnotation() { }
 
 	/**
-	 * Comparator for std containers.
+	 * Check whether a node with the first annotation value is to be handled
+	 * before a node with the second one. Ties are broken by node ID, so
+	 * the order is total.
 	 */
-	struct Comparator {
-		bool operator()(const DistanceAnnotation *x, const DistanceAnnotation *y) const;
-	};
+	static inline bool IsBefore(uint x_anno, NodeID x, uint y_anno, NodeID y)
+	{
+		return x_anno < y_anno || (x_anno == y_anno && x < y);
+	}
 };
 
 /**
@@ -80,11 +83,14 @@ public:
 	}
 
 	/**
-	 * Comparator for std containers.
+	 * Check whether a node with the first annotation value is to be handled
+	 * before a node with the second one. Ties are broken by node ID, so
+	 * the order is total.
 	 */
-	struct Comparator {
-		bool operator()(const CapacityAnnotation *x, const CapacityAnnotation *y) const;
-	};
+	static inline bool IsBefore(int x_anno, NodeID x, int y_anno, NodeID y)
+	{
+		return x_anno > y_anno || (x_anno == y_anno && x > y);
+	}
 };
 
 /**
@@ -258,22 +264,45 @@ bool CapacityAnnotation::IsBetter(const CapacityAnnotation *base, uint cap,
 template<class Tannotation, class Tedge_iterator>
 void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 {
-	typedef std::set<Tannotation *, typename Tannotation::Comparator> AnnoSet;
+	typedef decltype(std::declval<Tannotation>().GetAnnotation()) Tvalue;
+
+	/**
+	 * Entry of the queue. Nodes are queued again whenever their annotation
+	 * improves; entries from before that are recognised by their version.
+	 */
+	struct QueueItem {
+		Tvalue anno;  ///< Annotation value of the node when it was queued.
+		NodeID node;  ///< Node that was queued.
+		uint version; ///< Version of the node's annotation when it was queued.
+	};
+	/* The heap keeps the item to be handled next at the front. */
+	auto after = [](const QueueItem &x, const QueueItem &y) {
+		return Tannotation::IsBefore(y.anno, y.node, x.anno, x.node);
+	};
+
 	Tedge_iterator iter(this->job);
 	uint16 size = this->job.Size();
-	AnnoSet annos;
+	std::vector<QueueItem> queue;
+	std::vector<uint> versions(size, 0);
+	queue.reserve(size);
 	paths.resize(size, nullptr);
 	for (NodeID node = 0; node < size; ++node) {
 		Tannotation *anno = new Tannotation(node, node == source_node);
 		anno->UpdateAnnotation();
-		annos.insert(anno);
+		queue.push_back({anno->GetAnnotation(), node, 0});
 		paths[node] = anno;
 	}
-	while (!annos.empty()) {
-		typename AnnoSet::iterator i = annos.begin();
-		Tannotation *source = *i;
-		annos.erase(i);
-		NodeID from = source->GetNode();
+	std::make_heap(queue.begin(), queue.end(), after);
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), after);
+		QueueItem item = queue.back();
+		queue.pop_back();
+		/* Skip nodes that have been improved or handled since they were queued. */
+		if (item.version != versions[item.node]) continue;
+		versions[item.node]++;
+
+		Tannotation *source = static_cast<Tannotation *>(paths[item.node]);
+		NodeID from = item.node;
 		iter.SetNode(source_node, from);
 		for (NodeID to = iter.Next(); to != INVALID_NODE; to = iter.Next()) {
 			if (to == from) continue; // Not a real edge but a consumption sign.
@@ -288,10 +317,10 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 			uint distance = DistanceMaxPlusManhattan(this->job[from].XY(), this->job[to].XY()) + 1;
 			Tannotation *dest = static_cast<Tannotation *>(paths[to]);
 			if (dest->IsBetter(source, capacity, capacity - edge.Flow(), distance)) {
-				annos.erase(dest);
 				dest->Fork(source, capacity, capacity - edge.Flow(), distance);
 				dest->UpdateAnnotation();
-				annos.insert(dest);
+				queue.push_back({dest->GetAnnotation(), to, ++versions[to]});
+				std::push_heap(queue.begin(), queue.end(), after);
 			}
 		}
 	}
@@ -568,48 +597,3 @@ MCF2ndPass::MCF2ndPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 		}
 	}
 }
-
-/**
- * Relation that creates a weak order without duplicates.
- * Avoid accidentally deleting different paths of the same capacity/distance in
- * a set. When the annotation is the same node IDs are compared, so there are
- * no equal ranges.
- * @tparam T Type to be compared on.
- * @param x_anno First value.
- * @param y_anno Second value.
- * @param x Node id associated with the first value.
- * @param y Node id associated with the second value.
- */
-template <typename T>
-bool Greater(T x_anno, T y_anno, NodeID x, NodeID y)
-{
-	if (x_anno > y_anno) return true;
-	if (x_anno < y_anno) return false;
-	return x > y;
-}
-
-/**
- * Compare two capacity annotations.
- * @param x First capacity annotation.
- * @param y Second capacity annotation.
- * @return If x is better than y.
- */
-bool CapacityAnnotation::Comparator::operator()(const CapacityAnnotation *x,
-		const CapacityAnnotation *y) const
-{
-	return x != y && Greater<int>(x->GetAnnotation(), y->GetAnnotation(),
-			x->GetNode(), y->GetNode());
-}
-
-/**
- * Compare two distance annotations.
- * @param x First distance annotation.
- * @param y Second distance annotation.
- * @return If x is better than y.
- */
-bool DistanceAnnotation::Comparator::operator()(const DistanceAnnotation *x,
-		const DistanceAnnotation *y) const
-{
-	return x != y && !Greater<uint>(x->GetAnnotation(), y->GetAnnotation(),
-			x->GetNode(), y->GetNode());
-}
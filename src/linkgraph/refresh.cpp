@@ -151,6 +151,22 @@ void LinkRefresher::ResetRefit()
 	}
 }
 
+/**
+ * Check if branching to the given order would only retrace a hop that has
+ * already been seen. A branch to a plain order starts with the hop from
+ * \a cur to that order and stops right away if it has been seen before.
+ * Refit and conditional orders may branch further, so they are never skipped.
+ * @param cur Last stop where the consist could interact with cargo.
+ * @param skip_to Order the branch would continue with.
+ * @return If the branch wouldn't refresh anything.
+ */
+bool LinkRefresher::IsSeenBranch(const Order *cur, const Order *skip_to) const
+{
+	if (skip_to->IsType(OT_CONDITIONAL)) return false;
+	if ((skip_to->IsType(OT_GOTO_DEPOT) || skip_to->IsType(OT_GOTO_STATION)) && skip_to->IsRefit()) return false;
+	return this->seen_hops->find(Hop(cur->index, skip_to->index, this->cargo)) != this->seen_hops->end();
+}
+
 /**
  * Predict the next order the vehicle will execute and resolve conditionals by
  * recursion and return next non-conditional order in list.
@@ -175,11 +191,11 @@ const Order *LinkRefresher::PredictNextOrder(const Order *cur, const Order *next
 		if (next->IsType(OT_CONDITIONAL)) {
 			const Order *skip_to = this->vehicle->orders.list->GetNextDecisionNode(
 					this->vehicle->orders.list->GetOrderAt(next->GetConditionSkipToOrder()), num_hops);
-			if (skip_to != nullptr && num_hops < this->vehicle->orders.list->GetNumOrders()) {
+			if (skip_to != nullptr && num_hops < this->vehicle->orders.list->GetNumOrders() &&
+					!this->IsSeenBranch(cur, skip_to)) {
 				/* Make copies of capacity tracking lists. There is potential
 				 * for optimization here: If the vehicle never refits we don't
-				 * need to copy anything. Also, if we've seen the branched link
-				 * before we don't need to branch at all. */
+				 * need to copy anything. */
 				LinkRefresher branch(*this);
 				branch.RefreshLinks(cur, skip_to, flags, num_hops + 1);
 			}
@@ -11,6 +11,8 @@
 #include "debug.h"
 #include "core/alloc_func.hpp"
 #include "water_map.h"
+#include "tunnelbridge_map.h"
+#include "pathfinder/yapf/yapf_cache.h"
 #include "string_func.h"
 
 #include "safeguards.h"
@@ -29,6 +31,8 @@ uint _map_tile_mask; ///< _map_size - 1 (to mask the mapsize)
 
 Tile *_m = nullptr;          ///< Tiles of the map
 TileExtended *_me = nullptr; ///< Extended Tiles of the map
+byte *_m_type = nullptr;     ///< Type plane of the map
+byte *_m_height = nullptr;   ///< Height plane of the map
 
 
 /**
@@ -58,9 +62,17 @@ void AllocateMap(uint size_x, uint size_y)
 
 	free(_m);
 	free(_me);
+	free(_m_type);
+	free(_m_height);
 
 	_m = CallocT<Tile>(_map_size);
 	_me = CallocT<TileExtended>(_map_size);
+	_m_type = CallocT<byte>(_map_size);
+	_m_height = CallocT<byte>(_map_size);
+
+	ClearTunnelBridgeIndex();
+	/* Nothing YAPF knows about the previous map is valid any more. */
+	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
 }
 
 
@@ -41,6 +41,23 @@ extern Tile *_m;
  */
 extern TileExtended *_me;
 
+/**
+ * Pointer to the tile type plane.
+ *
+ * The type (bits 4..7), bridges (2..3) and rainforest/desert (0..1) of
+ * every tile are kept apart from #_m so scans over the whole map that
+ * only look at the type of tiles touch just one byte per tile.
+ */
+extern byte *_m_type;
+
+/**
+ * Pointer to the tile height plane.
+ *
+ * The height of the northern corner of every tile, kept apart from #_m
+ * for the same reason as #_m_type.
+ */
+extern byte *_m_height;
+
 void AllocateMap(uint size_x, uint size_y);
 
 /**
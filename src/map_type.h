@@ -12,11 +12,10 @@
 
 /**
  * Data that is stored per tile. Also used TileExtended for this.
+ * The type and height of the tile live in their own planes, see #_m_type and #_m_height.
  * Look at docs/landscape.html for the exact meaning of the members.
  */
 struct Tile {
-	byte   type;        ///< The type (bits 4..7), bridges (2..3), rainforest/desert (0..1)
-	byte   height;      ///< The height of the northern corner.
 	uint16 m2;          ///< Primarily used for indices to towns, industries and stations
 	byte   m1;          ///< Primarily used for ownership information
 	byte   m3;          ///< General purpose
@@ -24,7 +23,7 @@ struct Tile {
 	byte   m5;          ///< General purpose
 };
 
-static_assert(sizeof(Tile) == 8);
+static_assert(sizeof(Tile) == 6);
 
 /**
  * Data that is stored per tile. Also used Tile for this.
@@ -59,7 +58,14 @@ struct TileIndexDiffC {
 	int16 y;        ///< The y value of the coordinate
 };
 
-/** Minimal and maximal map width and height */
+/**
+ * Minimal and maximal map width and height.
+ * Raising the maximum is more than changing #MAX_MAP_SIZE_BITS. The tile loop's
+ * LFSR feedback table, the tree counter and the TGP height limits have one
+ * entry per map size and are checked by static_asserts. The map arrays are also
+ * allocated for the whole bounding box, so a 16k x 16k map needs gigabytes even
+ * when most of it is void.
+ */
 static const uint MIN_MAP_SIZE_BITS = 6;                      ///< Minimal size of map is equal to 2 ^ MIN_MAP_SIZE_BITS
 static const uint MAX_MAP_SIZE_BITS = 12;                     ///< Maximal size of map is equal to 2 ^ MAX_MAP_SIZE_BITS
 static const uint MIN_MAP_SIZE      = 1 << MIN_MAP_SIZE_BITS; ///< Minimal map size = 64
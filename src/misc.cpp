@@ -27,6 +27,7 @@
 #include "game/game.hpp"
 #include "linkgraph/linkgraphschedule.h"
 #include "station_kdtree.h"
+#include "industry_kdtree.h"
 #include "town_kdtree.h"
 #include "viewport_kdtree.h"
 #include "newgrf_profiling.h"
@@ -48,6 +49,7 @@ void InitializeGraphGui();
 void InitializeObjectGui();
 void InitializeTownGui();
 void InitializeIndustries();
+void InitializeTowns();
 void InitializeObjects();
 void InitializeTrees();
 void InitializeCompanies();
@@ -82,6 +84,7 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 
 	RebuildStationKdtree();
 	RebuildTownKdtree();
+	RebuildIndustryKdtree();
 	RebuildViewportKdtree();
 
 	ResetPersistentNewGRFData();
@@ -103,6 +106,7 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	InitializeAIGui();
 	InitializeTrees();
 	InitializeIndustries();
+	InitializeTowns();
 	InitializeObjects();
 	InitializeBuildingCounts();
 
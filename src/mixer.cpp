@@ -9,6 +9,7 @@
 
 #include "stdafx.h"
 #include <math.h>
+#include <vector>
 #include "core/math_func.hpp"
 #include "framerate_type.h"
 #include "settings_type.h"
@@ -61,7 +62,7 @@ static int RateConversion(T *b, int frac_pos)
 	return ((b[0] * ((1 << 16) - frac_pos)) + (b[1] * frac_pos)) >> 16;
 }
 
-static void mix_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effect_vol)
+static void mix_int16(MixerChannel *sc, int32 *buffer, uint samples, uint8 effect_vol)
 {
 	if (samples > sc->samples_left) samples = sc->samples_left;
 	sc->samples_left -= samples;
@@ -76,16 +77,16 @@ static void mix_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effec
 	if (frac_speed == 0x10000) {
 		/* Special case when frac_speed is 0x10000 */
 		do {
-			buffer[0] = Clamp(buffer[0] + (*b * volume_left  >> 16), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (*b * volume_right >> 16), -MAX_VOLUME, MAX_VOLUME);
+			buffer[0] += *b * volume_left  >> 16;
+			buffer[1] += *b * volume_right >> 16;
 			b++;
 			buffer += 2;
 		} while (--samples > 0);
 	} else {
 		do {
 			int data = RateConversion(b, frac_pos);
-			buffer[0] = Clamp(buffer[0] + (data * volume_left  >> 16), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (data * volume_right >> 16), -MAX_VOLUME, MAX_VOLUME);
+			buffer[0] += data * volume_left  >> 16;
+			buffer[1] += data * volume_right >> 16;
 			buffer += 2;
 			frac_pos += frac_speed;
 			b += frac_pos >> 16;
@@ -97,7 +98,7 @@ static void mix_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effec
 	sc->pos = b - (const int16 *)sc->memory;
 }
 
-static void mix_int8_to_int16(MixerChannel *sc, int16 *buffer, uint samples, uint8 effect_vol)
+static void mix_int8_to_int16(MixerChannel *sc, int32 *buffer, uint samples, uint8 effect_vol)
 {
 	if (samples > sc->samples_left) samples = sc->samples_left;
 	sc->samples_left -= samples;
@@ -112,16 +113,16 @@ static void mix_int8_to_int16(MixerChannel *sc, int16 *buffer, uint samples, uin
 	if (frac_speed == 0x10000) {
 		/* Special case when frac_speed is 0x10000 */
 		do {
-			buffer[0] = Clamp(buffer[0] + (*b * volume_left  >> 8), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (*b * volume_right >> 8), -MAX_VOLUME, MAX_VOLUME);
+			buffer[0] += *b * volume_left  >> 8;
+			buffer[1] += *b * volume_right >> 8;
 			b++;
 			buffer += 2;
 		} while (--samples > 0);
 	} else {
 		do {
 			int data = RateConversion(b, frac_pos);
-			buffer[0] = Clamp(buffer[0] + (data * volume_left  >> 8), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (data * volume_right >> 8), -MAX_VOLUME, MAX_VOLUME);
+			buffer[0] += data * volume_left  >> 8;
+			buffer[1] += data * volume_right >> 8;
 			buffer += 2;
 			frac_pos += frac_speed;
 			b += frac_pos >> 16;
@@ -155,6 +156,17 @@ void MxMixSamples(void *buffer, uint samples)
 	/* Fetch music if a sampled stream is available */
 	if (_music_stream) _music_stream((int16*)buffer, samples);
 
+	bool any_active = false;
+	for (mc = _channels; mc != endof(_channels); mc++) any_active |= mc->active;
+	if (!any_active) return;
+
+	/* The channels are mixed into a wider buffer, so the result only has to be
+	 * clamped to the output range once per sample instead of once per channel. */
+	static std::vector<int32> mix_buffer;
+	mix_buffer.resize(2 * samples);
+	int16 *out = (int16 *)buffer;
+	for (uint i = 0; i < 2 * samples; i++) mix_buffer[i] = out[i];
+
 	/* Apply simple x^3 scaling to master effect volume. This increases the
 	 * perceived difference in loudness to better match expectations. effect_vol
 	 * is expected to be in the range 0-127 hence the division by 127 * 127 to
@@ -167,13 +179,15 @@ void MxMixSamples(void *buffer, uint samples)
 	for (mc = _channels; mc != endof(_channels); mc++) {
 		if (mc->active) {
 			if (mc->is16bit) {
-				mix_int16(mc, (int16*)buffer, samples, effect_vol);
+				mix_int16(mc, mix_buffer.data(), samples, effect_vol);
 			} else {
-				mix_int8_to_int16(mc, (int16*)buffer, samples, effect_vol);
+				mix_int8_to_int16(mc, mix_buffer.data(), samples, effect_vol);
 			}
 			if (mc->samples_left == 0) MxCloseChannel(mc);
 		}
 	}
+
+	for (uint i = 0; i < 2 * samples; i++) out[i] = Clamp(mix_buffer[i], -MAX_VOLUME, MAX_VOLUME);
 }
 
 MixerChannel *MxAllocateChannel()
@@ -35,6 +35,7 @@
 static const uint GITHASH_SUFFIX_LEN = 12;
 
 NetworkServerGameInfo _network_game_info; ///< Information about our game.
+static uint32 _network_game_info_static_version = 0; ///< Incremented every time the static content of #_network_game_info is filled.
 
 /**
  * Get the network version string used by this build.
@@ -135,6 +136,8 @@ void FillStaticNetworkServerGameInfo()
 
 	_network_game_info.server_name = _settings_client.network.server_name;
 	_network_game_info.server_revision = GetNetworkRevisionString();
+
+	_network_game_info_static_version++;
 }
 
 /**
@@ -154,6 +157,17 @@ const NetworkServerGameInfo *GetCurrentNetworkServerGameInfo()
 	return &_network_game_info;
 }
 
+/**
+ * Get the key of the latest information of the server. When the key did not change,
+ * #SerializeNetworkGameInfo writes the same data as before, so that can be reused.
+ * @return The key of the current NetworkServerGameInfo.
+ */
+NetworkServerGameInfoKey GetCurrentNetworkServerGameInfoKey()
+{
+	const NetworkServerGameInfo *info = GetCurrentNetworkServerGameInfo();
+	return { _network_game_info_static_version, info->game_date, info->companies_on, info->spectators_on, info->clients_on, Game::GetInfo() };
+}
+
 /**
  * Function that is called for every GRFConfig that is read when receiving
  * a NetworkGameInfo. Only grfid and md5sum are set, the rest is zero. This
@@ -16,6 +16,7 @@
 #include "core.h"
 #include "../../newgrf_config.h"
 #include "../../date_type.h"
+#include <tuple>
 
 /*
  * NetworkGameInfo has several revisions which we still need to support on the
@@ -91,12 +92,16 @@ struct NetworkGameInfo : NetworkServerGameInfo {
 
 extern NetworkServerGameInfo _network_game_info;
 
+/** Everything that can make the serialised server game info differ: the static content's version, the date, the companies, spectators and clients on and the game script. */
+typedef std::tuple<uint32, Date, byte, byte, byte, const void *> NetworkServerGameInfoKey;
+
 std::string_view GetNetworkRevisionString();
 bool IsNetworkCompatibleVersion(std::string_view other);
 void CheckGameCompatibility(NetworkGameInfo &ngi);
 
 void FillStaticNetworkServerGameInfo();
 const NetworkServerGameInfo *GetCurrentNetworkServerGameInfo();
+NetworkServerGameInfoKey GetCurrentNetworkServerGameInfoKey();
 
 void DeserializeGRFIdentifier(Packet *p, GRFIdentifier *grf);
 void SerializeGRFIdentifier(Packet *p, const GRFIdentifier *grf);
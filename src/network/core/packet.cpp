@@ -16,6 +16,46 @@
 
 #include "../../safeguards.h"
 
+/** Maximum number of buffers kept in #_packet_buffer_pool. */
+static const size_t PACKET_BUFFER_POOL_SIZE = 16;
+/** Whether #_packet_buffer_pool of this thread is destroyed; packets owned by static objects are deleted after that. */
+static thread_local bool _packet_buffer_pool_destroyed = false;
+
+/** Pool of packet buffers that marks itself destroyed, so late deleted packets do not use it anymore. */
+struct PacketBufferPool : std::vector<std::vector<byte>> {
+	~PacketBufferPool() { _packet_buffer_pool_destroyed = true; }
+};
+
+/** Buffers of deleted packets, so new packets do not need to allocate their own. Per thread, as the map is written from the savegame thread. */
+static thread_local PacketBufferPool _packet_buffer_pool;
+
+/**
+ * Get an empty buffer for a packet, preferably one from the pool.
+ * @param buffer The buffer to replace.
+ */
+static void GetPacketBuffer(std::vector<byte> &buffer)
+{
+	if (_packet_buffer_pool_destroyed || _packet_buffer_pool.empty()) {
+		buffer.reserve(COMPAT_MTU);
+		return;
+	}
+
+	buffer.swap(_packet_buffer_pool.back());
+	_packet_buffer_pool.pop_back();
+	buffer.clear();
+}
+
+/**
+ * Return the buffer of a packet to the pool, if it is worth keeping.
+ * @param buffer The buffer to return.
+ */
+static void ReturnPacketBuffer(std::vector<byte> &buffer)
+{
+	if (_packet_buffer_pool_destroyed || buffer.capacity() < COMPAT_MTU || _packet_buffer_pool.size() >= PACKET_BUFFER_POOL_SIZE) return;
+
+	_packet_buffer_pool.emplace_back().swap(buffer);
+}
+
 /**
  * Create a packet that is used to read from a network socket.
  * @param cs                The socket handler associated with the socket we are reading from.
@@ -28,11 +68,12 @@
  *                          loose some the data of the packet, so there you pass the maximum
  *                          size for the packet you expect from the network.
  */
-Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size) : next(nullptr), pos(0), limit(limit)
+Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size) : pos(0), limit(limit)
 {
 	assert(cs != nullptr);
 
 	this->cs = cs;
+	GetPacketBuffer(this->buffer);
 	this->buffer.resize(initial_read_size);
 }
 
@@ -44,36 +85,19 @@ Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size)
  *              the limit as it might break things if the other side is not expecting
  *              much larger packets than what they support.
  */
-Packet::Packet(PacketType type, size_t limit) : next(nullptr), pos(0), limit(limit), cs(nullptr)
+Packet::Packet(PacketType type, size_t limit) : pos(0), limit(limit), cs(nullptr)
 {
+	GetPacketBuffer(this->buffer);
+
 	/* Allocate space for the the size so we can write that in just before sending the packet. */
 	this->Send_uint16(0);
 	this->Send_uint8(type);
 }
 
-/**
- * Add the given Packet to the end of the queue of packets.
- * @param queue  The pointer to the begin of the queue.
- * @param packet The packet to append to the queue.
- */
-/* static */ void Packet::AddToQueue(Packet **queue, Packet *packet)
-{
-	while (*queue != nullptr) queue = &(*queue)->next;
-	*queue = packet;
-}
-
-/**
- * Pop the packet from the begin of the queue and set the
- * begin of the queue to the second element in the queue.
- * @param queue  The pointer to the begin of the queue.
- * @return The Packet that used to be a the begin of the queue.
- */
-/* static */ Packet *Packet::PopFromQueue(Packet **queue)
+/** Give the buffer of the packet back to the pool. */
+Packet::~Packet()
 {
-	Packet *p = *queue;
-	*queue = p->next;
-	p->next = nullptr;
-	return p;
+	ReturnPacketBuffer(this->buffer);
 }
 
 
@@ -82,13 +106,17 @@ Packet::Packet(PacketType type, size_t limit) : next(nullptr), pos(0), limit(lim
  */
 void Packet::PrepareToSend()
 {
-	assert(this->cs == nullptr && this->next == nullptr);
+	assert(this->cs == nullptr);
 
 	this->buffer[0] = GB(this->Size(), 0, 8);
 	this->buffer[1] = GB(this->Size(), 8, 8);
 
 	this->pos  = 0; // We start reading from here
-	this->buffer.shrink_to_fit();
+
+	/* Queued packets only keep the memory they need; the larger buffer goes to the next packet. */
+	std::vector<byte> exact(this->buffer);
+	this->buffer.swap(exact);
+	ReturnPacketBuffer(exact);
 }
 
 /**
@@ -257,7 +285,7 @@ size_t Packet::Size() const
  */
 bool Packet::ParsePacketSize()
 {
-	assert(this->cs != nullptr && this->next == nullptr);
+	assert(this->cs != nullptr);
 	size_t size = (size_t)this->buffer[0];
 	size       += (size_t)this->buffer[1] << 8;
 
@@ -22,7 +22,7 @@
  */
 NetworkTCPSocketHandler::NetworkTCPSocketHandler(SOCKET s) :
 		NetworkSocketHandler(),
-		packet_queue(nullptr), packet_recv(nullptr),
+		packet_recv(nullptr),
 		sock(s), writable(false)
 {
 }
@@ -38,9 +38,8 @@ NetworkTCPSocketHandler::~NetworkTCPSocketHandler()
  */
 void NetworkTCPSocketHandler::EmptyPacketQueue()
 {
-	while (this->packet_queue != nullptr) {
-		delete Packet::PopFromQueue(&this->packet_queue);
-	}
+	this->packet_queue.clear();
+	this->send_buffer.clear();
 	delete this->packet_recv;
 	this->packet_recv = nullptr;
 }
@@ -83,7 +82,7 @@ void NetworkTCPSocketHandler::SendPacket(Packet *packet)
 	assert(packet != nullptr);
 
 	packet->PrepareToSend();
-	Packet::AddToQueue(&this->packet_queue, packet);
+	this->packet_queue.emplace_back(packet);
 }
 
 /**
@@ -99,14 +98,30 @@ void NetworkTCPSocketHandler::SendPacket(Packet *packet)
 SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 {
 	ssize_t res;
-	Packet *p;
 
 	/* We can not write to this socket!! */
 	if (!this->writable) return SPS_NONE_SENT;
 	if (!this->IsConnected()) return SPS_CLOSED;
 
-	while ((p = this->packet_queue) != nullptr) {
-		res = p->TransferOut<int>(send, this->sock, 0);
+	while (!this->send_buffer.empty() || !this->packet_queue.empty()) {
+		/* Copy consecutive small packets, like commands and frames, into one buffer so they
+		 * do not all end up in a TCP segment of their own; larger packets are sent directly. */
+		if (this->send_buffer.empty() && this->packet_queue.size() > 1) {
+			while (!this->packet_queue.empty() && this->send_buffer.size() + this->packet_queue.front()->RemainingBytesToTransfer() <= COMPAT_MTU) {
+				this->packet_queue.front()->TransferOut([](std::vector<byte> *buffer, const char *data, size_t amount) -> ssize_t {
+					buffer->insert(buffer->end(), data, data + amount);
+					return amount;
+				}, &this->send_buffer);
+				this->packet_queue.pop_front();
+			}
+		}
+
+		Packet *p = this->send_buffer.empty() ? this->packet_queue.front().get() : nullptr;
+		if (p != nullptr) {
+			res = p->TransferOut<int>(send, this->sock, 0);
+		} else {
+			res = send(this->sock, reinterpret_cast<const char *>(this->send_buffer.data()), static_cast<int>(this->send_buffer.size()), 0);
+		}
 		if (res == -1) {
 			NetworkError err = NetworkError::GetLast();
 			if (!err.WouldBlock()) {
@@ -125,10 +140,12 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 			return SPS_CLOSED;
 		}
 
-		/* Is this packet sent? */
-		if (p->RemainingBytesToTransfer() == 0) {
-			/* Go to the next packet */
-			delete Packet::PopFromQueue(&this->packet_queue);
+		if (p == nullptr) {
+			this->send_buffer.erase(this->send_buffer.begin(), this->send_buffer.begin() + res);
+			if (!this->send_buffer.empty()) return SPS_PARTLY_SENT;
+		} else if (p->RemainingBytesToTransfer() == 0) {
+			/* Is this packet sent? Go to the next packet */
+			this->packet_queue.pop_front();
 		} else {
 			return SPS_PARTLY_SENT;
 		}
@@ -227,7 +244,7 @@ bool NetworkTCPSocketHandler::CanSendReceive()
 	FD_SET(this->sock, &write_fd);
 
 	tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-	if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+	if (select((int)this->sock + 1, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
 
 	this->writable = !!FD_ISSET(this->sock, &write_fd);
 	return FD_ISSET(this->sock, &read_fd) != 0;
@@ -17,8 +17,11 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <map>
+#include <memory>
 #include <thread>
+#include <vector>
 
 /** The states of sending the packets. */
 enum SendPacketsState {
@@ -31,7 +34,8 @@ enum SendPacketsState {
 /** Base socket handler for all TCP sockets */
 class NetworkTCPSocketHandler : public NetworkSocketHandler {
 private:
-	Packet *packet_queue;     ///< Packets that are awaiting delivery
+	std::deque<std::unique_ptr<Packet>> packet_queue; ///< Packets that are awaiting delivery
+	std::vector<byte> send_buffer; ///< Data of small packets that are sent together; it goes before the packets in #packet_queue
 	Packet *packet_recv;      ///< Partially received packet
 
 	void EmptyPacketQueue();
@@ -59,7 +63,13 @@ public:
 	 * Whether there is something pending in the send queue.
 	 * @return true when something is pending in the send queue.
 	 */
-	bool HasSendQueue() { return this->packet_queue != nullptr; }
+	bool HasSendQueue() { return !this->send_buffer.empty() || !this->packet_queue.empty(); }
+
+	/**
+	 * Get the number of packets that are waiting in the send queue.
+	 * @return The number of queued packets.
+	 */
+	size_t GetSendQueueLength() const { return this->packet_queue.size(); }
 
 	NetworkTCPSocketHandler(SOCKET s = INVALID_SOCKET);
 	~NetworkTCPSocketHandler();
@@ -59,6 +59,7 @@ enum PacketAdminType {
 	ADMIN_PACKET_SERVER_GAMESCRIPT,      ///< The server gives the admin information from the GameScript in JSON.
 	ADMIN_PACKET_SERVER_RCON_END,        ///< The server indicates that the remote console command has completed.
 	ADMIN_PACKET_SERVER_PONG,            ///< The server replies to a ping request from the admin.
+	ADMIN_PACKET_SERVER_LINKGRAPH,       ///< The server gives the admin the changes to the links of the link graphs.
 
 	INVALID_ADMIN_PACKET = 0xFF,         ///< An invalid marker for admin packets.
 };
@@ -82,6 +83,7 @@ enum AdminUpdateType {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_LINKGRAPH,       ///< Updates about the capacity and usage of links.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -94,6 +96,7 @@ enum AdminUpdateFrequency {
 	ADMIN_FREQUENCY_QUARTERLY = 0x10, ///< The admin gets information about this on a quarterly basis.
 	ADMIN_FREQUENCY_ANUALLY   = 0x20, ///< The admin gets information about this on a yearly basis.
 	ADMIN_FREQUENCY_AUTOMATIC = 0x40, ///< The admin gets information about this when it changes.
+	ADMIN_FREQUENCY_CHANGES   = 0x80, ///< The periodic updates only contain what changed since the previous update.
 };
 DECLARE_ENUM_AS_BIT_SET(AdminUpdateFrequency)
 
@@ -469,6 +472,21 @@ protected:
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_PONG(Packet *p);
 
+	/**
+	 * Send the links of all link graphs that changed since the last update
+	 * to this admin. When polled all links are sent. These six fields are
+	 * repeated until the packet is full:
+	 * bool    Data to follow.
+	 * uint8   Cargo of the link.
+	 * uint16  ID of the station the link starts at.
+	 * uint16  ID of the station the link ends at.
+	 * uint32  Capacity of the link; 0 if the link has been removed.
+	 * uint32  Usage of the link.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_LINKGRAPH(Packet *p);
+
 	/**
 	 * Notify the admin connection that the rcon command has finished.
 	 * string The command as requested by the admin connection.
@@ -319,14 +319,16 @@ bool TCPConnecter::CheckActivity()
 
 	fd_set write_fd;
 	FD_ZERO(&write_fd);
+	int nfds = 0; // One more than the highest socket, so select() does not scan all of FD_SETSIZE; Winsock ignores this.
 	for (const auto &socket : this->sockets) {
 		FD_SET(socket, &write_fd);
+		nfds = std::max(nfds, (int)socket + 1);
 	}
 
 	timeval tv;
 	tv.tv_usec = 0;
 	tv.tv_sec = 0;
-	int n = select(FD_SETSIZE, nullptr, &write_fd, nullptr, &tv);
+	int n = select(nfds, nullptr, &write_fd, nullptr, &tv);
 	/* select() failed; hopefully next try it doesn't. */
 	if (n < 0) {
 		/* select() normally never fails; so hopefully it works next try! */
@@ -382,6 +384,14 @@ bool TCPConnecter::CheckActivity()
 		return false;
 	}
 
+	/* When only failed attempts reported activity, the other attempts are
+	 * still pending. Do not wait for the delay between attempts, but start
+	 * the next attempt right away, as one of the earlier attempts failed. */
+	if (std::none_of(this->sockets.begin(), this->sockets.end(), [&write_fd](SOCKET socket) { return FD_ISSET(socket, &write_fd); })) {
+		this->TryNextAddress();
+		return false;
+	}
+
 	/* At least one socket is connected. The first one that does is the one
 	 * we will be using, and we close all other sockets. */
 	SOCKET connected_socket = INVALID_SOCKET;
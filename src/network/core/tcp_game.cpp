@@ -20,6 +20,9 @@
 
 #include "../../safeguards.h"
 
+NetworkPacketStats _network_game_received_stats[PACKET_END]; ///< Traffic of all received game packets, per packet type.
+NetworkPacketStats _network_game_sent_stats[PACKET_END];     ///< Traffic of all sent game packets, per packet type.
+
 /**
  * Create a new socket for the game connection.
  * @param s The socket to connect with.
@@ -136,14 +139,38 @@ NetworkRecvStatus NetworkGameSocketHandler::ReceivePackets()
 {
 	Packet *p;
 	while ((p = this->ReceivePacket()) != nullptr) {
+		PacketType type = p->GetPacketType();
+		size_t size = p->Size();
+
+		auto start = std::chrono::steady_clock::now();
 		NetworkRecvStatus res = HandlePacket(p);
+		auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
 		delete p;
+
+		if (type < PACKET_END) _network_game_received_stats[type].Add(size, time);
+		/* When handling did not go okay, this socket might already be deleted. */
 		if (res != NETWORK_RECV_STATUS_OKAY) return res;
+
+		this->received_stats.Add(size, time);
 	}
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * This function puts the packet in the send-queue and accounts for it
+ * in the traffic statistics.
+ * @param packet the packet to send
+ */
+void NetworkGameSocketHandler::SendPacket(Packet *packet)
+{
+	PacketType type = packet->GetPacketType();
+	this->sent_stats.Add(packet->Size());
+	if (type < PACKET_END) _network_game_sent_stats[type].Add(packet->Size());
+
+	this->NetworkTCPSocketHandler::SendPacket(packet);
+}
+
 /**
  * Helper for logging receiving invalid packets.
  * @param type The received packet type.
@@ -127,6 +127,28 @@ enum PacketGameType {
 	PACKET_END,                          ///< Must ALWAYS be on the end of this list!! (period)
 };
 
+/** Traffic of packets of one type, or of one connection. */
+struct NetworkPacketStats {
+	uint64 packets = 0;               ///< The number of packets.
+	uint64 bytes = 0;                 ///< The number of bytes, including the packet headers.
+	std::chrono::microseconds time{}; ///< The time spent handling the packets; only for received packets.
+
+	/**
+	 * Account for a packet.
+	 * @param size The size of the packet.
+	 * @param time The time it took to handle the packet.
+	 */
+	void Add(size_t size, std::chrono::microseconds time = {})
+	{
+		this->packets++;
+		this->bytes += size;
+		this->time += time;
+	}
+};
+
+extern NetworkPacketStats _network_game_received_stats[PACKET_END];
+extern NetworkPacketStats _network_game_sent_stats[PACKET_END];
+
 /** Packet that wraps a command */
 struct CommandPacket;
 
@@ -537,6 +559,8 @@ public:
 	uint32 last_frame_server;    ///< Last frame the server has executed
 	CommandQueue incoming_queue; ///< The command-queue awaiting handling
 	std::chrono::steady_clock::time_point last_packet; ///< Time we received the last frame.
+	NetworkPacketStats received_stats; ///< Traffic of the packets received from this connection.
+	NetworkPacketStats sent_stats;     ///< Traffic of the packets sent to this connection.
 
 	NetworkRecvStatus CloseConnection(bool error = true) override;
 
@@ -566,10 +590,11 @@ public:
 		return this->info;
 	}
 
+	void SendPacket(Packet *packet) override;
 	NetworkRecvStatus ReceivePackets();
 
 	const char *ReceiveCommand(Packet *p, CommandPacket *cp);
-	void SendCommand(Packet *p, const CommandPacket *cp);
+	static void SendCommand(Packet *p, const CommandPacket *cp);
 };
 
 #endif /* NETWORK_CORE_TCP_GAME_H */
@@ -106,19 +106,23 @@ public:
 		FD_ZERO(&read_fd);
 		FD_ZERO(&write_fd);
 
+		/* Let select() only scan up to the highest socket we use, instead of all FD_SETSIZE of them. Winsock ignores this. */
+		int nfds = 0;
 
 		for (Tsocket *cs : Tsocket::Iterate()) {
 			FD_SET(cs->sock, &read_fd);
 			FD_SET(cs->sock, &write_fd);
+			nfds = std::max(nfds, (int)cs->sock + 1);
 		}
 
 		/* take care of listener port */
 		for (auto &s : sockets) {
 			FD_SET(s.second, &read_fd);
+			nfds = std::max(nfds, (int)s.second + 1);
 		}
 
 		tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-		if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+		if (select(nfds, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
 
 		/* accept clients.. */
 		for (auto &s : sockets) {
@@ -29,11 +29,16 @@
 #include "../window_func.h"
 #include "../company_func.h"
 #include "../company_base.h"
+#include "../vehicle_base.h"
+#include "../station_base.h"
+#include "../map_func.h"
 #include "../landscape_type.h"
 #include "../rev.h"
 #include "../core/pool_func.hpp"
 #include "../gfx_func.h"
 #include "../error.h"
+#include "../framerate_type.h"
+#include "../fileio_func.h"
 #include <charconv>
 #include <sstream>
 #include <iomanip>
@@ -41,7 +46,6 @@
 #include "../safeguards.h"
 
 #ifdef DEBUG_DUMP_COMMANDS
-#include "../fileio_func.h"
 /** When running the server till the wait point, run as fast as we can! */
 bool _ddc_fastforward = true;
 #endif /* DEBUG_DUMP_COMMANDS */
@@ -75,6 +79,9 @@ uint32 _sync_seed_1;                  ///< Seed to compare during sync checks.
 uint32 _sync_seed_2;                  ///< Second part of the seed.
 #endif
 uint32 _sync_frame;                   ///< The frame to perform the sync check.
+uint32 _sync_hashes[NSH_END];         ///< Hashes of parts of the game state to compare during sync checks.
+uint8 _sync_map_slice;                ///< The slice of the map that is hashed for the sync check.
+bool _sync_has_hashes;                ///< Whether the client received hashes of the game state to compare.
 bool _network_first_time;             ///< Whether we have finished joining or not.
 CompanyMask _network_company_passworded; ///< Bitmask of the password status of all companies.
 
@@ -617,6 +624,7 @@ static void NetworkInitialize(bool close_admins = true)
 	InitializeNetworkPools(close_admins);
 
 	_sync_frame = 0;
+	_sync_has_hashes = false;
 	_network_first_time = true;
 
 	_network_reconnect = 0;
@@ -1022,12 +1030,185 @@ void NetworkUpdateServerGameType()
 	}
 }
 
+/**
+ * Add a value to a hash of the game state.
+ * @param hash  The hash to update.
+ * @param value The value to add.
+ */
+static inline void AddToSyncHash(uint32 &hash, uint64 value)
+{
+	/* FNV-1a over 32 bit words. */
+	hash = (hash ^ GB(value, 0, 32)) * 16777619;
+	hash = (hash ^ GB(value, 32, 32)) * 16777619;
+}
+
+/**
+ * Calculate the hashes of parts of the game state, with only a part of the map.
+ * @param begin       The first tile of the map to hash.
+ * @param end         The tile after the last tile of the map to hash.
+ * @param[out] hashes The hashes, indexed by #NetworkSyncHash.
+ */
+static void CalculateSyncHashes(TileIndex begin, TileIndex end, uint32 *hashes)
+{
+	for (uint i = 0; i < NSH_END; i++) hashes[i] = 2166136261U;
+
+	for (TileIndex t = begin; t < end; t++) {
+		AddToSyncHash(hashes[NSH_MAP], _m_type[t] | _m_height[t] << 8 | (uint64)_m[t].m2 << 16 | (uint64)_m[t].m1 << 32 | (uint64)_m[t].m3 << 40 | (uint64)_m[t].m4 << 48 | (uint64)_m[t].m5 << 56);
+		AddToSyncHash(hashes[NSH_MAP], _me[t].m6 | _me[t].m7 << 8 | (uint64)_me[t].m8 << 16);
+	}
+
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		AddToSyncHash(hashes[NSH_VEHICLES], v->index | (uint64)v->tile << 32);
+		AddToSyncHash(hashes[NSH_VEHICLES], (uint32)v->x_pos | (uint64)(uint32)v->y_pos << 32);
+		AddToSyncHash(hashes[NSH_VEHICLES], (uint32)v->z_pos | (uint64)v->cur_speed << 32);
+		AddToSyncHash(hashes[NSH_VEHICLES], v->direction | v->progress << 8);
+		AddToSyncHash(hashes[NSH_VEHICLES], v->cargo.StoredCount());
+	}
+
+	for (const Station *st : Station::Iterate()) {
+		AddToSyncHash(hashes[NSH_STATIONS], st->index);
+		for (CargoID c = 0; c < NUM_CARGO; c++) {
+			AddToSyncHash(hashes[NSH_STATIONS], st->goods[c].cargo.TotalCount() | (uint64)st->goods[c].rating << 32);
+		}
+	}
+
+	for (const Company *c : Company::Iterate()) {
+		AddToSyncHash(hashes[NSH_COMPANIES], c->index);
+		AddToSyncHash(hashes[NSH_COMPANIES], (int64)c->money);
+		AddToSyncHash(hashes[NSH_COMPANIES], (int64)c->current_loan);
+	}
+}
+
+/**
+ * Calculate the hashes of parts of the game state for the sync check.
+ * Server and clients calculate these at the same frame, so any difference means a desync in that part.
+ * @param map_slice   Which of the #NETWORK_SYNC_MAP_SLICES slices of the map to hash.
+ * @param[out] hashes The hashes, indexed by #NetworkSyncHash.
+ */
+void NetworkCalculateSyncHashes(uint8 map_slice, uint32 *hashes)
+{
+	uint rows = std::max<uint>(1, MapSizeY() / NETWORK_SYNC_MAP_SLICES);
+	TileIndex begin = std::min(MapSizeY(), (map_slice % NETWORK_SYNC_MAP_SLICES) * rows) * MapSizeX();
+	TileIndex end = std::min(MapSizeY(), (map_slice % NETWORK_SYNC_MAP_SLICES + 1) * rows) * MapSizeX();
+	CalculateSyncHashes(begin, end, hashes);
+}
+
+/**
+ * Calculate the hashes of all parts of the game state of the sync check, including the whole map.
+ * This is too slow to do every frame in a network game; it is meant for checking two runs of the same game behave the same.
+ * @param[out] hashes The hashes, indexed by #NetworkSyncHash.
+ */
+void NetworkCalculateFullSyncHashes(uint32 *hashes)
+{
+	CalculateSyncHashes(0, MapSize(), hashes);
+}
+
+/**
+ * Get the name of a part of the game state that is hashed for the sync check.
+ * @param part The part of the game state.
+ * @return The name, for in the logs.
+ */
+const char *GetNetworkSyncHashName(NetworkSyncHash part)
+{
+	static const char * const names[] = { "map", "vehicles", "stations", "companies" };
+	static_assert(lengthof(names) == NSH_END);
+	return names[part];
+}
+
+static FILE *_state_hash_log = nullptr; ///< File the hashes of the game state are written to or compared with every tick, if any.
+static bool _state_hash_verify = false;  ///< Whether the hashes in #_state_hash_log are compared with instead of written.
+
+/**
+ * Start writing the hashes of the game state of every tick to a file, or comparing them with a file written before.
+ * Running the same savegame with different settings, e.g. with and without threads, must give the same hashes.
+ * @param filename The file to write to or compare with.
+ * @param verify   Whether to compare with the file instead of writing it.
+ * @return true when the file could be opened.
+ */
+bool NetworkStartStateHashLog(const std::string &filename, bool verify)
+{
+	_state_hash_log = FioFOpenFile(filename, verify ? "r" : "w", NO_DIRECTORY);
+	_state_hash_verify = verify;
+	return _state_hash_log != nullptr;
+}
+
+/** Stop writing or comparing the hashes of the game state. */
+void NetworkStopStateHashLog()
+{
+	if (_state_hash_log == nullptr) return;
+
+	FioFCloseFile(_state_hash_log);
+	_state_hash_log = nullptr;
+}
+
+/**
+ * Write the hashes of the game state of the current tick to the state hash log, or compare them with it.
+ * The hashes cover the same parts as the sync check, with the whole map, and the random state.
+ * @return false when comparing and the game state differs from the log; the differing parts are logged.
+ */
+bool NetworkStateHashLogTick()
+{
+	if (_state_hash_log == nullptr) return true;
+
+	uint32 hashes[NSH_END + 1];
+	NetworkCalculateFullSyncHashes(hashes);
+	hashes[NSH_END] = 2166136261U;
+	AddToSyncHash(hashes[NSH_END], _random.state[0] | (uint64)_random.state[1] << 32);
+
+	if (!_state_hash_verify) {
+		fprintf(_state_hash_log, "%08x %02x", _date, _date_fract);
+		for (uint i = 0; i <= NSH_END; i++) fprintf(_state_hash_log, " %08x", hashes[i]);
+		fprintf(_state_hash_log, "\n");
+		return true;
+	}
+
+	uint date, date_fract;
+	uint32 expected[NSH_END + 1];
+	bool valid = fscanf(_state_hash_log, "%x %x", &date, &date_fract) == 2;
+	for (uint i = 0; valid && i <= NSH_END; i++) valid = fscanf(_state_hash_log, "%x", &expected[i]) == 1;
+	if (!valid) {
+		Debug(desync, 0, "State hash log ended at {:08x}; {:02x}, stopped comparing", _date, _date_fract);
+		NetworkStopStateHashLog();
+		return true;
+	}
+
+	if (date != (uint)_date || date_fract != _date_fract) {
+		Debug(desync, 0, "State hash log is at {:08x}; {:02x}, but the game is at {:08x}; {:02x}", date, date_fract, _date, _date_fract);
+		return false;
+	}
+
+	bool same = true;
+	for (uint i = 0; i <= NSH_END; i++) {
+		if (hashes[i] == expected[i]) continue;
+		Debug(desync, 0, "Game state differs from the state hash log at {:08x}; {:02x} in: {}", _date, _date_fract, i < NSH_END ? GetNetworkSyncHashName((NetworkSyncHash)i) : "random");
+		same = false;
+	}
+	return same;
+}
+
+/**
+ * Calculate a single hash over everything the sync check covers, for the whole map, and the random state.
+ * This is too slow to do every frame; it is meant for checking two runs of the same game ended the same.
+ * @return The hash of the game state.
+ */
+uint32 NetworkCalculateGameStateHash()
+{
+	uint32 hash = 2166136261U;
+	uint32 hashes[NSH_END];
+	NetworkCalculateFullSyncHashes(hashes);
+	for (uint i = 0; i < NSH_END; i++) AddToSyncHash(hash, hashes[i]);
+	AddToSyncHash(hash, _random.state[0] | (uint64)_random.state[1] << 32);
+	return hash;
+}
+
 /**
  * Receives something from the network.
  * @return true if everything went fine, false when the connection got closed.
  */
 static bool NetworkReceive()
 {
+	PerformanceAccumulator framerate(PFE_NETWORK);
+
 	if (_network_server) {
 		ServerNetworkAdminSocketHandler::Receive();
 		return ServerNetworkGameSocketHandler::Receive();
@@ -1039,6 +1220,8 @@ static bool NetworkReceive()
 /* This sends all buffered commands (if possible) */
 static void NetworkSend()
 {
+	PerformanceAccumulator framerate(PFE_NETWORK);
+
 	if (_network_server) {
 		ServerNetworkAdminSocketHandler::Send();
 		ServerNetworkGameSocketHandler::Send();
@@ -1068,6 +1251,8 @@ void NetworkGameLoop()
 {
 	if (!_networking) return;
 
+	PerformanceAccumulator::Reset(PFE_NETWORK);
+
 	if (!NetworkReceive()) return;
 
 	if (_network_server) {
@@ -21,6 +21,7 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../linkgraph/linkgraph.h"
 
 #include "../safeguards.h"
 
@@ -39,6 +40,10 @@ INSTANTIATE_POOL_METHODS(NetworkAdminSocket)
 
 /** The timeout for authorisation of the client. */
 static const std::chrono::seconds ADMIN_AUTHORISATION_TIMEOUT(10);
+/** The number of queued packets after which periodic updates are not sent to an admin until it caught up. */
+static const size_t ADMIN_UPDATE_MAX_SEND_QUEUE = 256;
+/** The number of queued packets after which an admin is disconnected, as it does not keep up with the server. */
+static const size_t ADMIN_MAX_SEND_QUEUE = 8192;
 
 
 /** Frequencies, which may be registered for a certain update type. */
@@ -46,13 +51,14 @@ static const AdminUpdateFrequency _admin_update_type_frequencies[] = {
 	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_DATE
 	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CLIENT_INFO
 	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_COMPANY_INFO
-	ADMIN_FREQUENCY_POLL |                         ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_COMPANY_ECONOMY
-	ADMIN_FREQUENCY_POLL |                         ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_COMPANY_STATS
+	ADMIN_FREQUENCY_POLL |                         ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY | ADMIN_FREQUENCY_CHANGES, ///< ADMIN_UPDATE_COMPANY_ECONOMY
+	ADMIN_FREQUENCY_POLL |                         ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY | ADMIN_FREQUENCY_CHANGES, ///< ADMIN_UPDATE_COMPANY_STATS
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CHAT
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CONSOLE
 	ADMIN_FREQUENCY_POLL,                                                                                                                                  ///< ADMIN_UPDATE_CMD_NAMES
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CMD_LOGGING
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_GAMESCRIPT
+	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_LINKGRAPH
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -101,8 +107,12 @@ ServerNetworkAdminSocketHandler::~ServerNetworkAdminSocketHandler()
 			as->CloseConnection(true);
 			continue;
 		}
-		if (as->writable) {
-			as->SendPackets();
+		/* When sending fails, the connection is closed and the handler is deleted. */
+		if (as->writable && as->SendPackets() == SPS_CLOSED) continue;
+
+		if (as->GetSendQueueLength() > ADMIN_MAX_SEND_QUEUE) {
+			Debug(net, 1, "[admin] Admin did not keep up with receiving its {} queued packets", as->GetSendQueueLength());
+			as->CloseConnection(true);
 		}
 	}
 }
@@ -163,6 +173,11 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendProtocol()
 /** Send a welcome message to the admin. */
 NetworkRecvStatus ServerNetworkAdminSocketHandler::SendWelcome()
 {
+	/* Station and company IDs of a previous game mean nothing in the new one. */
+	this->sent_links.clear();
+	this->sent_economy.clear();
+	this->sent_stats.clear();
+
 	Packet *p = new Packet(ADMIN_PACKET_SERVER_WELCOME);
 
 	p->Send_string(_settings_client.network.server_name);
@@ -380,9 +395,13 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyRemove(CompanyID c
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
-/** Send economic information of all companies. */
-NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyEconomy()
+/**
+ * Send economic information of all companies.
+ * @param full Send all companies, instead of only those whose economy changed since the last update.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyEconomy(bool full)
 {
+	std::map<CompanyID, std::array<int64, 10>> economy;
 	for (const Company *company : Company::Iterate()) {
 		/* Get the income. */
 		Money income = 0;
@@ -390,54 +409,133 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyEconomy()
 			income -= company->yearly_expenses[0][i];
 		}
 
-		Packet *p = new Packet(ADMIN_PACKET_SERVER_COMPANY_ECONOMY);
+		economy[company->index] = {
+			/* Current information. */
+			company->money,
+			company->current_loan,
+			income,
+			static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->cur_economy.delivered_cargo.GetSum<OverflowSafeInt64>())),
+			/* Stats for the last 2 quarters. */
+			company->old_economy[0].company_value,
+			company->old_economy[0].performance_history,
+			static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->old_economy[0].delivered_cargo.GetSum<OverflowSafeInt64>())),
+			company->old_economy[1].company_value,
+			company->old_economy[1].performance_history,
+			static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->old_economy[1].delivered_cargo.GetSum<OverflowSafeInt64>())),
+		};
+	}
+
+	for (const auto &record : economy) {
+		auto sent = this->sent_economy.find(record.first);
+		if (!full && sent != this->sent_economy.end() && sent->second == record.second) continue;
 
-		p->Send_uint8(company->index);
+		const std::array<int64, 10> &e = record.second;
+		Packet *p = new Packet(ADMIN_PACKET_SERVER_COMPANY_ECONOMY);
 
-		/* Current information. */
-		p->Send_uint64(company->money);
-		p->Send_uint64(company->current_loan);
-		p->Send_uint64(income);
-		p->Send_uint16(static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->cur_economy.delivered_cargo.GetSum<OverflowSafeInt64>())));
+		p->Send_uint8(record.first);
 
-		/* Send stats for the last 2 quarters. */
-		for (uint i = 0; i < 2; i++) {
-			p->Send_uint64(company->old_economy[i].company_value);
-			p->Send_uint16(company->old_economy[i].performance_history);
-			p->Send_uint16(static_cast<uint16>(std::min<uint64>(UINT16_MAX, company->old_economy[i].delivered_cargo.GetSum<OverflowSafeInt64>())));
+		p->Send_uint64(e[0]);
+		p->Send_uint64(e[1]);
+		p->Send_uint64(e[2]);
+		p->Send_uint16(static_cast<uint16>(e[3]));
+		for (uint i = 4; i < e.size(); i += 3) {
+			p->Send_uint64(e[i]);
+			p->Send_uint16(static_cast<uint16>(e[i + 1]));
+			p->Send_uint16(static_cast<uint16>(e[i + 2]));
 		}
 
 		this->SendPacket(p);
 	}
-
+	this->sent_economy.swap(economy);
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
-/** Send statistics about the companies. */
-NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
+/**
+ * Send statistics about the companies.
+ * @param full Send all companies, instead of only those whose statistics changed since the last update.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats(bool full)
 {
 	/* Fetch the latest version of the stats. */
 	NetworkCompanyStats company_stats[MAX_COMPANIES];
 	NetworkPopulateCompanyStats(company_stats);
 
-	/* Go through all the companies. */
+	std::map<CompanyID, std::array<uint16, 2 * NETWORK_VEH_END>> stats;
 	for (const Company *company : Company::Iterate()) {
+		std::array<uint16, 2 * NETWORK_VEH_END> &s = stats[company->index];
+		std::copy(std::begin(company_stats[company->index].num_vehicle), std::end(company_stats[company->index].num_vehicle), s.begin());
+		std::copy(std::begin(company_stats[company->index].num_station), std::end(company_stats[company->index].num_station), s.begin() + NETWORK_VEH_END);
+	}
+
+	/* Go through all the companies. */
+	for (const auto &record : stats) {
+		auto sent = this->sent_stats.find(record.first);
+		if (!full && sent != this->sent_stats.end() && sent->second == record.second) continue;
+
 		Packet *p = new Packet(ADMIN_PACKET_SERVER_COMPANY_STATS);
 
-		/* Send the information. */
-		p->Send_uint8(company->index);
+		/* Send the information; first the vehicles, then the stations. */
+		p->Send_uint8(record.first);
+		for (uint16 count : record.second) p->Send_uint16(count);
+
+		this->SendPacket(p);
+	}
+	this->sent_stats.swap(stats);
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
 
-		for (uint i = 0; i < NETWORK_VEH_END; i++) {
-			p->Send_uint16(company_stats[company->index].num_vehicle[i]);
+/**
+ * Send the capacity and usage of the links in all link graphs.
+ * @param full Send all links, instead of only those that changed since the last update.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendLinkGraph(bool full)
+{
+	std::map<LinkKey, std::pair<uint, uint>> links;
+	for (const LinkGraph *lg : LinkGraph::Iterate()) {
+		for (NodeID from = 0; from < lg->Size(); from++) {
+			LinkGraph::ConstNode node = (*lg)[from];
+			for (LinkGraph::ConstEdgeIterator it(node.Begin()); it != node.End(); ++it) {
+				links[LinkKey(lg->Cargo(), node.Station(), (*lg)[it->first].Station())] = {it->second.Capacity(), it->second.Usage()};
+			}
 		}
+	}
 
-		for (uint i = 0; i < NETWORK_VEH_END; i++) {
-			p->Send_uint16(company_stats[company->index].num_station[i]);
+	Packet *p = new Packet(ADMIN_PACKET_SERVER_LINKGRAPH);
+	auto send_link = [this, &p](const LinkKey &key, uint capacity, uint usage) {
+		/* Should COMPAT_MTU be exceeded, start a new packet (magic 15: the
+		 * fields of one link, its "more data" bool and one bool "no more data"). */
+		if (!p->CanWriteToPacket(15)) {
+			p->Send_bool(false);
+			this->SendPacket(p);
+
+			p = new Packet(ADMIN_PACKET_SERVER_LINKGRAPH);
 		}
 
-		this->SendPacket(p);
+		p->Send_bool(true);
+		p->Send_uint8(std::get<0>(key));
+		p->Send_uint16(std::get<1>(key));
+		p->Send_uint16(std::get<2>(key));
+		p->Send_uint32(capacity);
+		p->Send_uint32(usage);
+	};
+
+	for (const auto &link : links) {
+		auto sent = this->sent_links.find(link.first);
+		if (full || sent == this->sent_links.end() || sent->second != link.second) {
+			send_link(link.first, link.second.first, link.second.second);
+		}
+	}
+	/* Links that are gone are sent with zero capacity. */
+	for (const auto &link : this->sent_links) {
+		if (links.find(link.first) == links.end()) send_link(link.first, 0, 0);
 	}
+	this->sent_links.swap(links);
+
+	/* Marker to notify the end of the packet has been reached. */
+	p->Send_bool(false);
+	this->SendPacket(p);
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -735,12 +833,12 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet *p)
 
 		case ADMIN_UPDATE_COMPANY_ECONOMY:
 			/* The admin is requesting economy info. */
-			this->SendCompanyEconomy();
+			this->SendCompanyEconomy(true);
 			break;
 
 		case ADMIN_UPDATE_COMPANY_STATS:
 			/* the admin is requesting company stats. */
-			this->SendCompanyStats();
+			this->SendCompanyStats(true);
 			break;
 
 		case ADMIN_UPDATE_CMD_NAMES:
@@ -748,6 +846,11 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet *p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_LINKGRAPH:
+			/* The admin is requesting all links. */
+			this->SendLinkGraph(true);
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			Debug(net, 1, "[admin] Not supported poll {} ({}) from '{}' ({}).", type, d1, this->admin_name, this->admin_version);
@@ -979,6 +1082,9 @@ void ServerNetworkAdminSocketHandler::WelcomeAll()
 void NetworkAdminUpdate(AdminUpdateFrequency freq)
 {
 	for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::IterateActive()) {
+		/* Skip this round for slow admins; the next update has the latest data anyway. */
+		if (as->GetSendQueueLength() > ADMIN_UPDATE_MAX_SEND_QUEUE) continue;
+
 		for (int i = 0; i < ADMIN_UPDATE_END; i++) {
 			if (as->update_frequency[i] & freq) {
 				/* Update the admin for the required details */
@@ -988,11 +1094,15 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						break;
 
 					case ADMIN_UPDATE_COMPANY_ECONOMY:
-						as->SendCompanyEconomy();
+						as->SendCompanyEconomy((as->update_frequency[i] & ADMIN_FREQUENCY_CHANGES) == 0);
 						break;
 
 					case ADMIN_UPDATE_COMPANY_STATS:
-						as->SendCompanyStats();
+						as->SendCompanyStats((as->update_frequency[i] & ADMIN_FREQUENCY_CHANGES) == 0);
+						break;
+
+					case ADMIN_UPDATE_LINKGRAPH:
+						as->SendLinkGraph(false);
 						break;
 
 					default: NOT_REACHED();
@@ -13,6 +13,11 @@
 #include "network_internal.h"
 #include "core/tcp_listen.h"
 #include "core/tcp_admin.h"
+#include "../cargo_type.h"
+#include "../station_type.h"
+#include <array>
+#include <map>
+#include <tuple>
 
 extern AdminIndex _redirect_console_to_admin;
 
@@ -35,6 +40,15 @@ protected:
 
 	NetworkRecvStatus SendProtocol();
 	NetworkRecvStatus SendPong(uint32 d1);
+
+	/** Identification of a link: cargo, source and destination station. */
+	typedef std::tuple<CargoID, StationID, StationID> LinkKey;
+	/** Capacity and usage of the links, as last sent to the admin. */
+	std::map<LinkKey, std::pair<uint, uint>> sent_links;
+	/** Economy of the companies, in the order it is sent, as last sent to the admin. */
+	std::map<CompanyID, std::array<int64, 10>> sent_economy;
+	/** Statistics of the companies, as last sent to the admin. */
+	std::map<CompanyID, std::array<uint16, 2 * NETWORK_VEH_END>> sent_stats;
 public:
 	AdminUpdateFrequency update_frequency[ADMIN_UPDATE_END]; ///< Admin requested update intervals.
 	std::chrono::steady_clock::time_point connect_time;      ///< Time of connection.
@@ -58,8 +72,9 @@ public:
 	NetworkRecvStatus SendCompanyInfo(const Company *c);
 	NetworkRecvStatus SendCompanyUpdate(const Company *c);
 	NetworkRecvStatus SendCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
-	NetworkRecvStatus SendCompanyEconomy();
-	NetworkRecvStatus SendCompanyStats();
+	NetworkRecvStatus SendCompanyEconomy(bool full);
+	NetworkRecvStatus SendCompanyStats(bool full);
+	NetworkRecvStatus SendLinkGraph(bool full);
 
 	NetworkRecvStatus SendChat(NetworkAction action, DestType desttype, ClientID client_id, const std::string &msg, int64 data);
 	NetworkRecvStatus SendRcon(uint16 colour, const std::string_view command);
@@ -287,6 +287,26 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 				return false;
 			}
 
+			if (_sync_has_hashes) {
+				uint32 hashes[NSH_END];
+				NetworkCalculateSyncHashes(_sync_map_slice, hashes);
+
+				bool in_sync = true;
+				for (uint i = 0; i < NSH_END; i++) {
+					if (hashes[i] == _sync_hashes[i]) continue;
+
+					Debug(desync, 1, "sync_err: {:08x}; {:02x}; {} differ", _date, _date_fract, GetNetworkSyncHashName((NetworkSyncHash)i));
+					Debug(net, 0, "Sync error detected in the {}", GetNetworkSyncHashName((NetworkSyncHash)i));
+					in_sync = false;
+				}
+				if (!in_sync) {
+					ShowNetworkError(STR_NETWORK_ERROR_DESYNC);
+					my_client->ClientError(NETWORK_RECV_STATUS_DESYNC);
+					return false;
+				}
+				_sync_has_hashes = false;
+			}
+
 			/* If this is the first time we have a sync-frame, we
 			 *   need to let the server know that we are ready and at the same
 			 *   frame as it is.. so we can start playing! */
@@ -442,6 +462,8 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::SendCommand(const CommandPacke
 	my_client->NetworkGameSocketHandler::SendCommand(p, cp);
 
 	my_client->SendPacket(p);
+	/* The server only executes the command once it got it, so do not wait for the next game loop to send it. */
+	my_client->SendPackets();
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
@@ -993,6 +1015,10 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_SYNC(Packet *p)
 	_sync_seed_2 = p->Recv_uint32();
 #endif
 
+	_sync_map_slice = p->Recv_uint8();
+	for (uint i = 0; i < NSH_END; i++) _sync_hashes[i] = p->Recv_uint32();
+	_sync_has_hashes = true;
+
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
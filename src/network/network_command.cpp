@@ -208,8 +208,13 @@ void NetworkExecuteLocalCommandQueue()
 		/* We can execute this command */
 		_current_company = cp->company;
 		cp->cmd |= CMD_NETWORK_COMMAND;
+		auto start = std::chrono::steady_clock::now();
 		DoCommandP(cp, cp->my_cmd);
 
+		/* Charge the client for the time its command took, so it can be throttled. */
+		NetworkClientSocket *cs = _network_server ? NetworkClientSocket::GetByClientID(cp->client_id) : nullptr;
+		if (cs != nullptr) cs->command_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
 		queue.Pop();
 		delete cp;
 	}
@@ -237,18 +242,26 @@ static void DistributeCommandPacket(CommandPacket &cp, const NetworkClientSocket
 	CommandCallback *callback = cp.callback;
 	cp.frame = _frame_counter_max + 1;
 
+	/* All clients but the owner receive exactly the same command, so encode it only once. */
+	cp.callback = nullptr;
+	cp.my_cmd = false;
+	std::shared_ptr<const Packet> encoded(ServerNetworkGameSocketHandler::CreateCommandPacket(&cp));
+
 	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
 		if (cs->status >= NetworkClientSocket::STATUS_MAP) {
 			/* Callbacks are only send back to the client who sent them in the
 			 *  first place. This filters that out. */
 			cp.callback = (cs != owner) ? nullptr : callback;
 			cp.my_cmd = (cs == owner);
+			cp.encoded = (cs != owner) ? encoded : nullptr;
 			cs->outgoing_queue.Append(&cp);
 		}
 	}
 
+	cp.encoded = nullptr;
 	cp.callback = (nullptr != owner) ? nullptr : callback;
 	cp.my_cmd = (nullptr == owner);
+	cp.client_id = (nullptr != owner) ? owner->client_id : CLIENT_ID_SERVER;
 	_local_execution_queue.Append(&cp);
 }
 
@@ -257,13 +270,21 @@ static void DistributeCommandPacket(CommandPacket &cp, const NetworkClientSocket
  * @param queue The queue of commands that has to be distributed.
  * @param owner The client that owns the commands,
  */
-static void DistributeQueue(CommandQueue *queue, const NetworkClientSocket *owner)
+static void DistributeQueue(CommandQueue *queue, NetworkClientSocket *owner)
 {
 #ifdef DEBUG_DUMP_COMMANDS
 	/* When replaying we do not want this limitation. */
 	int to_go = UINT16_MAX;
 #else
 	int to_go = _settings_client.network.commands_per_frame;
+
+	if (owner != nullptr && _settings_client.network.max_command_time != 0) {
+		/* Pay off the time the earlier commands of the client took to execute; until that
+		 * is done its next commands have to wait, so a few expensive commands cannot stall the game. */
+		std::chrono::microseconds allowance = std::chrono::milliseconds(_settings_client.network.max_command_time * (_settings_client.network.frame_freq + 1));
+		owner->command_time = std::max(owner->command_time - allowance, std::chrono::microseconds::zero());
+		if (owner->command_time > std::chrono::microseconds::zero()) return;
+	}
 #endif
 
 	CommandPacket *cp;
@@ -317,7 +338,7 @@ const char *NetworkGameSocketHandler::ReceiveCommand(Packet *p, CommandPacket *c
  * @param p the packet to send it in.
  * @param cp the packet to actually send.
  */
-void NetworkGameSocketHandler::SendCommand(Packet *p, const CommandPacket *cp)
+/* static */ void NetworkGameSocketHandler::SendCommand(Packet *p, const CommandPacket *cp)
 {
 	p->Send_uint8 (cp->company);
 	p->Send_uint32(cp->cmd);
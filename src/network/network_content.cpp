@@ -377,102 +377,117 @@ void ClientNetworkContentSocketHandler::DownloadSelectedContentFallback(const Co
 }
 
 /**
- * Determine the full filename of a piece of content information
- * @param ci         the information to get the filename from
- * @param compressed should the filename end with .gz?
- * @return a statically allocated buffer with the filename or
- *         nullptr when no filename could be made.
+ * Determine the full filename of the tar of a piece of content information
+ * @param ci the information to get the filename from
+ * @return the filename or an empty string when no filename could be made.
  */
-static std::string GetFullFilename(const ContentInfo *ci, bool compressed)
+static std::string GetFullFilename(const ContentInfo *ci)
 {
 	Subdirectory dir = GetContentInfoSubDir(ci->type);
 	if (dir == NO_DIRECTORY) return {};
 
 	std::string buf = FioGetDirectory(SP_AUTODOWNLOAD_DIR, dir);
 	buf += ci->filename;
-	buf += compressed ? ".tar.gz" : ".tar";
+	buf += ".tar";
 
 	return buf;
 }
 
-/**
- * Gunzip a given file and remove the .gz if successful.
- * @param ci container with filename
- * @return true if the gunzip completed
- */
-static bool GunzipFile(const ContentInfo *ci)
-{
+/** Decompression of a downloaded .tar.gz straight into its .tar file, while it is being received. */
+struct ContentDecompressor {
 #if defined(WITH_ZLIB)
-	bool ret = true;
+	z_stream z;      ///< The state of zlib.
+#endif
+	size_t received; ///< The number of compressed bytes received so far.
+	bool finished;   ///< Whether decompression reached the end of the compressed data.
+	bool corrupt;    ///< Whether the compressed data could not be decompressed.
 
-	/* Need to open the file with fopen() to support non-ASCII on Windows. */
-	FILE *ftmp = fopen(GetFullFilename(ci, true).c_str(), "rb");
-	if (ftmp == nullptr) return false;
-	/* Duplicate the handle, and close the FILE*, to avoid double-closing the handle later. */
-	int fdup = dup(fileno(ftmp));
-	gzFile fin = gzdopen(fdup, "rb");
-	fclose(ftmp);
+	ContentDecompressor() : received(0), finished(false), corrupt(false)
+	{
+#if defined(WITH_ZLIB)
+		memset(&this->z, 0, sizeof(this->z));
+		/* Accept the gzip header. */
+		if (inflateInit2(&this->z, MAX_WBITS + 16) != Z_OK) this->corrupt = true;
+#else
+		NOT_REACHED();
+#endif /* defined(WITH_ZLIB) */
+	}
 
-	FILE *fout = fopen(GetFullFilename(ci, false).c_str(), "wb");
+	~ContentDecompressor()
+	{
+#if defined(WITH_ZLIB)
+		inflateEnd(&this->z);
+#endif /* defined(WITH_ZLIB) */
+	}
+
+	/**
+	 * Decompress the next part of the download into the file.
+	 * @param file   The file to write the decompressed data to.
+	 * @param data   The compressed data.
+	 * @param length The number of bytes of compressed data.
+	 * @return false when writing to the file failed.
+	 */
+	bool Write(FILE *file, const char *data, size_t length)
+	{
+		this->received += length;
+		if (this->corrupt) return true;
+
+#if defined(WITH_ZLIB)
+		this->z.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(data));
+		this->z.avail_in = (uInt)length;
 
-	if (fin == nullptr || fout == nullptr) {
-		ret = false;
-	} else {
 		byte buff[8192];
-		for (;;) {
-			int read = gzread(fin, buff, sizeof(buff));
-			if (read == 0) {
-				/* If gzread() returns 0, either the end-of-file has been
-				 * reached or an underlying read error has occurred.
-				 *
-				 * gzeof() can't be used, because:
-				 * 1.2.5 - it is safe, 1 means 'everything was OK'
-				 * 1.2.3.5, 1.2.4 - 0 or 1 is returned 'randomly'
-				 * 1.2.3.3 - 1 is returned for truncated archive
-				 *
-				 * So we use gzerror(). When proper end of archive
-				 * has been reached, then:
-				 * errnum == Z_STREAM_END in 1.2.3.3,
-				 * errnum == 0 in 1.2.4 and 1.2.5 */
-				int errnum;
-				gzerror(fin, &errnum);
-				if (errnum != 0 && errnum != Z_STREAM_END) ret = false;
-				break;
+		while (this->z.avail_in != 0) {
+			/* Like gzread(), continue with the next member of a concatenated gzip file. */
+			if (this->finished) {
+				inflateReset(&this->z);
+				this->finished = false;
 			}
-			if (read < 0 || (size_t)read != fwrite(buff, 1, read, fout)) {
-				/* If gzread() returns -1, there was an error in archive */
-				ret = false;
-				break;
-			}
-			/* DO NOT DO THIS! It will fail to detect broken archive with 1.2.3.3!
-			 * if (read < sizeof(buff)) break; */
+
+			do {
+				this->z.next_out = buff;
+				this->z.avail_out = sizeof(buff);
+
+				int res = inflate(&this->z, Z_NO_FLUSH);
+				if (res != Z_OK && res != Z_STREAM_END && res != Z_BUF_ERROR) {
+					this->corrupt = true;
+					return true;
+				}
+
+				size_t out = sizeof(buff) - this->z.avail_out;
+				if (out != 0 && fwrite(buff, 1, out, file) != out) return false;
+
+				if (res == Z_STREAM_END) {
+					this->finished = true;
+					break;
+				}
+			} while (this->z.avail_out == 0);
 		}
+#endif /* defined(WITH_ZLIB) */
+		return true;
 	}
 
-	if (fin != nullptr) {
-		gzclose(fin);
-	} else if (fdup != -1) {
-		/* Failing gzdopen does not close the passed file descriptor. */
-		close(fdup);
+	/**
+	 * Whether all of the download could be decompressed.
+	 * @return true when the decompressed data is complete.
+	 */
+	bool Succeeded() const
+	{
+		return this->finished && !this->corrupt;
 	}
-	if (fout != nullptr) fclose(fout);
-
-	return ret;
-#else
-	NOT_REACHED();
-#endif /* defined(WITH_ZLIB) */
-}
+};
 
 /**
- * Simple wrapper around fwrite to be able to pass it to Packet's TransferOut.
- * @param file   The file to write data to.
- * @param buffer The buffer to write to the file.
- * @param amount The number of bytes to write.
+ * Simple wrapper around the decompression to be able to pass it to Packet's TransferOut.
+ * @param decompressor The decompression of the download.
+ * @param buffer       The compressed data to write to the file.
+ * @param amount       The number of bytes to write.
+ * @param file         The file to write the decompressed data to.
  * @return The number of bytes that were written.
  */
-static inline ssize_t TransferOutFWrite(FILE *file, const char *buffer, size_t amount)
+static inline ssize_t TransferOutDecompress(ContentDecompressor *decompressor, const char *buffer, size_t amount, FILE *file)
 {
-	return fwrite(buffer, 1, amount, file);
+	return decompressor->Write(file, buffer, amount) ? amount : 0;
 }
 
 bool ClientNetworkContentSocketHandler::Receive_SERVER_CONTENT(Packet *p)
@@ -493,12 +508,14 @@ bool ClientNetworkContentSocketHandler::Receive_SERVER_CONTENT(Packet *p)
 	} else {
 		/* We have a file opened, thus are downloading internal content */
 		size_t toRead = p->RemainingBytesToTransfer();
-		if (toRead != 0 && (size_t)p->TransferOut(TransferOutFWrite, this->curFile) != toRead) {
+		if (toRead != 0 && (size_t)p->TransferOut(TransferOutDecompress, this->decompressor, this->curFile) != toRead) {
 			CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_CONTENT_DOWNLOAD);
 			ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD, STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD_FILE_NOT_WRITABLE, WL_ERROR);
 			this->CloseConnection();
 			fclose(this->curFile);
 			this->curFile = nullptr;
+			delete this->decompressor;
+			this->decompressor = nullptr;
 
 			return false;
 		}
@@ -524,14 +541,16 @@ bool ClientNetworkContentSocketHandler::BeforeDownload()
 	}
 
 	if (this->curInfo->filesize != 0) {
-		/* The filesize is > 0, so we are going to download it */
-		std::string filename = GetFullFilename(this->curInfo, true);
+		/* The filesize is > 0, so we are going to download it; it is decompressed while it comes in. */
+		std::string filename = GetFullFilename(this->curInfo);
 		if (filename.empty() || (this->curFile = fopen(filename.c_str(), "wb")) == nullptr) {
 			/* Unless that fails of course... */
 			CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_CONTENT_DOWNLOAD);
 			ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD, STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD_FILE_NOT_WRITABLE, WL_ERROR);
 			return false;
 		}
+		delete this->decompressor;
+		this->decompressor = new ContentDecompressor();
 	}
 	return true;
 }
@@ -543,18 +562,18 @@ bool ClientNetworkContentSocketHandler::BeforeDownload()
 void ClientNetworkContentSocketHandler::AfterDownload()
 {
 	/* We read nothing; that's our marker for end-of-stream.
-	 * Now gunzip the tar and make it known. */
-	fclose(this->curFile);
+	 * The tar has been decompressed while downloading, so make it known. */
+	bool success = fclose(this->curFile) == 0 && this->decompressor->Succeeded();
 	this->curFile = nullptr;
+	delete this->decompressor;
+	this->decompressor = nullptr;
 
-	if (GunzipFile(this->curInfo)) {
-		unlink(GetFullFilename(this->curInfo, true).c_str());
-
+	if (success) {
 		Subdirectory sd = GetContentInfoSubDir(this->curInfo->type);
 		if (sd == NO_DIRECTORY) NOT_REACHED();
 
 		TarScanner ts;
-		std::string fname = GetFullFilename(this->curInfo, false);
+		std::string fname = GetFullFilename(this->curInfo);
 		ts.AddFile(sd, fname);
 
 		if (this->curInfo->type == CONTENT_TYPE_BASE_MUSIC) {
@@ -586,11 +605,13 @@ void ClientNetworkContentSocketHandler::OnFailure()
 
 	if (this->curFile != nullptr) {
 		/* Revert the download progress when we are going for the old system. */
-		long size = ftell(this->curFile);
-		if (size > 0) this->OnDownloadProgress(this->curInfo, (int)-size);
+		size_t size = this->decompressor->received;
+		if (size > 0) this->OnDownloadProgress(this->curInfo, (int)-(int64)size);
 
 		fclose(this->curFile);
 		this->curFile = nullptr;
+		delete this->decompressor;
+		this->decompressor = nullptr;
 	}
 }
 
@@ -616,8 +637,8 @@ void ClientNetworkContentSocketHandler::OnReceiveData(const char *data, size_t l
 	}
 
 	if (data != nullptr) {
-		/* We have data, so write it to the file. */
-		if (fwrite(data, 1, length, this->curFile) != length) {
+		/* We have data, so decompress it into the file. */
+		if (!this->decompressor->Write(this->curFile, data, length)) {
 			/* Writing failed somehow, let try via the old method. */
 			this->OnFailure();
 		} else {
@@ -726,6 +747,7 @@ ClientNetworkContentSocketHandler::ClientNetworkContentSocketHandler() :
 	NetworkContentSocketHandler(),
 	http_response_index(-2),
 	curFile(nullptr),
+	decompressor(nullptr),
 	curInfo(nullptr),
 	isConnecting(false)
 {
@@ -737,6 +759,7 @@ ClientNetworkContentSocketHandler::~ClientNetworkContentSocketHandler()
 {
 	delete this->curInfo;
 	if (this->curFile != nullptr) fclose(this->curFile);
+	delete this->decompressor;
 
 	for (ContentInfo *ci : this->infos) delete ci;
 }
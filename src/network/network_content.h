@@ -72,6 +72,7 @@ protected:
 	int http_response_index;                      ///< Where we are, in the response, with handling it
 
 	FILE *curFile;        ///< Currently downloaded file
+	struct ContentDecompressor *decompressor; ///< Decompression of the currently downloaded file
 	ContentInfo *curInfo; ///< Information about the currently downloaded file
 	bool isConnecting;    ///< Whether we're connecting
 	std::chrono::steady_clock::time_point lastActivity;  ///< The last time there was network activity
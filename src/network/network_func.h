@@ -45,6 +45,10 @@ std::string NetworkChangeCompanyPassword(CompanyID company_id, std::string passw
 void NetworkReboot();
 void NetworkDisconnect(bool blocking = false, bool close_admins = true);
 void NetworkGameLoop();
+uint32 NetworkCalculateGameStateHash();
+bool NetworkStartStateHashLog(const std::string &filename, bool verify);
+void NetworkStopStateHashLog();
+bool NetworkStateHashLogTick();
 void NetworkBackgroundLoop();
 std::string_view ParseFullConnectionString(const std::string &connection_string, uint16 &port, CompanyID *company_id = nullptr);
 void NetworkStartDebugLog(const std::string &connection_string);
@@ -71,6 +75,8 @@ void NetworkServerYearlyLoop();
 void NetworkServerSendConfigUpdate();
 void NetworkServerUpdateGameInfo();
 void NetworkServerShowStatusToConsole();
+void NetworkServerShowTrafficToConsole();
+void NetworkServerShowLagToConsole();
 bool NetworkServerStart();
 void NetworkServerNewCompany(const Company *company, NetworkClientInfo *ci);
 bool NetworkServerChangeClientName(ClientID client_id, const std::string &new_name);
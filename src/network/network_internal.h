@@ -77,6 +77,20 @@ extern uint32 _sync_seed_1;
 extern uint32 _sync_seed_2;
 #endif
 extern uint32 _sync_frame;
+
+/** Parts of the game state of which a hash is compared in the sync checks, so a desync can be pinned down. */
+enum NetworkSyncHash {
+	NSH_MAP,       ///< One slice of the rows of the map, see #NETWORK_SYNC_MAP_SLICES.
+	NSH_VEHICLES,  ///< Position, speed and load of the vehicles.
+	NSH_STATIONS,  ///< Waiting cargo and ratings of the stations.
+	NSH_COMPANIES, ///< Money and loan of the companies.
+	NSH_END,       ///< End marker.
+};
+static const uint NETWORK_SYNC_MAP_SLICES = 64; ///< The map is hashed in this many slices, one slice per sync check.
+
+extern uint32 _sync_hashes[NSH_END];
+extern uint8 _sync_map_slice;
+extern bool _sync_has_hashes;
 extern bool _network_first_time;
 /* Vars needed for the join-GUI */
 extern NetworkJoinStatus _network_join_status;
@@ -104,15 +118,20 @@ void UpdateNetworkGameWindow();
  */
 struct CommandPacket : CommandContainer {
 	/** Make sure the pointer is nullptr. */
-	CommandPacket() : next(nullptr), company(INVALID_COMPANY), frame(0), my_cmd(false) {}
+	CommandPacket() : next(nullptr), company(INVALID_COMPANY), client_id(INVALID_CLIENT_ID), frame(0), my_cmd(false) {}
 	CommandPacket *next; ///< the next command packet (if in queue)
 	CompanyID company;   ///< company that is executing the command
+	ClientID client_id;  ///< on the server, the client that sent the command
 	uint32 frame;        ///< the frame in which this packet is executed
 	bool my_cmd;         ///< did the command originate from "me"
+	std::shared_ptr<const Packet> encoded; ///< the command already encoded for sending, shared by all clients that receive the same bytes
 };
 
 void NetworkDistributeCommands();
 void NetworkExecuteLocalCommandQueue();
+void NetworkCalculateSyncHashes(uint8 map_slice, uint32 *hashes);
+void NetworkCalculateFullSyncHashes(uint32 *hashes);
+const char *GetNetworkSyncHashName(NetworkSyncHash part);
 void NetworkFreeLocalCommandQueue();
 void NetworkSyncCommandQueue(NetworkClientSocket *cs);
 
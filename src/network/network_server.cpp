@@ -31,6 +31,8 @@
 #include "../rev.h"
 #include <mutex>
 #include <condition_variable>
+#include <map>
+#include <vector>
 
 #include "../safeguards.h"
 
@@ -55,19 +57,28 @@ template SocketList TCPListenHandler<ServerNetworkGameSocketHandler, PACKET_SERV
 
 /** Writing a savegame directly to a number of packets. */
 struct PacketWriter : SaveFilter {
-	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
+	/** The progress of one of the clients we are sending the savegame to. */
+	struct Receiver {
+		size_t next_packet = 0; ///< Index in #packets of the next packet to send to the client.
+		bool size_sent = false; ///< Whether the total size has been sent to the client.
+	};
+
+	std::map<ServerNetworkGameSocketHandler *, Receiver> receivers; ///< Sockets we are sending the savegame to.
 	Packet *current;                    ///< The packet we're currently writing to.
 	size_t total_size;                  ///< Total size of the compressed savegame.
-	Packet *packets;                    ///< Packet queue of the savegame; send these "slowly" to the client.
+	bool finished;                      ///< Whether the savegame has been written completely, so #total_size is known.
+	std::vector<Packet *> packets;      ///< Packets of the savegame; send these "slowly" to the clients.
+	size_t freed_packets;               ///< Number of packets at the front of #packets that have been sent to all clients and freed.
 	std::mutex mutex;                   ///< Mutex for making threaded saving safe.
 	std::condition_variable exit_sig;   ///< Signal for threaded destruction of this packet writer.
 
 	/**
 	 * Create the packet writer.
-	 * @param cs The socket handler we're making the packets for.
+	 * @param sockets The socket handlers we're making the packets for.
 	 */
-	PacketWriter(ServerNetworkGameSocketHandler *cs) : SaveFilter(nullptr), cs(cs), current(nullptr), total_size(0), packets(nullptr)
+	PacketWriter(const std::vector<ServerNetworkGameSocketHandler *> &sockets) : SaveFilter(nullptr), current(nullptr), total_size(0), finished(false), freed_packets(0)
 	{
+		for (ServerNetworkGameSocketHandler *cs : sockets) this->receivers[cs] = {};
 	}
 
 	/** Make sure everything is cleaned up. */
@@ -75,32 +86,33 @@ struct PacketWriter : SaveFilter {
 	{
 		std::unique_lock<std::mutex> lock(this->mutex);
 
-		if (this->cs != nullptr) this->exit_sig.wait(lock);
+		this->exit_sig.wait(lock, [this] { return this->receivers.empty(); });
 
-		/* This must all wait until the Destroy function is called. */
+		/* This must all wait until the Destroy function is called for every socket. */
 
-		while (this->packets != nullptr) {
-			delete Packet::PopFromQueue(&this->packets);
-		}
+		for (Packet *p : this->packets) delete p;
 
 		delete this->current;
 	}
 
 	/**
-	 * Begin the destruction of this packet writer. It can happen in two ways:
+	 * Begin the destruction of this packet writer for one of the sockets. It can happen in two ways:
 	 * in the first case the client disconnected while saving the map. In this
 	 * case the saving has not finished and killed this PacketWriter. In that
-	 * case we simply set cs to nullptr, triggering the appending to fail due to
-	 * the connection problem and eventually triggering the destructor. In the
-	 * second case the destructor is already called, and it is waiting for our
-	 * signal which we will send. Only then the packets will be removed by the
-	 * destructor.
+	 * case we simply remove the socket, and once no socket is left the appending
+	 * fails due to the connection problem and eventually triggers the destructor.
+	 * In the second case the destructor is already called, and it is waiting for
+	 * our signal which we will send once the last socket is done. Only then the
+	 * packets will be removed by the destructor.
+	 * @param cs The socket that does not need the savegame anymore.
 	 */
-	void Destroy()
+	void Destroy(ServerNetworkGameSocketHandler *cs)
 	{
 		std::unique_lock<std::mutex> lock(this->mutex);
 
-		this->cs = nullptr;
+		this->receivers.erase(cs);
+		/* Other clients are still receiving the savegame. */
+		if (!this->receivers.empty()) return;
 
 		this->exit_sig.notify_all();
 		lock.unlock();
@@ -113,57 +125,66 @@ struct PacketWriter : SaveFilter {
 	}
 
 	/**
-	 * Transfer all packets from here to the network's queue while holding
-	 * the lock on our mutex.
+	 * Transfer all packets that have not been sent yet from here to the
+	 * network's queue while holding the lock on our mutex.
 	 * @param socket The network socket to write to.
 	 * @return True iff the last packet of the map has been sent.
 	 */
 	bool TransferToNetworkQueue(ServerNetworkGameSocketHandler *socket)
 	{
-		/* Unsafe check for the queue being empty or not. */
-		if (this->packets == nullptr) return false;
-
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		while (this->packets != nullptr) {
-			Packet *p = Packet::PopFromQueue(&this->packets);
-			bool last_packet = p->GetPacketType() == PACKET_SERVER_MAP_DONE;
+		Receiver &receiver = this->receivers.at(socket);
+
+		/* Fast-track the size to the client. */
+		if (this->finished && !receiver.size_sent) {
+			Packet *p = new Packet(PACKET_SERVER_MAP_SIZE);
+			p->Send_uint32((uint32)this->total_size);
 			socket->SendPacket(p);
+			receiver.size_sent = true;
+		}
 
-			if (last_packet) return true;
+		bool last_packet = false;
+		while (!last_packet && receiver.next_packet < this->packets.size()) {
+			const Packet *p = this->packets[receiver.next_packet++];
+			last_packet = p->GetPacketType() == PACKET_SERVER_MAP_DONE;
+			/* The socket takes ownership of the packet it sends, and every socket needs its own. */
+			socket->SendPacket(new Packet(*p));
 		}
 
-		return false;
+		this->FreeSentPackets();
+		return last_packet;
 	}
 
-	/** Append the current packet to the queue. */
-	void AppendQueue()
+	/** Free the packets that have been transferred to all the sockets. */
+	void FreeSentPackets()
 	{
-		if (this->current == nullptr) return;
+		size_t sent = this->packets.size();
+		for (const auto &it : this->receivers) sent = std::min(sent, it.second.next_packet);
 
-		Packet::AddToQueue(&this->packets, this->current);
-		this->current = nullptr;
+		for (; this->freed_packets < sent; this->freed_packets++) {
+			delete this->packets[this->freed_packets];
+			this->packets[this->freed_packets] = nullptr;
+		}
 	}
 
-	/** Prepend the current packet to the queue. */
-	void PrependQueue()
+	/** Append the current packet to the queue. */
+	void AppendQueue()
 	{
 		if (this->current == nullptr) return;
 
-		/* Reversed from AppendQueue so the queue gets added to the current one. */
-		Packet::AddToQueue(&this->current, this->packets);
-		this->packets = this->current;
+		this->packets.push_back(this->current);
 		this->current = nullptr;
 	}
 
 	void Write(byte *buf, size_t size) override
 	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+		std::lock_guard<std::mutex> lock(this->mutex);
 
-		if (this->current == nullptr) this->current = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
+		/* We want to abort the saving when all sockets are closed. */
+		if (this->receivers.empty()) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
-		std::lock_guard<std::mutex> lock(this->mutex);
+		if (this->current == nullptr) this->current = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
 
 		byte *bufe = buf + size;
 		while (buf != bufe) {
@@ -181,11 +202,11 @@ struct PacketWriter : SaveFilter {
 
 	void Finish() override
 	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
 		std::lock_guard<std::mutex> lock(this->mutex);
 
+		/* We want to abort the saving when all sockets are closed. */
+		if (this->receivers.empty()) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+
 		/* Make sure the last packet is flushed. */
 		this->AppendQueue();
 
@@ -193,10 +214,7 @@ struct PacketWriter : SaveFilter {
 		this->current = new Packet(PACKET_SERVER_MAP_DONE);
 		this->AppendQueue();
 
-		/* Fast-track the size to the client. */
-		this->current = new Packet(PACKET_SERVER_MAP_SIZE);
-		this->current->Send_uint32((uint32)this->total_size);
-		this->PrependQueue();
+		this->finished = true;
 	}
 };
 
@@ -210,6 +228,7 @@ ServerNetworkGameSocketHandler::ServerNetworkGameSocketHandler(SOCKET s) : Netwo
 	this->status = STATUS_INACTIVE;
 	this->client_id = _network_client_id++;
 	this->receive_limit = _settings_client.network.bytes_per_frame_burst;
+	this->command_time = std::chrono::microseconds::zero();
 
 	/* The Socket and Info pools need to be the same in size. After all,
 	 * each Socket will be associated with at most one Info object. As
@@ -226,7 +245,7 @@ ServerNetworkGameSocketHandler::~ServerNetworkGameSocketHandler()
 	OrderBackup::ResetUser(this->client_id);
 
 	if (this->savegame != nullptr) {
-		this->savegame->Destroy();
+		this->savegame->Destroy(this);
 		this->savegame = nullptr;
 	}
 }
@@ -274,7 +293,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::CloseConnection(NetworkRecvSta
 	 * process and queue the next client to receive the map. */
 	if (this->status == STATUS_MAP) {
 		/* Ensure the saving of the game is stopped too. */
-		this->savegame->Destroy();
+		this->savegame->Destroy(this);
 		this->savegame = nullptr;
 
 		this->CheckNextClientToSendMap(this);
@@ -354,10 +373,18 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendClientInfo(NetworkClientIn
 /** Send the client information about the server. */
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendGameInfo()
 {
-	Packet *p = new Packet(PACKET_SERVER_GAME_INFO, TCP_MTU);
-	SerializeNetworkGameInfo(p, GetCurrentNetworkServerGameInfo());
+	/* Server listings query this a lot, so only serialise the game info again when it changed. */
+	static std::unique_ptr<Packet> cached;
+	static NetworkServerGameInfoKey cached_key;
 
-	this->SendPacket(p);
+	NetworkServerGameInfoKey key = GetCurrentNetworkServerGameInfoKey();
+	if (cached == nullptr || key != cached_key) {
+		cached.reset(new Packet(PACKET_SERVER_GAME_INFO, TCP_MTU));
+		SerializeNetworkGameInfo(cached.get(), GetCurrentNetworkServerGameInfo());
+		cached_key = key;
+	}
+
+	this->SendPacket(new Packet(*cached));
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -574,6 +601,9 @@ void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocke
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
 		if (ignore_cs == new_cs) continue;
 
+		/* Others are still receiving the same savegame; the waiting clients have to wait for the next one. */
+		if (new_cs->status == STATUS_MAP) return;
+
 		if (new_cs->status == STATUS_MAP_WAIT) {
 			if (best == nullptr || best->GetInfo()->join_date > new_cs->GetInfo()->join_date || (best->GetInfo()->join_date == new_cs->GetInfo()->join_date && best->client_id > new_cs->client_id)) {
 				best = new_cs;
@@ -581,16 +611,10 @@ void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocke
 		}
 	}
 
-	/* Is there someone else to join? */
+	/* Is there someone else to join? Let the first start joining, the others join along. */
 	if (best != nullptr) {
-		/* Let the first start joining. */
 		best->status = STATUS_AUTHORIZED;
 		best->SendMap();
-
-		/* And update the rest. */
-		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-			if (new_cs->status == STATUS_MAP_WAIT) new_cs->SendWait();
-		}
 	}
 }
 
@@ -603,28 +627,39 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 	}
 
 	if (this->status == STATUS_AUTHORIZED) {
-		this->savegame = new PacketWriter(this);
+		/* All clients that are waiting for the map receive the same savegame, so it only has to be made once. */
+		std::vector<NetworkClientSocket *> receivers = { this };
+		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
+			if (new_cs->status == STATUS_MAP_WAIT) receivers.push_back(new_cs);
+		}
 
-		/* Now send the _frame_counter and how many packets are coming */
-		Packet *p = new Packet(PACKET_SERVER_MAP_BEGIN);
-		p->Send_uint32(_frame_counter);
-		this->SendPacket(p);
+		PacketWriter *savegame = new PacketWriter(receivers);
+		for (NetworkClientSocket *cs : receivers) {
+			cs->savegame = savegame;
 
-		NetworkSyncCommandQueue(this);
-		this->status = STATUS_MAP;
-		/* Mark the start of download */
-		this->last_frame = _frame_counter;
-		this->last_frame_server = _frame_counter;
+			/* Now send the _frame_counter and how many packets are coming */
+			Packet *p = new Packet(PACKET_SERVER_MAP_BEGIN);
+			p->Send_uint32(_frame_counter);
+			cs->SendPacket(p);
+
+			NetworkSyncCommandQueue(cs);
+			cs->status = STATUS_MAP;
+			/* Mark the start of download */
+			cs->last_frame = _frame_counter;
+			cs->last_frame_server = _frame_counter;
+		}
 
 		/* Make a dump of the current game */
-		if (SaveWithFilter(this->savegame, true) != SL_OK) usererror("network savedump failed");
+		/* Joining clients wait for the map, so the server may compress it quicker than the games saved by the user. */
+		const std::string &format = _network_map_format.empty() ? _savegame_format : _network_map_format;
+		if (SaveWithFilter(savegame, true, format) != SL_OK) usererror("network savedump failed");
 	}
 
 	if (this->status == STATUS_MAP) {
 		bool last_packet = this->savegame->TransferToNetworkQueue(this);
 		if (last_packet) {
 			/* Done reading, make sure saving is done as well */
-			this->savegame->Destroy();
+			this->savegame->Destroy(this);
 			this->savegame = nullptr;
 
 			/* Set the status to DONE_MAP, no we will wait for the client
@@ -684,23 +719,40 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendSync()
 #ifdef NETWORK_SEND_DOUBLE_SEED
 	p->Send_uint32(_sync_seed_2);
 #endif
+
+	p->Send_uint8(_sync_map_slice);
+	for (uint i = 0; i < NSH_END; i++) p->Send_uint32(_sync_hashes[i]);
+
 	this->SendPacket(p);
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/** Calculate the hashes of the game state for the sync packets of the current frame; each time for the next slice of the map. */
+static void UpdateSyncHashes()
+{
+	_sync_map_slice = (_sync_map_slice + 1) % NETWORK_SYNC_MAP_SLICES;
+	NetworkCalculateSyncHashes(_sync_map_slice, _sync_hashes);
+}
+
 /**
  * Send a command to the client to execute.
  * @param cp The command to send.
  */
-NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommand(const CommandPacket *cp)
+/* static */ Packet *ServerNetworkGameSocketHandler::CreateCommandPacket(const CommandPacket *cp)
 {
 	Packet *p = new Packet(PACKET_SERVER_COMMAND);
 
-	this->NetworkGameSocketHandler::SendCommand(p, cp);
+	NetworkGameSocketHandler::SendCommand(p, cp);
 	p->Send_uint32(cp->frame);
 	p->Send_bool  (cp->my_cmd);
 
-	this->SendPacket(p);
+	return p;
+}
+
+NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommand(const CommandPacket *cp)
+{
+	/* The socket takes ownership of the packet it sends, so shared packets are copied. */
+	this->SendPacket(cp->encoded != nullptr ? new Packet(*cp->encoded) : CreateCommandPacket(cp));
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
@@ -1014,6 +1066,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_MAP_OK(Packet *
 		this->status = STATUS_PRE_ACTIVE;
 		NetworkHandleCommandQueue(this);
 		this->SendFrame();
+		UpdateSyncHashes();
 		this->SendSync();
 
 		/* This is the frame the client receives
@@ -1198,6 +1251,8 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_ACK(Packet *p)
 		this->last_token = 0;
 	}
 
+	this->lag_stats.Add(_frame_counter > frame ? _frame_counter - frame : 0, this->GetSendQueueLength());
+
 	/* The client received the frame, make note of it */
 	this->last_frame = frame;
 	/* With those 2 values we can calculate the lag realtime */
@@ -1760,6 +1815,7 @@ void NetworkServer_Tick(bool send_frame)
 	if (_frame_counter >= _last_sync_frame + _settings_client.network.sync_freq) {
 		_last_sync_frame = _frame_counter;
 		send_sync = true;
+		UpdateSyncHashes();
 	}
 #endif
 
@@ -1943,6 +1999,64 @@ void NetworkServerShowStatusToConsole()
 	}
 }
 
+/**
+ * Account for an acknowledgement of a frame by the client.
+ * @param lag The number of frames the client is behind the server.
+ * @param send_queue The number of packets waiting to be sent to the client.
+ */
+void NetworkClientLagStats::Add(uint32 lag, size_t send_queue)
+{
+	/* Like the interarrival jitter of RTP: move 1/16th towards the latest difference. */
+	uint32 difference = this->acks == 0 ? 0 : Delta(lag, this->last_lag);
+	this->jitter = this->jitter - (this->jitter + 8) / 16 + difference;
+
+	uint bucket = 0;
+	while (bucket < HISTOGRAM_SIZE - 1 && lag >= (8U << bucket)) bucket++;
+	this->histogram[bucket]++;
+
+	this->acks++;
+	this->last_lag = lag;
+	this->max_lag = std::max(this->max_lag, lag);
+	this->max_send_queue = std::max(this->max_send_queue, send_queue);
+}
+
+/** Show the lag statistics of all clients on the console. */
+void NetworkServerShowLagToConsole()
+{
+	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
+		const NetworkClientLagStats &stats = cs->lag_stats;
+		if (stats.acks == 0) continue;
+
+		std::string histogram;
+		for (uint i = 0; i < NetworkClientLagStats::HISTOGRAM_SIZE; i++) {
+			if (i != 0) histogram += " ";
+			histogram += std::to_string(stats.histogram[i]);
+		}
+
+		IConsolePrint(CC_INFO, "Client #{}  lag: {}  max-lag: {}  jitter: {:.1f}  send-queue: {}  max-send-queue: {}  lag-histogram: {}",
+			cs->client_id, stats.last_lag, stats.max_lag, stats.jitter / 16.0, cs->GetSendQueueLength(), stats.max_send_queue, histogram);
+	}
+}
+
+/** Show the traffic per packet type and per client on the console. */
+void NetworkServerShowTrafficToConsole()
+{
+	for (uint type = 0; type < PACKET_END; type++) {
+		const NetworkPacketStats &recv = _network_game_received_stats[type];
+		const NetworkPacketStats &sent = _network_game_sent_stats[type];
+		if (recv.packets == 0 && sent.packets == 0) continue;
+
+		IConsolePrint(CC_INFO, "Packet type {:2d}  received: {} packets, {} bytes, {} ms  sent: {} packets, {} bytes",
+			type, recv.packets, recv.bytes, recv.time.count() / 1000, sent.packets, sent.bytes);
+	}
+
+	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
+		IConsolePrint(CC_INFO, "Client #{}  received: {} packets, {} bytes, {} ms  sent: {} packets, {} bytes",
+			cs->client_id, cs->received_stats.packets, cs->received_stats.bytes, cs->received_stats.time.count() / 1000,
+			cs->sent_stats.packets, cs->sent_stats.bytes);
+	}
+}
+
 /**
  * Send Config Update
  */
@@ -20,6 +20,20 @@ typedef ServerNetworkGameSocketHandler NetworkClientSocket;
 typedef Pool<NetworkClientSocket, ClientIndex, 8, MAX_CLIENT_SLOTS, PT_NCLIENT> NetworkClientSocketPool;
 extern NetworkClientSocketPool _networkclientsocket_pool;
 
+/** Statistics of the lag of a client, as seen from its acknowledgements of frames. */
+struct NetworkClientLagStats {
+	static const uint HISTOGRAM_SIZE = 7; ///< Number of buckets of the histogram; the first is for less than 8 frames, each next one doubles that.
+
+	uint32 acks = 0;                      ///< The number of acknowledgements.
+	uint32 last_lag = 0;                  ///< The lag, in frames, of the last acknowledgement.
+	uint32 max_lag = 0;                   ///< The highest lag, in frames, of any acknowledgement.
+	uint32 jitter = 0;                    ///< Smoothed difference between the lag of consecutive acknowledgements, in 1/16 frames.
+	uint32 histogram[HISTOGRAM_SIZE] = {}; ///< The number of acknowledgements per lag bucket.
+	size_t max_send_queue = 0;            ///< The longest send queue, in packets, when an acknowledgement was received.
+
+	void Add(uint32 lag, size_t send_queue);
+};
+
 /** Class for handling the server side of the game connection. */
 class ServerNetworkGameSocketHandler : public NetworkClientSocketPool::PoolItem<&_networkclientsocket_pool>, public NetworkGameSocketHandler, public TCPListenHandler<ServerNetworkGameSocketHandler, PACKET_SERVER_FULL, PACKET_SERVER_BANNED> {
 protected:
@@ -70,6 +84,8 @@ public:
 	ClientStatus status;         ///< Status of this client
 	CommandQueue outgoing_queue; ///< The command-queue awaiting delivery
 	size_t receive_limit;        ///< Amount of bytes that we can receive at this moment
+	NetworkClientLagStats lag_stats; ///< Statistics of the lag of this client
+	std::chrono::microseconds command_time; ///< Execution time of the commands of this client that is not yet covered by #NetworkSettings::max_command_time
 
 	struct PacketWriter *savegame; ///< Writer used to write the savegame.
 	NetworkAddress client_address; ///< IP-address of the client (so they can be banned)
@@ -98,6 +114,7 @@ public:
 	NetworkRecvStatus SendJoin(ClientID client_id);
 	NetworkRecvStatus SendFrame();
 	NetworkRecvStatus SendSync();
+	static Packet *CreateCommandPacket(const CommandPacket *cp);
 	NetworkRecvStatus SendCommand(const CommandPacket *cp);
 	NetworkRecvStatus SendCompanyUpdate();
 	NetworkRecvStatus SendConfigUpdate();
@@ -8946,6 +8946,8 @@ static void FinaliseEngineArray()
 			}
 		}
 
+		e->static_sprites = EngineHasStaticSprites(e);
+
 		if (!HasBit(e->info.climates, _settings_game.game_creation.landscape)) continue;
 
 		/* When the train does not set property 27 (misc flags), but it
@@ -9835,7 +9837,8 @@ void LoadNewGRF(uint load_index, uint num_baseset)
 			if (stage > GLS_INIT && HasBit(c->flags, GCF_INIT_ONLY)) continue;
 
 			Subdirectory subdir = num_grfs < num_baseset ? BASESET_DIR : NEWGRF_DIR;
-			if (!FioCheckFileExists(c->filename, subdir)) {
+			/* Once loaded in the first stage, the file is kept open in the sprite file cache. */
+			if (stage == GLS_LABELSCAN && !FioCheckFileExists(c->filename, subdir)) {
 				Debug(grf, 0, "NewGRF file is missing '{}'; disabling", c->filename);
 				c->status = GCS_NOT_FOUND;
 				continue;
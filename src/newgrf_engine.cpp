@@ -24,6 +24,8 @@
 #include "newgrf_roadtype.h"
 #include "ship.h"
 
+#include <set>
+
 #include "safeguards.h"
 
 void SetWagonOverrideSprites(EngineID engine, CargoID cargo, const SpriteGroup *group, EngineID *train_id, uint trains)
@@ -1389,3 +1391,81 @@ void FillNewGRFVehicleCache(const Vehicle *v)
 	/* Make sure really all bits are set. */
 	assert(v->grf_cache.cache_valid == (1 << NCVV_END) - 1);
 }
+
+/**
+ * Check whether resolving a vehicle sprite group only depends on the callback
+ * parameters and the cargo and loading state of the vehicle, i.e. whether it
+ * gives the same result for as long as those do not change.
+ * @param group The group to check.
+ * @param seen The groups that were checked already.
+ * @return True iff the result of the group depends on nothing else.
+ */
+static bool IsStaticVehicleSpriteGroup(const SpriteGroup *group, std::set<const SpriteGroup *> &seen)
+{
+	if (group == nullptr || !seen.insert(group).second) return true;
+
+	switch (group->type) {
+		case SGT_REAL: {
+			const RealSpriteGroup *real = (const RealSpriteGroup *)group;
+			for (const SpriteGroup *g : real->loaded) {
+				if (!IsStaticVehicleSpriteGroup(g, seen)) return false;
+			}
+			for (const SpriteGroup *g : real->loading) {
+				if (!IsStaticVehicleSpriteGroup(g, seen)) return false;
+			}
+			return true;
+		}
+
+		case SGT_DETERMINISTIC: {
+			const DeterministicSpriteGroup *det = (const DeterministicSpriteGroup *)group;
+			for (const auto &adjust : det->adjusts) {
+				if (adjust.operation == DSGA_OP_STOP) return false;
+
+				if (adjust.variable == 0x7E) {
+					if (!IsStaticVehicleSpriteGroup(adjust.subroutine, seen)) return false;
+					continue;
+				}
+
+				/* Only callback parameters, temporary storage and NewGRF parameters are allowed. */
+				switch (adjust.variable == 0x7B ? adjust.parameter : adjust.variable) {
+					case 0x0C: case 0x10: case 0x18: case 0x1A: case 0x1C: case 0x7D: case 0x7F:
+						break;
+
+					default:
+						return false;
+				}
+			}
+			for (const auto &range : det->ranges) {
+				if (!IsStaticVehicleSpriteGroup(range.group, seen)) return false;
+			}
+			return IsStaticVehicleSpriteGroup(det->default_group, seen) && IsStaticVehicleSpriteGroup(det->error_group, seen);
+		}
+
+		case SGT_CALLBACK:
+		case SGT_RESULT:
+			return true;
+
+		default:
+			/* Random groups and anything unexpected. */
+			return false;
+	}
+}
+
+/**
+ * Check whether the sprites of vehicles of an engine only depend on their direction,
+ * cargo, loading state and the engine at the front of the consist, so they only have
+ * to be resolved again when one of those changes.
+ * @param e The engine to check.
+ * @return True iff the sprites of the engine are static.
+ */
+bool EngineHasStaticSprites(const Engine *e)
+{
+	std::set<const SpriteGroup *> seen;
+	for (const SpriteGroup *group : e->grf_prop.spritegroup) {
+		if (!IsStaticVehicleSpriteGroup(group, seen)) return false;
+	}
+	for (const WagonOverride &wo : e->overrides) {
+		if (!IsStaticVehicleSpriteGroup(wo.group, seen)) return false;
+	}
+	return true;
+}
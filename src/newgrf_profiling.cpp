@@ -16,6 +16,8 @@
 #include "walltime_func.h"
 
 #include <chrono>
+#include <map>
+#include <tuple>
 
 
 std::vector<NewGRFProfiler> _newgrf_profilers;
@@ -158,3 +160,93 @@ uint32 NewGRFProfiler::FinishAll()
 
 	return total_microseconds;
 }
+
+
+uint NewGRFSampler::interval = 0;
+uint NewGRFSampler::countdown = 0;
+bool NewGRFSampler::busy = false;
+
+/** Start time of the sampled resolve in progress (nanoseconds). */
+static uint64 _newgrf_sample_start;
+/** Aggregated measurements, keyed by GRF ID, feature and callback. */
+static std::map<std::tuple<uint32, GrfSpecFeature, CallbackID>, NewGRFSampler::Stats> _newgrf_samples;
+
+/**
+ * Get the current time for measuring samples.
+ * @return Time in nanoseconds.
+ */
+static uint64 GetSampleTime()
+{
+	using namespace std::chrono;
+	return (uint64)time_point_cast<nanoseconds>(high_resolution_clock::now()).time_since_epoch().count();
+}
+
+/**
+ * Capture the start of a sampled sprite group resolution.
+ */
+void NewGRFSampler::BeginSample()
+{
+	NewGRFSampler::busy = true;
+	_newgrf_sample_start = GetSampleTime();
+}
+
+/**
+ * Capture the completion of a sampled sprite group resolution.
+ * @param resolver Data about sprite group that has been resolved.
+ */
+void NewGRFSampler::EndSample(const ResolverObject &resolver)
+{
+	uint64 time = GetSampleTime() - _newgrf_sample_start;
+
+	uint32 grfid = resolver.grffile != nullptr ? resolver.grffile->grfid : 0;
+	GrfSpecFeature feat = resolver.GetFeature();
+	auto it = _newgrf_samples.try_emplace(std::make_tuple(grfid, feat, resolver.callback), Stats{ grfid, feat, resolver.callback, 0, 0 }).first;
+	it->second.samples++;
+	it->second.time += time;
+
+	NewGRFSampler::busy = false;
+	NewGRFSampler::countdown = NewGRFSampler::interval;
+}
+
+/**
+ * Start sampling with a new interval, discarding the samples collected so far.
+ * @param interval Sample one in this many top-level resolves, 0 to stop sampling and keep the samples.
+ */
+void NewGRFSampler::Start(uint interval)
+{
+	if (interval != 0) _newgrf_samples.clear();
+	NewGRFSampler::interval = interval;
+	NewGRFSampler::countdown = interval;
+}
+
+/**
+ * Print the NewGRF callbacks that took most time according to the samples.
+ * @param count Number of lines to print.
+ */
+void NewGRFSampler::ShowTop(uint count)
+{
+	if (_newgrf_samples.empty()) {
+		IConsolePrint(CC_INFO, "No NewGRF resolves have been sampled.");
+		return;
+	}
+
+	std::vector<const Stats *> stats;
+	uint64 total_time = 0;
+	for (const auto &it : _newgrf_samples) {
+		stats.push_back(&it.second);
+		total_time += it.second.time;
+	}
+	std::sort(stats.begin(), stats.end(), [](const Stats *a, const Stats *b) { return a->time > b->time; });
+
+	extern const std::vector<GRFFile *> &GetAllGRFFiles();
+	const std::vector<GRFFile *> &files = GetAllGRFFiles();
+
+	IConsolePrint(CC_INFO, "Sampled NewGRF resolves taking most time:");
+	for (uint i = 0; i < count && i < stats.size(); i++) {
+		const Stats *s = stats[i];
+		auto grf = std::find_if(files.begin(), files.end(), [&](const GRFFile *f) { return f->grfid == s->grfid; });
+		IConsolePrint(CC_INFO, "{:5.1f}%  [{:08X}] {}  feature 0x{:02X}  callback 0x{:X}: {} samples, {:.1f} us average",
+				100.0 * s->time / std::max<uint64>(total_time, 1), BSWAP32(s->grfid), grf != files.end() ? (*grf)->filename : "?",
+				(uint)s->feat, (uint)s->cb, s->samples, s->time / 1000.0 / s->samples);
+	}
+}
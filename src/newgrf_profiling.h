@@ -57,6 +57,41 @@ struct NewGRFProfiler {
 	std::vector<Call> calls; ///< All calls collected so far
 };
 
+/**
+ * Sampling profiler of the resolves of all NewGRFs. Only one in a number of top-level
+ * resolves is measured, and the measurements are aggregated per NewGRF, feature and
+ * callback, so it has little overhead and can keep running on a server.
+ */
+struct NewGRFSampler {
+	/** Aggregated measurements of one NewGRF, feature and callback. */
+	struct Stats {
+		uint32 grfid;        ///< GRF ID of the NewGRF.
+		GrfSpecFeature feat; ///< GRF feature being resolved for.
+		CallbackID cb;       ///< Callback ID.
+		uint32 samples;      ///< Number of sampled resolves.
+		uint64 time;         ///< Total time of the sampled resolves (nanoseconds).
+	};
+
+	static uint interval;  ///< Sample one in this many top-level resolves, or 0 when not sampling.
+	static uint countdown; ///< Number of top-level resolves until the next sample.
+	static bool busy;      ///< Whether a sampled resolve is in progress; nested resolves are part of that sample.
+
+	/**
+	 * Check whether the upcoming top-level resolve has to be sampled.
+	 * @return True to sample the resolve.
+	 */
+	static inline bool ShouldSample()
+	{
+		return interval != 0 && !busy && --countdown == 0;
+	}
+
+	static void BeginSample();
+	static void EndSample(const ResolverObject &resolver);
+
+	static void Start(uint interval);
+	static void ShowTop(uint count);
+};
+
 extern std::vector<NewGRFProfiler> _newgrf_profilers;
 extern Date _newgrf_profile_end_date;
 
@@ -39,7 +39,15 @@ TemporaryStorageArray<int32, 0x110> _temp_store;
 	auto profiler = std::find_if(_newgrf_profilers.begin(), _newgrf_profilers.end(), [&](const NewGRFProfiler &pr) { return pr.grffile == grf; });
 
 	if (profiler == _newgrf_profilers.end() || !profiler->active) {
-		if (top_level) _temp_store.ClearChanges();
+		if (top_level) {
+			_temp_store.ClearChanges();
+			if (NewGRFSampler::ShouldSample()) {
+				NewGRFSampler::BeginSample();
+				const SpriteGroup *result = group->Resolve(object);
+				NewGRFSampler::EndSample(object);
+				return result;
+			}
+		}
 		return group->Resolve(object);
 	} else if (top_level) {
 		profiler->BeginResolve(object);
@@ -184,21 +192,23 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 }
 
 
-static bool RangeHighComparator(const DeterministicSpriteGroupRange& range, uint32 value)
-{
-	return range.high < value;
-}
-
-const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+/**
+ * Evaluate the adjustment chain of a deterministic sprite group for variables of the given size.
+ * Selecting the size once for the whole chain keeps it out of the loop over the adjustments.
+ * U is the unsigned type and S is the signed type to use.
+ * @param adjusts The adjustment chain.
+ * @param object Object we are resolving for.
+ * @param scope Scope of the variables.
+ * @param[in,out] last_value Result of the adjustments so far.
+ * @return False if one of the variables is not available, true otherwise.
+ */
+template <typename U, typename S>
+static bool EvalAdjustsT(const std::vector<DeterministicSpriteGroupAdjust> &adjusts, ResolverObject &object, ScopeResolver *scope, uint32 &last_value)
 {
-	uint32 last_value = 0;
-	uint32 value = 0;
-
-	ScopeResolver *scope = object.GetScope(this->var_scope);
-
-	for (const auto &adjust : this->adjusts) {
+	for (const auto &adjust : adjusts) {
 		/* Try to get the variable. We shall assume it is available, unless told otherwise. */
 		bool available = true;
+		uint32 value;
 		if (adjust.variable == 0x7E) {
 			const SpriteGroup *subgroup = SpriteGroup::Resolve(adjust.subroutine, object, false);
 			if (subgroup == nullptr) {
@@ -214,22 +224,41 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 			value = GetVariable(object, scope, adjust.variable, adjust.parameter, &available);
 		}
 
-		if (!available) {
-			/* Unsupported variable: skip further processing and return either
-			 * the group from the first range or the default group. */
-			return SpriteGroup::Resolve(this->error_group, object, false);
-		}
+		/* Unsupported variable: skip further processing. */
+		if (!available) return false;
 
-		switch (this->size) {
-			case DSG_SIZE_BYTE:  value = EvalAdjustT<uint8,  int8> (adjust, scope, last_value, value); break;
-			case DSG_SIZE_WORD:  value = EvalAdjustT<uint16, int16>(adjust, scope, last_value, value); break;
-			case DSG_SIZE_DWORD: value = EvalAdjustT<uint32, int32>(adjust, scope, last_value, value); break;
-			default: NOT_REACHED();
-		}
-		last_value = value;
+		last_value = EvalAdjustT<U, S>(adjust, scope, last_value, value);
+	}
+	return true;
+}
+
+
+static bool RangeHighComparator(const DeterministicSpriteGroupRange& range, uint32 value)
+{
+	return range.high < value;
+}
+
+const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+{
+	uint32 last_value = 0;
+
+	ScopeResolver *scope = object.GetScope(this->var_scope);
+
+	bool available;
+	switch (this->size) {
+		case DSG_SIZE_BYTE:  available = EvalAdjustsT<uint8,  int8> (this->adjusts, object, scope, last_value); break;
+		case DSG_SIZE_WORD:  available = EvalAdjustsT<uint16, int16>(this->adjusts, object, scope, last_value); break;
+		case DSG_SIZE_DWORD: available = EvalAdjustsT<uint32, int32>(this->adjusts, object, scope, last_value); break;
+		default: NOT_REACHED();
+	}
+
+	if (!available) {
+		/* Unsupported variable: return either the group from the first range or the default group. */
+		return SpriteGroup::Resolve(this->error_group, object, false);
 	}
 
 	object.last_value = last_value;
+	uint32 value = last_value;
 
 	if (this->calculated_result) {
 		/* nvar == 0 is a special case -- we turn our value into a callback result */
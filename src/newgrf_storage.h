@@ -12,6 +12,8 @@
 
 #include "core/pool_type.hpp"
 #include "tile_type.h"
+#include <bitset>
+#include <vector>
 
 /**
  * Mode switches to the behaviour of persistent storage array.
@@ -65,20 +67,15 @@ private:
 template <typename TYPE, uint SIZE>
 struct PersistentStorageArray : BasePersistentStorageArray {
 	TYPE storage[SIZE]; ///< Memory to for the storage array
-	TYPE *prev_storage; ///< Memory to store "old" states so we can revert them on the performance of test cases for commands etc.
+	std::vector<std::pair<uint16, TYPE>> prev_values; ///< Original values of the slots changed temporarily, so we can revert them on the performance of test cases for commands etc.
+	std::bitset<SIZE> prev_saved; ///< Slots of which the original value is in #prev_values.
 
 	/** Simply construct the array */
-	PersistentStorageArray() : prev_storage(nullptr)
+	PersistentStorageArray()
 	{
 		memset(this->storage, 0, sizeof(this->storage));
 	}
 
-	/** And free all data related to it */
-	~PersistentStorageArray()
-	{
-		free(this->prev_storage);
-	}
-
 	/** Resets all values to zero. */
 	void ResetToZero()
 	{
@@ -87,8 +84,8 @@ struct PersistentStorageArray : BasePersistentStorageArray {
 
 	/**
 	 * Stores some value at a given position.
-	 * If there is no backup of the data that backup is made and then
-	 * we write the data.
+	 * If the change is temporary and the original value of the slot
+	 * has not been saved yet, that is done before writing the data.
 	 * @param pos   the position to write at
 	 * @param value the value to write
 	 */
@@ -101,16 +98,16 @@ struct PersistentStorageArray : BasePersistentStorageArray {
 		 * Saves a few cycles and such and it's pretty easy to check. */
 		if (this->storage[pos] == value) return;
 
-		/* We do not have made a backup; lets do so */
+		/* Save the original value of only this slot, if not done yet */
 		if (AreChangesPersistent()) {
-			assert(this->prev_storage == nullptr);
-		} else if (this->prev_storage == nullptr) {
-			this->prev_storage = MallocT<TYPE>(SIZE);
-			memcpy(this->prev_storage, this->storage, sizeof(this->storage));
-
-			/* We only need to register ourselves when we made the backup
-			 * as that is the only time something will have changed */
-			AddChangedPersistentStorage(this);
+			assert(this->prev_values.empty());
+		} else if (!this->prev_saved.test(pos)) {
+			/* We only need to register ourselves when we save the first
+			 * slot as that is the only time something will have changed */
+			if (this->prev_values.empty()) AddChangedPersistentStorage(this);
+
+			this->prev_values.emplace_back(pos, this->storage[pos]);
+			this->prev_saved.set(pos);
 		}
 
 		this->storage[pos] = value;
@@ -131,11 +128,11 @@ struct PersistentStorageArray : BasePersistentStorageArray {
 
 	void ClearChanges()
 	{
-		if (this->prev_storage != nullptr) {
-			memcpy(this->storage, this->prev_storage, sizeof(this->storage));
-			free(this->prev_storage);
-			this->prev_storage = nullptr;
+		for (const auto &prev : this->prev_values) {
+			this->storage[prev.first] = prev.second;
 		}
+		this->prev_values.clear();
+		this->prev_saved.reset();
 	}
 };
 
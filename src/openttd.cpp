@@ -70,6 +70,7 @@
 
 #include <stdarg.h>
 #include <system_error>
+#include <chrono>
 
 #include "safeguards.h"
 
@@ -91,6 +92,7 @@ extern void ShowOSErrorBox(const char *buf, bool system);
 extern std::string _config_file;
 
 bool _save_config = false;
+bool _simulation_only = false; ///< Only run the simulation; skip everything that is only needed to show the game to the user.
 bool _request_newgrf_scan = false;
 NewGRFScanCallback *_request_newgrf_scan_callback = nullptr;
 
@@ -1113,18 +1115,13 @@ void SwitchToMode(SwitchMode new_mode)
 
 
 /**
- * Check the validity of some of the caches.
- * Especially in the sense of desyncs between
- * the cached value and what the value would
- * be when calculated from the 'base' data.
+ * Check the town caches and the caches derived from them.
+ * @return True iff a mismatch was found.
  */
-static void CheckCaches()
+static bool CheckTownCaches()
 {
-	/* Return here so it is easy to add checks that are run
-	 * always to aid testing of caches. */
-	if (_debug_desync_level <= 1) return;
+	bool mismatch = false;
 
-	/* Check the town caches. */
 	std::vector<TownCache> old_town_caches;
 	for (const Town *t : Town::Iterate()) {
 		old_town_caches.push_back(t->cache);
@@ -1138,26 +1135,43 @@ static void CheckCaches()
 	for (Town *t : Town::Iterate()) {
 		if (MemCmpT(old_town_caches.data() + i, &t->cache) != 0) {
 			Debug(desync, 2, "town cache mismatch: town {}", t->index);
+			mismatch = true;
 		}
 		i++;
 	}
 
-	/* Check company infrastructure cache. */
+	return mismatch;
+}
+
+/**
+ * Check the company infrastructure caches.
+ * @return True iff a mismatch was found.
+ */
+static bool CheckInfrastructureCaches()
+{
+	bool mismatch = false;
+
 	std::vector<CompanyInfrastructure> old_infrastructure;
 	for (const Company *c : Company::Iterate()) old_infrastructure.push_back(c->infrastructure);
 
 	extern void AfterLoadCompanyStats();
 	AfterLoadCompanyStats();
 
-	i = 0;
+	uint i = 0;
 	for (const Company *c : Company::Iterate()) {
 		if (MemCmpT(old_infrastructure.data() + i, &c->infrastructure) != 0) {
 			Debug(desync, 2, "infrastructure cache mismatch: company {}", c->index);
+			mismatch = true;
 		}
 		i++;
 	}
 
-	/* Strict checking of the road stop cache entries */
+	return mismatch;
+}
+
+/** Strict checking of the road stop cache entries. */
+static void CheckRoadStopCaches()
+{
 	for (const RoadStop *rs : RoadStop::Iterate()) {
 		if (IsStandardRoadStopTile(rs->xy)) continue;
 
@@ -1165,88 +1179,157 @@ static void CheckCaches()
 		rs->GetEntry(DIAGDIR_NE)->CheckIntegrity(rs);
 		rs->GetEntry(DIAGDIR_NW)->CheckIntegrity(rs);
 	}
+}
 
-	for (Vehicle *v : Vehicle::Iterate()) {
-		extern void FillNewGRFVehicleCache(const Vehicle *v);
-		if (v != v->First() || v->vehstatus & VS_CRASHED || !v->IsPrimaryVehicle()) continue;
-
-		uint length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) length++;
-
-		NewGRFCache        *grf_cache = CallocT<NewGRFCache>(length);
-		VehicleCache       *veh_cache = CallocT<VehicleCache>(length);
-		GroundVehicleCache *gro_cache = CallocT<GroundVehicleCache>(length);
-		TrainCache         *tra_cache = CallocT<TrainCache>(length);
-
-		length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			grf_cache[length] = u->grf_cache;
-			veh_cache[length] = u->vcache;
-			switch (u->type) {
-				case VEH_TRAIN:
-					gro_cache[length] = Train::From(u)->gcache;
-					tra_cache[length] = Train::From(u)->tcache;
-					break;
-				case VEH_ROAD:
-					gro_cache[length] = RoadVehicle::From(u)->gcache;
-					break;
-				default:
-					break;
-			}
-			length++;
+/**
+ * Check the caches of a vehicle, and of its whole consist when it is the front of a primary vehicle.
+ * @param v The vehicle to check.
+ * @return True iff a mismatch was found.
+ */
+static bool CheckVehicleCaches(Vehicle *v)
+{
+	/* Check whether the cargo cache is still valid */
+	byte buff[sizeof(VehicleCargoList)];
+	memcpy(buff, &v->cargo, sizeof(VehicleCargoList));
+	v->cargo.InvalidateCache();
+	assert(memcmp(&v->cargo, buff, sizeof(VehicleCargoList)) == 0);
+
+	extern void FillNewGRFVehicleCache(const Vehicle *v);
+	if (v != v->First() || v->vehstatus & VS_CRASHED || !v->IsPrimaryVehicle()) return false;
+
+	bool mismatch = false;
+
+	uint length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) length++;
+
+	NewGRFCache        *grf_cache = CallocT<NewGRFCache>(length);
+	VehicleCache       *veh_cache = CallocT<VehicleCache>(length);
+	GroundVehicleCache *gro_cache = CallocT<GroundVehicleCache>(length);
+	TrainCache         *tra_cache = CallocT<TrainCache>(length);
+
+	length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		grf_cache[length] = u->grf_cache;
+		veh_cache[length] = u->vcache;
+		switch (u->type) {
+			case VEH_TRAIN:
+				gro_cache[length] = Train::From(u)->gcache;
+				tra_cache[length] = Train::From(u)->tcache;
+				break;
+			case VEH_ROAD:
+				gro_cache[length] = RoadVehicle::From(u)->gcache;
+				break;
+			default:
+				break;
 		}
+		length++;
+	}
 
-		switch (v->type) {
-			case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
-			case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
-			case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
-			case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
-			default: break;
-		}
+	switch (v->type) {
+		case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
+		case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
+		case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
+		case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
+		default: break;
+	}
 
-		length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			if (memcmp(&grf_cache[length], &u->grf_cache, sizeof(NewGRFCache)) != 0) {
-				Debug(desync, 2, "newgrf cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
-			}
-			if (memcmp(&veh_cache[length], &u->vcache, sizeof(VehicleCache)) != 0) {
-				Debug(desync, 2, "vehicle cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
-			}
-			switch (u->type) {
-				case VEH_TRAIN:
-					if (memcmp(&gro_cache[length], &Train::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
-						Debug(desync, 2, "train ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					if (memcmp(&tra_cache[length], &Train::From(u)->tcache, sizeof(TrainCache)) != 0) {
-						Debug(desync, 2, "train cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					break;
-				case VEH_ROAD:
-					if (memcmp(&gro_cache[length], &RoadVehicle::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
-						Debug(desync, 2, "road vehicle ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					break;
-				default:
-					break;
-			}
-			length++;
+	length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		if (memcmp(&grf_cache[length], &u->grf_cache, sizeof(NewGRFCache)) != 0) {
+			Debug(desync, 2, "newgrf cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
+			mismatch = true;
 		}
+		if (memcmp(&veh_cache[length], &u->vcache, sizeof(VehicleCache)) != 0) {
+			Debug(desync, 2, "vehicle cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
+			mismatch = true;
+		}
+		switch (u->type) {
+			case VEH_TRAIN:
+				if (memcmp(&gro_cache[length], &Train::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
+					Debug(desync, 2, "train ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
+					mismatch = true;
+				}
+				if (memcmp(&tra_cache[length], &Train::From(u)->tcache, sizeof(TrainCache)) != 0) {
+					Debug(desync, 2, "train cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
+					mismatch = true;
+				}
+				break;
+			case VEH_ROAD:
+				if (memcmp(&gro_cache[length], &RoadVehicle::From(u)->gcache, sizeof(GroundVehicleCache)) != 0) {
+					Debug(desync, 2, "road vehicle ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
+					mismatch = true;
+				}
+				break;
+			default:
+				break;
+		}
+		length++;
+	}
 
-		free(grf_cache);
-		free(veh_cache);
-		free(gro_cache);
-		free(tra_cache);
+	free(grf_cache);
+	free(veh_cache);
+	free(gro_cache);
+	free(tra_cache);
+
+	return mismatch;
+}
+
+/**
+ * Check the caches of a station.
+ * @param st The station to check.
+ * @return True iff a mismatch was found.
+ */
+static bool CheckStationCaches(Station *st)
+{
+	bool mismatch = false;
+
+	for (CargoID c = 0; c < NUM_CARGO; c++) {
+		byte buff[sizeof(StationCargoList)];
+		memcpy(buff, &st->goods[c].cargo, sizeof(StationCargoList));
+		st->goods[c].cargo.InvalidateCache();
+		assert(memcmp(&st->goods[c].cargo, buff, sizeof(StationCargoList)) == 0);
 	}
 
-	/* Check whether the caches are still valid */
-	for (Vehicle *v : Vehicle::Iterate()) {
-		byte buff[sizeof(VehicleCargoList)];
-		memcpy(buff, &v->cargo, sizeof(VehicleCargoList));
-		v->cargo.InvalidateCache();
-		assert(memcmp(&v->cargo, buff, sizeof(VehicleCargoList)) == 0);
+	/* Check docking tiles */
+	TileArea ta;
+	std::map<TileIndex, bool> docking_tiles;
+	for (TileIndex tile : st->docking_station) {
+		ta.Add(tile);
+		docking_tiles[tile] = IsDockingTile(tile);
 	}
+	UpdateStationDockingTiles(st);
+	if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
+		Debug(desync, 2, "station docking mismatch: station {}, company {}", st->index, st->owner);
+		mismatch = true;
+	}
+	for (TileIndex tile : ta) {
+		if (docking_tiles[tile] != IsDockingTile(tile)) {
+			Debug(desync, 2, "docking tile mismatch: tile {}", tile);
+			mismatch = true;
+		}
+	}
+
+	/* Check industries_near */
+	IndustryList industries_near = st->industries_near;
+	st->RecomputeCatchment();
+	if (st->industries_near != industries_near) {
+		Debug(desync, 2, "station industries near mismatch: station {}", st->index);
+		mismatch = true;
+	}
+
+	return mismatch;
+}
+
+/**
+ * Check the caches of all stations, including the lists of nearby
+ * stations of towns and industries that get rebuilt while doing so.
+ * @return True iff a mismatch was found.
+ */
+static bool CheckAllStationCaches()
+{
+	bool mismatch = false;
 
 	/* Backup stations_near */
 	std::vector<StationList> old_town_stations_near;
@@ -1256,43 +1339,15 @@ static void CheckCaches()
 	for (Industry *ind : Industry::Iterate())  old_industry_stations_near.push_back(ind->stations_near);
 
 	for (Station *st : Station::Iterate()) {
-		for (CargoID c = 0; c < NUM_CARGO; c++) {
-			byte buff[sizeof(StationCargoList)];
-			memcpy(buff, &st->goods[c].cargo, sizeof(StationCargoList));
-			st->goods[c].cargo.InvalidateCache();
-			assert(memcmp(&st->goods[c].cargo, buff, sizeof(StationCargoList)) == 0);
-		}
-
-		/* Check docking tiles */
-		TileArea ta;
-		std::map<TileIndex, bool> docking_tiles;
-		for (TileIndex tile : st->docking_station) {
-			ta.Add(tile);
-			docking_tiles[tile] = IsDockingTile(tile);
-		}
-		UpdateStationDockingTiles(st);
-		if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
-			Debug(desync, 2, "station docking mismatch: station {}, company {}", st->index, st->owner);
-		}
-		for (TileIndex tile : ta) {
-			if (docking_tiles[tile] != IsDockingTile(tile)) {
-				Debug(desync, 2, "docking tile mismatch: tile {}", tile);
-			}
-		}
-
-		/* Check industries_near */
-		IndustryList industries_near = st->industries_near;
-		st->RecomputeCatchment();
-		if (st->industries_near != industries_near) {
-			Debug(desync, 2, "station industries near mismatch: station {}", st->index);
-		}
+		if (CheckStationCaches(st)) mismatch = true;
 	}
 
 	/* Check stations_near */
-	i = 0;
+	uint i = 0;
 	for (Town *t : Town::Iterate()) {
 		if (t->stations_near != old_town_stations_near[i]) {
 			Debug(desync, 2, "town stations near mismatch: town {}", t->index);
+			mismatch = true;
 		}
 		i++;
 	}
@@ -1300,9 +1355,76 @@ static void CheckCaches()
 	for (Industry *ind : Industry::Iterate()) {
 		if (ind->stations_near != old_industry_stations_near[i]) {
 			Debug(desync, 2, "industry stations near mismatch: industry {}", ind->index);
+			mismatch = true;
 		}
 		i++;
 	}
+
+	return mismatch;
+}
+
+/**
+ * Check the caches of the next slice of a pool, continuing where the previous slice ended.
+ * @tparam T The type of the pool items.
+ * @param cursor Index of the first item to check; it is updated to the index after the last checked item.
+ * @param slice Number of items to check.
+ * @param check Function that checks a single item, returning true on a mismatch.
+ * @return True iff a mismatch was found; checking stops at the first one.
+ */
+template <typename T, typename F>
+static bool CheckCachesSlice(size_t &cursor, uint slice, F check)
+{
+	for (T *item : T::Iterate(cursor)) {
+		if (slice-- == 0) return false;
+		cursor = item->index + 1;
+		if (check(item)) return true;
+	}
+
+	/* Reached the end of the pool, start over on the next slice. */
+	cursor = 0;
+	return false;
+}
+
+/**
+ * Check the validity of some of the caches.
+ * Especially in the sense of desyncs between
+ * the cached value and what the value would
+ * be when calculated from the 'base' data.
+ *
+ * Normally all caches are checked every tick. When a slice size is
+ * configured, only that many vehicles and stations are checked each tick
+ * and the map wide caches are checked whenever all vehicles have been
+ * checked once. This makes it feasible to hunt desyncs on large maps.
+ */
+static void CheckCaches()
+{
+	/* Return here so it is easy to add checks that are run
+	 * always to aid testing of caches. */
+	if (_debug_desync_level <= 1) return;
+
+	uint slice = _settings_client.gui.cache_check_slice;
+	if (slice == 0) {
+		CheckTownCaches();
+		CheckInfrastructureCaches();
+		CheckRoadStopCaches();
+		for (Vehicle *v : Vehicle::Iterate()) CheckVehicleCaches(v);
+		CheckAllStationCaches();
+		return;
+	}
+
+	static size_t vehicle_cursor = 0;
+	static size_t station_cursor = 0;
+
+	bool mismatch = false;
+	if (vehicle_cursor == 0) {
+		/* Starting a new round over the vehicles; also check the map wide caches. */
+		mismatch = CheckTownCaches() || CheckInfrastructureCaches();
+		CheckRoadStopCaches();
+	}
+	if (!mismatch) mismatch = CheckCachesSlice<Vehicle>(vehicle_cursor, slice, CheckVehicleCaches);
+	if (!mismatch) mismatch = CheckCachesSlice<Station>(station_cursor, slice, CheckStationCaches);
+
+	if (mismatch) Debug(desync, 2, "cache mismatch found at date {:08x}; {:02x}", _date, _date_fract);
 }
 
 /**
@@ -1346,8 +1468,10 @@ void StateGameLoop()
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP);
 		UpdateLandscapingLimits();
 
-		CallWindowGameTickEvent();
-		NewsLoop();
+		if (!_simulation_only) {
+			CallWindowGameTickEvent();
+			NewsLoop();
+		}
 	} else {
 		if (_debug_desync_level > 2 && _date_fract == 0 && (_date & 0x1F) == 0) {
 			/* Save the desync savegame if needed. */
@@ -1379,14 +1503,47 @@ void StateGameLoop()
 #endif
 		UpdateLandscapingLimits();
 
-		CallWindowGameTickEvent();
-		NewsLoop();
+		if (!_simulation_only) {
+			CallWindowGameTickEvent();
+			NewsLoop();
+		}
 		cur_company.Restore();
 	}
 
+	PoolBase::EndTick();
+
 	assert(IsLocalCompany());
 }
 
+/**
+ * Run the game for a number of ticks as fast as possible, without
+ * updating the windows, news and viewports in the meantime.
+ * @param ticks The number of ticks to run.
+ * @param tick_proc Optional function to call after every tick, e.g. to log the game state.
+ * @return The achieved number of ticks per second.
+ * @pre !_networking
+ */
+double SimulateTicks(uint ticks, void (*tick_proc)())
+{
+	assert(!_networking);
+
+	auto start = std::chrono::steady_clock::now();
+	{
+		Backup<bool> simulation_only(_simulation_only, true, FILE_LINE);
+		for (uint i = 0; i < ticks && !_exit_game; i++) {
+			StateGameLoop();
+			if (tick_proc != nullptr) tick_proc();
+		}
+		simulation_only.Restore();
+	}
+	auto duration = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+
+	/* Nothing has been drawn in the meantime. */
+	MarkWholeScreenDirty();
+
+	return duration.count() > 0 ? ticks / duration.count() : 0;
+}
+
 /**
  * Create an autosave. The default name is "autosave#.sav". However with
  * the setting 'keep_all_autosave' the name defaults to company-name + date
@@ -55,6 +55,7 @@ extern GameMode _game_mode;
 extern SwitchMode _switch_mode;
 extern std::atomic<bool> _exit_game;
 extern bool _save_config;
+extern bool _simulation_only;
 
 /** Modes of pausing we've got */
 enum PauseMode : byte {
@@ -85,4 +86,6 @@ void SwitchToMode(SwitchMode new_mode);
 
 bool RequestNewGRFScan(struct NewGRFScanCallback *callback = nullptr);
 
+double SimulateTicks(uint ticks, void (*tick_proc)() = nullptr);
+
 #endif /* OPENTTD_H */
@@ -296,8 +296,10 @@ void OrderList::Initialize(Order *chain, Vehicle *v)
 	this->num_manual_orders = 0;
 	this->num_vehicles = 1;
 	this->timetable_duration = 0;
+	this->order_index.clear();
 
 	for (Order *o = this->first; o != nullptr; o = o->next) {
+		this->order_index.push_back(o);
 		++this->num_orders;
 		if (!o->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 		this->total_duration += o->GetWaitTime() + o->GetTravelTime();
@@ -340,6 +342,7 @@ void OrderList::FreeChain(bool keep_orderlist)
 
 	if (keep_orderlist) {
 		this->first = nullptr;
+		this->order_index.clear();
 		this->num_orders = 0;
 		this->num_manual_orders = 0;
 		this->timetable_duration = 0;
@@ -355,14 +358,9 @@ void OrderList::FreeChain(bool keep_orderlist)
  */
 Order *OrderList::GetOrderAt(int index) const
 {
-	if (index < 0) return nullptr;
+	if (index < 0 || (uint)index >= this->order_index.size()) return nullptr;
 
-	Order *order = this->first;
-
-	while (order != nullptr && index-- > 0) {
-		order = order->next;
-	}
-	return order;
+	return this->order_index[index];
 }
 
 /**
@@ -487,6 +485,7 @@ void OrderList::InsertOrderAt(Order *new_order, int index)
 			order->next = new_order;
 		}
 	}
+	this->order_index.insert(this->order_index.begin() + std::min<size_t>(index, this->order_index.size()), new_order);
 	++this->num_orders;
 	if (!new_order->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 	this->timetable_duration += new_order->GetTimetabledWait() + new_order->GetTimetabledTravel();
@@ -520,6 +519,7 @@ void OrderList::DeleteOrderAt(int index)
 		to_remove = prev->next;
 		prev->next = to_remove->next;
 	}
+	this->order_index.erase(this->order_index.begin() + index);
 	--this->num_orders;
 	if (!to_remove->IsType(OT_IMPLICIT)) --this->num_manual_orders;
 	this->timetable_duration -= (to_remove->GetTimetabledWait() + to_remove->GetTimetabledTravel());
@@ -547,6 +547,7 @@ void OrderList::MoveOrder(int from, int to)
 		moving_one = one_before->next;
 		one_before->next = moving_one->next;
 	}
+	this->order_index.erase(this->order_index.begin() + from);
 
 	/* Insert the moving_order again in the pointer-chain */
 	if (to == 0) {
@@ -557,6 +558,7 @@ void OrderList::MoveOrder(int from, int to)
 		moving_one->next = one_before->next;
 		one_before->next = moving_one;
 	}
+	this->order_index.insert(this->order_index.begin() + to, moving_one);
 }
 
 /**
@@ -623,12 +625,14 @@ void OrderList::DebugCheckSanity() const
 	Debug(misc, 6, "Checking OrderList {} for sanity...", this->index);
 
 	for (const Order *o = this->first; o != nullptr; o = o->next) {
+		assert(check_num_orders < this->order_index.size() && this->order_index[check_num_orders] == o);
 		++check_num_orders;
 		if (!o->IsType(OT_IMPLICIT)) ++check_num_manual_orders;
 		check_timetable_duration += o->GetTimetabledWait() + o->GetTimetabledTravel();
 		check_total_duration += o->GetWaitTime() + o->GetTravelTime();
 	}
 	assert(this->num_orders == check_num_orders);
+	assert(this->order_index.size() == check_num_orders);
 	assert(this->num_manual_orders == check_num_manual_orders);
 	assert(this->timetable_duration == check_timetable_duration);
 	assert(this->total_duration == check_total_duration);
@@ -85,6 +85,7 @@ void AyStar::OpenListAdd(PathNode *parent, const AyStarNode *node, int f, int g)
 	/* Add a new Node to the OpenList */
 	OpenListNode *new_node = MallocT<OpenListNode>(1);
 	new_node->g = g;
+	new_node->f = f;
 	new_node->path.parent = parent;
 	new_node->path.node = *node;
 	this->openlist_hash.Set(node->tile, node->direction, new_node);
@@ -133,7 +134,7 @@ void AyStar::CheckTile(AyStarNode *current, OpenListNode *parent)
 		uint i;
 		/* Yes, check if this g value is lower.. */
 		if (new_g > check->g) return;
-		this->openlist_queue.Delete(check, 0);
+		this->openlist_queue.Delete(check, check->f);
 		/* It is lower, so change it to this item */
 		check->g = new_g;
 		check->path.parent = closedlist_parent;
@@ -142,6 +143,7 @@ void AyStar::CheckTile(AyStarNode *current, OpenListNode *parent)
 			check->path.node.user_data[i] = current->user_data[i];
 		}
 		/* Re-add it in the openlist_queue. */
+		check->f = new_f;
 		this->openlist_queue.Push(check, new_f);
 	} else {
 		/* A new node, add it to the OpenList */
@@ -54,6 +54,7 @@ struct PathNode {
  */
 struct OpenListNode {
 	int g;
+	int f;            ///< The f-value the node is queued with in the open list.
 	PathNode path;
 };
 
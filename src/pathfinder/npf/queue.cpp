@@ -93,34 +93,21 @@ bool BinaryHeap::Push(void *item, int priority)
 		this->blocks++;
 	}
 
-	/* Add the item at the end of the array */
-	this->GetElement(this->size + 1).priority = priority;
-	this->GetElement(this->size + 1).item = item;
 	this->size++;
 
 	/* Now we are going to check where it belongs. As long as the parent is
-	 * bigger, we switch with the parent */
-	{
-		BinaryHeapNode temp;
-		int i;
-		int j;
-
-		i = this->size;
-		while (i > 1) {
-			/* Get the parent of this object (divide by 2) */
-			j = i / 2;
-			/* Is the parent bigger than the current, switch them */
-			if (this->GetElement(i).priority <= this->GetElement(j).priority) {
-				temp = this->GetElement(j);
-				this->GetElement(j) = this->GetElement(i);
-				this->GetElement(i) = temp;
-				i = j;
-			} else {
-				/* It is not, we're done! */
-				break;
-			}
-		}
+	 * bigger, we move the parent down into the gap and continue upwards */
+	uint i = this->size;
+	while (i > 1) {
+		/* Get the parent of this object (divide by 2) */
+		uint j = i / 2;
+		/* Is the parent bigger than the current, move it down */
+		if (priority > this->GetElement(j).priority) break;
+		this->GetElement(i) = this->GetElement(j);
+		i = j;
 	}
+	this->GetElement(i).priority = priority;
+	this->GetElement(i).item = item;
 
 	return true;
 }
@@ -132,59 +119,91 @@ bool BinaryHeap::Push(void *item, int priority)
  */
 bool BinaryHeap::Delete(void *item, int priority)
 {
-	uint i = 0;
-
 	/* First, we try to find the item.. */
-	do {
-		if (this->GetElement(i + 1).item == item) break;
-		i++;
-	} while (i < this->size);
+	uint i = priority < 0 ? this->FindLinear(item) : this->Find(item, priority, 1);
 	/* We did not find the item, so we return false */
-	if (i == this->size) return false;
+	if (i == 0) return false;
 
 	/* Now we put the last item over the current item while decreasing the size of the elements */
 	this->size--;
-	this->GetElement(i + 1) = this->GetElement(this->size + 1);
+	if (i == this->size + 1) return true;
+	BinaryHeapNode last = this->GetElement(this->size + 1);
+
+	/* The last item can come from another subtree and be smaller than the
+	 * parent of the gap. Then move the parents down into the gap like Push
+	 * does, otherwise the pruning in Find would miss items. */
+	while (i > 1 && last.priority < this->GetElement(i / 2).priority) {
+		this->GetElement(i) = this->GetElement(i / 2);
+		i /= 2;
+	}
 
 	/* Now the only thing we have to do, is resort it..
 	 * On place i there is the item to be sorted.. let's start there */
-	{
-		uint j;
-		BinaryHeapNode temp;
-		/* Because of the fact that Binary Heap uses array from 1 to n, we need to
-		 * increase i by 1
-		 */
-		i++;
-
-		for (;;) {
-			j = i;
-			/* Check if we have 2 children */
-			if (2 * j + 1 <= this->size) {
-				/* Is this child smaller than the parent? */
-				if (this->GetElement(j).priority >= this->GetElement(2 * j).priority) i = 2 * j;
-				/* Yes, we _need_ to use i here, not j, because we want to have the smallest child
-				 *  This way we get that straight away! */
-				if (this->GetElement(i).priority >= this->GetElement(2 * j + 1).priority) i = 2 * j + 1;
-			/* Do we have one child? */
-			} else if (2 * j <= this->size) {
-				if (this->GetElement(j).priority >= this->GetElement(2 * j).priority) i = 2 * j;
+	for (;;) {
+		uint j = i;
+		int smallest = last.priority;
+		/* Check if we have 2 children */
+		if (2 * j + 1 <= this->size) {
+			/* Is this child smaller than the parent? */
+			if (smallest >= this->GetElement(2 * j).priority) {
+				i = 2 * j;
+				smallest = this->GetElement(i).priority;
 			}
+			/* Yes, we _need_ to use the smallest so far here, because we want to have the smallest child
+			 *  This way we get that straight away! */
+			if (smallest >= this->GetElement(2 * j + 1).priority) i = 2 * j + 1;
+		/* Do we have one child? */
+		} else if (2 * j <= this->size) {
+			if (smallest >= this->GetElement(2 * j).priority) i = 2 * j;
+		}
 
-			/* One of our children is smaller than we are, switch */
-			if (i != j) {
-				temp = this->GetElement(j);
-				this->GetElement(j) = this->GetElement(i);
-				this->GetElement(i) = temp;
-			} else {
-				/* None of our children is smaller, so we stay here.. stop :) */
-				break;
-			}
+		/* One of our children is smaller than we are, move it up */
+		if (i != j) {
+			this->GetElement(j) = this->GetElement(i);
+		} else {
+			/* None of our children is smaller, so we stay here.. stop :) */
+			break;
 		}
 	}
+	this->GetElement(i) = last;
 
 	return true;
 }
 
+/**
+ * Find an item by walking the whole heap.
+ * @param item The item to find.
+ * @return The position of the item (counting from \c 1), or \c 0 when it is not in the heap.
+ */
+uint BinaryHeap::FindLinear(void *item)
+{
+	for (uint i = 1; i <= this->size; i++) {
+		if (this->GetElement(i).item == item) return i;
+	}
+	return 0;
+}
+
+/**
+ * Find an item with a known priority. Subtrees whose root has a higher
+ * priority can not contain the item, so they are not visited.
+ * @param item The item to find.
+ * @param priority The priority the item was pushed with.
+ * @param i The position of the subtree to search (counting from \c 1).
+ * @return The position of the item (counting from \c 1), or \c 0 when it is not in the subtree.
+ */
+uint BinaryHeap::Find(void *item, int priority, uint i)
+{
+	if (i > this->size) return 0;
+
+	const BinaryHeapNode &node = this->GetElement(i);
+	if (node.priority > priority) return 0;
+	if (node.item == item) return i;
+
+	uint found = this->Find(item, priority, 2 * i);
+	if (found == 0) found = this->Find(item, priority, 2 * i + 1);
+	return found;
+}
+
 /**
  * Pops the first element from the queue. What exactly is the first element,
  * is defined by the exact type of queue.
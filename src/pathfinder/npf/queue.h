@@ -35,6 +35,8 @@ struct BinaryHeap {
 	bool Delete(void *item, int priority);
 	void Clear(bool free_values);
 	void Free(bool free_values);
+	uint FindLinear(void *item);
+	uint Find(void *item, int priority, uint i);
 
 	/**
 	 * Get an element from the #elements.
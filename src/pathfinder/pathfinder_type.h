@@ -39,7 +39,10 @@ static const int YAPF_TILE_CORNER_LENGTH = 71;
 static const int YAPF_INFINITE_PENALTY = 1000 * YAPF_TILE_LENGTH;
 
 /** Maximum length of ship path cache */
-static const int YAPF_SHIP_PATH_CACHE_LENGTH = 32;
+static const int YAPF_SHIP_PATH_CACHE_LENGTH = 64;
+
+/** Number of tiles before the destination of a ship to not cache */
+static const int YAPF_SHIP_PATH_CACHE_DESTINATION_LIMIT = 16;
 
 /** Maximum segments of road vehicle path cache */
 static const int YAPF_ROADVEH_PATH_CACHE_SEGMENTS = 8;
@@ -97,4 +97,21 @@ bool YapfTrainCheckReverse(const Train *v);
  */
 bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, bool override_railtype);
 
+/** Statistics of a single YAPF search, kept to find the expensive ones. */
+struct YapfSearchStats {
+	VehicleID vehicle; ///< Vehicle the search was done for, or #INVALID_VEHICLE.
+	char transport;    ///< Transport type character of the pathfinder.
+	bool found;        ///< Whether a path to the destination was found.
+	int steps;         ///< Number of rounds of the search.
+	int open;          ///< Number of nodes still open at the end.
+	int closed;        ///< Number of closed nodes at the end.
+	int cost_calcs;    ///< Number of segment costs calculated.
+	int cache_hits;    ///< Number of segment costs reused from the cache.
+	uint32 duration;   ///< Wall time of the search in microseconds.
+};
+
+void YapfRecordSearch(const YapfSearchStats &stats);
+void YapfPrintSearchStats(uint count);
+void YapfBenchmarkSearches(uint rounds);
+
 #endif /* YAPF_H */
@@ -12,6 +12,7 @@
 
 #include "../../debug.h"
 #include "../../settings_type.h"
+#include <chrono>
 
 /**
  * CYapfBaseT - A-star type path finder base class.
@@ -112,6 +113,8 @@ public:
 	{
 		m_veh = v;
 
+		auto start_time = std::chrono::steady_clock::now();
+
 		Yapf().PfSetStartupNodes();
 		bool bDestFound = true;
 
@@ -139,6 +142,18 @@ public:
 
 		bDestFound &= (m_pBestDestNode != nullptr);
 
+		YapfSearchStats stats;
+		stats.vehicle = (m_veh != nullptr) ? m_veh->index : INVALID_VEHICLE;
+		stats.transport = Yapf().TransportTypeChar();
+		stats.found = bDestFound;
+		stats.steps = m_num_steps;
+		stats.open = m_nodes.OpenCount();
+		stats.closed = m_nodes.ClosedCount();
+		stats.cost_calcs = m_stats_cost_calcs;
+		stats.cache_hits = m_stats_cache_hits;
+		stats.duration = (uint32)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+		YapfRecordSearch(stats);
+
 		if (_debug_yapf_level >= 3) {
 			UnitID veh_idx = (m_veh != nullptr) ? m_veh->unitnumber : 0;
 			char ttc = Yapf().TransportTypeChar();
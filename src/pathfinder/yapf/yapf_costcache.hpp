@@ -95,16 +95,32 @@ public:
  *  of track layout changes and static notification function called whenever
  *  the track layout changes. It is implemented as base class because it needs
  *  to be shared between all rail YAPF types (one shared counter, one notification
- *  function.
+ *  function. The most recently changed tiles are remembered as well, so each
+ *  cache can drop only the segments near them.
  */
 struct CSegmentCostCacheBase
 {
-	static int   s_rail_change_counter;
+	static const uint C_CHANGED_TILES = 64; ///< number of recent track layout changes kept
+
+	static uint      s_rail_change_counter;
+	static TileIndex s_changed_tiles[C_CHANGED_TILES];
+	static uint      s_reservation_counter;
 
 	static void NotifyTrackLayoutChange(TileIndex tile, Track track)
 	{
+		s_changed_tiles[s_rail_change_counter % C_CHANGED_TILES] = tile;
 		s_rail_change_counter++;
 	}
+
+	/**
+	 * Notify that a path has been reserved. Only segments of pathfinders that
+	 *  mask reserved tracks depend on the reservations, so only their caches
+	 *  have to be flushed.
+	 */
+	static void NotifyPathReservation()
+	{
+		s_reservation_counter++;
+	}
 };
 
 
@@ -121,6 +137,7 @@ struct CSegmentCostCacheBase
 template <class Tsegment>
 struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 	static const int C_HASH_BITS = 14;
+	static const uint C_MAX_SEGMENTS = 1 << 15; ///< flush the whole cache when it holds more segments than this
 
 	typedef CHashTableT<Tsegment, C_HASH_BITS> HashTable;
 	typedef SmallArray<Tsegment> Heap;
@@ -138,6 +155,40 @@ struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 		m_heap.Clear();
 	}
 
+	/**
+	 * Drop the segments affected by the track layout changes since the given counter value.
+	 * The whole cache is flushed when the changes are not known individually any more,
+	 * when one of them is not bound to a tile, or when the cache has grown too large.
+	 * @param last_change_counter Value of #s_rail_change_counter at the previous check.
+	 */
+	inline void Invalidate(uint last_change_counter)
+	{
+		uint num_changes = s_rail_change_counter - last_change_counter;
+		if (num_changes > C_CHANGED_TILES || m_heap.Length() > C_MAX_SEGMENTS) {
+			Flush();
+			return;
+		}
+
+		for (uint i = last_change_counter; i != s_rail_change_counter; i++) {
+			if (s_changed_tiles[i % C_CHANGED_TILES] == INVALID_TILE) {
+				Flush();
+				return;
+			}
+		}
+
+		for (uint j = 0; j < m_heap.Length(); j++) {
+			Tsegment &item = m_heap[j];
+			/* Segments that were dropped before stay in the heap until the next flush. */
+			if (m_map.Find(item.GetKey()) != &item) continue;
+			for (uint i = last_change_counter; i != s_rail_change_counter; i++) {
+				if (item.IsAffectedBy(s_changed_tiles[i % C_CHANGED_TILES])) {
+					m_map.Pop(item);
+					break;
+				}
+			}
+		}
+	}
+
 	inline Tsegment& Get(Key &key, bool *found)
 	{
 		Tsegment *item = m_map.Find(key);
@@ -181,13 +232,20 @@ protected:
 
 	inline static Cache& stGetGlobalCache()
 	{
-		static int last_rail_change_counter = 0;
+		static uint last_rail_change_counter = 0;
+		static uint last_reservation_counter = 0;
 		static Cache C;
 
-		/* delete the cache sometimes... */
+		/* reservations only change the segments when reserved tracks are masked */
+		if (Types::TrackFollower::DoTrackMasking() && last_reservation_counter != Cache::s_reservation_counter) {
+			last_reservation_counter = Cache::s_reservation_counter;
+			C.Flush();
+		}
+
+		/* forget the segments near track layout changes */
 		if (last_rail_change_counter != Cache::s_rail_change_counter) {
+			C.Invalidate(last_rail_change_counter);
 			last_rail_change_counter = Cache::s_rail_change_counter;
-			C.Flush();
 		}
 		return C;
 	}
@@ -370,6 +370,9 @@ public:
 
 no_entry_cost: // jump here at the beginning if the node has no parent (it is the first node)
 
+			/* Remember which tiles the segment covers, so only changes near them invalidate it. */
+			segment.m_area.Add(cur.tile);
+
 			/* All other tile costs will be calculated here. */
 			segment_cost += Yapf().OneTileCost(cur.tile, cur.td);
 
@@ -497,6 +500,8 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 				break;
 			}
 
+			segment.m_area.Add(tf_local.m_new_tile);
+
 			/* Check if the next tile is not a choice. */
 			if (KillFirstBit(tf_local.m_new_td_bits) != TRACKDIR_BIT_NONE) {
 				/* More than one segment will follow. Close this one. */
@@ -623,6 +628,7 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 		if (n.m_segment->m_cost < 0) {
 			n.m_segment->m_last_tile = n.m_key.m_tile;
 			n.m_segment->m_last_td = n.m_key.m_td;
+			n.m_segment->m_area.Clear();
 		}
 	}
 
@@ -69,6 +69,7 @@ struct CYapfRailSegment
 	TileIndex              m_last_signal_tile;
 	Trackdir               m_last_signal_td;
 	EndSegmentReasonBits   m_end_segment_reason;
+	TileArea               m_area;
 	CYapfRailSegment      *m_hash_next;
 
 	inline CYapfRailSegment(const CYapfRailSegmentKey &key)
@@ -92,6 +93,17 @@ struct CYapfRailSegment
 		return m_key.GetTile();
 	}
 
+	/**
+	 * Check whether a change to the given tile may change the cached data of this segment.
+	 * @param tile The changed tile.
+	 * @return True if the tile is within, or next to, the area covered by the segment.
+	 */
+	inline bool IsAffectedBy(TileIndex tile) const
+	{
+		if (m_area.tile == INVALID_TILE) return true;
+		return TileArea(m_area).Expand(1).Contains(tile);
+	}
+
 	inline CYapfRailSegment *GetHashNext()
 	{
 		return m_hash_next;
@@ -111,6 +123,7 @@ struct CYapfRailSegment
 		dmp.WriteTile("m_last_signal_tile", m_last_signal_tile);
 		dmp.WriteEnumT("m_last_signal_td", m_last_signal_td);
 		dmp.WriteEnumT("m_end_segment_reason", m_end_segment_reason);
+		dmp.WriteTile("m_area", m_area.tile);
 	}
 };
 
@@ -218,7 +231,7 @@ typedef CYapfRailNodeT<CYapfNodeKeyExitDir>  CYapfRailNodeExitDir;
 typedef CYapfRailNodeT<CYapfNodeKeyTrackDir> CYapfRailNodeTrackDir;
 
 /* Default NodeList types */
-typedef CNodeList_HashTableT<CYapfRailNodeExitDir , 8, 10> CRailNodeListExitDir;
-typedef CNodeList_HashTableT<CYapfRailNodeTrackDir, 8, 10> CRailNodeListTrackDir;
+typedef CNodeList_HashTableT<CYapfRailNodeExitDir , 10, 12> CRailNodeListExitDir;
+typedef CNodeList_HashTableT<CYapfRailNodeTrackDir, 10, 12> CRailNodeListTrackDir;
 
 #endif /* YAPF_NODE_RAIL_HPP */
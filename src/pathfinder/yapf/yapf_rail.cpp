@@ -16,6 +16,10 @@
 #include "yapf_destrail.hpp"
 #include "../../viewport_func.h"
 #include "../../newgrf_station.h"
+#include "../../framerate_type.h"
+#include "../../depot_base.h"
+#include "../../tunnelbridge_map.h"
+#include <queue>
 
 #include "../../safeguards.h"
 
@@ -178,7 +182,7 @@ public:
 		if (target != nullptr) target->okay = true;
 
 		if (Yapf().CanUseGlobalCache(*m_res_node)) {
-			YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+			CSegmentCostCacheBase::NotifyPathReservation();
 		}
 
 		return true;
@@ -530,6 +534,9 @@ struct CYapfAnySafeTileRail2 : CYapfT<CYapfRail_TypesT<CYapfAnySafeTileRail2, CF
 
 Track YapfTrainChooseTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target)
 {
+	static const PerformanceScopeID scope = RegisterPerformanceScope("Train pathfinding");
+	PerformanceScope profile(scope);
+
 	/* default is YAPF type 2 */
 	typedef Trackdir (*PfnChooseRailTrack)(const Train*, TileIndex, DiagDirection, TrackBits, bool&, bool, PBSTileInfo*);
 	PfnChooseRailTrack pfnChooseRailTrack = &CYapfRail1::stChooseRailTrack;
@@ -602,6 +609,153 @@ bool YapfTrainCheckReverse(const Train *v)
 	return reverse;
 }
 
+/**
+ * Lower bounds of the distance, in tiles, from every tile to the nearest rail depot.
+ * The rail network is treated as undirected and any two neighbouring tiles with rail
+ * are considered to be connected, so the distance along the tracks can only be longer.
+ * Because of that the field stays a valid lower bound when tracks are removed; only
+ * added tracks and depots can make distances shorter, and those are propagated from
+ * the tiles of the track layout changes YAPF is notified of.
+ */
+class CYapfRailDepotDistances : public CSegmentCostCacheBase {
+	static constexpr uint16 UNREACHABLE = UINT16_MAX;  ///< distance of tiles from which no rail depot can be reached
+	static const uint C_MAX_LOCAL_UPDATES = 1024;      ///< rebuild the whole field after this many changes, so removed tracks stop counting
+
+	typedef std::pair<uint, TileIndex> QueueItem;
+	typedef std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> Queue;
+
+	std::vector<uint16> m_dist;      ///< distance per tile
+	uint m_last_change_counter = 0;  ///< value of #s_rail_change_counter the field is up to date with
+	uint m_local_updates = 0;        ///< number of changes applied since the last full rebuild
+	Queue m_queue;                   ///< tiles of which the neighbours have to be updated
+
+	static bool HasRail(TileIndex tile)
+	{
+		return TrackStatusToTrackdirBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) != TRACKDIR_BIT_NONE;
+	}
+
+	/** Queue a tile that has a known distance, so its neighbours get updated. */
+	void Enqueue(TileIndex tile)
+	{
+		if (m_dist[tile] != UNREACHABLE) m_queue.push(QueueItem(m_dist[tile], tile));
+	}
+
+	/** Lower the distance of a tile with rail, if the given one is shorter. */
+	void Lower(TileIndex tile, uint dist)
+	{
+		if (dist >= m_dist[tile] || !HasRail(tile)) return;
+		m_dist[tile] = dist;
+		m_queue.push(QueueItem(dist, tile));
+	}
+
+	/** Propagate the queued distances over the network (Dijkstra). */
+	void Propagate()
+	{
+		while (!m_queue.empty()) {
+			QueueItem item = m_queue.top();
+			m_queue.pop();
+			TileIndex tile = item.second;
+			if (item.first != m_dist[tile]) continue;
+
+			for (DiagDirection dir = DIAGDIR_BEGIN; dir != DIAGDIR_END; dir++) {
+				TileIndexDiffC diff = TileIndexDiffCByDiagDir(dir);
+				TileIndex neighbour = TileAddWrap(tile, diff.x, diff.y);
+				if (neighbour != INVALID_TILE) Lower(neighbour, item.first + 1);
+			}
+
+			if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL) {
+				TileIndex other = GetOtherTunnelBridgeEnd(tile);
+				Lower(other, item.first + DistanceManhattan(tile, other));
+			}
+		}
+	}
+
+	/** Compute the distances of all tiles from scratch. */
+	void Rebuild()
+	{
+		m_dist.assign(MapSize(), UNREACHABLE);
+		m_local_updates = 0;
+		for (const Depot *depot : Depot::Iterate()) {
+			if (!IsRailDepotTile(depot->xy)) continue;
+			m_dist[depot->xy] = 0;
+			Enqueue(depot->xy);
+		}
+		Propagate();
+	}
+
+	/** Queue a changed tile, and the tiles next to it, for updating. */
+	void EnqueueAround(TileIndex tile)
+	{
+		Enqueue(tile);
+		for (DiagDirection dir = DIAGDIR_BEGIN; dir != DIAGDIR_END; dir++) {
+			TileIndexDiffC diff = TileIndexDiffCByDiagDir(dir);
+			TileIndex neighbour = TileAddWrap(tile, diff.x, diff.y);
+			if (neighbour != INVALID_TILE) Enqueue(neighbour);
+		}
+	}
+
+	/** Bring the field up to date with the track layout changes since the last look-up. */
+	void Update()
+	{
+		uint num_changes = s_rail_change_counter - m_last_change_counter;
+		bool rebuild = m_dist.size() != MapSize() || num_changes > C_CHANGED_TILES || m_local_updates + num_changes > C_MAX_LOCAL_UPDATES;
+		for (uint i = m_last_change_counter; !rebuild && i != s_rail_change_counter; i++) {
+			if (s_changed_tiles[i % C_CHANGED_TILES] == INVALID_TILE) rebuild = true;
+		}
+		m_last_change_counter = s_rail_change_counter;
+
+		if (rebuild) {
+			Rebuild();
+			return;
+		}
+
+		for (uint i = m_last_change_counter - num_changes; i != m_last_change_counter; i++) {
+			TileIndex tile = s_changed_tiles[i % C_CHANGED_TILES];
+			if (IsRailDepotTile(tile)) m_dist[tile] = 0;
+			EnqueueAround(tile);
+			if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL) {
+				EnqueueAround(GetOtherTunnelBridgeEnd(tile));
+			}
+		}
+		m_local_updates += num_changes;
+		Propagate();
+	}
+
+public:
+	/**
+	 * Get a lower bound of the cost to reach any rail depot from a tile.
+	 * @param tile The tile to start from.
+	 * @return Lower bound of the cost, or \c INT_MAX when no depot can be reached at all.
+	 */
+	int GetMinCost(TileIndex tile)
+	{
+		if (m_dist.empty() || m_last_change_counter != s_rail_change_counter) Update();
+
+		uint dist = m_dist[tile];
+		if (dist == UNREACHABLE) return INT_MAX;
+		/* Every tile on the way, possibly except the first and the depot, costs at least a corner piece. */
+		return dist > 1 ? (dist - 1) * YAPF_TILE_CORNER_LENGTH : 0;
+	}
+};
+
+/** The depot distances of the rail network. */
+static CYapfRailDepotDistances _rail_depot_distances;
+
+/**
+ * Check whether the look-ahead signal penalties are never negative. Only then
+ * no path can be cheaper than the lower bound of the depot distances, and the
+ * bound gives the same answer as the search, whatever the history of the field.
+ * @return True iff the depot distances can be used to skip searches.
+ */
+static bool CanUseRailDepotDistances()
+{
+	const YAPFSettings &yapf = _settings_game.pf.yapf;
+	for (uint i = 0; i < yapf.rail_look_ahead_max_signals; i++) {
+		if ((int)(yapf.rail_look_ahead_signal_p0 + i * (yapf.rail_look_ahead_signal_p1 + i * yapf.rail_look_ahead_signal_p2)) < 0) return false;
+	}
+	return true;
+}
+
 FindDepotData YapfTrainFindNearestDepot(const Train *v, int max_penalty)
 {
 	const Train *last_veh = v->Last();
@@ -618,6 +772,18 @@ FindDepotData YapfTrainFindNearestDepot(const Train *v, int max_penalty)
 		pfnFindNearestDepotTwoWay = &CYapfAnyDepotRail2::stFindNearestDepotTwoWay; // Trackdir, forbid 90-deg
 	}
 
+	/* Skip the search when no depot can be close enough; the search would not find one either. */
+	int min_cost = CanUseRailDepotDistances() ? std::min(_rail_depot_distances.GetMinCost(origin.tile), _rail_depot_distances.GetMinCost(last_tile)) : 0;
+	if (min_cost == INT_MAX || (max_penalty != 0 && min_cost > max_penalty)) {
+		if (_debug_desync_level >= 2) {
+			FindDepotData result = pfnFindNearestDepotTwoWay(v, origin.tile, origin.trackdir, last_tile, td_rev, max_penalty, YAPF_INFINITE_PENALTY);
+			if (result.best_length != UINT_MAX && (max_penalty == 0 || result.best_length <= (uint)max_penalty)) {
+				Debug(desync, 2, "CACHE ERROR: depot distance field misses depot at 0x{:X}", result.tile);
+			}
+		}
+		return FindDepotData();
+	}
+
 	return pfnFindNearestDepotTwoWay(v, origin.tile, origin.trackdir, last_tile, td_rev, max_penalty, YAPF_INFINITE_PENALTY);
 }
 
@@ -635,7 +801,11 @@ bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, b
 }
 
 /** if any track changes, this counter is incremented - that will invalidate segment cost cache */
-int CSegmentCostCacheBase::s_rail_change_counter = 0;
+uint CSegmentCostCacheBase::s_rail_change_counter = 0;
+/** the tiles of the most recent track layout changes, indexed by the change counter */
+TileIndex CSegmentCostCacheBase::s_changed_tiles[CSegmentCostCacheBase::C_CHANGED_TILES];
+/** if any path is reserved, this counter is incremented - that will flush the caches of pathfinders masking reserved tracks */
+uint CSegmentCostCacheBase::s_reservation_counter = 0;
 
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
@@ -11,6 +11,7 @@
 #include "../../ship.h"
 #include "../../industry.h"
 #include "../../vehicle_func.h"
+#include "../../framerate_type.h"
 
 #include "yapf.hpp"
 #include "yapf_node_ship.hpp"
@@ -173,7 +174,7 @@ public:
 			uint steps = 0;
 			for (Node *n = pNode; n->m_parent != nullptr; n = n->m_parent) steps++;
 			uint skip = 0;
-			if (path_found) skip = YAPF_SHIP_PATH_CACHE_LENGTH / 2;
+			if (path_found) skip = YAPF_SHIP_PATH_CACHE_DESTINATION_LIMIT;
 
 			/* walk through the path back to the origin */
 			Node *pPrevNode = nullptr;
@@ -242,6 +243,8 @@ public:
 	typedef typename Node::Key Key;               ///< key to hash tables
 
 protected:
+	const ShipVehicleInfo *m_svi = nullptr; ///< vehicle info of the ship, looked up on the first node
+
 	/** to access inherited path finder */
 	Tpf& Yapf()
 	{
@@ -296,8 +299,8 @@ public:
 		c += YAPF_TILE_LENGTH * tf->m_tiles_skipped;
 
 		/* Ocean/canal speed penalty. */
-		const ShipVehicleInfo *svi = ShipVehInfo(Yapf().GetVehicle()->engine_type);
-		byte speed_frac = (GetEffectiveWaterClass(n.GetTile()) == WATER_CLASS_SEA) ? svi->ocean_speed_frac : svi->canal_speed_frac;
+		if (m_svi == nullptr) m_svi = ShipVehInfo(Yapf().GetVehicle()->engine_type);
+		byte speed_frac = (GetEffectiveWaterClass(n.GetTile()) == WATER_CLASS_SEA) ? m_svi->ocean_speed_frac : m_svi->canal_speed_frac;
 		if (speed_frac > 0) c += YAPF_TILE_LENGTH * (1 + tf->m_tiles_skipped) * speed_frac / (256 - speed_frac);
 
 		/* apply it */
@@ -350,6 +353,9 @@ static inline bool RequireTrackdirKey()
 /** Ship controller helper - path finder invoker */
 Track YapfShipChooseTrack(const Ship *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, ShipPathCache &path_cache)
 {
+	static const PerformanceScopeID scope = RegisterPerformanceScope("Ship pathfinding");
+	PerformanceScope profile(scope);
+
 	/* default is YAPF type 2 */
 	typedef Trackdir (*PfnChooseShipTrack)(const Ship*, TileIndex, DiagDirection, TrackBits, bool &path_found, ShipPathCache &path_cache);
 	PfnChooseShipTrack pfnChooseShipTrack = CYapfShip2::ChooseShipTrack; // default: ExitDir
@@ -0,0 +1,143 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file yapf_stats.cpp Statistics of the most recent YAPF searches. */
+
+#include "../../stdafx.h"
+#include "../../console_func.h"
+#include "../../train.h"
+#include "../../roadveh.h"
+#include "../../ship.h"
+#include "yapf.h"
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include "../../safeguards.h"
+
+static const uint YAPF_SEARCH_STATS_SIZE = 1024; ///< Number of searches kept in the ring buffer.
+
+static YapfSearchStats _yapf_search_stats[YAPF_SEARCH_STATS_SIZE]; ///< Ring buffer of the most recent searches.
+static uint _yapf_search_stats_count = 0; ///< Total number of searches recorded.
+
+/**
+ * Record the statistics of a finished search.
+ * @param stats The statistics of the search.
+ */
+void YapfRecordSearch(const YapfSearchStats &stats)
+{
+	_yapf_search_stats[_yapf_search_stats_count % YAPF_SEARCH_STATS_SIZE] = stats;
+	_yapf_search_stats_count++;
+}
+
+/**
+ * Print the vehicles whose searches took the most time to the console.
+ * @param count The number of vehicles to print.
+ */
+void YapfPrintSearchStats(uint count)
+{
+	/** Summed statistics of the searches of one vehicle. */
+	struct VehicleSearchStats {
+		char transport = ' '; ///< Transport type character of the pathfinder.
+		uint searches = 0;    ///< Number of searches.
+		uint failed = 0;      ///< Number of searches without a path.
+		uint64 duration = 0;  ///< Total wall time in microseconds.
+		int max_closed = 0;   ///< Largest number of closed nodes of a single search.
+		uint64 cost_calcs = 0; ///< Total number of segment costs calculated.
+		uint64 cache_hits = 0; ///< Total number of segment costs reused from the cache.
+	};
+
+	uint num_searches = std::min(_yapf_search_stats_count, YAPF_SEARCH_STATS_SIZE);
+	std::map<VehicleID, VehicleSearchStats> per_vehicle;
+	for (uint i = 0; i < num_searches; i++) {
+		const YapfSearchStats &stats = _yapf_search_stats[i];
+		VehicleSearchStats &sum = per_vehicle[stats.vehicle];
+		sum.transport = stats.transport;
+		sum.searches++;
+		if (!stats.found) sum.failed++;
+		sum.duration += stats.duration;
+		sum.max_closed = std::max(sum.max_closed, stats.closed);
+		sum.cost_calcs += stats.cost_calcs;
+		sum.cache_hits += stats.cache_hits;
+	}
+
+	std::vector<std::pair<VehicleID, VehicleSearchStats>> sorted(per_vehicle.begin(), per_vehicle.end());
+	std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+		return a.second.duration > b.second.duration;
+	});
+
+	IConsolePrint(CC_DEFAULT, "Most expensive vehicles over the last {} pathfinder searches:", num_searches);
+	for (uint i = 0; i < count && i < sorted.size(); i++) {
+		const VehicleSearchStats &sum = sorted[i].second;
+		uint64 segments = sum.cost_calcs + sum.cache_hits;
+		IConsolePrint(CC_DEFAULT, "  [{}] vehicle {}: {} us in {} searches ({} failed), max {} closed nodes, {}% cache hits",
+			sum.transport, sorted[i].first, sum.duration, sum.searches, sum.failed, sum.max_closed,
+			segments == 0 ? 0 : sum.cache_hits * 100 / segments);
+	}
+}
+
+/**
+ * Print the latency percentiles of a set of timed searches to the console.
+ * @param name Name of the kind of search.
+ * @param durations Durations of the searches in microseconds; gets sorted.
+ */
+static void PrintSearchLatencies(const char *name, std::vector<uint> &durations)
+{
+	if (durations.empty()) {
+		IConsolePrint(CC_DEFAULT, "  {}: no searches", name);
+		return;
+	}
+
+	std::sort(durations.begin(), durations.end());
+	auto percentile = [&durations](uint p) { return durations[(durations.size() - 1) * p / 100]; };
+
+	uint64 total = 0;
+	for (uint duration : durations) total += duration;
+
+	IConsolePrint(CC_DEFAULT, "  {}: {} searches, {} us total, p50 {} us, p90 {} us, p99 {} us, max {} us",
+		name, durations.size(), total, percentile(50), percentile(90), percentile(99), durations.back());
+}
+
+/**
+ * Replay pathfinder searches for all vehicles of the current game and print the
+ * latency percentiles per transport type. Only searches that do not change the
+ * game state are used: reverse checks for trains and ships, and nearest depot
+ * searches for road vehicles.
+ * @param rounds The number of times every search is repeated.
+ */
+void YapfBenchmarkSearches(uint rounds)
+{
+	using namespace std::chrono;
+
+	std::vector<uint> rail, road, water;
+	auto time_search = [](std::vector<uint> &durations, auto search) {
+		auto start = high_resolution_clock::now();
+		search();
+		durations.push_back((uint)duration_cast<microseconds>(high_resolution_clock::now() - start).count());
+	};
+
+	for (uint round = 0; round < rounds; round++) {
+		for (const Train *t : Train::Iterate()) {
+			if (!t->IsFrontEngine() || t->IsInDepot() || (t->vehstatus & VS_CRASHED) != 0) continue;
+			time_search(rail, [t]() { YapfTrainCheckReverse(t); });
+		}
+		for (const RoadVehicle *rv : RoadVehicle::Iterate()) {
+			if (!rv->IsFrontEngine() || rv->IsInDepot() || (rv->vehstatus & VS_CRASHED) != 0) continue;
+			time_search(road, [rv]() { YapfRoadVehicleFindNearestDepot(rv, 0); });
+		}
+		for (const Ship *s : Ship::Iterate()) {
+			if (s->IsInDepot()) continue;
+			time_search(water, [s]() { YapfShipCheckReverse(s); });
+		}
+	}
+
+	IConsolePrint(CC_DEFAULT, "Pathfinder latencies over {} round(s):", rounds);
+	PrintSearchLatencies("rail", rail);
+	PrintSearchLatencies("road", road);
+	PrintSearchLatencies("water", water);
+}
@@ -184,7 +184,12 @@ void UnreserveRailTrack(TileIndex tile, Track t)
 }
 
 
-/** Follow a reservation starting from a specific tile to the end. */
+/**
+ * Follow a reservation starting from a specific tile to the end.
+ * The track follower skips station platforms as a whole, so the walk through
+ * a large station only costs one step per platform. The result is not cached, as
+ * reservations change whenever any train moves and a stale end would desync.
+ */
 static PBSTileInfo FollowReservation(Owner o, RailTypes rts, TileIndex tile, Trackdir trackdir, bool ignore_oneway = false)
 {
 	TileIndex start_tile = tile;
@@ -36,6 +36,8 @@ RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory sub
 	this->simplified_filename = name_without_path.substr(0, name_without_path.rfind('.'));
 	strtolower(this->simplified_filename);
 
+	this->pos = 0;
+	this->buffer = this->buffer_end = this->buffer_start;
 	this->SeekTo((size_t)pos, SEEK_SET);
 }
 
@@ -84,6 +86,13 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 {
 	if (mode == SEEK_CUR) pos += this->GetPos();
 
+	/* When the new position is within the buffer, there is no need to seek in and read from the file again. */
+	size_t buffer_pos = this->pos - (this->buffer_end - this->buffer_start);
+	if (pos >= buffer_pos && pos < this->pos) {
+		this->buffer = this->buffer_start + (pos - buffer_pos);
+		return;
+	}
+
 	this->pos = pos;
 	if (fseek(this->file_handle, this->pos, SEEK_SET) < 0) {
 		Debug(misc, 0, "Seeking in {} failed", this->filename);
@@ -137,8 +146,15 @@ uint32 RandomAccessFile::ReadDword()
  */
 void RandomAccessFile::ReadBlock(void *ptr, size_t size)
 {
-	this->SeekTo(this->GetPos(), SEEK_SET);
-	this->pos += fread(ptr, 1, size, this->file_handle);
+	/* First use what is still in the buffer. */
+	size_t buffered = std::min<size_t>(size, this->buffer_end - this->buffer);
+	memcpy(ptr, this->buffer, buffered);
+	this->buffer += buffered;
+	if (buffered == size) return;
+
+	/* The buffer is used up, so the file is at the current position; read the rest directly. */
+	this->buffer = this->buffer_end = this->buffer_start;
+	this->pos += fread(static_cast<byte *>(ptr) + buffered, 1, size - buffered, this->file_handle);
 }
 
 /**
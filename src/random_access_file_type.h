@@ -21,8 +21,8 @@
  * files to load the sprites from when needed.
  */
 class RandomAccessFile {
-	/** The number of bytes to allocate for the buffer. */
-	static constexpr int BUFFER_SIZE = 512;
+	/** The number of bytes to allocate for the buffer. Skipping sprites within the buffer does not need a seek. */
+	static constexpr int BUFFER_SIZE = 4096;
 
 	std::string filename;            ///< Full name of the file; relative path to subdir plus the extension of the file.
 	std::string simplified_filename; ///< Simplified lowecase name of the file; only the name, no path or extension.
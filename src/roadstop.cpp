@@ -123,6 +123,17 @@ void RoadStop::MakeDriveThrough()
 	this->west->length += added;
 }
 
+/**
+ * Check whether a road vehicle has entered a drive through road stop, and not yet left it.
+ * @param rv The road vehicle to check.
+ * @return True iff the vehicle is counted in the occupancy of an entry of the road stop at its tile.
+ */
+static bool IsInDriveThroughRoadStop(const RoadVehicle *rv)
+{
+	return rv->IsFrontEngine() && (rv->vehstatus & VS_CRASHED) == 0 &&
+			IsInsideMM(rv->state, RVSB_IN_DT_ROAD_STOP, RVSB_IN_DT_ROAD_STOP_END) && IsDriveThroughStopTile(rv->tile);
+}
+
 /**
  * Prepare for removal of this stop; update other neighbouring stops
  * if needed. Also update the length etc.
@@ -175,18 +186,27 @@ void RoadStop::ClearDriveThrough()
 				rs_north = RoadStop::GetByTile(north_tile, rst);
 			}
 
-			/* We have to rebuild the entries because we cannot easily determine
-			 * how full each part is. So instead of keeping and maintaining a list
-			 * of vehicles and using that to 'rebuild' the occupied state we just
-			 * rebuild it from scratch as that removes lots of maintenance code
-			 * for the vehicle list and it's faster in real games as long as you
-			 * do not keep split and merge road stop every tick by the millions. */
-			rs_south_base->east->Rebuild(rs_south_base);
-			rs_south_base->west->Rebuild(rs_south_base);
+			/* Update the lengths; the removed tile was in neither part. */
+			for (TileIndex tile = base_tile; IsDriveThroughRoadStopContinuation(base_tile, tile); tile += offset) {
+				rs_south_base->east->length += TILE_SIZE;
+				rs_south_base->west->length += TILE_SIZE;
+			}
+			rs_north->east->length -= rs_south_base->east->length + TILE_SIZE;
+			rs_north->west->length -= rs_south_base->west->length + TILE_SIZE;
 
+			/* The vehicles in the southern part leave the old entries and
+			 * enter the new ones, as if they drove from one into the other. */
 			assert(HasBit(rs_north->status, RSSFB_BASE_ENTRY));
-			rs_north->east->Rebuild(rs_north);
-			rs_north->west->Rebuild(rs_north);
+			for (const RoadVehicle *rv : RoadVehicle::Iterate()) {
+				if (!IsInDriveThroughRoadStop(rv) || GetStationIndex(rv->tile) != GetStationIndex(base_tile) || GetRoadStopType(rv->tile) != rst) continue;
+
+				RoadStop *rs = RoadStop::GetByTile(rv->tile, rst);
+				if (rs->east != rs_south_base->east) continue;
+
+				DiagDirection dir = DirToDiagDir(rv->direction);
+				rs_north->GetEntry(dir)->Leave(rv);
+				rs_south_base->GetEntry(dir)->Enter(rv);
+			}
 		} else {
 			/* Only we left, so simple update the length. */
 			rs_north->east->length -= TILE_SIZE;
@@ -209,6 +229,20 @@ void RoadStop::ClearDriveThrough()
 	this->west = nullptr;
 }
 
+/**
+ * Let all road vehicles that are in a drive through road stop enter the entry
+ * of their road stop again. Used to fill the entries after loading a game,
+ * as they are not saved.
+ */
+/* static */ void RoadStop::EnterDriveThroughVehicles()
+{
+	for (const RoadVehicle *rv : RoadVehicle::Iterate()) {
+		if (!IsInDriveThroughRoadStop(rv)) continue;
+
+		RoadStop::GetByTile(rv->tile, GetRoadStopType(rv->tile))->GetEntry(DirToDiagDir(rv->direction))->Enter(rv);
+	}
+}
+
 /**
  * Leave the road stop
  * @param rv the vehicle that leaves the stop
@@ -346,6 +380,8 @@ Vehicle *FindVehiclesInRoadStop(Vehicle *v, void *data)
 
 /**
  * Rebuild, from scratch, the vehicles and other metadata on this stop.
+ * The entries are kept up to date by the vehicles entering and leaving
+ * them, so this is only used to verify them.
  * @param rs   the roadstop this entry is part of
  * @param side the side of the road stop to look at
  */
@@ -145,6 +145,7 @@ struct RoadStop : RoadStopPool::PoolItem<&_roadstop_pool> {
 	static RoadStop *GetByTile(TileIndex tile, RoadStopType type);
 
 	static bool IsDriveThroughRoadStopContinuation(TileIndex rs, TileIndex next);
+	static void EnterDriveThroughVehicles();
 
 private:
 	Entry *east; ///< The vehicles that entered from the east
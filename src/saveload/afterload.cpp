@@ -540,6 +540,8 @@ static inline bool MayHaveBridgeAbove(TileIndex t)
 /**
  * Perform a (large) amount of savegame conversion *magic* in order to
  * load older savegames and to fill the caches for various purposes.
+ * The conversions are guarded by the savegame version they apply to, so a
+ * current savegame only pays for the sweeps that rebuild unsaved state.
  * @return True iff conversion went without a problem.
  */
 bool AfterLoadGame()
@@ -559,6 +561,7 @@ bool AfterLoadGame()
 
 	RebuildTownKdtree();
 	RebuildStationKdtree();
+	RebuildIndustryKdtree();
 	/* This needs to be done even before conversion, because some conversions will destroy objects
 	 * that otherwise won't exist in the tree. */
 	RebuildViewportKdtree();
@@ -612,14 +615,14 @@ bool AfterLoadGame()
 
 		/* In old savegame versions, the heightlevel was coded in bits 0..3 of the type field */
 		for (TileIndex t = 0; t < map_size; t++) {
-			_m[t].height = GB(_m[t].type, 0, 4);
-			SB(_m[t].type, 0, 2, GB(_me[t].m6, 0, 2));
+			_m_height[t] = GB(_m_type[t], 0, 4);
+			SB(_m_type[t], 0, 2, GB(_me[t].m6, 0, 2));
 			SB(_me[t].m6, 0, 2, 0);
 			if (MayHaveBridgeAbove(t)) {
-				SB(_m[t].type, 2, 2, GB(_me[t].m6, 6, 2));
+				SB(_m_type[t], 2, 2, GB(_me[t].m6, 6, 2));
 				SB(_me[t].m6, 6, 2, 0);
 			} else {
-				SB(_m[t].type, 2, 2, 0);
+				SB(_m_type[t], 2, 2, 0);
 			}
 		}
 	}
@@ -795,6 +798,9 @@ bool AfterLoadGame()
 		}
 	}
 
+	/* The vehicle tile hash is sized to the map, which is only known now. */
+	ResetVehicleHash();
+
 	/* Update all vehicles */
 	AfterLoadVehicles(true);
 
@@ -2619,8 +2625,7 @@ bool AfterLoadGame()
 					ClrBit(t->flags, 2);
 
 					/* Clear both bits first. */
-					ClrBit(t->gv_flags, GVF_GOINGUP_BIT);
-					ClrBit(t->gv_flags, GVF_GOINGDOWN_BIT);
+					t->SetInclination(0);
 
 					/* Crashed vehicles can't be going up/down. */
 					if (t->vehstatus & VS_CRASHED) break;
@@ -2628,13 +2633,12 @@ bool AfterLoadGame()
 					/* Only X/Y tracks can be sloped. */
 					if (t->track != TRACK_BIT_X && t->track != TRACK_BIT_Y) break;
 
-					t->gv_flags |= FixVehicleInclination(t, t->direction);
+					t->SetInclination(FixVehicleInclination(t, t->direction));
 					break;
 				}
 				case VEH_ROAD: {
 					RoadVehicle *rv = RoadVehicle::From(v);
-					ClrBit(rv->gv_flags, GVF_GOINGUP_BIT);
-					ClrBit(rv->gv_flags, GVF_GOINGDOWN_BIT);
+					rv->SetInclination(0);
 
 					/* Crashed vehicles can't be going up/down. */
 					if (rv->vehstatus & VS_CRASHED) break;
@@ -2658,7 +2662,7 @@ bool AfterLoadGame()
 						dir = INVALID_DIR;
 					}
 
-					rv->gv_flags |= FixVehicleInclination(rv, dir);
+					rv->SetInclination(FixVehicleInclination(rv, dir));
 					break;
 				}
 				case VEH_SHIP:
@@ -3157,6 +3161,10 @@ bool AfterLoadGame()
 
 	/* Road stops is 'only' updating some caches */
 	AfterLoadRoadStops();
+	RebuildLoadingStations();
+	RebuildIndustrySchedule();
+	RebuildTownGrowthSchedule();
+	RebuildTunnelBridgeIndex();
 	AfterLoadLabelMaps();
 	AfterLoadCompanyStats();
 	AfterLoadStoryBook();
@@ -397,6 +397,7 @@ struct GLOGChunkHandler : ChunkHandler {
 	void Load() const override
 	{
 		this->LoadCommon(_gamelog_action, _gamelog_actions);
+		GamelogCompact();
 	}
 
 	void LoadCheck(size_t) const override
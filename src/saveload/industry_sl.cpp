@@ -81,6 +81,9 @@ struct INDYChunkHandler : ChunkHandler {
 	{
 		SlTableHeader(_industry_desc);
 
+		/* The stored counters must be the actual counters. */
+		NormaliseIndustryCounters();
+
 		/* Write the industries */
 		for (Industry *ind : Industry::Iterate()) {
 			SlSetArrayIndex(ind->index);
@@ -40,6 +40,26 @@ static inline byte CalcOldVarLen(OldChunkType type)
 	return type_mem_size[length];
 }
 
+/**
+ *
+ * Reads the next BUFFER_SIZE bytes from the file into the buffer
+ *
+ */
+static void FillBuffer(LoadgameState *ls)
+{
+	/* Read some new bytes from the file */
+	int count = (int)fread(ls->buffer, 1, BUFFER_SIZE, ls->file);
+
+	/* We tried to read, but there is nothing in the file anymore.. */
+	if (count == 0) {
+		Debug(oldloader, 0, "Read past end of file, loading failed");
+		throw std::exception();
+	}
+
+	ls->buffer_count = count;
+	ls->buffer_cur   = 0;
+}
+
 /**
  *
  * Reads a byte from a file (do not call yourself, use ReadByte())
@@ -49,30 +69,17 @@ static byte ReadByteFromFile(LoadgameState *ls)
 {
 	/* To avoid slow reads, we read BUFFER_SIZE of bytes per time
 	and just return a byte per time */
-	if (ls->buffer_cur >= ls->buffer_count) {
-
-		/* Read some new bytes from the file */
-		int count = (int)fread(ls->buffer, 1, BUFFER_SIZE, ls->file);
-
-		/* We tried to read, but there is nothing in the file anymore.. */
-		if (count == 0) {
-			Debug(oldloader, 0, "Read past end of file, loading failed");
-			throw std::exception();
-		}
-
-		ls->buffer_count = count;
-		ls->buffer_cur   = 0;
-	}
+	if (ls->buffer_cur >= ls->buffer_count) FillBuffer(ls);
 
 	return ls->buffer[ls->buffer_cur++];
 }
 
 /**
  *
- * Reads a byte from the buffer and decompress if needed
+ * Starts reading the next RLE chunk when the current one is finished
  *
  */
-byte ReadByte(LoadgameState *ls)
+static inline void ReadChunkHeader(LoadgameState *ls)
 {
 	/* Old savegames have a nice compression algorithm (RLE)
 	which means that we have a chunk, which starts with a length
@@ -94,6 +101,16 @@ byte ReadByte(LoadgameState *ls)
 			ls->chunk_size  = new_byte + 1;
 		}
 	}
+}
+
+/**
+ *
+ * Reads a byte from the buffer and decompress if needed
+ *
+ */
+byte ReadByte(LoadgameState *ls)
+{
+	ReadChunkHeader(ls);
 
 	ls->total_read++;
 	ls->chunk_size--;
@@ -101,6 +118,37 @@ byte ReadByte(LoadgameState *ls)
 	return ls->decoding ? ls->decode_char : ReadByteFromFile(ls);
 }
 
+/**
+ *
+ * Reads a number of bytes at once, filling or copying whole RLE chunks instead of going byte by byte
+ *
+ */
+void ReadBytes(LoadgameState *ls, byte *dest, uint length)
+{
+	while (length != 0) {
+		ReadChunkHeader(ls);
+
+		uint count = std::min(length, ls->chunk_size);
+		if (ls->decoding) {
+			memset(dest, ls->decode_char, count);
+		} else {
+			for (uint copied = 0; copied != count;) {
+				if (ls->buffer_cur >= ls->buffer_count) FillBuffer(ls);
+
+				uint to_copy = std::min(count - copied, ls->buffer_count - ls->buffer_cur);
+				memcpy(dest + copied, ls->buffer + ls->buffer_cur, to_copy);
+				ls->buffer_cur += to_copy;
+				copied += to_copy;
+			}
+		}
+
+		ls->total_read += count;
+		ls->chunk_size -= count;
+		dest += count;
+		length -= count;
+	}
+}
+
 /**
  *
  * Loads a chunk from the old savegame
@@ -118,6 +166,14 @@ bool LoadChunk(LoadgameState *ls, void *base, const OldChunks *chunks)
 		byte *ptr = (byte*)chunk->ptr;
 		if (chunk->type & OC_DEREFERENCE_POINTER) ptr = *(byte**)ptr;
 
+		/* Byte arrays need no conversion, so read them in one go */
+		if (GetOldChunkType(chunk->type) == OC_SIMPLE && chunk->ptr != nullptr && chunk->amount > 1 &&
+				(GetOldChunkFileType(chunk->type) == OC_FILE_U8 || GetOldChunkFileType(chunk->type) == OC_FILE_I8) &&
+				(GetOldChunkVarType(chunk->type) == OC_VAR_U8 || GetOldChunkVarType(chunk->type) == OC_VAR_I8)) {
+			ReadBytes(ls, ptr, chunk->amount);
+			continue;
+		}
+
 		for (uint i = 0; i < chunk->amount; i++) {
 			/* Handle simple types */
 			if (GetOldChunkType(chunk->type) != 0) {
@@ -98,6 +98,7 @@ static_assert(sizeof(TileIndex) == 4);
 
 extern uint _bump_assert_value;
 byte ReadByte(LoadgameState *ls);
+void ReadBytes(LoadgameState *ls, byte *dest, uint length);
 bool LoadChunk(LoadgameState *ls, void *base, const OldChunks *chunks);
 
 bool LoadTTDMain(LoadgameState *ls);
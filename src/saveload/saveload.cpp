@@ -43,6 +43,7 @@
 #include "../fios.h"
 #include "../error.h"
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <vector>
 #include <string>
@@ -66,6 +67,8 @@ uint32 _ttdp_version;         ///< version of TTDP savegame (if applicable)
 SaveLoadVersion _sl_version;  ///< the major savegame version identifier
 byte   _sl_minor_version;     ///< the minor savegame version, DO NOT USE!
 std::string _savegame_format; ///< how to compress savegames
+std::string _autosave_format; ///< how to compress autosaves, empty to use #_savegame_format
+std::string _network_map_format; ///< how to compress the map sent to joining clients, empty to use #_savegame_format
 bool _do_autosave;            ///< are we doing an autosave at the moment?
 
 /** What are we currently doing? */
@@ -102,20 +105,42 @@ struct ReadBuffer {
 	{
 	}
 
-	inline byte ReadByte()
+	/** Read the next block of data from the filter into the buffer. */
+	void Fill()
 	{
-		if (this->bufp == this->bufe) {
-			size_t len = this->reader->Read(this->buf, lengthof(this->buf));
-			if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
+		size_t len = this->reader->Read(this->buf, lengthof(this->buf));
+		if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
 
-			this->read += len;
-			this->bufp = this->buf;
-			this->bufe = this->buf + len;
-		}
+		this->read += len;
+		this->bufp = this->buf;
+		this->bufe = this->buf + len;
+	}
+
+	inline byte ReadByte()
+	{
+		if (this->bufp == this->bufe) this->Fill();
 
 		return *this->bufp++;
 	}
 
+	/**
+	 * Read a number of bytes at once.
+	 * @param ptr The destination of the bytes.
+	 * @param length The number of bytes to read.
+	 */
+	void CopyBytes(byte *ptr, size_t length)
+	{
+		while (length != 0) {
+			if (this->bufp == this->bufe) this->Fill();
+
+			size_t to_copy = std::min<size_t>(length, this->bufe - this->bufp);
+			memcpy(ptr, this->bufp, to_copy);
+			this->bufp += to_copy;
+			ptr += to_copy;
+			length -= to_copy;
+		}
+	}
+
 	/**
 	 * Get the size of the memory dump made so far.
 	 * @return The size.
@@ -145,6 +170,17 @@ struct MemoryDumper {
 		}
 	}
 
+	/**
+	 * Start writing into a new block of memory.
+	 * The block is not cleared, as only the part that has been written to is ever flushed.
+	 */
+	void AllocateBlock()
+	{
+		this->buf = MallocT<byte>(MEMORY_CHUNK_SIZE);
+		this->blocks.push_back(this->buf);
+		this->bufe = this->buf + MEMORY_CHUNK_SIZE;
+	}
+
 	/**
 	 * Write a single byte into the dumper.
 	 * @param b The byte to write.
@@ -152,15 +188,30 @@ struct MemoryDumper {
 	inline void WriteByte(byte b)
 	{
 		/* Are we at the end of this chunk? */
-		if (this->buf == this->bufe) {
-			this->buf = CallocT<byte>(MEMORY_CHUNK_SIZE);
-			this->blocks.push_back(this->buf);
-			this->bufe = this->buf + MEMORY_CHUNK_SIZE;
-		}
+		if (this->buf == this->bufe) this->AllocateBlock();
 
 		*this->buf++ = b;
 	}
 
+	/**
+	 * Write a number of bytes at once into the dumper.
+	 * @param ptr The bytes to write.
+	 * @param length The number of bytes to write.
+	 */
+	void CopyBytes(const byte *ptr, size_t length)
+	{
+		while (length != 0) {
+			/* Are we at the end of this chunk? */
+			if (this->buf == this->bufe) this->AllocateBlock();
+
+			size_t to_copy = std::min<size_t>(length, this->bufe - this->buf);
+			memcpy(this->buf, ptr, to_copy);
+			this->buf += to_copy;
+			ptr += to_copy;
+			length -= to_copy;
+		}
+	}
+
 	/**
 	 * Flush this dumper into a writer.
 	 * @param writer The filter we want to use.
@@ -203,6 +254,7 @@ struct SaveLoadParams {
 
 	MemoryDumper *dumper;                ///< Memory dumper to write the savegame to.
 	SaveFilter *sf;                      ///< Filter to write the savegame to.
+	std::string save_format;             ///< Format (and compression level) to write the savegame in.
 
 	ReadBuffer *reader;                  ///< Savegame reading buffer.
 	LoadFilter *lf;                      ///< Filter to read the savegame from.
@@ -779,10 +831,10 @@ static void SlCopyBytes(void *ptr, size_t length)
 	switch (_sl.action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD:
-			for (; length != 0; length--) *p++ = SlReadByte();
+			_sl.reader->CopyBytes(p, length);
 			break;
 		case SLA_SAVE:
-			for (; length != 0; length--) SlWriteByte(*p++);
+			_sl.dumper->CopyBytes(p, length);
 			break;
 		default: NOT_REACHED();
 	}
@@ -1091,6 +1143,42 @@ static void SlStdString(void *ptr, VarType conv)
 	}
 }
 
+/**
+ * Copy a list of integers that have the same size in memory and in the savegame.
+ * The savegame stores them big endian, so they are copied in bulk and only byte
+ * swapped when needed, instead of being converted one by one.
+ * @param object The integers being manipulated.
+ * @param length The number of integers.
+ */
+template <typename T>
+static void SlCopyBigEndian(T *object, size_t length)
+{
+	static_assert(sizeof(T) == 2 || sizeof(T) == 4);
+
+#if TTD_ENDIAN == TTD_BIG_ENDIAN
+	SlCopyBytes(object, length * sizeof(T));
+#else
+	auto swap = [](T v) -> T {
+		if constexpr (sizeof(T) == 2) return BSWAP16(v);
+		return BSWAP32(v);
+	};
+
+	if (_sl.action == SLA_SAVE) {
+		T buf[1024];
+		while (length != 0) {
+			size_t count = std::min(length, lengthof(buf));
+			for (size_t i = 0; i < count; i++) buf[i] = swap(object[i]);
+			SlCopyBytes(buf, count * sizeof(T));
+			object += count;
+			length -= count;
+		}
+	} else {
+		SlCopyBytes(object, length * sizeof(T));
+		for (size_t i = 0; i < length; i++) object[i] = swap(object[i]);
+	}
+#endif /* TTD_ENDIAN == TTD_BIG_ENDIAN */
+}
+
 /**
  * Internal function to save/Load a list of SL_VARs.
  * SlCopy() and SlArray() are very similar, with the exception of the header.
@@ -1129,6 +1217,10 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
 	 * conversion is needed, use specialized copy-copy function to speed up things */
 	if (conv == SLE_INT8 || conv == SLE_UINT8) {
 		SlCopyBytes(object, length);
+	} else if (conv == SLE_INT16 || conv == SLE_UINT16) {
+		SlCopyBigEndian((uint16 *)object, length);
+	} else if (conv == SLE_INT32 || conv == SLE_UINT32) {
+		SlCopyBigEndian((uint32 *)object, length);
 	} else {
 		byte *a = (byte*)object;
 		byte mem_size = SlCalcConvMemLen(conv);
@@ -2269,11 +2361,27 @@ static void SlSaveChunk(const ChunkHandler &ch)
 	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
+/**
+ * Show the size of a chunk and the time it took to save or load it, for profiling the chunk handlers.
+ * @param action Whether the chunk was saved or loaded.
+ * @param id The chunk in question.
+ * @param bytes The uncompressed size of the chunk.
+ * @param start When saving or loading the chunk started.
+ */
+static void SlDebugChunkTiming(const char *action, uint32 id, size_t bytes, std::chrono::steady_clock::time_point start)
+{
+	Debug(sl, 3, "{} chunk {:c}{:c}{:c}{:c}: {} bytes in {} us", action, id >> 24, id >> 16, id >> 8, id, bytes,
+		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
 /** Save all chunks */
 static void SlSaveChunks()
 {
-	for (auto &ch : ChunkHandlers()) {
+	for (const ChunkHandler &ch : ChunkHandlers()) {
+		auto start = std::chrono::steady_clock::now();
+		size_t offs = _sl.dumper->GetSize();
 		SlSaveChunk(ch);
+		if (ch.type != CH_READONLY) SlDebugChunkTiming("Saved", ch.id, _sl.dumper->GetSize() - offs, start);
 	}
 
 	/* Terminator */
@@ -2303,13 +2411,25 @@ static void SlLoadChunks()
 
 		ch = SlFindChunkHandler(id);
 		if (ch == nullptr) SlErrorCorrupt("Unknown chunk type");
+
+		auto start = std::chrono::steady_clock::now();
+		size_t offs = _sl.reader->GetSize();
 		SlLoadChunk(*ch);
+		SlDebugChunkTiming("Loaded", id, _sl.reader->GetSize() - offs, start);
 	}
 }
 
-/** Load all chunks for savegame checking */
+/**
+ * Load all chunks for savegame checking.
+ * Only a few chunks fill #_load_check_data, so once all of those have been
+ * read, the remainder of the savegame is not decompressed anymore.
+ */
 static void SlLoadCheckChunks()
 {
+	/* The chunks with a LoadCheck that fills _load_check_data. */
+	static const uint32 load_check_chunks[] = { 'GLOG', 'MAPS', 'DATE', 'PATS', 'PLYR', 'NGRF' };
+	uint remaining = lengthof(load_check_chunks);
+
 	uint32 id;
 	const ChunkHandler *ch;
 
@@ -2319,6 +2439,8 @@ static void SlLoadCheckChunks()
 		ch = SlFindChunkHandler(id);
 		if (ch == nullptr) SlErrorCorrupt("Unknown chunk type");
 		SlLoadCheckChunk(*ch);
+
+		if (std::find(std::begin(load_check_chunks), std::end(load_check_chunks), id) != std::end(load_check_chunks) && --remaining == 0) break;
 	}
 }
 
@@ -2783,6 +2905,126 @@ struct LZMASaveFilter : SaveFilter {
 
 #endif /* WITH_LIBLZMA */
 
+/********************************************
+ ********** START OF ZSTD CODE **************
+ ********************************************/
+
+#if defined(WITH_ZSTD)
+#include <zstd.h>
+
+/** Filter using Zstandard compression. */
+struct ZSTDLoadFilter : LoadFilter {
+	ZSTD_DCtx *zstd;                   ///< Stream state that we are reading from.
+	byte fread_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for reading from the file.
+	ZSTD_inBuffer input;               ///< The part of #fread_buf that still has to be decompressed.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	ZSTDLoadFilter(LoadFilter *chain) : LoadFilter(chain), input({this->fread_buf, 0, 0})
+	{
+		this->zstd = ZSTD_createDCtx();
+		if (this->zstd == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize decompressor");
+	}
+
+	/** Clean everything up. */
+	~ZSTDLoadFilter()
+	{
+		ZSTD_freeDCtx(this->zstd);
+	}
+
+	size_t Read(byte *buf, size_t size) override
+	{
+		ZSTD_outBuffer output = {buf, size, 0};
+
+		while (output.pos < output.size) {
+			/* read more bytes from the file? */
+			if (this->input.pos == this->input.size) {
+				this->input.size = this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				this->input.pos = 0;
+			}
+
+			size_t decompressed = output.pos;
+			size_t r = ZSTD_decompressStream(this->zstd, &output, &this->input);
+			if (ZSTD_isError(r)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+
+			/* The file has been read completely and nothing is left in the decompressor. */
+			if (this->input.size == 0 && output.pos == decompressed) break;
+		}
+
+		return output.pos;
+	}
+};
+
+/** Filter using Zstandard compression. */
+struct ZSTDSaveFilter : SaveFilter {
+	ZSTD_CCtx *zstd; ///< Stream state that we are writing to.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param compression_level The requested level of compression.
+	 */
+	ZSTDSaveFilter(SaveFilter *chain, byte compression_level) : SaveFilter(chain)
+	{
+		this->zstd = ZSTD_createCCtx();
+		if (this->zstd == nullptr ||
+				ZSTD_isError(ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_compressionLevel, compression_level)) ||
+				/* The map arrays are saved one after another, so matches are often a whole map array apart. */
+				ZSTD_isError(ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_enableLongDistanceMatching, 1))) {
+			SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
+		}
+
+		/* Let libzstd compress blocks of the savegame on worker threads; the result is still a single regular frame.
+		 * This fails when libzstd is built without multithreading support, in which case we just compress on this thread. */
+		uint threads = std::thread::hardware_concurrency();
+		if (threads > 1) ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_nbWorkers, threads);
+	}
+
+	/** Clean up what we allocated. */
+	~ZSTDSaveFilter()
+	{
+		ZSTD_freeCCtx(this->zstd);
+	}
+
+	/**
+	 * Helper loop for writing the data.
+	 * @param p    The bytes to write.
+	 * @param len  Amount of bytes to write.
+	 * @param mode Mode for ZSTD_compressStream2.
+	 */
+	void WriteLoop(byte *p, size_t len, ZSTD_EndDirective mode)
+	{
+		byte buf[MEMORY_CHUNK_SIZE]; // output buffer
+		ZSTD_inBuffer input = {p, len, 0};
+		bool finished;
+		do {
+			ZSTD_outBuffer output = {buf, sizeof(buf), 0};
+			size_t r = ZSTD_compressStream2(this->zstd, &output, &input, mode);
+			if (ZSTD_isError(r)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+
+			if (output.pos != 0) this->chain->Write(buf, output.pos);
+
+			/* When ending the stream everything has to be flushed, otherwise only the input has to be consumed. */
+			finished = (mode == ZSTD_e_end) ? r == 0 : input.pos == input.size;
+		} while (!finished);
+	}
+
+	void Write(byte *buf, size_t size) override
+	{
+		this->WriteLoop(buf, size, ZSTD_e_continue);
+	}
+
+	void Finish() override
+	{
+		this->WriteLoop(nullptr, 0, ZSTD_e_end);
+		this->chain->Finish();
+	}
+};
+
+#endif /* WITH_ZSTD */
+
 /*******************************************
  ************* END OF CODE *****************
  *******************************************/
@@ -2818,6 +3060,13 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{"zlib",   TO_BE32X('OTTZ'), nullptr,                            nullptr,                            0, 0, 0},
 #endif
+#if defined(WITH_ZSTD)
+	/* Listed before lzma, so lzma stays the default format and games saved by default remain loadable without libzstd.
+	 * Level 3 is the default level of libzstd itself; long distance matching is always enabled. */
+	{"zstd",   TO_BE32X('OTTS'), CreateLoadFilter<ZSTDLoadFilter>,   CreateSaveFilter<ZSTDSaveFilter>,   1, 3, 19},
+#else
+	{"zstd",   TO_BE32X('OTTS'), nullptr,                            nullptr,                            0, 0, 0},
+#endif
 #if defined(WITH_LIBLZMA)
 	/* Level 2 compression is speed wise as fast as zlib level 6 compression (old default), but results in ~10% smaller saves.
 	 * Higher compression levels are possible, and might improve savegame size by up to 25%, but are also up to 10 times slower.
@@ -2973,7 +3222,7 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
 	try {
 		byte compression;
-		const SaveLoadFormat *fmt = GetSavegameFormat(_savegame_format, &compression);
+		const SaveLoadFormat *fmt = GetSavegameFormat(_sl.save_format, &compression);
 
 		/* We have written our stuff to memory, now write it to file! */
 		uint32 hdr[2] = { fmt->tag, TO_BE32(SAVEGAME_VERSION << 16) };
@@ -3025,19 +3274,25 @@ void WaitTillSaved()
  * using the writer, either in threaded mode if possible, or single-threaded.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param format   The compression format (and level) to write the savegame with.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
+static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded, const std::string &format)
 {
 	assert(!_sl.saveinprogress);
 
 	_sl.dumper = new MemoryDumper();
 	_sl.sf = writer;
+	_sl.save_format = format;
 
 	_sl_version = SAVEGAME_VERSION;
 
+	/* Only this part runs while the game is paused; the compression and writing happen in the background. */
+	auto start = std::chrono::steady_clock::now();
 	SaveViewportBeforeSaveGame();
 	SlSaveChunks();
+	Debug(sl, 2, "Serialised {} bytes in {} ms", _sl.dumper->GetSize(),
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
 
 	SaveFileStart();
 
@@ -3057,13 +3312,14 @@ static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
  * Save the game using a (writer) filter.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param format   The compression format (and level) to write the savegame with.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-SaveOrLoadResult SaveWithFilter(SaveFilter *writer, bool threaded)
+SaveOrLoadResult SaveWithFilter(SaveFilter *writer, bool threaded, const std::string &format)
 {
 	try {
 		_sl.action = SLA_SAVE;
-		return DoSave(writer, threaded);
+		return DoSave(writer, threaded, format);
 	} catch (...) {
 		ClearSaveLoadState();
 		return SL_ERROR;
@@ -3185,8 +3441,11 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 		SlLoadCheckChunks();
 	} else {
 		/* Load chunks and resolve references */
+		auto start = std::chrono::steady_clock::now();
 		SlLoadChunks();
 		SlFixPointers();
+		Debug(sl, 2, "Loaded chunks in {} ms",
+			std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
 	}
 
 	ClearSaveLoadState();
@@ -3201,10 +3460,13 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 
 		/* After loading fix up savegame for any internal changes that
 		 * might have occurred since then. If it fails, load back the old game. */
+		auto start = std::chrono::steady_clock::now();
 		if (!AfterLoadGame()) {
 			GamelogStopAction();
 			return SL_REINIT;
 		}
+		Debug(sl, 2, "Converted the savegame and rebuilt caches in {} ms",
+			std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
 
 		GamelogStopAction();
 	}
@@ -3304,7 +3566,8 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 			Debug(desync, 1, "save: {:08x}; {:02x}; {}", _date, _date_fract, filename);
 			if (_network_server || !_settings_client.gui.threaded_saves) threaded = false;
 
-			return DoSave(new FileWriter(fh), threaded);
+			/* Autosaves are made often, so they may use a quicker format than the games saved by the user. */
+			return DoSave(new FileWriter(fh), threaded, (_do_autosave && !_autosave_format.empty()) ? _autosave_format : _savegame_format);
 		}
 
 		/* LOAD game */
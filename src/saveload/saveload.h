@@ -384,7 +384,7 @@ void DoExitSave();
 
 void DoAutoOrNetsave(FiosNumberedSaveName &counter);
 
-SaveOrLoadResult SaveWithFilter(struct SaveFilter *writer, bool threaded);
+SaveOrLoadResult SaveWithFilter(struct SaveFilter *writer, bool threaded, const std::string &format);
 SaveOrLoadResult LoadWithFilter(struct LoadFilter *reader);
 
 typedef void AutolengthProc(void *arg);
@@ -1143,6 +1143,8 @@ static inline void SlSkipBytes(size_t length)
 }
 
 extern std::string _savegame_format;
+extern std::string _autosave_format;
+extern std::string _network_map_format;
 extern bool _do_autosave;
 
 #endif /* SAVELOAD_H */
@@ -134,13 +134,8 @@ void AfterLoadRoadStops()
 	for (RoadStop *rs : RoadStop::Iterate()) {
 		if (IsDriveThroughStopTile(rs->xy)) rs->MakeDriveThrough();
 	}
-	/* And then rebuild the data in those entries */
-	for (RoadStop *rs : RoadStop::Iterate()) {
-		if (!HasBit(rs->status, RoadStop::RSSFB_BASE_ENTRY)) continue;
-
-		rs->GetEntry(DIAGDIR_NE)->Rebuild(rs);
-		rs->GetEntry(DIAGDIR_NW)->Rebuild(rs);
-	}
+	/* And then fill those entries with the vehicles in them */
+	RoadStop::EnterDriveThroughVehicles();
 }
 
 static const SaveLoad _roadstop_desc[] = {
@@ -284,6 +284,9 @@ struct CITYChunkHandler : ChunkHandler {
 		SlTableHeader(_town_desc);
 
 		for (Town *t : Town::Iterate()) {
+			/* The stored grow counter is not kept up to date while the town is growing. */
+			t->grow_counter = t->GetGrowCounter();
+
 			SlSetArrayIndex(t->index);
 			SlObject(t, _town_desc);
 		}
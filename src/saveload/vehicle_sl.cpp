@@ -473,6 +473,7 @@ void AfterLoadVehicles(bool part_of_load)
 		v->UpdateDeltaXY();
 		v->coord.left = INVALID_COORD;
 		v->sprite_cache.old_coord.left = INVALID_COORD;
+		v->sprite_cache.last_direction = INVALID_DIR;
 		v->UpdatePosition();
 		v->UpdateViewport(false);
 	}
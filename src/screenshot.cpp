@@ -41,6 +41,20 @@ static char _screenshot_name[128];    ///< Filename of the screenshot file.
 char _full_screenshot_name[MAX_PATH]; ///< Pathname of the screenshot file.
 uint _heightmap_highest_peak;         ///< When saving a heightmap, this contains the highest peak on the map.
 
+/**
+ * Get the number of lines to render per call of the screenshot callback.
+ * Every call has to handle the tiles and sprites around the edges of its lines
+ * again, so taller strips make large world screenshots a lot quicker, while the
+ * buffer stays bounded by the size of the image's width.
+ * @param bytes_per_line Number of bytes of one line in the buffer.
+ * @return Number of lines, between 16 and 128.
+ */
+static uint GetScreenshotMaxLines(uint bytes_per_line)
+{
+	/* Try to use 32 MiB of memory, store between 16 and 128 lines */
+	return Clamp((32U << 20) / bytes_per_line, 16, 128);
+}
+
 /**
  * Callback function signature for generating lines of pixel data to be written to the screenshot file.
  * @param userdata Pointer to user data.
@@ -175,8 +189,7 @@ static bool MakeBMPImage(const char *name, ScreenshotCallback *callb, void *user
 		}
 	}
 
-	/* Try to use 64k of memory, store between 16 and 128 lines */
-	uint maxlines = Clamp(65536 / (w * pixelformat / 8), 16, 128); // number of lines per iteration
+	uint maxlines = GetScreenshotMaxLines(w * pixelformat / 8); // number of lines per iteration
 
 	uint8 *buff = MallocT<uint8>(maxlines * w * pixelformat / 8); // buffer which is rendered to
 	uint8 *line = AllocaM(uint8, bytewidth); // one line, stored to file
@@ -368,8 +381,7 @@ static bool MakePNGImage(const char *name, ScreenshotCallback *callb, void *user
 #endif /* TTD_ENDIAN == TTD_LITTLE_ENDIAN */
 	}
 
-	/* use by default 64k temp memory */
-	maxlines = Clamp(65536 / w, 16, 128);
+	maxlines = GetScreenshotMaxLines(w * bpp);
 
 	/* now generate the bitmap bits */
 	void *buff = CallocT<uint8>(w * maxlines * bpp); // by default generate 128 lines at a time.
@@ -475,8 +487,7 @@ static bool MakePCXImage(const char *name, ScreenshotCallback *callb, void *user
 		return false;
 	}
 
-	/* use by default 64k temp memory */
-	maxlines = Clamp(65536 / w, 16, 128);
+	maxlines = GetScreenshotMaxLines(w);
 
 	/* now generate the bitmap bits */
 	uint8 *buff = CallocT<uint8>(w * maxlines); // by default generate 128 lines at a time.
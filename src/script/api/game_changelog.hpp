@@ -17,6 +17,12 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li GSTileList::ValuateTileProperty
+ * \li GSEventController::DisableEvent
+ * \li GSEventController::EnableEvent
+ * \li GSEventController::IsEventEnabled
+ *
  * \b 1.11.0
  *
  * API additions:
@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_event_types.hpp"
 
+#include <bitset>
 #include <queue>
 
 #include "../../safeguards.h"
@@ -17,6 +18,7 @@
 /** The queue of events for a script. */
 struct ScriptEventData {
 	std::queue<ScriptEvent *> stack; ///< The actual queue.
+	std::bitset<64> disabled;        ///< Event types the script does not want to receive.
 };
 
 /* static */ void ScriptEventController::CreateEventPointer()
@@ -41,18 +43,22 @@ struct ScriptEventData {
 	delete data;
 }
 
-/* static */ bool ScriptEventController::IsEventWaiting()
+/* static */ ScriptEventData *ScriptEventController::GetEventData()
 {
 	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
-	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+	return (ScriptEventData *)ScriptObject::GetEventPointer();
+}
+
+/* static */ bool ScriptEventController::IsEventWaiting()
+{
+	ScriptEventData *data = GetEventData();
 
 	return !data->stack.empty();
 }
 
 /* static */ ScriptEvent *ScriptEventController::GetNextEvent()
 {
-	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
-	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+	ScriptEventData *data = GetEventData();
 
 	if (data->stack.empty()) return nullptr;
 
@@ -63,10 +69,29 @@ struct ScriptEventData {
 
 /* static */ void ScriptEventController::InsertEvent(ScriptEvent *event)
 {
-	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
-	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+	ScriptEventData *data = GetEventData();
+
+	if ((uint)event->GetEventType() < data->disabled.size() && data->disabled.test(event->GetEventType())) return;
 
 	event->AddRef();
 	data->stack.push(event);
 }
 
+/* static */ void ScriptEventController::DisableEvent(ScriptEvent::ScriptEventType type)
+{
+	ScriptEventData *data = GetEventData();
+	if ((uint)type < data->disabled.size()) data->disabled.set(type);
+}
+
+/* static */ void ScriptEventController::EnableEvent(ScriptEvent::ScriptEventType type)
+{
+	ScriptEventData *data = GetEventData();
+	if ((uint)type < data->disabled.size()) data->disabled.reset(type);
+}
+
+/* static */ bool ScriptEventController::IsEventEnabled(ScriptEvent::ScriptEventType type)
+{
+	ScriptEventData *data = GetEventData();
+	return (uint)type >= data->disabled.size() || !data->disabled.test(type);
+}
+
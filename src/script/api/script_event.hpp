@@ -99,8 +99,32 @@ public:
 	 */
 	static ScriptEvent *GetNextEvent();
 
+	/**
+	 * Stop queueing events of the given type for this script.
+	 * Events of this type that are already waiting stay in the queue.
+	 * @param type The type of events to ignore from now on.
+	 * @note The set of ignored events is not stored in the savegame; call
+	 *  this again after loading a game.
+	 */
+	static void DisableEvent(ScriptEvent::ScriptEventType type);
+
+	/**
+	 * Queue events of the given type for this script again.
+	 * All event types are enabled by default.
+	 * @param type The type of events to receive from now on.
+	 */
+	static void EnableEvent(ScriptEvent::ScriptEventType type);
+
+	/**
+	 * Check whether events of the given type are queued for this script.
+	 * @param type The type of events to check.
+	 * @return True if events of this type are put in the queue.
+	 */
+	static bool IsEventEnabled(ScriptEvent::ScriptEventType type);
+
 	/**
 	 * Insert an event to the queue for the company.
+	 * Events of a type the script disabled are not queued.
 	 * @param event The event to insert.
 	 * @api -all
 	 */
@@ -117,6 +141,12 @@ private:
 	 * Create the event pointer.
 	 */
 	static void CreateEventPointer();
+
+	/**
+	 * Get the event data of the active script, creating it when needed.
+	 * @return The event data.
+	 */
+	static struct ScriptEventData *GetEventData();
 };
 
 #endif /* SCRIPT_EVENT_HPP */
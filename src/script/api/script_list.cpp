@@ -16,407 +16,291 @@
 #include "../../safeguards.h"
 
 /**
- * Base class for any ScriptList sorter.
+ * Get the position of an item in the sort order of the current sorter type.
+ * @param item The item.
+ * @param value The value of the item.
+ * @return The position to store in the index.
  */
-class ScriptListSorter {
-protected:
-	ScriptList *list;       ///< The list that's being sorted.
-	bool has_no_more_items; ///< Whether we have more items to iterate over.
-	int64 item_next;        ///< The next item we will show.
-
-public:
-	/**
-	 * Virtual dtor, needed to mute warnings.
-	 */
-	virtual ~ScriptListSorter() { }
-
-	/**
-	 * Get the first item of the sorter.
-	 */
-	virtual int64 Begin() = 0;
-
-	/**
-	 * Stop iterating a sorter.
-	 */
-	virtual void End() = 0;
-
-	/**
-	 * Get the next item of the sorter.
-	 */
-	virtual int64 Next() = 0;
-
-	/**
-	 * See if the sorter has reached the end.
-	 */
-	bool IsEnd()
-	{
-		return this->list->buckets.empty() || this->has_no_more_items;
-	}
-
-	/**
-	 * Callback from the list if an item gets removed.
-	 */
-	virtual void Remove(int item) = 0;
-
-	/**
-	 * Attach the sorter to a new list. This assumes the content of the old list has been moved to
-	 * the new list, too, so that we don't have to invalidate any iterators. Note that std::swap
-	 * doesn't invalidate iterators on lists and maps, so that should be safe.
-	 * @param target New list to attach to.
-	 */
-	virtual void Retarget(ScriptList *new_list)
-	{
-		this->list = new_list;
-	}
-};
+ScriptList::ScriptListKey ScriptList::MakeKey(int64 item, int64 value) const
+{
+	return this->sorter_type == SORT_BY_VALUE ? ScriptListKey(value, item) : ScriptListKey(item, value);
+}
 
 /**
- * Sort by value, ascending.
+ * Get the item belonging to a position in the index.
+ * @param key The position.
+ * @return The item.
  */
-class ScriptListSorterValueAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterValueAscending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	int64 Begin()
-	{
-		if (this->list->buckets.empty()) return 0;
-		this->has_no_more_items = false;
+int64 ScriptList::GetKeyItem(const ScriptListKey &key) const
+{
+	return this->sorter_type == SORT_BY_VALUE ? key.second : key.first;
+}
 
-		this->bucket_iter = this->list->buckets.begin();
-		this->bucket_list = &(*this->bucket_iter).second;
-		this->bucket_list_iter = this->bucket_list->begin();
-		this->item_next = *this->bucket_list_iter;
+/**
+ * Check whether a position in the index still belongs to an item in the list.
+ * Removing an item or changing its value does not remove its old position
+ * from the index; those positions are skipped instead.
+ * @param key The position.
+ * @return True if the item is in the list with that value.
+ */
+bool ScriptList::IsKeyValid(const ScriptListKey &key) const
+{
+	int64 item  = this->sorter_type == SORT_BY_VALUE ? key.second : key.first;
+	int64 value = this->sorter_type == SORT_BY_VALUE ? key.first : key.second;
 
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
+	ScriptListMap::const_iterator item_iter = this->items.find(item);
+	return item_iter != this->items.end() && item_iter->second == value;
+}
 
-	void End()
-	{
-		this->bucket_list = nullptr;
-		this->has_no_more_items = true;
-		this->item_next = 0;
+/**
+ * (Re)build the index from scratch by sorting the positions of all items.
+ */
+void ScriptList::BuildIndex()
+{
+	this->index.clear();
+	this->index.reserve(this->items.size());
+	for (const auto &item : this->items) {
+		this->index.push_back(this->MakeKey(item.first, item.second));
 	}
+	std::sort(this->index.begin(), this->index.end());
 
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
-		}
+	this->pending.clear();
+	this->index_valid = true;
+	this->index_stale = 0;
+	this->index_cursor_valid = false;
+}
 
-		this->bucket_list_iter++;
-		if (this->bucket_list_iter == this->bucket_list->end()) {
-			this->bucket_iter++;
-			if (this->bucket_iter == this->list->buckets.end()) {
-				this->bucket_list = nullptr;
-				return;
-			}
-			this->bucket_list = &(*this->bucket_iter).second;
-			this->bucket_list_iter = this->bucket_list->begin();
-		}
-		this->item_next = *this->bucket_list_iter;
+/**
+ * Make sure the index holds exactly the positions of all items, so it can
+ * be used to find the items by their place in the sort order.
+ */
+void ScriptList::CompactIndex()
+{
+	if (!this->index_valid) {
+		this->BuildIndex();
+		return;
 	}
+	if (this->pending.empty() && this->index_stale == 0) return;
 
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
+	auto is_stale = [this](const ScriptListKey &key) { return !this->IsKeyValid(key); };
+	this->index.erase(std::remove_if(this->index.begin(), this->index.end(), is_stale), this->index.end());
+	this->pending.erase(std::remove_if(this->pending.begin(), this->pending.end(), is_stale), this->pending.end());
 
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
+	size_t middle = this->index.size();
+	this->index.insert(this->index.end(), this->pending.begin(), this->pending.end());
+	std::inplace_merge(this->index.begin(), this->index.begin() + middle, this->index.end());
+	/* An item that got its old value back is valid in both lists. */
+	this->index.erase(std::unique(this->index.begin(), this->index.end()), this->index.end());
 
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
+	this->pending.clear();
+	this->index_stale = 0;
+	this->index_cursor_valid = false;
+}
 
 /**
- * Sort by value, descending.
+ * Add the position of an item that has been added or has changed value.
+ * @param item The item.
+ * @param value The (new) value of the item.
  */
-class ScriptListSorterValueDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterValueDescending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
+void ScriptList::IndexAdd(int64 item, int64 value)
+{
+	if (!this->index_valid) return;
 
-	int64 Begin()
-	{
-		if (this->list->buckets.empty()) return 0;
-		this->has_no_more_items = false;
+	/* Without an iteration in progress it is cheaper to sort everything again when it is needed. */
+	if (this->IsIterationEnd()) {
+		this->index_valid = false;
+		return;
+	}
 
-		/* Go to the end of the bucket-list */
-		this->bucket_iter = this->list->buckets.end();
-		--this->bucket_iter;
-		this->bucket_list = &(*this->bucket_iter).second;
+	ScriptListKey key = this->MakeKey(item, value);
+	this->pending.insert(std::upper_bound(this->pending.begin(), this->pending.end(), key), key);
+	if (this->pending.size() > std::max<size_t>(64, this->index.size() / 64)) this->CompactIndex();
+}
 
-		/* Go to the end of the items in the bucket */
-		this->bucket_list_iter = this->bucket_list->end();
-		--this->bucket_list_iter;
-		this->item_next = *this->bucket_list_iter;
+/**
+ * Note that the position of an item in the index has become invalid.
+ */
+void ScriptList::IndexRemove()
+{
+	if (!this->index_valid) return;
 
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
+	if (this->IsIterationEnd()) {
+		this->index_valid = false;
+		return;
 	}
 
-	void End()
-	{
-		this->bucket_list = nullptr;
-		this->has_no_more_items = true;
-		this->item_next = 0;
-	}
+	if (++this->index_stale > std::max<size_t>(64, this->index.size() / 2)) this->CompactIndex();
+}
 
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
+/**
+ * Find the item to show after item_next, or the first item, and make it
+ * the new item_next.
+ * @param from_start Whether to find the first item instead.
+ * @return False if there is no such item; item_next is not changed then.
+ */
+bool ScriptList::SeekNext(bool from_start)
+{
+	if (!this->index_valid) this->BuildIndex();
+
+	/* Everything the cursor has passed comes before item_next or is not valid anymore. Items that
+	 * have been added or have changed value since are only found in pending. */
+	if (from_start) {
+		this->index_cursor = this->sort_ascending ? 0 : this->index.size();
+	} else if (!this->index_cursor_valid) {
+		ScriptListIndex::iterator iter = this->sort_ascending ?
+				std::upper_bound(this->index.begin(), this->index.end(), this->item_next) :
+				std::lower_bound(this->index.begin(), this->index.end(), this->item_next);
+		this->index_cursor = iter - this->index.begin();
+	}
+	this->index_cursor_valid = true;
+
+	const ScriptListKey *found = nullptr;
+	if (this->sort_ascending) {
+		for (; this->index_cursor < this->index.size(); this->index_cursor++) {
+			const ScriptListKey &key = this->index[this->index_cursor];
+			if ((from_start || this->item_next < key) && this->IsKeyValid(key)) {
+				found = &key;
+				break;
+			}
 		}
 
-		if (this->bucket_list_iter == this->bucket_list->begin()) {
-			if (this->bucket_iter == this->list->buckets.begin()) {
-				this->bucket_list = nullptr;
-				return;
+		ScriptListIndex::iterator iter = from_start ? this->pending.begin() : std::upper_bound(this->pending.begin(), this->pending.end(), this->item_next);
+		for (; iter != this->pending.end(); iter++) {
+			if (!this->IsKeyValid(*iter)) continue;
+			if (found == nullptr || *iter < *found) found = &*iter;
+			break;
+		}
+	} else {
+		for (; this->index_cursor > 0; this->index_cursor--) {
+			const ScriptListKey &key = this->index[this->index_cursor - 1];
+			if ((from_start || key < this->item_next) && this->IsKeyValid(key)) {
+				found = &key;
+				break;
 			}
-			this->bucket_iter--;
-			this->bucket_list = &(*this->bucket_iter).second;
-			/* Go to the end of the items in the bucket */
-			this->bucket_list_iter = this->bucket_list->end();
-			--this->bucket_list_iter;
-		} else {
-			this->bucket_list_iter--;
 		}
-		this->item_next = *this->bucket_list_iter;
-	}
-
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
 
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
+		ScriptListIndex::iterator iter = from_start ? this->pending.end() : std::lower_bound(this->pending.begin(), this->pending.end(), this->item_next);
+		while (iter != this->pending.begin()) {
+			--iter;
+			if (!this->IsKeyValid(*iter)) continue;
+			if (found == nullptr || *found < *iter) found = &*iter;
+			break;
 		}
 	}
-};
+
+	if (found == nullptr) return false;
+	this->item_next = *found;
+	return true;
+}
 
 /**
- * Sort by item, ascending.
+ * Find the next item, and store that information.
  */
-class ScriptListSorterItemAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterItemAscending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	int64 Begin()
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->item_iter = this->list->items.begin();
-		this->item_next = (*this->item_iter).first;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End()
-	{
+void ScriptList::FindNext()
+{
+	if (!this->has_next) {
 		this->has_no_more_items = true;
+		return;
 	}
 
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->item_iter == this->list->items.end()) {
-			this->has_no_more_items = true;
-			return;
-		}
-		this->item_iter++;
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
-	}
-
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
+	if (!this->SeekNext(false)) this->has_next = false;
+}
 
 /**
- * Sort by item, descending.
+ * Stop iterating the list.
  */
-class ScriptListSorterItemDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterItemDescending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
+void ScriptList::EndIteration()
+{
+	this->has_next = false;
+	this->has_no_more_items = true;
+}
 
-	int64 Begin()
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
+/**
+ * See if the iteration has reached the end.
+ * @return True if there are no more items to show.
+ */
+bool ScriptList::IsIterationEnd() const
+{
+	return this->items.empty() || this->has_no_more_items;
+}
 
-		this->item_iter = this->list->items.end();
-		--this->item_iter;
-		this->item_next = (*this->item_iter).first;
+/**
+ * Update the iteration before an item gets removed or changes value.
+ * @param item The item that is removed.
+ */
+void ScriptList::IterationRemove(int64 item)
+{
+	if (this->IsIterationEnd()) return;
 
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
+	/* If we remove the 'next' item, skip to the next */
+	if (item == this->GetKeyItem(this->item_next)) this->FindNext();
+}
 
-	void End()
-	{
-		this->has_no_more_items = true;
-	}
+/**
+ * Remove a number of items in one go.
+ * @param remove The items to remove, in the order they should be removed in.
+ */
+void ScriptList::RemoveItems(const std::vector<int64> &remove)
+{
+	if (remove.empty()) return;
 
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->item_iter == this->list->items.end()) {
-			this->has_no_more_items = true;
-			return;
-		}
-		if (this->item_iter == this->list->items.begin()) {
-			/* Use 'end' as marker for 'beyond begin' */
-			this->item_iter = this->list->items.end();
-		} else {
-			this->item_iter--;
-		}
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
+	if (!this->IsIterationEnd()) {
+		/* The iteration has to skip the removed items one by one. */
+		for (int64 item : remove) this->RemoveItem(item);
+		return;
 	}
 
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
+	for (int64 item : remove) this->items.erase(item);
+	this->index_valid = false;
+}
 
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
+/**
+ * Remove all items for which a condition holds, in ascending order of the items.
+ * @param remove Function taking the item and its value, returning true if it should be removed.
+ */
+template <typename T>
+void ScriptList::RemoveItemsIf(T remove)
+{
+	std::vector<int64> list_items;
+	for (const auto &item : this->items) {
+		if (remove(item.first, item.second)) list_items.push_back(item.first);
 	}
+	if (!this->IsIterationEnd()) std::sort(list_items.begin(), list_items.end());
 
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
+	this->RemoveItems(list_items);
+}
 
+/**
+ * Get all items in ascending order.
+ * @return The items.
+ */
+std::vector<int64> ScriptList::GetSortedItems() const
+{
+	std::vector<int64> list_items;
+	list_items.reserve(this->items.size());
+	for (const auto &item : this->items) list_items.push_back(item.first);
+	std::sort(list_items.begin(), list_items.end());
+	return list_items;
+}
 
 
 ScriptList::ScriptList()
 {
 	/* Default sorter */
-	this->sorter         = new ScriptListSorterValueDescending(this);
-	this->sorter_type    = SORT_BY_VALUE;
-	this->sort_ascending = false;
-	this->initialized    = false;
-	this->modifications  = 0;
+	this->sorter_type        = SORT_BY_VALUE;
+	this->sort_ascending     = false;
+	this->initialized        = false;
+	this->modifications      = 0;
+	this->index_valid        = false;
+	this->index_stale        = 0;
+	this->index_cursor       = 0;
+	this->index_cursor_valid = false;
+	this->item_next          = ScriptListKey(0, 0);
+	this->EndIteration();
 }
 
 ScriptList::~ScriptList()
 {
-	delete this->sorter;
 }
 
 bool ScriptList::HasItem(int64 item)
@@ -429,18 +313,19 @@ void ScriptList::Clear()
 	this->modifications++;
 
 	this->items.clear();
-	this->buckets.clear();
-	this->sorter->End();
+	this->index.clear();
+	this->pending.clear();
+	this->index_valid = false;
+	this->EndIteration();
 }
 
 void ScriptList::AddItem(int64 item, int64 value)
 {
 	this->modifications++;
 
-	if (this->HasItem(item)) return;
+	if (!this->items.emplace(item, value).second) return;
 
-	this->items[item] = value;
-	this->buckets[value].insert(item);
+	this->IndexAdd(item, value);
 }
 
 void ScriptList::RemoveItem(int64 item)
@@ -450,20 +335,22 @@ void ScriptList::RemoveItem(int64 item)
 	ScriptListMap::iterator item_iter = this->items.find(item);
 	if (item_iter == this->items.end()) return;
 
-	int64 value = item_iter->second;
-
-	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
+	this->IterationRemove(item);
 	this->items.erase(item_iter);
+	this->IndexRemove();
 }
 
 int64 ScriptList::Begin()
 {
 	this->initialized = true;
-	return this->sorter->Begin();
+
+	if (this->items.empty()) return 0;
+	this->has_no_more_items = false;
+	this->has_next = this->SeekNext(true);
+
+	int64 item_current = this->GetKeyItem(this->item_next);
+	this->FindNext();
+	return item_current;
 }
 
 int64 ScriptList::Next()
@@ -472,7 +359,11 @@ int64 ScriptList::Next()
 		Debug(script, 0, "Next() is invalid as Begin() is never called");
 		return 0;
 	}
-	return this->sorter->Next();
+	if (this->IsIterationEnd()) return 0;
+
+	int64 item_current = this->GetKeyItem(this->item_next);
+	this->FindNext();
+	return item_current;
 }
 
 bool ScriptList::IsEmpty()
@@ -486,7 +377,7 @@ bool ScriptList::IsEnd()
 		Debug(script, 0, "IsEnd() is invalid as Begin() is never called");
 		return true;
 	}
-	return this->sorter->IsEnd();
+	return this->IsIterationEnd();
 }
 
 int32 ScriptList::Count()
@@ -510,13 +401,10 @@ bool ScriptList::SetValue(int64 item, int64 value)
 	int64 value_old = item_iter->second;
 	if (value_old == value) return true;
 
-	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value_old);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
+	this->IterationRemove(item);
 	item_iter->second = value;
-	this->buckets[value].insert(item);
+	this->IndexRemove();
+	this->IndexAdd(item, value);
 
 	return true;
 }
@@ -528,29 +416,14 @@ void ScriptList::Sort(SorterType sorter, bool ascending)
 	if (sorter != SORT_BY_VALUE && sorter != SORT_BY_ITEM) return;
 	if (sorter == this->sorter_type && ascending == this->sort_ascending) return;
 
-	delete this->sorter;
-	switch (sorter) {
-		case SORT_BY_ITEM:
-			if (ascending) {
-				this->sorter = new ScriptListSorterItemAscending(this);
-			} else {
-				this->sorter = new ScriptListSorterItemDescending(this);
-			}
-			break;
-
-		case SORT_BY_VALUE:
-			if (ascending) {
-				this->sorter = new ScriptListSorterValueAscending(this);
-			} else {
-				this->sorter = new ScriptListSorterValueDescending(this);
-			}
-			break;
+	/* The index is always ascending, so only a different type needs a new one. */
+	if (sorter != this->sorter_type) this->index_valid = false;
+	this->index_cursor_valid = false;
 
-		default: NOT_REACHED();
-	}
 	this->sorter_type    = sorter;
 	this->sort_ascending = ascending;
 	this->initialized    = false;
+	this->EndIteration();
 }
 
 void ScriptList::AddList(ScriptList *list)
@@ -560,13 +433,15 @@ void ScriptList::AddList(ScriptList *list)
 	if (this->IsEmpty()) {
 		/* If this is empty, we can just take the items of the other list as is. */
 		this->items = list->items;
-		this->buckets = list->buckets;
+		this->index_valid = false;
 		this->modifications++;
 	} else {
-		ScriptListMap *list_items = &list->items;
-		for (ScriptListMap::iterator iter = list_items->begin(); iter != list_items->end(); iter++) {
-			this->AddItem((*iter).first);
-			this->SetValue((*iter).first, (*iter).second);
+		/* Add the items in the order the map based list always used. */
+		std::vector<std::pair<int64, int64>> list_items(list->items.begin(), list->items.end());
+		std::sort(list_items.begin(), list_items.end());
+		for (const auto &item : list_items) {
+			this->AddItem(item.first);
+			this->SetValue(item.first, item.second);
 		}
 	}
 }
@@ -576,54 +451,47 @@ void ScriptList::SwapList(ScriptList *list)
 	if (list == this) return;
 
 	this->items.swap(list->items);
-	this->buckets.swap(list->buckets);
-	Swap(this->sorter, list->sorter);
+	this->index.swap(list->index);
+	this->pending.swap(list->pending);
+	Swap(this->index_valid, list->index_valid);
+	Swap(this->index_stale, list->index_stale);
+	Swap(this->index_cursor, list->index_cursor);
+	Swap(this->index_cursor_valid, list->index_cursor_valid);
 	Swap(this->sorter_type, list->sorter_type);
 	Swap(this->sort_ascending, list->sort_ascending);
 	Swap(this->initialized, list->initialized);
 	Swap(this->modifications, list->modifications);
-	this->sorter->Retarget(this);
-	list->sorter->Retarget(list);
+	Swap(this->item_next, list->item_next);
+	Swap(this->has_next, list->has_next);
+	Swap(this->has_no_more_items, list->has_no_more_items);
 }
 
 void ScriptList::RemoveAboveValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](int64, int64 item_value) { return item_value > value; });
 }
 
 void ScriptList::RemoveBelowValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second < value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](int64, int64 item_value) { return item_value < value; });
 }
 
 void ScriptList::RemoveBetweenValue(int64 start, int64 end)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > start && (*iter).second < end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([start, end](int64, int64 item_value) { return item_value > start && item_value < end; });
 }
 
 void ScriptList::RemoveValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second == value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](int64, int64 item_value) { return item_value == value; });
 }
 
 void ScriptList::RemoveTop(int32 count)
@@ -637,30 +505,14 @@ void ScriptList::RemoveTop(int32 count)
 		return;
 	}
 
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::iterator iter = this->buckets.begin(); iter != this->buckets.end(); iter = this->buckets.begin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::iterator iter = items->begin(); iter != items->end(); iter = items->begin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
+	if (count <= 0) return;
 
-		case SORT_BY_ITEM:
-			for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter = this->items.begin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
+	this->CompactIndex();
+	std::vector<int64> list_items;
+	for (ScriptListIndex::iterator iter = this->index.begin(); iter != this->index.end() && count-- > 0; iter++) {
+		list_items.push_back(this->GetKeyItem(*iter));
 	}
+	this->RemoveItems(list_items);
 }
 
 void ScriptList::RemoveBottom(int32 count)
@@ -674,30 +526,14 @@ void ScriptList::RemoveBottom(int32 count)
 		return;
 	}
 
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::reverse_iterator iter = this->buckets.rbegin(); iter != this->buckets.rend(); iter = this->buckets.rbegin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::reverse_iterator iter = items->rbegin(); iter != items->rend(); iter = items->rbegin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
+	if (count <= 0) return;
 
-		case SORT_BY_ITEM:
-			for (ScriptListMap::reverse_iterator iter = this->items.rbegin(); iter != this->items.rend(); iter = this->items.rbegin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
+	this->CompactIndex();
+	std::vector<int64> list_items;
+	for (ScriptListIndex::reverse_iterator iter = this->index.rbegin(); iter != this->index.rend() && count-- > 0; iter++) {
+		list_items.push_back(this->GetKeyItem(*iter));
 	}
+	this->RemoveItems(list_items);
 }
 
 void ScriptList::RemoveList(ScriptList *list)
@@ -708,9 +544,7 @@ void ScriptList::RemoveList(ScriptList *list)
 		Clear();
 	} else {
 		ScriptListMap *list_items = &list->items;
-		for (ScriptListMap::iterator iter = list_items->begin(); iter != list_items->end(); iter++) {
-			this->RemoveItem((*iter).first);
-		}
+		this->RemoveItemsIf([list_items](int64 item, int64) { return list_items->count(item) != 0; });
 	}
 }
 
@@ -718,40 +552,28 @@ void ScriptList::KeepAboveValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](int64, int64 item_value) { return item_value <= value; });
 }
 
 void ScriptList::KeepBelowValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second >= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](int64, int64 item_value) { return item_value >= value; });
 }
 
 void ScriptList::KeepBetweenValue(int64 start, int64 end)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= start || (*iter).second >= end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([start, end](int64, int64 item_value) { return item_value <= start || item_value >= end; });
 }
 
 void ScriptList::KeepValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second != value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](int64, int64 item_value) { return item_value != value; });
 }
 
 void ScriptList::KeepTop(int32 count)
@@ -774,10 +596,21 @@ void ScriptList::KeepList(ScriptList *list)
 
 	this->modifications++;
 
-	ScriptList tmp;
-	tmp.AddList(this);
-	tmp.RemoveList(list);
-	this->RemoveList(&tmp);
+	ScriptListMap *list_items = &list->items;
+	this->RemoveItemsIf([list_items](int64 item, int64) { return list_items->count(item) == 0; });
+}
+
+void ScriptList::ValuateNative(int64 (*valuator)(int64 item))
+{
+	this->modifications++;
+
+	std::vector<int64> list_items = this->GetSortedItems();
+
+	if (this->IsIterationEnd()) this->index_valid = false;
+
+	for (int64 item : list_items) this->SetValue(item, valuator(item));
+
+	ScriptObject::DecreaseOps((int)list_items.size());
 }
 
 SQInteger ScriptList::_get(HSQUIRRELVM vm)
@@ -869,14 +702,20 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Push the function to call */
 	sq_push(vm, 2);
 
-	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
+	/* Valuate in the order of the items, like the map based list always did. */
+	std::vector<int64> list_items = this->GetSortedItems();
+
+	/* Without an iteration in progress, sort the new values once when they are needed. */
+	if (this->IsIterationEnd()) this->index_valid = false;
+
+	for (int64 item : list_items) {
 		/* Check for changing of items. */
 		int previous_modification_count = this->modifications;
 
 		/* Push the root table as instance object, this is what squirrel does for meta-functions. */
 		sq_pushroottable(vm);
 		/* Push all arguments for the valuator function. */
-		sq_pushinteger(vm, (*iter).first);
+		sq_pushinteger(vm, item);
 		for (int i = 0; i < nparam - 1; i++) {
 			sq_push(vm, i + 3);
 		}
@@ -930,7 +769,7 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			return sq_throwerror(vm, "modifying valuated list outside of valuator function");
 		}
 
-		this->SetValue((*iter).first, value);
+		this->SetValue(item, value);
 
 		/* Pop the return value. */
 		sq_poptop(vm);
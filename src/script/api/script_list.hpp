@@ -12,10 +12,8 @@
 #define SCRIPT_LIST_HPP
 
 #include "script_object.hpp"
-#include <map>
-#include <set>
-
-class ScriptListSorter;
+#include <unordered_map>
+#include <vector>
 
 /**
  * Class that creates a list which can keep item/value pairs, which you can walk.
@@ -35,20 +33,53 @@ public:
 	static const bool SORT_DESCENDING = false;
 
 private:
-	ScriptListSorter *sorter;     ///< Sorting algorithm
+	typedef std::unordered_map<int64, int64> ScriptListMap; ///< Value per item
+	typedef std::pair<int64, int64> ScriptListKey;          ///< Position of an item in the sort order; (value, item) or (item, value) depending on the sorter type
+	typedef std::vector<ScriptListKey> ScriptListIndex;     ///< Sorted positions of items
+
+	ScriptListMap items;          ///< The items in the list
+	ScriptListIndex index;        ///< The positions of the items in ascending order; may contain positions that are no longer valid
+	ScriptListIndex pending;      ///< The positions of items added or changed since the index was compacted, in ascending order
+	bool index_valid;             ///< Whether index and pending hold the positions of all items
+	size_t index_stale;           ///< Number of positions in index and pending that have been invalidated
+	size_t index_cursor;          ///< Position in the index to continue iterating from
+	bool index_cursor_valid;      ///< Whether index_cursor belongs to the current index
+
 	SorterType sorter_type;       ///< Sorting type
 	bool sort_ascending;          ///< Whether to sort ascending or descending
 	bool initialized;             ///< Whether an iteration has been started
 	int modifications;            ///< Number of modification that has been done. To prevent changing data while valuating.
 
-public:
-	typedef std::set<int64> ScriptItemList;                   ///< The list of items inside the bucket
-	typedef std::map<int64, ScriptItemList> ScriptListBucket; ///< The bucket list per value
-	typedef std::map<int64, int64> ScriptListMap;             ///< List per item
+	ScriptListKey item_next;      ///< The position of the next item we will show
+	bool has_next;                ///< Whether item_next still points to an item after the current one
+	bool has_no_more_items;       ///< Whether we have more items to iterate over
+
+	ScriptListKey MakeKey(int64 item, int64 value) const;
+	int64 GetKeyItem(const ScriptListKey &key) const;
+	bool IsKeyValid(const ScriptListKey &key) const;
+
+	void BuildIndex();
+	void CompactIndex();
+	void IndexAdd(int64 item, int64 value);
+	void IndexRemove();
 
-	ScriptListMap items;           ///< The items in the list
-	ScriptListBucket buckets;      ///< The items in the list, sorted by value
+	bool SeekNext(bool from_start);
+	void FindNext();
+	void EndIteration();
+	bool IsIterationEnd() const;
+	void IterationRemove(int64 item);
+	std::vector<int64> GetSortedItems() const;
+	void RemoveItems(const std::vector<int64> &remove);
+	template <typename T> void RemoveItemsIf(T remove);
 
+protected:
+	/**
+	 * Give all items a value computed in C++, without calling into the script.
+	 * @param valuator The function giving the value of an item.
+	 */
+	void ValuateNative(int64 (*valuator)(int64 item));
+
+public:
 	ScriptList();
 	~ScriptList();
 
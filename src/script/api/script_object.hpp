@@ -247,6 +247,12 @@ protected:
 	 */
 	static bool CanSuspend();
 
+	/**
+	 * Charge the script for work done in C++ on its behalf.
+	 * @param amount The number of opcodes to charge.
+	 */
+	static void DecreaseOps(int amount);
+
 	/**
 	 * Get the pointer to store event data in.
 	 */
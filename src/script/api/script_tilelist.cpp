@@ -10,6 +10,8 @@
 #include "../../stdafx.h"
 #include "script_tilelist.hpp"
 #include "script_industry.hpp"
+#include "script_road.hpp"
+#include "script_tile.hpp"
 #include "../../industry.h"
 #include "../../station_base.h"
 
@@ -47,6 +49,20 @@ void ScriptTileList::RemoveTile(TileIndex tile)
 	this->RemoveItem(tile);
 }
 
+void ScriptTileList::ValuateTileProperty(TileProperty property)
+{
+	switch (property) {
+		case TILE_PROPERTY_BUILDABLE:  this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::IsBuildable((TileIndex)tile) ? 1 : 0; }); break;
+		case TILE_PROPERTY_WATER:      this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::IsWaterTile((TileIndex)tile) ? 1 : 0; }); break;
+		case TILE_PROPERTY_COAST:      this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::IsCoastTile((TileIndex)tile) ? 1 : 0; }); break;
+		case TILE_PROPERTY_SLOPE:      this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::GetSlope((TileIndex)tile); }); break;
+		case TILE_PROPERTY_MIN_HEIGHT: this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::GetMinHeight((TileIndex)tile); }); break;
+		case TILE_PROPERTY_MAX_HEIGHT: this->ValuateNative([](int64 tile) -> int64 { return ScriptTile::GetMaxHeight((TileIndex)tile); }); break;
+		case TILE_PROPERTY_ROAD:       this->ValuateNative([](int64 tile) -> int64 { return ScriptRoad::IsRoadTile((TileIndex)tile) ? 1 : 0; }); break;
+		default: break;
+	}
+}
+
 /**
  * Helper to get list of tiles that will cover an industry's production or acceptance.
  * @param i Industry in question
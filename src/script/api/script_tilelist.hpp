@@ -20,6 +20,19 @@
  */
 class ScriptTileList : public ScriptList {
 public:
+	/**
+	 * Properties of tiles that can be valuated without calling back into the script.
+	 */
+	enum TileProperty {
+		TILE_PROPERTY_BUILDABLE,  ///< 1 if the tile is buildable, see ScriptTile::IsBuildable.
+		TILE_PROPERTY_WATER,      ///< 1 if the tile is water, see ScriptTile::IsWaterTile.
+		TILE_PROPERTY_COAST,      ///< 1 if the tile is coast, see ScriptTile::IsCoastTile.
+		TILE_PROPERTY_SLOPE,      ///< The slope of the tile, see ScriptTile::GetSlope.
+		TILE_PROPERTY_MIN_HEIGHT, ///< The lowest height of the tile, see ScriptTile::GetMinHeight.
+		TILE_PROPERTY_MAX_HEIGHT, ///< The highest height of the tile, see ScriptTile::GetMaxHeight.
+		TILE_PROPERTY_ROAD,       ///< 1 if the tile has a road, see ScriptRoad::IsRoadTile.
+	};
+
 	/**
 	 * Adds the rectangle between tile_from and tile_to to the to-be-evaluated tiles.
 	 * @param tile_from One corner of the tiles to add.
@@ -51,6 +64,17 @@ public:
 	 * @pre ScriptMap::IsValidTile(tile).
 	 */
 	void RemoveTile(TileIndex tile);
+
+	/**
+	 * Give all tiles the value of one of their properties. This gives the
+	 *  same values as Valuate with the matching ScriptTile or ScriptRoad
+	 *  function, but without calling a valuator for each tile.
+	 * @param property The property to valuate the tiles with.
+	 * @note Example:
+	 *  list.ValuateTileProperty(ScriptTileList.TILE_PROPERTY_BUILDABLE);
+	 *  list.KeepValue(1);
+	 */
+	void ValuateTileProperty(TileProperty property);
 };
 
 /**
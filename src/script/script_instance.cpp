@@ -26,6 +26,9 @@
 #include "../company_base.h"
 #include "../company_func.h"
 #include "../fileio_func.h"
+#include "../framerate_type.h"
+#include "../gfx_type.h"
+#include "../network/network.h"
 
 #include "../safeguards.h"
 
@@ -165,6 +168,28 @@ void ScriptInstance::Died()
 	this->engine = nullptr;
 }
 
+/**
+ * Get the number of opcodes a script may run this tick before it is suspended.
+ * On a server the budget follows how busy the game loop was recently: scripts
+ * get more opcodes while ticks finish early, and fewer when ticks take longer
+ * than they should. Scripts only run on the server, and their commands are
+ * distributed like any other, so this does not affect clients. In single
+ * player the budget stays fixed, so a script does the same after loading
+ * a savegame.
+ * @return The number of opcodes for this tick.
+ */
+static uint32 GetMaxOpcodeTillSuspend()
+{
+	uint32 ops = _settings_game.script.script_max_opcode_till_suspend;
+	if (!_network_server) return ops;
+
+	double load = PerformanceMeasurer::GetAverageDurationMilliseconds(PFE_GAMELOOP, 8) / MILLISECONDS_PER_TICK;
+	if (load < 0.25) return ops * 4;
+	if (load < 0.5) return ops * 2;
+	if (load > 1.0) return std::max<uint32>(ops / 2, 500);
+	return ops;
+}
+
 void ScriptInstance::GameLoop()
 {
 	ScriptObject::ActiveInstance active(this);
@@ -242,7 +267,7 @@ void ScriptInstance::GameLoop()
 
 	/* Continue the VM */
 	try {
-		if (!this->engine->Resume(_settings_game.script.script_max_opcode_till_suspend)) this->Died();
+		if (!this->engine->Resume(GetMaxOpcodeTillSuspend())) this->Died();
 	} catch (Script_Suspend &e) {
 		this->suspend  = e.GetSuspendTime();
 		this->callback = e.GetSuspendCallback();
@@ -341,14 +366,7 @@ enum SQSaveLoadType {
 	SQSL_ARRAY_TABLE_END = 0xFF, ///< Marks the end of an array or table, no data follows.
 };
 
-static byte _script_sl_byte; ///< Used as source/target by the script saveload code to store/load a single byte.
-
-/** SaveLoad array that saves/loads exactly one byte. */
-static const SaveLoad _script_byte[] = {
-	SLEG_VAR("type", _script_sl_byte, SLE_UINT8),
-};
-
-/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, bool test)
+/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, std::vector<byte> &data)
 {
 	if (max_depth == 0) {
 		ScriptLog::Error("Savedata can only be nested to 25 deep. No data saved."); // SQUIRREL_MAX_DEPTH = 25
@@ -357,24 +375,17 @@ static const SaveLoad _script_byte[] = {
 
 	switch (sq_gettype(vm, index)) {
 		case OT_INTEGER: {
-			if (!test) {
-				_script_sl_byte = SQSL_INT;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_INT);
 			SQInteger res;
 			sq_getinteger(vm, index, &res);
-			if (!test) {
-				int64 value = (int64)res;
-				SlCopy(&value, 1, SLE_INT64);
-			}
+			/* Stored big endian, like SlCopy does with SLE_INT64. */
+			uint64 value = (uint64)(int64)res;
+			for (int shift = 56; shift >= 0; shift -= 8) data.push_back((byte)(value >> shift));
 			return true;
 		}
 
 		case OT_STRING: {
-			if (!test) {
-				_script_sl_byte = SQSL_STRING;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_STRING);
 			const SQChar *buf;
 			sq_getstring(vm, index, &buf);
 			size_t len = strlen(buf) + 1;
@@ -382,23 +393,17 @@ static const SaveLoad _script_byte[] = {
 				ScriptLog::Error("Maximum string length is 254 chars. No data saved.");
 				return false;
 			}
-			if (!test) {
-				_script_sl_byte = (byte)len;
-				SlObject(nullptr, _script_byte);
-				SlCopy(const_cast<char *>(buf), len, SLE_CHAR);
-			}
+			data.push_back((byte)len);
+			data.insert(data.end(), buf, buf + len);
 			return true;
 		}
 
 		case OT_ARRAY: {
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_ARRAY);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the value */
-				bool res = SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -1, max_depth - 1, data);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -406,22 +411,16 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_TABLE: {
-			if (!test) {
-				_script_sl_byte = SQSL_TABLE;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_TABLE);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the key + value */
-				bool res = SaveObject(vm, -2, max_depth - 1, test) && SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -2, max_depth - 1, data) && SaveObject(vm, -1, max_depth - 1, data);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -429,32 +428,20 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_BOOL: {
-			if (!test) {
-				_script_sl_byte = SQSL_BOOL;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_BOOL);
 			SQBool res;
 			sq_getbool(vm, index, &res);
-			if (!test) {
-				_script_sl_byte = res ? 1 : 0;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(res ? 1 : 0);
 			return true;
 		}
 
 		case OT_NULL: {
-			if (!test) {
-				_script_sl_byte = SQSL_NULL;
-				SlObject(nullptr, _script_byte);
-			}
+			data.push_back(SQSL_NULL);
 			return true;
 		}
 
@@ -466,8 +453,8 @@ static const SaveLoad _script_byte[] = {
 
 /* static */ void ScriptInstance::SaveEmpty()
 {
-	_script_sl_byte = 0;
-	SlObject(nullptr, _script_byte);
+	byte empty = 0;
+	SlCopy(&empty, 1, SLE_UINT8);
 }
 
 void ScriptInstance::Save()
@@ -482,10 +469,10 @@ void ScriptInstance::Save()
 
 	HSQUIRRELVM vm = this->engine->GetVM();
 	if (this->is_save_data_on_stack) {
-		_script_sl_byte = 1;
-		SlObject(nullptr, _script_byte);
 		/* Save the data that was just loaded. */
-		SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
+		std::vector<byte> data(1, 1);
+		SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, data);
+		SlCopy(data.data(), data.size(), SLE_UINT8);
 	} else if (!this->is_started) {
 		SaveEmpty();
 		return;
@@ -524,10 +511,10 @@ void ScriptInstance::Save()
 			return;
 		}
 		sq_pushobject(vm, savedata);
-		if (SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, true)) {
-			_script_sl_byte = 1;
-			SlObject(nullptr, _script_byte);
-			SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
+		/* Everything is serialised first, so nothing is written when the data turns out to be invalid. */
+		std::vector<byte> data(1, 1);
+		if (SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, data)) {
+			SlCopy(data.data(), data.size(), SLE_UINT8);
 			this->is_save_data_on_stack = true;
 		} else {
 			SaveEmpty();
@@ -535,8 +522,7 @@ void ScriptInstance::Save()
 		}
 	} else {
 		ScriptLog::Warning("Save function is not implemented");
-		_script_sl_byte = 0;
-		SlObject(nullptr, _script_byte);
+		SaveEmpty();
 	}
 }
 
@@ -561,8 +547,7 @@ bool ScriptInstance::IsPaused()
 
 /* static */ bool ScriptInstance::LoadObjects(HSQUIRRELVM vm)
 {
-	SlObject(nullptr, _script_byte);
-	switch (_script_sl_byte) {
+	switch (SlReadByte()) {
 		case SQSL_INT: {
 			int64 value;
 			SlCopy(&value, 1, IsSavegameVersionBefore(SLV_SCRIPT_INT64) ? SLE_INT32 : SLE_INT64);
@@ -571,10 +556,10 @@ bool ScriptInstance::IsPaused()
 		}
 
 		case SQSL_STRING: {
-			SlObject(nullptr, _script_byte);
-			static char buf[std::numeric_limits<decltype(_script_sl_byte)>::max()];
-			SlCopy(buf, _script_sl_byte, SLE_CHAR);
-			StrMakeValidInPlace(buf, buf + _script_sl_byte);
+			byte len = SlReadByte();
+			static char buf[std::numeric_limits<byte>::max()];
+			SlCopy(buf, len, SLE_CHAR);
+			StrMakeValidInPlace(buf, buf + len);
 			if (vm != nullptr) sq_pushstring(vm, buf, -1);
 			return true;
 		}
@@ -599,8 +584,8 @@ bool ScriptInstance::IsPaused()
 		}
 
 		case SQSL_BOOL: {
-			SlObject(nullptr, _script_byte);
-			if (vm != nullptr) sq_pushbool(vm, (SQBool)(_script_sl_byte != 0));
+			byte value = SlReadByte();
+			if (vm != nullptr) sq_pushbool(vm, (SQBool)(value != 0));
 			return true;
 		}
 
@@ -619,9 +604,8 @@ bool ScriptInstance::IsPaused()
 
 /* static */ void ScriptInstance::LoadEmpty()
 {
-	SlObject(nullptr, _script_byte);
 	/* Check if there was anything saved at all. */
-	if (_script_sl_byte == 0) return;
+	if (SlReadByte() == 0) return;
 
 	LoadObjects(nullptr);
 }
@@ -636,9 +620,8 @@ void ScriptInstance::Load(int version)
 	}
 	HSQUIRRELVM vm = this->engine->GetVM();
 
-	SlObject(nullptr, _script_byte);
 	/* Check if there was anything saved at all. */
-	if (_script_sl_byte == 0) return;
+	if (SlReadByte() == 0) return;
 
 	sq_pushinteger(vm, version);
 	LoadObjects(vm);
@@ -23,6 +23,49 @@
 
 #include "../safeguards.h"
 
+/** Helper for creating a MD5sum of all files within of a script. */
+struct ScriptFileChecksumCreator : FileScanner {
+	byte md5sum[16];  ///< The final md5sum.
+	Subdirectory dir; ///< The directory to look in.
+
+	/**
+	 * Initialise the md5sum to be all zeroes,
+	 * so we can easily xor the data.
+	 */
+	ScriptFileChecksumCreator(Subdirectory dir)
+	{
+		this->dir = dir;
+		memset(this->md5sum, 0, sizeof(this->md5sum));
+	}
+
+	/* Add the file and calculate the md5 sum. */
+	virtual bool AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename)
+	{
+		Md5 checksum;
+		uint8 buffer[1024];
+		size_t len, size;
+		byte tmp_md5sum[16];
+
+		/* Open the file ... */
+		FILE *f = FioFOpenFile(filename, "rb", this->dir, &size);
+		if (f == nullptr) return false;
+
+		/* ... calculate md5sum... */
+		while ((len = fread(buffer, 1, (size > sizeof(buffer)) ? sizeof(buffer) : size, f)) != 0 && size != 0) {
+			size -= len;
+			checksum.Append(buffer, len);
+		}
+		checksum.Finish(tmp_md5sum);
+
+		FioFCloseFile(f);
+
+		/* ... and xor it to the overall md5sum. */
+		for (uint i = 0; i < sizeof(md5sum); i++) this->md5sum[i] ^= tmp_md5sum[i];
+
+		return true;
+	}
+};
+
 bool ScriptScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename)
 {
 	this->main_script = filename;
@@ -34,6 +77,19 @@ bool ScriptScanner::AddFile(const std::string &filename, size_t basepath_length,
 
 	if (!FioCheckFileExists(filename, this->subdir) || !FioCheckFileExists(this->main_script, this->subdir)) return false;
 
+	ScriptFileChecksumCreator checksum(this->subdir);
+	checksum.AddFile(filename, 0, tar_filename);
+
+	CachedScripts &cached = this->script_cache[this->main_script];
+	if (!cached.infos.empty() && memcmp(cached.md5sum, checksum.md5sum, sizeof(cached.md5sum)) == 0 && !_settings_client.gui.ai_developer_tools) {
+		/* The info file did not change since the previous scan, so register what it registered back then. */
+		std::vector<ScriptInfo *> infos = std::move(cached.infos);
+		cached.infos.clear();
+		for (ScriptInfo *info : infos) this->RegisterScript(info);
+		return true;
+	}
+	memcpy(cached.md5sum, checksum.md5sum, sizeof(cached.md5sum));
+
 	this->ResetEngine();
 	try {
 		this->engine->LoadScript(filename.c_str());
@@ -74,11 +130,23 @@ ScriptScanner::~ScriptScanner()
 
 void ScriptScanner::RescanDir()
 {
-	/* Forget about older scans */
+	/* Forget about older scans, but keep the scripts they found so
+	 * the ones whose info file did not change can be reused. */
+	for (const auto &item : this->info_list) {
+		this->script_cache[item.second->GetMainScript()].infos.push_back(item.second);
+		free(item.first);
+	}
+	this->info_list.clear();
 	this->Reset();
 
 	/* Scan for scripts */
 	this->Scan(this->GetFileName(), this->GetDirectory());
+
+	/* Free the scripts that were changed or removed since the previous scan. */
+	for (auto &item : this->script_cache) {
+		for (ScriptInfo *info : item.second.infos) delete info;
+		item.second.infos.clear();
+	}
 }
 
 void ScriptScanner::Reset()
@@ -158,48 +226,6 @@ char *ScriptScanner::GetConsoleList(char *p, const char *last, bool newest_only)
 	return p;
 }
 
-/** Helper for creating a MD5sum of all files within of a script. */
-struct ScriptFileChecksumCreator : FileScanner {
-	byte md5sum[16];  ///< The final md5sum.
-	Subdirectory dir; ///< The directory to look in.
-
-	/**
-	 * Initialise the md5sum to be all zeroes,
-	 * so we can easily xor the data.
-	 */
-	ScriptFileChecksumCreator(Subdirectory dir)
-	{
-		this->dir = dir;
-		memset(this->md5sum, 0, sizeof(this->md5sum));
-	}
-
-	/* Add the file and calculate the md5 sum. */
-	virtual bool AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename)
-	{
-		Md5 checksum;
-		uint8 buffer[1024];
-		size_t len, size;
-		byte tmp_md5sum[16];
-
-		/* Open the file ... */
-		FILE *f = FioFOpenFile(filename, "rb", this->dir, &size);
-		if (f == nullptr) return false;
-
-		/* ... calculate md5sum... */
-		while ((len = fread(buffer, 1, (size > sizeof(buffer)) ? sizeof(buffer) : size, f)) != 0 && size != 0) {
-			size -= len;
-			checksum.Append(buffer, len);
-		}
-		checksum.Finish(tmp_md5sum);
-
-		FioFCloseFile(f);
-
-		/* ... and xor it to the overall md5sum. */
-		for (uint i = 0; i < sizeof(md5sum); i++) this->md5sum[i] ^= tmp_md5sum[i];
-
-		return true;
-	}
-};
 
 /**
  * Check whether the script given in info is the same as in ci based
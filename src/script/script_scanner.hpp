@@ -90,6 +90,13 @@ protected:
 	ScriptInfoList info_list;        ///< The list of all script.
 	ScriptInfoList info_single_list; ///< The list of all unique script. The best script (highest version) is shown.
 
+	/** The result of evaluating the info file of a script during an earlier scan. */
+	struct CachedScripts {
+		byte md5sum[16];                 ///< MD5 checksum of the info file when it was evaluated.
+		std::vector<ScriptInfo *> infos; ///< The scripts it registered; only filled while rescanning.
+	};
+	std::map<std::string, CachedScripts> script_cache; ///< Earlier scan results, indexed by main script.
+
 	/**
 	 * Initialize the scanner.
 	 * @param name The name of the scanner ("AIScanner", "GSScanner", ..).
@@ -21,6 +21,7 @@
 
 #include <stdarg.h>
 #include <map>
+#include <vector>
 
 /**
  * In the memory allocator for Squirrel we want to directly use malloc/realloc, so when the OS
@@ -49,6 +50,15 @@ struct ScriptAllocator {
 
 	static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almost any situation
 
+	static const size_t POOL_GRANULARITY = 16;       ///< The block sizes of the pool are multiples of this
+	static const size_t POOL_MAX_SIZE = 256;         ///< Allocations larger than this do not come from the pool
+	static const size_t POOL_CHUNK_SIZE = 64 * 1024; ///< Size of the chunks the pool blocks are cut from
+
+	void *pool_free[POOL_MAX_SIZE / POOL_GRANULARITY]; ///< Freed blocks per block size, linked through their first bytes
+	std::vector<void *> pool_chunks; ///< All chunks allocated for the pool
+	char *pool_chunk_pos;            ///< Start of the unused part of the last chunk
+	size_t pool_chunk_left;          ///< Size of the unused part of the last chunk
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 	std::map<void *, size_t> allocations;
 #endif
@@ -97,9 +107,52 @@ struct ScriptAllocator {
 		}
 	}
 
+	/**
+	 * Get a block from the pool. Squirrel allocates many small objects (strings,
+	 * tables, closures), so they are kept together in chunks owned by this script
+	 * instead of being spread over the heap shared with the rest of the game.
+	 * @param size The size of the block, at most POOL_MAX_SIZE.
+	 * @return The block, or nullptr if no new chunk could be allocated.
+	 */
+	void *PoolMalloc(size_t size)
+	{
+		size_t index = (std::max<size_t>(size, 1) - 1) / POOL_GRANULARITY;
+		void *p = this->pool_free[index];
+		if (p != nullptr) {
+			this->pool_free[index] = *static_cast<void **>(p);
+			return p;
+		}
+
+		size_t block_size = (index + 1) * POOL_GRANULARITY;
+		if (this->pool_chunk_left < block_size) {
+			char *chunk = static_cast<char *>(malloc(POOL_CHUNK_SIZE));
+			if (chunk == nullptr) return nullptr;
+			this->pool_chunks.push_back(chunk);
+			this->pool_chunk_pos = chunk;
+			this->pool_chunk_left = POOL_CHUNK_SIZE;
+		}
+
+		p = this->pool_chunk_pos;
+		this->pool_chunk_pos += block_size;
+		this->pool_chunk_left -= block_size;
+		return p;
+	}
+
+	/**
+	 * Return a block to the pool.
+	 * @param p The block.
+	 * @param size The size the block was allocated with.
+	 */
+	void PoolFree(void *p, size_t size)
+	{
+		size_t index = (std::max<size_t>(size, 1) - 1) / POOL_GRANULARITY;
+		*static_cast<void **>(p) = this->pool_free[index];
+		this->pool_free[index] = p;
+	}
+
 	void *Malloc(SQUnsignedInteger size)
 	{
-		void *p = malloc(size);
+		void *p = size <= POOL_MAX_SIZE ? this->PoolMalloc(size) : malloc(size);
 		this->allocated_size += size;
 
 		this->CheckAllocation(size, p);
@@ -128,12 +181,26 @@ struct ScriptAllocator {
 		this->allocations.erase(p);
 #endif
 
-		void *new_p = realloc(p, size);
+		void *new_p;
+		if (oldsize > POOL_MAX_SIZE && size > POOL_MAX_SIZE) {
+			new_p = realloc(p, size);
+		} else {
+			/* Moving into, out of or within the pool; the old block stays valid when this fails. */
+			new_p = size <= POOL_MAX_SIZE ? this->PoolMalloc(size) : malloc(size);
+			if (new_p != nullptr) {
+				memcpy(new_p, p, std::min<size_t>(oldsize, size));
+				if (oldsize <= POOL_MAX_SIZE) {
+					this->PoolFree(p, oldsize);
+				} else {
+					free(p);
+				}
+			}
+		}
 
 		this->allocated_size -= oldsize;
 		this->allocated_size += size;
 
-		this->CheckAllocation(size, p);
+		this->CheckAllocation(size, new_p);
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(new_p != nullptr);
@@ -147,7 +214,11 @@ struct ScriptAllocator {
 	void Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		free(p);
+		if (size <= POOL_MAX_SIZE) {
+			this->PoolFree(p, size);
+		} else {
+			free(p);
+		}
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -162,6 +233,9 @@ struct ScriptAllocator {
 		this->allocation_limit = static_cast<size_t>(_settings_game.script.script_max_memory_megabytes) << 20;
 		if (this->allocation_limit == 0) this->allocation_limit = SAFE_LIMIT; // in case the setting is somehow zero
 		this->error_thrown = false;
+		std::fill(std::begin(this->pool_free), std::end(this->pool_free), nullptr);
+		this->pool_chunk_pos = nullptr;
+		this->pool_chunk_left = 0;
 	}
 
 	~ScriptAllocator()
@@ -169,6 +243,8 @@ struct ScriptAllocator {
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.size() == 0);
 #endif
+		/* Whatever the script left behind goes with the chunks. */
+		for (void *chunk : this->pool_chunks) free(chunk);
 	}
 };
 
@@ -404,8 +480,17 @@ void Squirrel::ResumeError()
 
 void Squirrel::CollectGarbage()
 {
+	/* Reference counting frees everything but cycles, so unless the memory use grew
+	 * there is not enough garbage to warrant walking all objects. Always collect
+	 * when getting near the limit, as the script would be killed otherwise. */
+	size_t allocated = this->allocator->allocated_size;
+	if (allocated < this->gc_threshold && allocated < this->allocator->allocation_limit / 4 * 3) return;
+
 	ScriptAllocatorScope alloc_scope(this);
 	sq_collectgarbage(this->vm);
+
+	allocated = this->allocator->allocated_size;
+	this->gc_threshold = allocated + std::max<size_t>(allocated / 4, 1 << 20);
 }
 
 bool Squirrel::CallMethod(HSQOBJECT instance, const char *method_name, HSQOBJECT *ret, int suspend)
@@ -540,6 +625,7 @@ void Squirrel::Initialize()
 	this->print_func = nullptr;
 	this->crashed = false;
 	this->overdrawn_ops = 0;
+	this->gc_threshold = 0;
 	this->vm = sq_open(1024);
 
 	/* Handle compile-errors ourself, so we can display it nicely */
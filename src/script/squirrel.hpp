@@ -31,6 +31,7 @@ private:
 	SQPrintFunc *print_func; ///< Points to either nullptr, or a custom print handler
 	bool crashed;            ///< True if the squirrel script made an error.
 	int overdrawn_ops;       ///< The amount of operations we have overdrawn.
+	size_t gc_threshold;     ///< Allocated memory above which the next garbage collection is done.
 	const char *APIName;     ///< Name of the API used for this squirrel.
 	std::unique_ptr<ScriptAllocator> allocator; ///< Allocator object used by this script.
 
@@ -145,7 +146,8 @@ public:
 	void ResumeError();
 
 	/**
-	 * Tell the VM to do a garbage collection run.
+	 * Tell the VM to do a garbage collection run, if enough memory has been
+	 *  allocated since the previous one.
 	 */
 	void CollectGarbage();
 
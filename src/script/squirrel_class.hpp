@@ -101,11 +101,13 @@ public:
 	void PreRegister(Squirrel *engine)
 	{
 		engine->AddClassBegin(this->classname);
+		sq_settypetag(engine->GetVM(), -1, GetClassTypeTag<CL, ST>());
 	}
 
 	void PreRegister(Squirrel *engine, const char *parent_class)
 	{
 		engine->AddClassBegin(this->classname, parent_class);
+		sq_settypetag(engine->GetVM(), -1, GetClassTypeTag<CL, ST>());
 	}
 
 	template <typename Func, int Tnparam>
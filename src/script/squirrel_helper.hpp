@@ -18,6 +18,17 @@
 
 template <class CL, ScriptType ST> const char *GetClassName();
 
+/**
+ * Get the type tag of the Squirrel class that wraps a C++ class.
+ * The tag is only compared by address, so any unique pointer will do.
+ * @return The type tag for this class.
+ */
+template <class CL, ScriptType ST> inline SQUserPointer GetClassTypeTag()
+{
+	static const char tag = 0;
+	return const_cast<char *>(&tag);
+}
+
 /**
  * The Squirrel convert routines
  */
@@ -739,22 +750,11 @@ namespace SQConvert {
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
 		SQUserPointer real_instance = nullptr;
-		HSQOBJECT instance;
-
-		/* Get the 'SQ' instance of this class */
-		Squirrel::GetInstance(vm, &instance);
-
-		/* Protect against calls to a non-static method in a static way */
-		sq_pushroottable(vm);
-		const char *className = GetClassName<Tcls, Ttype>();
-		sq_pushstring(vm, className, -1);
-		sq_get(vm, -2);
-		sq_pushobject(vm, instance);
-		if (sq_instanceof(vm) != SQTrue) return sq_throwerror(vm, "class method is non-static");
-		sq_pop(vm, 3);
-
-		/* Get the 'real' instance of this class */
-		sq_getinstanceup(vm, 1, &real_instance, nullptr);
+
+		/* Get the 'real' instance of this class. The type tag check protects
+		 * against calls to a non-static method in a static way, or on an
+		 * instance of an unrelated class, without looking up the class by name. */
+		if (SQ_FAILED(sq_getinstanceup(vm, 1, &real_instance, GetClassTypeTag<Tcls, Ttype>()))) return sq_throwerror(vm, "class method is non-static");
 		/* Get the real function pointer */
 		sq_getuserdata(vm, nparam, &ptr, nullptr);
 		if (real_instance == nullptr) return sq_throwerror(vm, "couldn't detect real instance of class for non-static call");
@@ -781,22 +781,11 @@ namespace SQConvert {
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
 		SQUserPointer real_instance = nullptr;
-		HSQOBJECT instance;
-
-		/* Get the 'SQ' instance of this class */
-		Squirrel::GetInstance(vm, &instance);
-
-		/* Protect against calls to a non-static method in a static way */
-		sq_pushroottable(vm);
-		const char *className = GetClassName<Tcls, Ttype>();
-		sq_pushstring(vm, className, -1);
-		sq_get(vm, -2);
-		sq_pushobject(vm, instance);
-		if (sq_instanceof(vm) != SQTrue) return sq_throwerror(vm, "class method is non-static");
-		sq_pop(vm, 3);
-
-		/* Get the 'real' instance of this class */
-		sq_getinstanceup(vm, 1, &real_instance, nullptr);
+
+		/* Get the 'real' instance of this class. The type tag check protects
+		 * against calls to a non-static method in a static way, or on an
+		 * instance of an unrelated class, without looking up the class by name. */
+		if (SQ_FAILED(sq_getinstanceup(vm, 1, &real_instance, GetClassTypeTag<Tcls, Ttype>()))) return sq_throwerror(vm, "class method is non-static");
 		/* Get the real function pointer */
 		sq_getuserdata(vm, nparam, &ptr, nullptr);
 		if (real_instance == nullptr) return sq_throwerror(vm, "couldn't detect real instance of class for non-static call");
@@ -23,6 +23,7 @@
 
 #include "stdafx.h"
 #include <charconv>
+#include <unordered_map>
 #include "settings_table.h"
 #include "debug.h"
 #include "currency.h"
@@ -1391,22 +1392,43 @@ void IntSettingDesc::ChangeValue(const void *object, int32 newval) const
  */
 static const SettingDesc *GetSettingFromName(const std::string_view name, const SettingTable &settings)
 {
-	/* First check all full names */
-	for (auto &desc : settings) {
-		const SettingDesc *sd = GetSettingDesc(desc);
-		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to)) continue;
-		if (sd->GetName() == name) return sd;
+	/** Settings of one table by their full name and by every shortcut variant of it. */
+	struct SettingNameIndex {
+		std::unordered_map<std::string_view, std::vector<const SettingDesc *>> full_names;
+		std::unordered_map<std::string_view, std::vector<const SettingDesc *>> short_names;
+	};
+	static std::unordered_map<const SettingVariant *, SettingNameIndex> indices;
+
+	auto [it, created] = indices.try_emplace(settings.begin());
+	SettingNameIndex &index = it->second;
+	if (created) {
+		for (auto &desc : settings) {
+			const SettingDesc *sd = GetSettingDesc(desc);
+			const std::string &full_name = sd->GetName();
+			index.full_names[full_name].push_back(sd);
+			/* Any part after a dot is a shortcut, e.g. "ai_in_multiplayer" for "ai.ai_in_multiplayer". */
+			for (size_t dot = full_name.find('.'); dot != std::string::npos; dot = full_name.find('.', dot + 1)) {
+				index.short_names[std::string_view(full_name).substr(dot + 1)].push_back(sd);
+			}
+		}
 	}
 
-	/* Then check the shortcut variant of the name. */
-	std::string short_name_suffix = std::string{ "." }.append(name);
-	for (auto &desc : settings) {
-		const SettingDesc *sd = GetSettingDesc(desc);
-		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to)) continue;
-		if (StrEndsWith(sd->GetName(), short_name_suffix)) return sd;
-	}
+	/* Names can be reused by settings of different savegame versions, so return the first one valid now. */
+	auto find = [name](const std::unordered_map<std::string_view, std::vector<const SettingDesc *>> &names) -> const SettingDesc * {
+		auto entry = names.find(name);
+		if (entry == names.end()) return nullptr;
+		for (const SettingDesc *sd : entry->second) {
+			if (SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to)) return sd;
+		}
+		return nullptr;
+	};
+
+	/* First check all full names */
+	const SettingDesc *sd = find(index.full_names);
+	if (sd != nullptr) return sd;
 
-	return nullptr;
+	/* Then check the shortcut variant of the name. */
+	return find(index.short_names);
 }
 
 /**
@@ -258,6 +258,8 @@ DECLARE_ENUM_AS_BIT_SET(SigFlags)
 
 /**
  * Search signal block
+ * The whole block is always explored, as every signal around it has to be
+ * collected into _tbuset; the train search stops at the first train found.
  *
  * @param owner owner whose signals we are updating
  * @return SigFlags
@@ -820,6 +820,56 @@ inline uint32 SmallMapWindow::GetTileColours(const TileArea &ta) const
 	}
 }
 
+/**
+ * Make sure the cache of tile colours fits the currently displayed zoom level and map type.
+ * The groups of tiles of the smallmap only move by whole groups while scrolling, so their
+ * colours stay valid until the tiles or the legends change, or the refresh timer elapses.
+ * @param tile_x X coordinate of a tile at the start of a group of tiles.
+ * @param tile_y Y coordinate of a tile at the start of a group of tiles.
+ */
+void SmallMapWindow::PrepareTileColours(int tile_x, int tile_y) const
+{
+	/* At the closest zoom level a group is a single tile, that is quick enough to not need a cache. */
+	if (this->zoom == 1) {
+		this->tile_colours.clear();
+		this->tile_colours_valid.clear();
+		return;
+	}
+
+	Point offset = {((tile_x % this->zoom) + this->zoom) % this->zoom, ((tile_y % this->zoom) + this->zoom) % this->zoom};
+	uint stride = MapSizeX() / this->zoom + 1;
+	size_t size = (size_t)stride * (MapSizeY() / this->zoom + 1);
+
+	if (this->tile_colours_valid.size() == size && this->tile_colours_zoom == this->zoom &&
+			this->tile_colours_offset.x == offset.x && this->tile_colours_offset.y == offset.y) return;
+
+	this->tile_colours.resize(size);
+	this->tile_colours_valid.assign(size, false);
+	this->tile_colours_stride = stride;
+	this->tile_colours_offset = offset;
+	this->tile_colours_zoom = this->zoom;
+}
+
+/**
+ * Get the colours to show for a group of tiles, using the cache when possible.
+ * @param xc The X coordinate of the first tile of the group.
+ * @param yc The Y coordinate of the first tile of the group.
+ * @param ta Tile area of the group.
+ * @return Colours to display.
+ * @pre #PrepareTileColours has been called for the group of tiles.
+ */
+inline uint32 SmallMapWindow::GetCachedTileColours(uint xc, uint yc, const TileArea &ta) const
+{
+	if (this->tile_colours_valid.empty()) return this->GetTileColours(ta);
+
+	size_t index = (size_t)(yc / this->zoom) * this->tile_colours_stride + xc / this->zoom;
+	if (!this->tile_colours_valid[index]) {
+		this->tile_colours[index] = this->GetTileColours(ta);
+		this->tile_colours_valid[index] = true;
+	}
+	return this->tile_colours[index];
+}
+
 /**
  * Draws one column of tiles of the small map in a certain mode onto the screen buffer, skipping the shifted rows in between.
  *
@@ -857,7 +907,7 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 		}
 		ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
 
-		uint32 val = this->GetTileColours(ta);
+		uint32 val = this->GetCachedTileColours(xc, yc, ta);
 		uint8 *val8 = (uint8 *)&val;
 		int idx = std::max(0, -start_pos);
 		for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
@@ -982,6 +1032,7 @@ void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi) const
 	Point tile = this->PixelToTile(dpi->left, dpi->top, &dx);
 	int tile_x = this->scroll_x / (int)TILE_SIZE + tile.x;
 	int tile_y = this->scroll_y / (int)TILE_SIZE + tile.y;
+	this->PrepareTileColours(tile_x, tile_y);
 
 	void *ptr = blitter->MoveTo(dpi->dst_ptr, -dx - 4, 0);
 	int x = - dx - 4;
@@ -1317,6 +1368,7 @@ void SmallMapWindow::SwitchMapType(SmallMapType map_type)
 
 	if (map_type == SMT_LINKSTATS) this->overlay->SetDirty();
 	if (map_type != SMT_INDUSTRY) this->BreakIndustryChainLink();
+	this->InvalidateTileColours();
 	this->SetDirty();
 }
 
@@ -1418,6 +1470,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 		_smallmap_industry_highlight = new_highlight;
 		this->refresh.SetInterval(_smallmap_industry_highlight != INVALID_INDUSTRYTYPE ? BLINK_PERIOD : FORCE_REFRESH_PERIOD);
 		_smallmap_industry_highlight_state = true;
+		this->InvalidateTileColours();
 		this->SetDirty();
 	}
 }
@@ -1493,6 +1546,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 						this->SelectLegendItem(click_pos, _legend_land_owners, _smallmap_company_count, NUM_NO_COMPANY_ENTRIES);
 					}
 				}
+				this->InvalidateTileColours();
 				this->SetDirty();
 			}
 			break;
@@ -1518,6 +1572,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 				tbl->show_on_map = (widget == WID_SM_ENABLE_ALL);
 			}
 			if (this->map_type == SMT_LINKSTATS) this->SetOverlayCargoMask();
+			this->InvalidateTileColours();
 			this->SetDirty();
 			break;
 		}
@@ -1525,6 +1580,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 		case WID_SM_SHOW_HEIGHT: // Enable/disable showing of heightmap.
 			_smallmap_show_heightmap = !_smallmap_show_heightmap;
 			this->SetWidgetLoweredState(WID_SM_SHOW_HEIGHT, _smallmap_show_heightmap);
+			this->InvalidateTileColours();
 			this->SetDirty();
 			break;
 	}
@@ -1536,6 +1592,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
  * - data = 0: Displayed industries at the industry chain window have changed.
  * - data = 1: Companies have changed.
  * - data = 2: Cheat changing the maximum heightlevel has been used, rebuild our heightlevel-to-colour index
+ * - data = 3: The colour scheme of the smallmap has changed.
  * @param gui_scope Whether the call is done from GUI scope. You may not do everything when not in GUI scope. See #InvalidateWindowData() for details.
  */
 /* virtual */ void SmallMapWindow::OnInvalidateData(int data, bool gui_scope)
@@ -1562,8 +1619,12 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 			this->RebuildColourIndexIfNecessary();
 			break;
 
+		case 3:
+			break;
+
 		default: NOT_REACHED();
 	}
+	this->InvalidateTileColours();
 	this->SetDirty();
 }
 
@@ -1604,6 +1665,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 	_smallmap_industry_highlight_state = !_smallmap_industry_highlight_state;
 
 	this->refresh.SetInterval(_smallmap_industry_highlight != INVALID_INDUSTRYTYPE ? BLINK_PERIOD : FORCE_REFRESH_PERIOD);
+	this->InvalidateTileColours();
 	this->SetDirty();
 }
 
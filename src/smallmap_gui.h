@@ -81,6 +81,12 @@ protected:
 	GUITimer refresh; ///< Refresh timer.
 	LinkGraphOverlay *overlay;
 
+	mutable std::vector<uint32> tile_colours;    ///< Cached colours of the groups of tiles shown at the current zoom level, see #GetCachedTileColours.
+	mutable std::vector<bool> tile_colours_valid; ///< For each entry in #tile_colours whether it has been computed already.
+	mutable uint tile_colours_stride;             ///< Number of entries of a row in #tile_colours.
+	mutable Point tile_colours_offset;            ///< %Tile coordinates modulo #zoom of the groups of tiles in #tile_colours.
+	mutable int tile_colours_zoom;                ///< Zoom level of the entries in #tile_colours.
+
 	static void BreakIndustryChainLink();
 	Point SmallmapRemapCoords(int x, int y) const;
 
@@ -166,6 +172,14 @@ protected:
 	void SetOverlayCargoMask();
 	void SetupWidgetData();
 	uint32 GetTileColours(const TileArea &ta) const;
+	void PrepareTileColours(int tile_x, int tile_y) const;
+	uint32 GetCachedTileColours(uint xc, uint yc, const TileArea &ta) const;
+
+	/** Forget the cached colours of the tiles, e.g. because the tiles or the legends have changed. */
+	inline void InvalidateTileColours()
+	{
+		this->tile_colours_valid.clear();
+	}
 
 	int GetPositionOnLegend(Point pt);
 
@@ -257,8 +257,13 @@ public:
 		if (!this->IsSortable()) return false;
 
 		const bool desc = (this->flags & VL_DESC) != 0;
+		auto comp = [&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); };
 
-		std::sort(std::vector<T>::begin(), std::vector<T>::end(), [&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); });
+		/* Periodic resorts and rebuilds mostly find the list still in order,
+		 * which takes a single pass to confirm instead of a full sort. */
+		if (!std::is_sorted(std::vector<T>::begin(), std::vector<T>::end(), comp)) {
+			std::sort(std::vector<T>::begin(), std::vector<T>::end(), comp);
+		}
 		return true;
 	}
 
@@ -112,6 +112,8 @@ static uint _sprite_lru_counter;
 static MemBlock *_spritecache_ptr;
 static uint _allocated_sprite_cache_size = 0;
 static int _compact_cache_counter;
+static uint64 _sprite_cache_hits;   ///< Number of sprite cache lookups that found the sprite loaded.
+static uint64 _sprite_cache_misses; ///< Number of sprite cache lookups that had to load the sprite.
 
 static void CompactSpriteCache();
 static void *AllocSprite(size_t mem_req);
@@ -238,11 +240,16 @@ static bool ResizeSpriteIn(SpriteLoader::Sprite *sprite, ZoomLevel src, ZoomLeve
 	sprite[tgt].AllocateData(tgt, sprite[tgt].width * sprite[tgt].height);
 
 	SpriteLoader::CommonPixel *dst = sprite[tgt].data;
-	for (int y = 0; y < sprite[tgt].height; y++) {
-		const SpriteLoader::CommonPixel *src_ln = &sprite[src].data[y / scaled_1 * sprite[src].width];
-		for (int x = 0; x < sprite[tgt].width; x++) {
-			*dst = src_ln[x / scaled_1];
-			dst++;
+	for (int y = 0; y < sprite[src].height; y++) {
+		/* Scale the line horizontally, and then repeat the scaled line for the vertical scaling. */
+		const SpriteLoader::CommonPixel *src_ln = &sprite[src].data[y * sprite[src].width];
+		const SpriteLoader::CommonPixel *dst_ln = dst;
+		for (int x = 0; x < sprite[src].width; x++) {
+			for (uint i = 0; i < scaled_1; i++) *dst++ = src_ln[x];
+		}
+		for (uint i = 1; i < scaled_1; i++) {
+			MemCpyT(dst, dst_ln, sprite[tgt].width);
+			dst += sprite[tgt].width;
 		}
 	}
 
@@ -264,19 +271,25 @@ static void ResizeSpriteOut(SpriteLoader::Sprite *sprite, ZoomLevel zoom)
 	const SpriteLoader::CommonPixel *src = sprite[zoom - 1].data;
 	[[maybe_unused]] const SpriteLoader::CommonPixel *src_end = src + sprite[zoom - 1].height * sprite[zoom - 1].width;
 
+	/* Every destination pixel takes the second of two source pixels, unless that one is transparent.
+	 * With an odd source width the last destination pixel of a line only has one source pixel. */
+	const uint pairs = sprite[zoom - 1].width / 2;
+	const bool odd_width = (sprite[zoom - 1].width & 1) != 0;
+	assert(pairs + (odd_width ? 1 : 0) == sprite[zoom].width);
+
 	for (uint y = 0; y < sprite[zoom].height; y++) {
 		const SpriteLoader::CommonPixel *src_ln = src + sprite[zoom - 1].width;
 		assert(src_ln <= src_end);
-		for (uint x = 0; x < sprite[zoom].width; x++) {
-			assert(src < src_ln);
-			if (src + 1 != src_ln && (src + 1)->a != 0) {
-				*dst = *(src + 1);
-			} else {
-				*dst = *src;
-			}
+		for (uint x = 0; x < pairs; x++) {
+			*dst = (src + 1)->a != 0 ? *(src + 1) : *src;
 			dst++;
 			src += 2;
 		}
+		if (odd_width) {
+			assert(src + 1 == src_ln);
+			*dst = *src;
+			dst++;
+		}
 		src = src_ln + sprite[zoom - 1].width;
 	}
 }
@@ -540,7 +553,8 @@ static std::map<uint32, size_t> _grf_sprite_offsets;
  */
 size_t GetGRFSpriteOffset(uint32 id)
 {
-	return _grf_sprite_offsets.find(id) != _grf_sprite_offsets.end() ? _grf_sprite_offsets[id] : SIZE_MAX;
+	auto it = _grf_sprite_offsets.find(id);
+	return it != _grf_sprite_offsets.end() ? it->second : SIZE_MAX;
 }
 
 /**
@@ -558,10 +572,11 @@ void ReadGRFSpriteOffsets(SpriteFile &file)
 		file.SeekTo(data_offset, SEEK_CUR);
 
 		/* Loop over all sprite section entries and store the file
-		 * offset for each newly encountered ID. */
+		 * offset for each newly encountered ID. The IDs are usually
+		 * increasing, so hint that the entry belongs at the end. */
 		uint32 id, prev_id = 0;
 		while ((id = file.ReadDword()) != 0) {
-			if (id != prev_id) _grf_sprite_offsets[id] = file.GetPos() - 4;
+			if (id != prev_id) _grf_sprite_offsets.insert_or_assign(_grf_sprite_offsets.end(), id, file.GetPos() - 4);
 			prev_id = id;
 			file.SkipBytes(file.ReadDword());
 		}
@@ -685,6 +700,14 @@ static size_t GetSpriteCacheUsage()
 	return tot_size;
 }
 
+/**
+ * Get the statistics of the sprite cache since it was last initialised.
+ * @return The hits, misses and memory usage of the sprite cache.
+ */
+SpriteCacheStats GetSpriteCacheStats()
+{
+	return { _sprite_cache_hits, _sprite_cache_misses, _spritecache_ptr == nullptr ? 0 : GetSpriteCacheUsage(), _allocated_sprite_cache_size };
+}
 
 void IncreaseSpriteLRU()
 {
@@ -726,13 +749,15 @@ static void CompactSpriteCache()
 
 	for (s = _spritecache_ptr; s->size != 0;) {
 		if (s->size & S_FREE_MASK) {
+			/* Free blocks are only coalesced with the blocks after them, so do it here. */
+			while (NextBlock(s)->size & S_FREE_MASK) {
+				s->size += NextBlock(s)->size & ~S_FREE_MASK;
+			}
+
 			MemBlock *next = NextBlock(s);
 			MemBlock temp;
 			SpriteID i;
 
-			/* Since free blocks are automatically coalesced, this should hold true. */
-			assert(!(next->size & S_FREE_MASK));
-
 			/* If the next block is the sentinel block, we can safely return */
 			if (next->size == 0) break;
 
@@ -770,13 +795,11 @@ static void DeleteEntryFromSpriteCache(uint item)
 	s->size |= S_FREE_MASK;
 	GetSpriteCache(item)->ptr = nullptr;
 
-	/* And coalesce adjacent free blocks */
-	for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-		if (s->size & S_FREE_MASK) {
-			while (NextBlock(s)->size & S_FREE_MASK) {
-				s->size += NextBlock(s)->size & ~S_FREE_MASK;
-			}
-		}
+	/* And coalesce with the free blocks after it. Free blocks before it are
+	 * coalesced when AllocSprite or CompactSpriteCache walk past them, which
+	 * saves walking the whole cache for every deleted sprite. */
+	while (NextBlock(s)->size & S_FREE_MASK) {
+		s->size += NextBlock(s)->size & ~S_FREE_MASK;
 	}
 }
 
@@ -816,6 +839,11 @@ static void *AllocSprite(size_t mem_req)
 
 		for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
 			if (s->size & S_FREE_MASK) {
+				/* Coalesce with the free blocks after this one. */
+				while (NextBlock(s)->size & S_FREE_MASK) {
+					s->size += NextBlock(s)->size & ~S_FREE_MASK;
+				}
+
 				size_t cur_size = s->size & ~S_FREE_MASK;
 
 				/* Is the block exactly the size we need or
@@ -925,7 +953,12 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator, S
 		sc->lru = ++_sprite_lru_counter;
 
 		/* Load the sprite, if it is not loaded, yet */
-		if (sc->ptr == nullptr) sc->ptr = ReadSprite(sc, sprite, type, AllocSprite, nullptr);
+		if (sc->ptr == nullptr) {
+			_sprite_cache_misses++;
+			sc->ptr = ReadSprite(sc, sprite, type, AllocSprite, nullptr);
+		} else {
+			_sprite_cache_hits++;
+		}
 
 		return sc->ptr;
 	} else {
@@ -996,6 +1029,8 @@ void GfxInitSpriteMem()
 	_spritecache = nullptr;
 
 	_compact_cache_counter = 0;
+	_sprite_cache_hits = 0;
+	_sprite_cache_misses = 0;
 	_sprite_files.clear();
 }
 
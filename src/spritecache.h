@@ -36,6 +36,16 @@ uint32 GetSpriteLocalID(SpriteID sprite);
 uint GetSpriteCountForFile(const std::string &filename, SpriteID begin, SpriteID end);
 uint GetMaxSpriteID();
 
+/** Statistics about the use of the sprite cache. */
+struct SpriteCacheStats {
+	uint64 hits;   ///< Number of requests for a sprite that was already in the cache.
+	uint64 misses; ///< Number of requests for a sprite that had to be loaded into the cache.
+	size_t used;   ///< Number of bytes of the cache in use.
+	size_t total;  ///< Total number of bytes of the cache.
+};
+
+SpriteCacheStats GetSpriteCacheStats();
+
 
 static inline const Sprite *GetSprite(SpriteID sprite, SpriteType type)
 {
@@ -561,6 +561,10 @@ CargoArray GetAcceptanceAroundTiles(TileIndex center_tile, int w, int h, int rad
 
 /**
  * Get the acceptance of cargoes around the station in.
+ * The acceptance is summed up from scratch on every call. House, object and
+ * industry acceptance may come from NewGRF callbacks that depend on the date,
+ * construction stage or random bits, so a per tile cache could not tell when
+ * to update without asking the callbacks again.
  * @param st Station to get acceptance of.
  * @param always_accepted bitmask of cargo accepted by houses and headquarters; can be nullptr
  */
@@ -1968,7 +1972,11 @@ static Vehicle *ClearRoadStopStatusEnum(Vehicle *v, void *)
 		 * bits and only when the state was 'in road stop', otherwise
 		 * we'll end up clearing the turn around bits. */
 		RoadVehicle *rv = RoadVehicle::From(v);
-		if (HasBit(rv->state, RVS_IN_DT_ROAD_STOP)) rv->state &= RVSB_ROAD_STOP_TRACKDIR_MASK;
+		if (HasBit(rv->state, RVS_IN_DT_ROAD_STOP)) {
+			/* Leave the entry first, as the vehicle will not leave it by driving. */
+			if (rv->IsFrontEngine() && (rv->vehstatus & VS_CRASHED) == 0) RoadStop::GetByTile(rv->tile, GetRoadStopType(rv->tile))->Leave(rv);
+			rv->state &= RVSB_ROAD_STOP_TRACKDIR_MASK;
+		}
 	}
 
 	return nullptr;
@@ -3458,6 +3466,13 @@ static void TruncateCargo(const CargoSpec *cs, GoodsEntry *ge, uint amount = UIN
 	}
 }
 
+/**
+ * Update the ratings of all cargoes at a station and truncate the waiting cargo of badly rated cargoes.
+ * This is called every #STATION_RATING_TICKS for each station, but as the counter
+ * of each station starts when it is built the updates of different stations are
+ * spread over those ticks already.
+ * @param st The station to update.
+ */
 static void UpdateStationRating(Station *st)
 {
 	bool waiting_changed = false;
@@ -3465,6 +3480,9 @@ static void UpdateStationRating(Station *st)
 	byte_inc_sat(&st->time_since_load);
 	byte_inc_sat(&st->time_since_unload);
 
+	/* The statue bonus is the same for all cargoes of the station. */
+	const int statue_bonus = (Company::IsValidID(st->owner) && HasBit(st->town->statues, st->owner)) ? 26 : 0;
+
 	for (const CargoSpec *cs : CargoSpec::Iterate()) {
 		GoodsEntry *ge = &st->goods[cs->Index()];
 		/* Slowly increase the rating back to its original level in the case we
@@ -3543,7 +3561,7 @@ static void UpdateStationRating(Station *st)
 				if (ge->max_waiting_cargo <= 100) rating += 10;
 			}
 
-			if (Company::IsValidID(st->owner) && HasBit(st->town->statues, st->owner)) rating += 26;
+			rating += statue_bonus;
 
 			byte age = ge->last_age;
 			if (age < 3) rating += 10;
@@ -4425,7 +4443,7 @@ StationID FlowStat::GetVia(StationID excluded, StationID excluded2) const
 		Swap(interval, interval2);
 	}
 	rand = RandomRange(new_max);
-	SharesMap::const_iterator it3 = this->shares.upper_bound(this->unrestricted);
+	SharesMap::const_iterator it3;
 	if (rand < begin) {
 		it3 = this->shares.upper_bound(rand);
 	} else if (rand < begin2 - interval) {
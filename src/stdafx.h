@@ -420,9 +420,11 @@ static_assert(SIZE_MAX >= UINT32_MAX);
 #if defined(__GNUC__) || defined(__clang__)
 #	define likely(x)   __builtin_expect(!!(x), 1)
 #	define unlikely(x) __builtin_expect(!!(x), 0)
+#	define prefetch(x) __builtin_prefetch(x)
 #else
 #	define likely(x)   (x)
 #	define unlikely(x) (x)
+#	define prefetch(x)
 #endif /* __GNUC__ || __clang__ */
 
 /* For the FMT library we only want to use the headers, not link to some library. */
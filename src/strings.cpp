@@ -822,6 +822,16 @@ static char *FormatString(char *buff, const char *str_arg, StringParameters *arg
 	str_stack.push(str_arg);
 
 	for (;;) {
+		if (!str_stack.empty()) {
+			/* Plain ASCII text does not contain control codes, so copy it
+			 * directly instead of decoding and encoding it per character. */
+			const char *&s = str_stack.top();
+			while ((byte)*s - 1U < 0x7F) {
+				if (buff + 1 < last) *buff++ = *s;
+				s++;
+			}
+		}
+
 		while (!str_stack.empty() && (b = Utf8Consume(&str_stack.top())) == '\0') {
 			str_stack.pop();
 		}
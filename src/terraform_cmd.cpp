@@ -20,15 +20,19 @@
 
 #include "table/strings.h"
 
-#include <map>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 #include "safeguards.h"
 
-/** Set of tiles. */
-typedef std::set<TileIndex> TileIndexSet;
-/** Mapping of tiles to their height. */
-typedef std::map<TileIndex, int> TileIndexToHeightMap;
+/**
+ * Set of tiles, kept sorted by tile index.
+ * A single terraform only touches a handful of tiles, for which a flat vector
+ * is a lot cheaper than allocating the nodes of a tree.
+ */
+typedef std::vector<TileIndex> TileIndexSet;
+/** Mapping of tiles to their height, kept sorted by tile index. */
+typedef std::vector<std::pair<TileIndex, int>> TileIndexToHeightMap;
 
 /** State of the terraforming. */
 struct TerraformerState {
@@ -47,8 +51,8 @@ TileIndex _terraform_err_tile; ///< first tile we couldn't terraform
  */
 static int TerraformGetHeightOfTile(const TerraformerState *ts, TileIndex tile)
 {
-	TileIndexToHeightMap::const_iterator it = ts->tile_to_new_height.find(tile);
-	return it != ts->tile_to_new_height.end() ? it->second : TileHeight(tile);
+	auto it = std::lower_bound(ts->tile_to_new_height.begin(), ts->tile_to_new_height.end(), tile, [](const auto &a, TileIndex b) { return a.first < b; });
+	return it != ts->tile_to_new_height.end() && it->first == tile ? it->second : TileHeight(tile);
 }
 
 /**
@@ -60,7 +64,12 @@ static int TerraformGetHeightOfTile(const TerraformerState *ts, TileIndex tile)
  */
 static void TerraformSetHeightOfTile(TerraformerState *ts, TileIndex tile, int height)
 {
-	ts->tile_to_new_height[tile] = height;
+	auto it = std::lower_bound(ts->tile_to_new_height.begin(), ts->tile_to_new_height.end(), tile, [](const auto &a, TileIndex b) { return a.first < b; });
+	if (it != ts->tile_to_new_height.end() && it->first == tile) {
+		it->second = height;
+	} else {
+		ts->tile_to_new_height.insert(it, {tile, height});
+	}
 }
 
 /**
@@ -72,7 +81,8 @@ static void TerraformSetHeightOfTile(TerraformerState *ts, TileIndex tile, int h
  */
 static void TerraformAddDirtyTile(TerraformerState *ts, TileIndex tile)
 {
-	ts->dirty_tiles.insert(tile);
+	auto it = std::lower_bound(ts->dirty_tiles.begin(), ts->dirty_tiles.end(), tile);
+	if (it == ts->dirty_tiles.end() || *it != tile) ts->dirty_tiles.insert(it, tile);
 }
 
 /**
@@ -226,9 +236,7 @@ CommandCost CmdTerraformLand(TileIndex tile, DoCommandFlag flags, uint32 p1, uin
 	 * Pass == 0: Collect tileareas which are caused to be auto-cleared.
 	 * Pass == 1: Collect the actual cost. */
 	for (int pass = 0; pass < 2; pass++) {
-		for (TileIndexSet::const_iterator it = ts.dirty_tiles.begin(); it != ts.dirty_tiles.end(); it++) {
-			TileIndex t = *it;
-
+		for (TileIndex t : ts.dirty_tiles) {
 			assert(t < MapSize());
 			/* MP_VOID tiles can be terraformed but as tunnels and bridges
 			 * cannot go under / over these tiles they don't need checking. */
@@ -309,20 +317,16 @@ CommandCost CmdTerraformLand(TileIndex tile, DoCommandFlag flags, uint32 p1, uin
 
 	if (flags & DC_EXEC) {
 		/* Mark affected areas dirty. */
-		for (TileIndexSet::const_iterator it = ts.dirty_tiles.begin(); it != ts.dirty_tiles.end(); it++) {
-			MarkTileDirtyByTile(*it);
-			TileIndexToHeightMap::const_iterator new_height = ts.tile_to_new_height.find(*it);
-			if (new_height == ts.tile_to_new_height.end()) continue;
-			MarkTileDirtyByTile(*it, 0, new_height->second);
+		for (TileIndex t : ts.dirty_tiles) {
+			MarkTileDirtyByTile(t);
+			int height = TerraformGetHeightOfTile(&ts, t);
+			if (height == (int)TileHeight(t)) continue;
+			MarkTileDirtyByTile(t, 0, height);
 		}
 
 		/* change the height */
-		for (TileIndexToHeightMap::const_iterator it = ts.tile_to_new_height.begin();
-				it != ts.tile_to_new_height.end(); it++) {
-			TileIndex t = it->first;
-			int height = it->second;
-
-			SetTileHeight(t, (uint)height);
+		for (const auto &it : ts.tile_to_new_height) {
+			SetTileHeight(it.first, (uint)it.second);
 		}
 
 		if (c != nullptr) c->terraform_limit -= (uint32)ts.tile_to_new_height.size() << 16;
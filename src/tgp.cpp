@@ -453,78 +453,96 @@ static int *HeightMapMakeHistogram(height_t h_min, height_t h_max, int *hist_buf
 	return hist;
 }
 
+/**
+ * Apply the sine wave redistribution to a single height.
+ * @param h The height to transform; at least h_min.
+ * @param h_min The lowest height to transform.
+ * @param h_max The highest height after the transformation.
+ * @return The transformed height.
+ */
+static height_t SineTransformHeight(height_t h, height_t h_min, height_t h_max)
+{
+	double fheight;
+
+	/* Transform height into 0..1 space */
+	fheight = (double)(h - h_min) / (double)(h_max - h_min);
+	/* Apply sine transform depending on landscape type */
+	switch (_settings_game.game_creation.landscape) {
+		case LT_TOYLAND:
+		case LT_TEMPERATE:
+			/* Move and scale 0..1 into -1..+1 */
+			fheight = 2 * fheight - 1;
+			/* Sine transform */
+			fheight = sin(fheight * M_PI_2);
+			/* Transform it back from -1..1 into 0..1 space */
+			fheight = 0.5 * (fheight + 1);
+			break;
+
+		case LT_ARCTIC:
+			{
+				/* Arctic terrain needs special height distribution.
+				 * Redistribute heights to have more tiles at highest (75%..100%) range */
+				double sine_upper_limit = 0.75;
+				double linear_compression = 2;
+				if (fheight >= sine_upper_limit) {
+					/* Over the limit we do linear compression up */
+					fheight = 1.0 - (1.0 - fheight) / linear_compression;
+				} else {
+					double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
+					/* Get 0..sine_upper_limit into -1..1 */
+					fheight = 2.0 * fheight / sine_upper_limit - 1.0;
+					/* Sine wave transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
+					fheight = 0.5 * (fheight + 1.0) * m;
+				}
+			}
+			break;
+
+		case LT_TROPIC:
+			{
+				/* Desert terrain needs special height distribution.
+				 * Half of tiles should be at lowest (0..25%) heights */
+				double sine_lower_limit = 0.5;
+				double linear_compression = 2;
+				if (fheight <= sine_lower_limit) {
+					/* Under the limit we do linear compression down */
+					fheight = fheight / linear_compression;
+				} else {
+					double m = sine_lower_limit / linear_compression;
+					/* Get sine_lower_limit..1 into -1..1 */
+					fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
+					/* Sine wave transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
+					fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
+				}
+			}
+			break;
+
+		default:
+			NOT_REACHED();
+			break;
+	}
+	/* Transform it back into h_min..h_max space */
+	h = (height_t)(fheight * (h_max - h_min) + h_min);
+	if (h < 0) h = I2H(0);
+	if (h >= h_max) h = h_max - 1;
+	return h;
+}
+
 /** Applies sine wave redistribution onto height map */
 static void HeightMapSineTransform(height_t h_min, height_t h_max)
 {
-	for (height_t &h : _height_map.h) {
-		double fheight;
+	/* The transformation only depends on the height itself, so calculate it
+	 * once for each height instead of once for each tile. */
+	std::vector<height_t> transformed(h_max - h_min + 1);
+	for (height_t h = h_min; h <= h_max; h++) transformed[h - h_min] = SineTransformHeight(h, h_min, h_max);
 
+	for (height_t &h : _height_map.h) {
 		if (h < h_min) continue;
 
-		/* Transform height into 0..1 space */
-		fheight = (double)(h - h_min) / (double)(h_max - h_min);
-		/* Apply sine transform depending on landscape type */
-		switch (_settings_game.game_creation.landscape) {
-			case LT_TOYLAND:
-			case LT_TEMPERATE:
-				/* Move and scale 0..1 into -1..+1 */
-				fheight = 2 * fheight - 1;
-				/* Sine transform */
-				fheight = sin(fheight * M_PI_2);
-				/* Transform it back from -1..1 into 0..1 space */
-				fheight = 0.5 * (fheight + 1);
-				break;
-
-			case LT_ARCTIC:
-				{
-					/* Arctic terrain needs special height distribution.
-					 * Redistribute heights to have more tiles at highest (75%..100%) range */
-					double sine_upper_limit = 0.75;
-					double linear_compression = 2;
-					if (fheight >= sine_upper_limit) {
-						/* Over the limit we do linear compression up */
-						fheight = 1.0 - (1.0 - fheight) / linear_compression;
-					} else {
-						double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
-						/* Get 0..sine_upper_limit into -1..1 */
-						fheight = 2.0 * fheight / sine_upper_limit - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
-						fheight = 0.5 * (fheight + 1.0) * m;
-					}
-				}
-				break;
-
-			case LT_TROPIC:
-				{
-					/* Desert terrain needs special height distribution.
-					 * Half of tiles should be at lowest (0..25%) heights */
-					double sine_lower_limit = 0.5;
-					double linear_compression = 2;
-					if (fheight <= sine_lower_limit) {
-						/* Under the limit we do linear compression down */
-						fheight = fheight / linear_compression;
-					} else {
-						double m = sine_lower_limit / linear_compression;
-						/* Get sine_lower_limit..1 into -1..1 */
-						fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
-						fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
-					}
-				}
-				break;
-
-			default:
-				NOT_REACHED();
-				break;
-		}
-		/* Transform it back into h_min..h_max space */
-		h = (height_t)(fheight * (h_max - h_min) + h_min);
-		if (h < 0) h = I2H(0);
-		if (h >= h_max) h = h_max - 1;
+		h = h <= h_max ? transformed[h - h_min] : SineTransformHeight(h, h_min, h_max);
 	}
 }
 
@@ -586,40 +604,54 @@ static void HeightMapCurves(uint level)
 		c[i] = Random() % lengthof(curve_maps);
 	}
 
-	/* Apply curves */
-	for (int x = 0; x < _height_map.size_x; x++) {
-
-		/* Get our X grid positions and bi-linear ratio */
-		float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
-		uint x1 = (uint)fx;
-		uint x2 = x1;
-		float xr = 2.0f * (fx - x1) - 1.0f;
-		xr = sin(xr * M_PI_2);
-		xr = sin(xr * M_PI_2);
-		xr = 0.5f * (xr + 1.0f);
-		float xri = 1.0f - xr;
-
-		if (x1 > 0) {
-			x1--;
-			if (x2 >= sx) x2--;
+	/** Position of a row or column of the height map within the curve map grid. */
+	struct grid_position_t {
+		uint p1;  ///< The first grid row or column.
+		uint p2;  ///< The second grid row or column.
+		float r;  ///< The bi-linear ratio of the second grid row or column.
+		float ri; ///< The bi-linear ratio of the first grid row or column.
+	};
+
+	/* The grid positions only depend on the row or column, so calculate them once
+	 * for each of those instead of once for each tile. */
+	auto get_grid_position = [](uint size, int pos, int map_size) {
+		grid_position_t gp;
+
+		/* Get our grid position and bi-linear ratio */
+		float f = (float)(size * pos) / map_size + 1.0f;
+		gp.p1 = (uint)f;
+		gp.p2 = gp.p1;
+		float r = 2.0f * (f - gp.p1) - 1.0f;
+		r = sin(r * M_PI_2);
+		r = sin(r * M_PI_2);
+		r = 0.5f * (r + 1.0f);
+		gp.r = r;
+		gp.ri = 1.0f - r;
+
+		if (gp.p1 > 0) {
+			gp.p1--;
+			if (gp.p2 >= size) gp.p2--;
 		}
+		return gp;
+	};
 
-		for (int y = 0; y < _height_map.size_y; y++) {
-
-			/* Get our Y grid position and bi-linear ratio */
-			float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
-			uint y1 = (uint)fy;
-			uint y2 = y1;
-			float yr = 2.0f * (fy - y1) - 1.0f;
-			yr = sin(yr * M_PI_2);
-			yr = sin(yr * M_PI_2);
-			yr = 0.5f * (yr + 1.0f);
-			float yri = 1.0f - yr;
-
-			if (y1 > 0) {
-				y1--;
-				if (y2 >= sy) y2--;
-			}
+	std::vector<grid_position_t> grid_x(_height_map.size_x);
+	for (int x = 0; x < _height_map.size_x; x++) grid_x[x] = get_grid_position(sx, x, _height_map.size_x);
+	std::vector<grid_position_t> grid_y(_height_map.size_y);
+	for (int y = 0; y < _height_map.size_y; y++) grid_y[y] = get_grid_position(sy, y, _height_map.size_y);
+
+	/* Apply curves; every tile is handled independently, so walk the height map row by row. */
+	for (int y = 0; y < _height_map.size_y; y++) {
+		const uint y1 = grid_y[y].p1;
+		const uint y2 = grid_y[y].p2;
+		const float yr = grid_y[y].r;
+		const float yri = grid_y[y].ri;
+
+		for (int x = 0; x < _height_map.size_x; x++) {
+			const uint x1 = grid_x[x].p1;
+			const uint x2 = grid_x[x].p2;
+			const float xr = grid_x[x].r;
+			const float xri = grid_x[x].ri;
 
 			uint corner_a = c[x1 + sx * y1];
 			uint corner_b = c[x1 + sx * y2];
@@ -459,19 +459,21 @@ void UpdateVehicleTimetable(Vehicle *v, bool travelling)
 
 	v->lateness_counter -= (timetabled - time_taken);
 
-	/* When we are more late than this timetabled bit takes we (somewhat expensively)
-	 * check how many ticks the (fully filled) timetable has. If a timetable cycle is
-	 * shorter than the amount of ticks we are late we reduce the lateness by the
-	 * length of a full cycle till lateness is less than the length of a timetable
-	 * cycle. When the timetable isn't fully filled the cycle will be INVALID_TICKS. */
-	if (v->lateness_counter > (int)timetabled) {
+	/* When we are more late than a full timetable cycle takes we reduce the lateness
+	 * by the length of a full cycle till lateness is less than the length of a
+	 * timetable cycle. The cached duration is compared first, so the (somewhat
+	 * expensive) check whether the timetable is fully filled only happens when the
+	 * lateness could actually be reduced. When the timetable isn't fully filled the
+	 * cycle will be INVALID_TICKS. */
+	if (v->lateness_counter > (int)timetabled && v->lateness_counter > v->orders.list->GetTimetableDurationIncomplete()) {
 		Ticks cycle = v->orders.list->GetTimetableTotalDuration();
 		if (cycle != INVALID_TICKS && v->lateness_counter > cycle) {
 			v->lateness_counter %= cycle;
 		}
 	}
 
-	for (v = v->FirstShared(); v != nullptr; v = v->NextShared()) {
-		SetWindowDirty(WC_VEHICLE_TIMETABLE, v->index);
-	}
+	/* Every vehicle sharing these orders shows this lateness in its timetable; walking
+	 * the (possibly huge) shared chain for each arrival costs more than redrawing the
+	 * few open timetable windows. */
+	SetWindowClassesDirty(WC_VEHICLE_TIMETABLE);
 }
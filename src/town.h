@@ -84,8 +84,9 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 
 	uint16 time_until_rebuild;       ///< time until we rebuild a house
 
-	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate
+	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate; only up to date while not growing, @see GetGrowCounter
 	uint16 growth_rate;              ///< town growth rate
+	uint64 grow_tick;                ///< NOSAVE: tick in the growth schedule at which the grow counter runs out, while growing
 
 	byte fund_buildings_months;      ///< fund buildings program in action?
 	byte road_build_months;          ///< fund road reconstruction in action?
@@ -108,6 +109,10 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 
 	void InitializeLayout(TownLayout layout);
 
+	uint16 GetGrowCounter() const;
+	void SetGrowCounter(uint16 counter);
+	void SetGrowing(bool growing);
+
 	/**
 	 * Calculate the max town noise.
 	 * The value is counted using the population divided by the content of the
@@ -151,6 +156,7 @@ void ShowTownViewWindow(TownID town);
 void ExpandTown(Town *t);
 
 void RebuildTownKdtree();
+void RebuildTownGrowthSchedule();
 
 
 /**
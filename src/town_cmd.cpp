@@ -63,6 +63,24 @@ INSTANTIATE_POOL_METHODS(Town)
 
 TownKdtree _town_kdtree(&Kdtree_TownXYFunc);
 
+/** Number of entries in the cache of nearest town lookups. */
+static const uint CLOSEST_TOWN_CACHE_SIZE = 256;
+
+/** Entry of the cache of nearest town lookups. */
+struct ClosestTownCacheItem {
+	TileIndex tile = INVALID_TILE; ///< Tile that was looked up, or INVALID_TILE if the entry is unused.
+	TownID town = INVALID_TOWN;    ///< Town nearest to the tile.
+};
+
+/** Cache of the nearest town of recently looked up tiles, indexed by tile. */
+static ClosestTownCacheItem _closest_town_cache[CLOSEST_TOWN_CACHE_SIZE];
+
+/** Forget all cached nearest towns; needed whenever the town k-d tree changes. */
+static void InvalidateClosestTownCache()
+{
+	for (ClosestTownCacheItem &item : _closest_town_cache) item.tile = INVALID_TILE;
+}
+
 void RebuildTownKdtree()
 {
 	std::vector<TownID> townids;
@@ -70,6 +88,79 @@ void RebuildTownKdtree()
 		townids.push_back(town->index);
 	}
 	_town_kdtree.Build(townids.begin(), townids.end());
+	InvalidateClosestTownCache();
+}
+
+/** Number of ticks the towns have been ticked since the game was started or loaded. */
+static uint64 _town_growth_ticks;
+
+/**
+ * The growing towns, ordered by the tick at which their grow counter runs
+ * out and then by index. This way only the towns that actually need to grow
+ * have to be looked at, in the same order as when iterating over all towns.
+ */
+static std::set<std::pair<uint64, TownID>> _town_growth_schedule;
+
+/** Reset the town related data for a new game. */
+void InitializeTowns()
+{
+	_town_growth_ticks = 0;
+	_town_growth_schedule.clear();
+}
+
+/** Rebuild the growth schedule from the grow counters, e.g. after loading a game. */
+void RebuildTownGrowthSchedule()
+{
+	_town_growth_schedule.clear();
+	for (Town *t : Town::Iterate()) {
+		if (!HasBit(t->flags, TOWN_IS_GROWING)) continue;
+
+		t->grow_tick = _town_growth_ticks + t->grow_counter + 1;
+		_town_growth_schedule.insert({t->grow_tick, t->index});
+	}
+}
+
+/**
+ * Get the counter of the number of ticks until the town grows.
+ * @return The grow counter.
+ */
+uint16 Town::GetGrowCounter() const
+{
+	if (!HasBit(this->flags, TOWN_IS_GROWING)) return this->grow_counter;
+	return (uint16)(this->grow_tick - _town_growth_ticks - 1);
+}
+
+/**
+ * Set the counter of the number of ticks until the town grows.
+ * @param counter The new grow counter.
+ */
+void Town::SetGrowCounter(uint16 counter)
+{
+	this->grow_counter = counter;
+	if (!HasBit(this->flags, TOWN_IS_GROWING)) return;
+
+	_town_growth_schedule.erase({this->grow_tick, this->index});
+	this->grow_tick = _town_growth_ticks + counter + 1;
+	_town_growth_schedule.insert({this->grow_tick, this->index});
+}
+
+/**
+ * Set whether the town is growing, and (un)schedule it accordingly.
+ * @param growing Whether the town is growing.
+ */
+void Town::SetGrowing(bool growing)
+{
+	if (growing == HasBit(this->flags, TOWN_IS_GROWING)) return;
+
+	if (growing) {
+		SetBit(this->flags, TOWN_IS_GROWING);
+		this->grow_tick = _town_growth_ticks + this->grow_counter + 1;
+		_town_growth_schedule.insert({this->grow_tick, this->index});
+	} else {
+		this->grow_counter = this->GetGrowCounter();
+		_town_growth_schedule.erase({this->grow_tick, this->index});
+		ClrBit(this->flags, TOWN_IS_GROWING);
+	}
 }
 
 
@@ -102,6 +193,8 @@ Town::~Town()
 {
 	if (CleaningPool()) return;
 
+	this->SetGrowing(false);
+
 	/* Delete town authority window
 	 * and remove from list of sorted towns */
 	CloseWindowById(WC_TOWN_VIEW, this->index);
@@ -599,10 +692,10 @@ static void TileLoop_Town(TileIndex tile)
 					uint32 genmask = (genmax >= 32) ? 0xFFFFFFFF : ((1 << genmax) - 1);
 					/* Mask random value by potential pax and count number of actual pax */
 					uint amt = CountBits(r & genmask);
-					/* Adjust and apply */
+					/* Adjust and apply; only look for stations if there is anything to move. */
 					if (EconomyIsInRecession()) amt = (amt + 1) >> 1;
 					t->supplied[CT_PASSENGERS].new_max += amt;
-					t->supplied[CT_PASSENGERS].new_act += MoveGoodsToStation(CT_PASSENGERS, amt, ST_TOWN, t->index, stations.GetStations());
+					if (amt != 0) t->supplied[CT_PASSENGERS].new_act += MoveGoodsToStation(CT_PASSENGERS, amt, ST_TOWN, t->index, stations.GetStations());
 
 					/* Do the same for mail, with a fresh random */
 					r = Random();
@@ -611,7 +704,7 @@ static void TileLoop_Town(TileIndex tile)
 					amt = CountBits(r & genmask);
 					if (EconomyIsInRecession()) amt = (amt + 1) >> 1;
 					t->supplied[CT_MAIL].new_max += amt;
-					t->supplied[CT_MAIL].new_act += MoveGoodsToStation(CT_MAIL, amt, ST_TOWN, t->index, stations.GetStations());
+					if (amt != 0) t->supplied[CT_MAIL].new_act += MoveGoodsToStation(CT_MAIL, amt, ST_TOWN, t->index, stations.GetStations());
 				}
 				break;
 
@@ -810,28 +903,36 @@ static void ChangeTileOwner_Town(TileIndex tile, Owner old_owner, Owner new_owne
 
 static bool GrowTown(Town *t);
 
+/**
+ * Handle a town whose grow counter has run out.
+ * @param t The town.
+ */
 static void TownTickHandler(Town *t)
 {
-	if (HasBit(t->flags, TOWN_IS_GROWING)) {
-		int i = (int)t->grow_counter - 1;
-		if (i < 0) {
-			if (GrowTown(t)) {
-				i = t->growth_rate;
-			} else {
-				/* If growth failed wait a bit before retrying */
-				i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
-			}
-		}
-		t->grow_counter = i;
+	assert(HasBit(t->flags, TOWN_IS_GROWING));
+
+	/* The counter stays at zero while the town tries to grow. */
+	t->SetGrowCounter(0);
+
+	uint16 i;
+	if (GrowTown(t)) {
+		i = t->growth_rate;
+	} else {
+		/* If growth failed wait a bit before retrying */
+		i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
 	}
+	t->SetGrowCounter(i);
 }
 
 void OnTick_Town()
 {
 	if (_game_mode == GM_EDITOR) return;
 
-	for (Town *t : Town::Iterate()) {
-		TownTickHandler(t);
+	/* Implicitly decrement the grow counters of all growing towns. */
+	_town_growth_ticks++;
+
+	while (!_town_growth_schedule.empty() && _town_growth_schedule.begin()->first <= _town_growth_ticks) {
+		TownTickHandler(Town::Get(_town_growth_schedule.begin()->second));
 	}
 }
 
@@ -1591,6 +1692,10 @@ static bool CanFollowRoad(TileIndex tile, DiagDirection dir)
 
 /**
  * Returns "growth" if a house was built, or no if the build failed.
+ * The town grows by a random walk along its roads, which is bounded by the
+ * number of houses. The walk is what makes towns grow outwards along their
+ * roads and is tied to the random sequence, so it is not replaced by sampling
+ * from a precomputed set of buildable tiles.
  * @param t town to inquiry
  * @param tile to inquiry
  * @return true if town expansion was possible
@@ -1820,11 +1925,12 @@ static void DoCreateTown(Town *t, TileIndex tile, uint32 townnameparts, TownSize
 	t->cache.population = 0;
 	/* Spread growth across ticks so even if there are many
 	 * similar towns they're unlikely to grow all in one tick */
-	t->grow_counter = t->index % TOWN_GROWTH_TICKS;
+	t->SetGrowCounter(t->index % TOWN_GROWTH_TICKS);
 	t->growth_rate = TownTicksToGameTicks(250);
 	t->show_zone = false;
 
 	_town_kdtree.Insert(t->index);
+	InvalidateClosestTownCache();
 
 	/* Set the default cargo requirement for town growth */
 	switch (_settings_game.game_creation.landscape) {
@@ -2867,12 +2973,12 @@ CommandCost CmdTownGrowthRate(TileIndex tile, DoCommandFlag flags, uint32 p1, ui
 			ClrBit(t->flags, TOWN_CUSTOM_GROWTH);
 		} else {
 			uint old_rate = t->growth_rate;
-			if (t->grow_counter >= old_rate) {
+			if (t->GetGrowCounter() >= old_rate) {
 				/* This also catches old_rate == 0 */
-				t->grow_counter = p2;
+				t->SetGrowCounter(p2);
 			} else {
 				/* Scale grow_counter, so half finished houses stay half finished */
-				t->grow_counter = t->grow_counter * p2 / old_rate;
+				t->SetGrowCounter(t->GetGrowCounter() * p2 / old_rate);
 			}
 			t->growth_rate = p2;
 			SetBit(t->flags, TOWN_CUSTOM_GROWTH);
@@ -3041,6 +3147,7 @@ CommandCost CmdDeleteTown(TileIndex tile, DoCommandFlag flags, uint32 p1, uint32
 	/* The town destructor will delete the other things related to the town. */
 	if (flags & DC_EXEC) {
 		_town_kdtree.Remove(t->index);
+		InvalidateClosestTownCache();
 		if (t->cache.sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeTown(t->index));
 		delete t;
 	}
@@ -3210,7 +3317,8 @@ static CommandCost TownActionFundBuildings(Town *t, DoCommandFlag flags)
 		 * tick-perfect and gives player some time window where they can
 		 * spam funding with the exact same efficiency.
 		 */
-		t->grow_counter = std::min<uint16>(t->grow_counter, 2 * TOWN_GROWTH_TICKS - (t->growth_rate - t->grow_counter) % TOWN_GROWTH_TICKS);
+		uint16 grow_counter = t->GetGrowCounter();
+		t->SetGrowCounter(std::min<uint16>(grow_counter, 2 * TOWN_GROWTH_TICKS - (t->growth_rate - grow_counter) % TOWN_GROWTH_TICKS));
 
 		SetWindowDirty(WC_TOWN_VIEW, t->index);
 	}
@@ -3424,10 +3532,10 @@ static void UpdateTownGrowCounter(Town *t, uint16 prev_growth_rate)
 {
 	if (t->growth_rate == TOWN_GROWTH_RATE_NONE) return;
 	if (prev_growth_rate == TOWN_GROWTH_RATE_NONE) {
-		t->grow_counter = std::min<uint16>(t->growth_rate, t->grow_counter);
+		t->SetGrowCounter(std::min<uint16>(t->growth_rate, t->GetGrowCounter()));
 		return;
 	}
-	t->grow_counter = RoundDivSU((uint32)t->grow_counter * (t->growth_rate + 1), prev_growth_rate + 1);
+	t->SetGrowCounter(RoundDivSU((uint32)t->GetGrowCounter() * (t->growth_rate + 1), prev_growth_rate + 1));
 }
 
 /**
@@ -3496,7 +3604,7 @@ static void UpdateTownGrowth(Town *t)
 {
 	UpdateTownGrowthRate(t);
 
-	ClrBit(t->flags, TOWN_IS_GROWING);
+	t->SetGrowing(false);
 	SetWindowDirty(WC_TOWN_VIEW, t->index);
 
 	if (_settings_game.economy.town_growth_rate == 0 && t->fund_buildings_months == 0) return;
@@ -3519,14 +3627,14 @@ static void UpdateTownGrowth(Town *t)
 	}
 
 	if (HasBit(t->flags, TOWN_CUSTOM_GROWTH)) {
-		if (t->growth_rate != TOWN_GROWTH_RATE_NONE) SetBit(t->flags, TOWN_IS_GROWING);
+		if (t->growth_rate != TOWN_GROWTH_RATE_NONE) t->SetGrowing(true);
 		SetWindowDirty(WC_TOWN_VIEW, t->index);
 		return;
 	}
 
 	if (t->fund_buildings_months == 0 && CountActiveStations(t) == 0 && !Chance16(1, 12)) return;
 
-	SetBit(t->flags, TOWN_IS_GROWING);
+	t->SetGrowing(true);
 	SetWindowDirty(WC_TOWN_VIEW, t->index);
 }
 
@@ -3577,8 +3685,12 @@ Town *CalcClosestTownFromTile(TileIndex tile, uint threshold)
 {
 	if (Town::GetNumItems() == 0) return nullptr;
 
-	TownID tid = _town_kdtree.FindNearest(TileX(tile), TileY(tile));
-	Town *town = Town::Get(tid);
+	ClosestTownCacheItem &item = _closest_town_cache[tile % CLOSEST_TOWN_CACHE_SIZE];
+	if (item.tile != tile) {
+		item.tile = tile;
+		item.town = _town_kdtree.FindNearest(TileX(tile), TileY(tile));
+	}
+	Town *town = Town::Get(item.town);
 	if (DistanceManhattan(tile, town->xy) < threshold) return town;
 	return nullptr;
 }
@@ -112,6 +112,14 @@ struct Train FINAL : public GroundVehicle<Train, VEH_TRAIN> {
 	void PlayLeaveStationSound() const;
 	bool IsPrimaryVehicle() const { return this->IsFrontEngine(); }
 	void GetImage(Direction direction, EngineImageType image_type, VehicleSpriteSeq *result) const;
+
+	inline bool GetSpriteState(VehicleSpriteState *state) const
+	{
+		if (!this->GroundVehicleBase::GetSpriteState(state)) return false;
+		state->reversed = HasBit(this->flags, VRF_REVERSE_DIRECTION);
+		return true;
+	}
+
 	int GetDisplaySpeed() const { return this->gcache.last_speed; }
 	int GetDisplayMaxSpeed() const { return this->vcache.cached_max_speed; }
 	Money GetRunningCost() const;
@@ -1514,35 +1514,32 @@ static void MarkTrainAsStuck(Train *v)
 	}
 }
 
+/**
+ * Get the reversed up/down flags: if going up (#GVF_GOINGUP_BIT set), the #GVF_GOINGDOWN_BIT is set, and vice versa.
+ * @param flags The flags to reverse.
+ * @return The reversed #GVF_GOINGUP_BIT and #GVF_GOINGDOWN_BIT flags.
+ */
+static uint16 ReverseInclination(uint16 flags)
+{
+	if (HasBit(flags, GVF_GOINGUP_BIT)) return 1 << GVF_GOINGDOWN_BIT;
+	if (HasBit(flags, GVF_GOINGDOWN_BIT)) return 1 << GVF_GOINGUP_BIT;
+	return 0;
+}
+
 /**
  * Swap the two up/down flags in two ways:
- * - Swap values of \a swap_flag1 and \a swap_flag2, and
+ * - Swap values of the flags of \a a and \a b, and
  * - If going up previously (#GVF_GOINGUP_BIT set), the #GVF_GOINGDOWN_BIT is set, and vice versa.
- * @param[in,out] swap_flag1 First train flag.
- * @param[in,out] swap_flag2 Second train flag.
+ * @param a First train part.
+ * @param b Second train part.
  */
-static void SwapTrainFlags(uint16 *swap_flag1, uint16 *swap_flag2)
+static void SwapTrainFlags(Train *a, Train *b)
 {
-	uint16 flag1 = *swap_flag1;
-	uint16 flag2 = *swap_flag2;
-
-	/* Clear the flags */
-	ClrBit(*swap_flag1, GVF_GOINGUP_BIT);
-	ClrBit(*swap_flag1, GVF_GOINGDOWN_BIT);
-	ClrBit(*swap_flag2, GVF_GOINGUP_BIT);
-	ClrBit(*swap_flag2, GVF_GOINGDOWN_BIT);
+	uint16 flag1 = a->gv_flags;
+	uint16 flag2 = b->gv_flags;
 
-	/* Reverse the rail-flags (if needed) */
-	if (HasBit(flag1, GVF_GOINGUP_BIT)) {
-		SetBit(*swap_flag2, GVF_GOINGDOWN_BIT);
-	} else if (HasBit(flag1, GVF_GOINGDOWN_BIT)) {
-		SetBit(*swap_flag2, GVF_GOINGUP_BIT);
-	}
-	if (HasBit(flag2, GVF_GOINGUP_BIT)) {
-		SetBit(*swap_flag1, GVF_GOINGDOWN_BIT);
-	} else if (HasBit(flag2, GVF_GOINGDOWN_BIT)) {
-		SetBit(*swap_flag1, GVF_GOINGUP_BIT);
-	}
+	a->SetInclination(ReverseInclination(flag2));
+	b->SetInclination(ReverseInclination(flag1));
 }
 
 /**
@@ -1609,7 +1606,7 @@ void ReverseTrainSwapVeh(Train *v, int l, int r)
 		Swap(a->tile,  b->tile);
 		Swap(a->z_pos, b->z_pos);
 
-		SwapTrainFlags(&a->gv_flags, &b->gv_flags);
+		SwapTrainFlags(a, b);
 
 		UpdateStatusAfterSwap(a);
 		UpdateStatusAfterSwap(b);
@@ -1617,7 +1614,7 @@ void ReverseTrainSwapVeh(Train *v, int l, int r)
 		/* Swap GVF_GOINGUP_BIT/GVF_GOINGDOWN_BIT.
 		 * This is a little bit redundant way, a->gv_flags will
 		 * be (re)set twice, but it reduces code duplication */
-		SwapTrainFlags(&a->gv_flags, &a->gv_flags);
+		SwapTrainFlags(a, a);
 		UpdateStatusAfterSwap(a);
 	}
 }
@@ -3000,28 +2997,33 @@ static Vehicle *FindTrainCollideEnum(Vehicle *v, void *data)
 {
 	TrainCollideChecker *tcc = (TrainCollideChecker*)data;
 
-	/* not a train or in depot */
-	if (v->type != VEH_TRAIN || Train::From(v)->track == TRACK_BIT_DEPOT) return nullptr;
-
-	/* do not crash into trains of another company. */
-	if (v->owner != tcc->v->owner) return nullptr;
-
-	/* get first vehicle now to make most usual checks faster */
-	Train *coll = Train::From(v)->First();
-
-	/* can't collide with own wagons */
-	if (coll == tcc->v) return nullptr;
+	/* not a train */
+	if (v->type != VEH_TRAIN) return nullptr;
 
 	int x_diff = v->x_pos - tcc->v->x_pos;
 	int y_diff = v->y_pos - tcc->v->y_pos;
 
 	/* Do fast calculation to check whether trains are not in close vicinity
 	 * and quickly reject trains distant enough for any collision.
+	 * Most vehicles in the scanned hash chains are rejected here, so do it
+	 * before looking at the consist they belong to.
 	 * Differences are shifted by 7, mapping range [-7 .. 8] into [0 .. 15]
 	 * Differences are then ORed and then we check for any higher bits */
 	uint hash = (y_diff + 7) | (x_diff + 7);
 	if (hash & ~15) return nullptr;
 
+	/* in depot */
+	if (Train::From(v)->track == TRACK_BIT_DEPOT) return nullptr;
+
+	/* do not crash into trains of another company. */
+	if (v->owner != tcc->v->owner) return nullptr;
+
+	/* get first vehicle now to make most usual checks faster */
+	Train *coll = Train::From(v)->First();
+
+	/* can't collide with own wagons */
+	if (coll == tcc->v) return nullptr;
+
 	/* Slower check using multiplication */
 	int min_diff = (Train::From(v)->gcache.cached_veh_length + 1) / 2 + (tcc->v->gcache.cached_veh_length + 1) / 2 - 1;
 	if (x_diff * x_diff + y_diff * y_diff > min_diff * min_diff) return nullptr;
@@ -156,6 +156,8 @@ static TreeType GetRandomTreeType(TileIndex tile, uint seed)
  * Create a new tree-tile for the given tile. The second parameter is used for
  * randomness like type and number of trees.
  *
+ * @note The tile is not marked dirty; all callers place trees over the whole
+ *       map and redraw the whole screen afterwards.
  * @param tile The tile to make a tree-tile from
  * @param r The randomness value from a Random() value
  */
@@ -165,7 +167,6 @@ static void PlaceTree(TileIndex tile, uint32 r)
 
 	if (tree != TREE_INVALID) {
 		PlantTreesOnTile(tile, tree, GB(r, 22, 2), std::min<byte>(GB(r, 16, 3), 6));
-		MarkTileDirtyByTile(tile);
 
 		/* Rerandomize ground, if neither snow nor shore */
 		TreeGround ground = GetTreeGround(tile);
@@ -265,7 +266,7 @@ void PlaceTreesRandomly()
 			 *  It is almost real life ;) */
 			ht = GetTileZ(tile);
 			/* The higher we get, the more trees we plant */
-			j = GetTileZ(tile) * 2;
+			j = ht * 2;
 			/* Above snowline more trees! */
 			if (_settings_game.game_creation.landscape == LT_ARCTIC && ht > GetSnowLine()) j *= 3;
 			while (j--) {
@@ -687,6 +688,12 @@ static bool CanPlantExtraTrees(TileIndex tile)
 		_settings_game.construction.extra_tree_placement == ETP_SPREAD_ALL);
 }
 
+/**
+ * Tile loop of tree tiles.
+ * The tree counter advances on every visit, so there are no settled tree tiles
+ * that could be skipped by the tile loop.
+ * @param tile The tile to process.
+ */
 static void TileLoop_Trees(TileIndex tile)
 {
 	if (GetTreeGround(tile) == TREE_GROUND_SHORE) {
@@ -14,12 +14,11 @@
 
 
 /**
- * Gets the other end of the tunnel. Where a vehicle would reappear when it
- * enters at the given tile.
+ * Finds the other end of the tunnel by walking through it.
  * @param tile the tile to search from.
  * @return the tile of the other end of the tunnel.
  */
-TileIndex GetOtherTunnelEnd(TileIndex tile)
+static TileIndex FindOtherTunnelEnd(TileIndex tile)
 {
 	DiagDirection dir = GetTunnelBridgeDirection(tile);
 	TileIndexDiff delta = TileOffsByDiagDir(dir);
@@ -37,6 +36,22 @@ TileIndex GetOtherTunnelEnd(TileIndex tile)
 	return tile;
 }
 
+/**
+ * Gets the other end of the tunnel. Where a vehicle would reappear when it
+ * enters at the given tile.
+ * @param tile the tile to search from.
+ * @return the tile of the other end of the tunnel.
+ */
+TileIndex GetOtherTunnelEnd(TileIndex tile)
+{
+	TileIndex other = GetIndexedTunnelBridgeEnd(tile);
+	if (other != INVALID_TILE) return other;
+
+	other = FindOtherTunnelEnd(tile);
+	AddTunnelBridgeEnds(tile, other);
+	return other;
+}
+
 
 /**
  * Is there a tunnel in the way in the given direction?
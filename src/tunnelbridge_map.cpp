@@ -0,0 +1,73 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file tunnelbridge_map.cpp Index of the ends of tunnels and bridges. */
+
+#include "stdafx.h"
+#include "tunnelbridge_map.h"
+
+#include <unordered_map>
+
+#include "safeguards.h"
+
+/** The other end of every indexed tunnel entrance and bridge ramp. */
+static std::unordered_map<TileIndex, TileIndex> _tunnel_bridge_ends;
+
+/**
+ * Look up the other end of a tunnel or bridge in the index.
+ * @param tile The tunnel entrance or bridge ramp.
+ * @pre IsTileType(tile, MP_TUNNELBRIDGE)
+ * @return The other end, or #INVALID_TILE when the tile is not indexed.
+ */
+TileIndex GetIndexedTunnelBridgeEnd(TileIndex tile)
+{
+	auto it = _tunnel_bridge_ends.find(tile);
+	if (it == _tunnel_bridge_ends.end()) return INVALID_TILE;
+
+	/* Guard against entries that went stale while the map was converted on load. */
+	TileIndex other = it->second;
+	if (!IsTileType(other, MP_TUNNELBRIDGE) || GetTunnelBridgeDirection(other) != ReverseDiagDir(GetTunnelBridgeDirection(tile))) return INVALID_TILE;
+	return other;
+}
+
+/**
+ * Add both ends of a tunnel or bridge to the index.
+ * @param start One end of the tunnel or bridge.
+ * @param end The other end of the tunnel or bridge.
+ */
+void AddTunnelBridgeEnds(TileIndex start, TileIndex end)
+{
+	_tunnel_bridge_ends[start] = end;
+	_tunnel_bridge_ends[end] = start;
+}
+
+/**
+ * Remove both ends of a tunnel or bridge from the index.
+ * @param start One end of the tunnel or bridge.
+ * @param end The other end of the tunnel or bridge.
+ */
+void RemoveTunnelBridgeEnds(TileIndex start, TileIndex end)
+{
+	_tunnel_bridge_ends.erase(start);
+	_tunnel_bridge_ends.erase(end);
+}
+
+/** Remove all tunnels and bridges from the index, e.g. when a new map is allocated. */
+void ClearTunnelBridgeIndex()
+{
+	_tunnel_bridge_ends.clear();
+}
+
+/** Rebuild the index from the tunnels and bridges on the map. */
+void RebuildTunnelBridgeIndex()
+{
+	_tunnel_bridge_ends.clear();
+	for (TileIndex tile = 0; tile < MapSize(); tile++) {
+		/* Looking up an end that is not indexed yet adds both ends. */
+		if (IsTileType(tile, MP_TUNNELBRIDGE)) GetOtherTunnelBridgeEnd(tile);
+	}
+}
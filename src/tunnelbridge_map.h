@@ -69,6 +69,12 @@ static inline void SetTunnelBridgeSnowOrDesert(TileIndex t, bool snow_or_desert)
 	SB(_me[t].m7, 5, 1, snow_or_desert);
 }
 
+TileIndex GetIndexedTunnelBridgeEnd(TileIndex tile);
+void AddTunnelBridgeEnds(TileIndex start, TileIndex end);
+void RemoveTunnelBridgeEnds(TileIndex start, TileIndex end);
+void ClearTunnelBridgeIndex();
+void RebuildTunnelBridgeIndex();
+
 /**
  * Determines type of the wormhole and returns its other end
  * @param t one end
@@ -57,8 +57,8 @@
 #include "safeguards.h"
 
 /* Number of bits in the hash to use from each vehicle coord */
-static const uint GEN_HASHX_BITS = 6;
-static const uint GEN_HASHY_BITS = 6;
+static const uint GEN_HASHX_BITS = 7;
+static const uint GEN_HASHY_BITS = 7;
 
 /* Size of each hash bucket */
 static const uint GEN_HASHX_BUCKET_BITS = 7;
@@ -347,6 +347,7 @@ Vehicle::Vehicle(VehicleType type)
 	this->type               = type;
 	this->coord.left         = INVALID_COORD;
 	this->sprite_cache.old_coord.left = INVALID_COORD;
+	this->sprite_cache.last_direction = INVALID_DIR;
 	this->group_id           = DEFAULT_GROUP;
 	this->fill_percent_te_id = INVALID_TE_ID;
 	this->first              = this;
@@ -365,25 +366,38 @@ byte VehicleRandomBits()
 	return GB(Random(), 0, 8);
 }
 
-/* Size of the hash, 6 = 64 x 64, 7 = 128 x 128. Larger sizes will (in theory) reduce hash
- * lookup times at the expense of memory usage. */
-const int HASH_BITS = 7;
-const int HASH_SIZE = 1 << HASH_BITS;
-const int HASH_MASK = HASH_SIZE - 1;
-const int TOTAL_HASH_SIZE = 1 << (HASH_BITS * 2);
-const int TOTAL_HASH_MASK = TOTAL_HASH_SIZE - 1;
+/* Maximum size of the hash along each axis, 7 = 128, 10 = 1024. The hash is sized to the map,
+ * so on maps up to this size every tile has its own chain; larger maps fold several tiles
+ * into one chain. Larger sizes will reduce hash lookup times at the expense of memory usage. */
+const uint MAX_HASH_BITS = 10;
 
 /* Resolution of the hash, 0 = 1*1 tile, 1 = 2*2 tiles, 2 = 4*4 tiles, etc.
  * Profiling results show that 0 is fastest. */
 const int HASH_RES = 0;
 
-static Vehicle *_vehicle_tile_hash[TOTAL_HASH_SIZE];
+static uint _vehicle_tile_hash_bits_x; ///< Number of bits of the tile hash along the X axis.
+static uint _vehicle_tile_hash_bits_y; ///< Number of bits of the tile hash along the Y axis.
+static std::vector<Vehicle *> _vehicle_tile_hash; ///< Chains of vehicles per (folded) tile.
+
+/**
+ * Get the position in the tile hash for a tile coordinate.
+ * @param x The X coordinate of the tile; may be outside of the map.
+ * @param y The Y coordinate of the tile; may be outside of the map.
+ * @return The X and Y part of the hash index, add them for the index.
+ */
+static inline std::pair<int, int> GetVehicleTileHashXY(int x, int y)
+{
+	return { GB(x, HASH_RES, _vehicle_tile_hash_bits_x), GB(y, HASH_RES, _vehicle_tile_hash_bits_y) << _vehicle_tile_hash_bits_x };
+}
 
 static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
 {
-	for (int y = yl; ; y = (y + (1 << HASH_BITS)) & (HASH_MASK << HASH_BITS)) {
-		for (int x = xl; ; x = (x + 1) & HASH_MASK) {
-			Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	const int x_mask = (1 << _vehicle_tile_hash_bits_x) - 1;
+	const int y_mask = ((1 << _vehicle_tile_hash_bits_y) - 1) << _vehicle_tile_hash_bits_x;
+
+	for (int y = yl; ; y = (y + (1 << _vehicle_tile_hash_bits_x)) & y_mask) {
+		for (int x = xl; ; x = (x + 1) & x_mask) {
+			Vehicle *v = _vehicle_tile_hash[x + y];
 			for (; v != nullptr; v = v->hash_tile_next) {
 				Vehicle *a = proc(v, data);
 				if (find_first && a != nullptr) return a;
@@ -413,10 +427,8 @@ static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *p
 	const int COLL_DIST = 6;
 
 	/* Hash area to scan is from xl,yl to xu,yu */
-	int xl = GB((x - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int xu = GB((x + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int yl = GB((y - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
-	int yu = GB((y + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
+	auto [xl, yl] = GetVehicleTileHashXY((x - COLL_DIST) / (int)TILE_SIZE, (y - COLL_DIST) / (int)TILE_SIZE);
+	auto [xu, yu] = GetVehicleTileHashXY((x + COLL_DIST) / (int)TILE_SIZE, (y + COLL_DIST) / (int)TILE_SIZE);
 
 	return VehicleFromTileHash(xl, yl, xu, yu, data, proc, find_first);
 }
@@ -468,10 +480,9 @@ bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
  */
 static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
 {
-	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
-	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
+	auto [x, y] = GetVehicleTileHashXY(TileX(tile), TileY(tile));
 
-	Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	Vehicle *v = _vehicle_tile_hash[x + y];
 	for (; v != nullptr; v = v->hash_tile_next) {
 		if (v->tile != tile) continue;
 
@@ -617,9 +628,8 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 	if (remove) {
 		new_hash = nullptr;
 	} else {
-		int x = GB(TileX(v->tile), HASH_RES, HASH_BITS);
-		int y = GB(TileY(v->tile), HASH_RES, HASH_BITS) << HASH_BITS;
-		new_hash = &_vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+		auto [x, y] = GetVehicleTileHashXY(TileX(v->tile), TileY(v->tile));
+		new_hash = &_vehicle_tile_hash[x + y];
 	}
 
 	if (old_hash == new_hash) return;
@@ -668,11 +678,18 @@ static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int o
 	}
 }
 
+/**
+ * Empty the vehicle hashes, and size the tile hash to the current map.
+ * Vehicles are added to the hashes again when their position is updated.
+ */
 void ResetVehicleHash()
 {
 	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
 	memset(_vehicle_viewport_hash, 0, sizeof(_vehicle_viewport_hash));
-	memset(_vehicle_tile_hash, 0, sizeof(_vehicle_tile_hash));
+
+	_vehicle_tile_hash_bits_x = std::min(MapLogX() - HASH_RES, MAX_HASH_BITS);
+	_vehicle_tile_hash_bits_y = std::min(MapLogY() - HASH_RES, MAX_HASH_BITS);
+	_vehicle_tile_hash.assign((size_t)1 << (_vehicle_tile_hash_bits_x + _vehicle_tile_hash_bits_y), nullptr);
 }
 
 void ResetVehicleColourMap()
@@ -692,6 +709,7 @@ void InitializeVehicles()
 	_vehicles_to_autoreplace.clear();
 	_vehicles_to_autoreplace.shrink_to_fit();
 	ResetVehicleHash();
+	ClearParticles();
 }
 
 uint CountVehiclesInChain(const Vehicle *v)
@@ -803,7 +821,7 @@ void Vehicle::PreDestructor()
 
 	if (Station::IsValidID(this->last_station_visited)) {
 		Station *st = Station::Get(this->last_station_visited);
-		st->loading_vehicles.remove(this);
+		RemoveLoadingVehicle(st, this);
 
 		HideFillingPercent(&this->fill_percent_te_id);
 		this->CancelReservation(INVALID_STATION, st);
@@ -945,13 +963,19 @@ void CallVehicleTicks()
 
 	{
 		PerformanceMeasurer framerate(PFE_GL_ECONOMY);
-		for (Station *st : Station::Iterate()) LoadUnloadStation(st);
+		LoadUnloadStations();
 	}
 	PerformanceAccumulator::Reset(PFE_GL_TRAINS);
 	PerformanceAccumulator::Reset(PFE_GL_ROADVEHS);
 	PerformanceAccumulator::Reset(PFE_GL_SHIPS);
 	PerformanceAccumulator::Reset(PFE_GL_AIRCRAFT);
 
+	/* Resolving the sound effects may run NewGRF callbacks for every vehicle,
+	 * which is wasted effort when nobody is able to hear the result. */
+	const bool play_sounds = !_network_dedicated && _settings_client.sound.vehicle && _settings_client.music.effect_vol != 0;
+
+	TickParticles();
+
 	for (Vehicle *v : Vehicle::Iterate()) {
 		[[maybe_unused]] size_t vehicle_index = v->index;
 
@@ -1008,6 +1032,8 @@ void CallVehicleTicks()
 				}
 
 				v->motion_counter += front->cur_speed;
+				if (!play_sounds) break;
+
 				/* Play a running sound if the motion counter passes 256 (Do we not skip sounds?) */
 				if (GB(v->motion_counter, 0, 8) < front->cur_speed) PlayVehicleSound(v, VSE_RUNNING);
 
@@ -1034,12 +1060,16 @@ void CallVehicleTicks()
 		 * they are already leaving the depot again before being replaced. */
 		if (it.second) v->vehstatus &= ~VS_STOPPED;
 
+		/* Without any replacement rules and with autorenew off the command
+		 * can only conclude there is nothing to do, so do not run it. */
+		const Company *c = Company::Get(_current_company);
+		if (c->engine_renew_list == nullptr && !c->settings.engine_renew) continue;
+
 		/* Store the position of the effect as the vehicle pointer will become invalid later */
 		int x = v->x_pos;
 		int y = v->y_pos;
 		int z = v->z_pos;
 
-		const Company *c = Company::Get(_current_company);
 		SubtractMoneyFromCompany(CommandCost(EXPENSES_NEW_VEHICLES, (Money)c->settings.engine_renew_money));
 		CommandCost res = DoCommand(0, v->index, 0, DC_EXEC, CMD_AUTOREPLACE_VEHICLE);
 		SubtractMoneyFromCompany(CommandCost(EXPENSES_NEW_VEHICLES, -(Money)c->settings.engine_renew_money));
@@ -1117,6 +1147,10 @@ void ViewportAddVehicles(DrawPixelInfo *dpi)
 	const int xb = MAX_VEHICLE_PIXEL_X * ZOOM_LVL_BASE;
 	const int yb = MAX_VEHICLE_PIXEL_Y * ZOOM_LVL_BASE;
 
+	/* Effect vehicles, such as smoke, are details that are hardly visible when zoomed out far. */
+	const bool skip_effects = dpi->zoom > ZOOM_LVL_DETAIL;
+	if (!skip_effects) ViewportAddParticles(dpi);
+
 	/* The hash area to scan */
 	int xl, xu, yl, yu;
 
@@ -1140,11 +1174,12 @@ void ViewportAddVehicles(DrawPixelInfo *dpi)
 
 	for (int y = yl;; y = (y + GEN_HASHY_INC) & GEN_HASHY_MASK) {
 		for (int x = xl;; x = (x + GEN_HASHX_INC) & GEN_HASHX_MASK) {
-			const Vehicle *v = _vehicle_viewport_hash[x + y]; // already masked & 0xFFF
+			const Vehicle *v = _vehicle_viewport_hash[x + y]; // already masked & 0x3FFF
 
 			while (v != nullptr) {
 
 				if (!(v->vehstatus & VS_HIDDEN) &&
+					!(skip_effects && v->type == VEH_EFFECT) &&
 					l <= v->coord.right + xb &&
 					t <= v->coord.bottom + yb &&
 					r >= v->coord.left - xb &&
@@ -2274,7 +2309,7 @@ void Vehicle::LeaveStation()
 	this->current_order.MakeLeaveStation();
 	Station *st = Station::Get(this->last_station_visited);
 	this->CancelReservation(INVALID_STATION, st);
-	st->loading_vehicles.remove(this);
+	RemoveLoadingVehicle(st, this);
 
 	HideFillingPercent(&this->fill_percent_te_id);
 	trip_occupancy = CalcPercentVehicleFilled(this, nullptr);
@@ -2336,23 +2371,6 @@ void Vehicle::HandleLoading(bool mode)
 	this->IncrementImplicitOrderIndex();
 }
 
-/**
- * Get a map of cargoes and free capacities in the consist.
- * @param capacities Map to be filled with cargoes and capacities.
- */
-void Vehicle::GetConsistFreeCapacities(SmallMap<CargoID, uint> &capacities) const
-{
-	for (const Vehicle *v = this; v != nullptr; v = v->Next()) {
-		if (v->cargo_cap == 0) continue;
-		std::pair<CargoID, uint> *pair = capacities.Find(v->cargo_type);
-		if (pair == capacities.End()) {
-			capacities.push_back({v->cargo_type, v->cargo_cap - v->cargo.StoredCount()});
-		} else {
-			pair->second += v->cargo_cap - v->cargo.StoredCount();
-		}
-	}
-}
-
 uint Vehicle::GetConsistTotalCapacity() const
 {
 	uint result = 0;
@@ -2807,6 +2825,9 @@ void Vehicle::RemoveFromShared()
 
 void VehiclesYearlyLoop()
 {
+	/* The profits of the groups are recalculated while going over the vehicles. */
+	GroupStatistics::ClearAllProfits();
+
 	for (Vehicle *v : Vehicle::Iterate()) {
 		if (v->IsPrimaryVehicle()) {
 			/* show warning if vehicle is not generating enough income last 2 years (corresponds to a red icon in the vehicle list) */
@@ -2822,10 +2843,12 @@ void VehiclesYearlyLoop()
 
 			v->profit_last_year = v->profit_this_year;
 			v->profit_this_year = 0;
-			SetWindowDirty(WC_VEHICLE_DETAILS, v->index);
+
+			if (v->age > VEHICLE_PROFIT_MIN_AGE) GroupStatistics::VehicleReachedProfitAge(v);
 		}
 	}
-	GroupStatistics::UpdateProfits();
+	/* Marking each vehicle's details window dirty would search all windows once per vehicle. */
+	SetWindowClassesDirty(WC_VEHICLE_DETAILS);
 	SetWindowClassesDirty(WC_TRAINS_LIST);
 	SetWindowClassesDirty(WC_SHIPS_LIST);
 	SetWindowClassesDirty(WC_ROADVEH_LIST);
@@ -182,12 +182,36 @@ struct VehicleSpriteSeq {
 	void Draw(int x, int y, PaletteID default_pal, bool force_pal) const;
 };
 
+/**
+ * Everything besides the direction the sprites of a vehicle with static NewGRF graphics
+ * (see Engine::static_sprites) depend on. As long as this does not change, there is no
+ * need to resolve the sprites of the vehicle again.
+ */
+struct VehicleSpriteState {
+	uint cargo_count;      ///< Amount of cargo in the vehicle.
+	uint16 cargo_cap;      ///< Capacity of the vehicle.
+	CargoID cargo_type;    ///< Type of cargo the vehicle carries.
+	byte spritenum;        ///< Sprite number of the vehicle.
+	EngineID first_engine; ///< Engine of the front vehicle, for wagon overrides.
+	bool in_motion;        ///< Whether the consist is not loading.
+	bool reversed;         ///< Whether the vehicle is drawn reversed.
+
+	inline bool operator==(const VehicleSpriteState &other) const
+	{
+		return this->cargo_count == other.cargo_count && this->cargo_cap == other.cargo_cap &&
+				this->cargo_type == other.cargo_type && this->spritenum == other.spritenum &&
+				this->first_engine == other.first_engine && this->in_motion == other.in_motion &&
+				this->reversed == other.reversed;
+	}
+};
+
 /**
  * Cache for vehicle sprites and values relating to whether they should be updated before drawing,
  * or calculating the viewport.
  */
 struct MutableSpriteCache {
 	Direction last_direction;     ///< Last direction we obtained sprites for
+	VehicleSpriteState last_state; ///< State of the vehicle when we last obtained sprites, if it has static sprites
 	bool revalidate_before_draw;  ///< We need to do a GetImage() and check bounds before drawing this sprite
 	Rect old_coord;               ///< Co-ordinates from the last valid bounding box
 	bool is_viewport_candidate;   ///< This vehicle can potentially be drawn on a viewport
@@ -248,11 +272,40 @@ public:
 	 */
 	TileIndex dest_tile;
 
-	Money profit_this_year;             ///< Profit this year << 8, low 8 bits are fract
-	Money profit_last_year;             ///< Profit last year << 8, low 8 bits are fract
-	Money value;                        ///< Value of the vehicle
+	/* Fields used every tick by the vehicle controllers are kept together to limit the cache lines touched. */
+	int32 x_pos;                        ///< x coordinate.
+	int32 y_pos;                        ///< y coordinate.
+	int32 z_pos;                        ///< z coordinate.
+	Direction direction;                ///< facing
 
-	CargoPayment *cargo_payment;        ///< The cargo payment we're currently in
+	Owner owner;                        ///< Which company owns the vehicle?
+	/**
+	 * currently displayed sprite index
+	 * 0xfd == custom sprite, 0xfe == custom second head sprite
+	 * 0xff == reserved for another custom sprite
+	 */
+	byte spritenum;
+	byte x_extent;                      ///< x-extent of vehicle bounding box
+	byte y_extent;                      ///< y-extent of vehicle bounding box
+	byte z_extent;                      ///< z-extent of vehicle bounding box
+	int8 x_bb_offs;                     ///< x offset of vehicle bounding box
+	int8 y_bb_offs;                     ///< y offset of vehicle bounding box
+	int8 x_offs;                        ///< x offset for vehicle sprite
+	int8 y_offs;                        ///< y offset for vehicle sprite
+	EngineID engine_type;               ///< The type of engine used for this vehicle.
+
+	uint16 cur_speed;                   ///< current speed
+	byte subspeed;                      ///< fractional speed
+	byte acceleration;                  ///< used by train & aircraft
+	uint32 motion_counter;              ///< counter to occasionally play a vehicle sound.
+	byte progress;                      ///< The percentage (if divided by 256) this vehicle already crossed the tile unit.
+
+	byte day_counter;                   ///< Increased by one for each day
+	byte tick_counter;                  ///< Increased by one for each tick
+	byte running_ticks;                 ///< Number of ticks this vehicle was not stopped this day
+
+	byte vehstatus;                     ///< Status
+	Order current_order;                ///< The current order (+ status, like: loading)
 
 	mutable Rect coord;                 ///< NOSAVE: Graphical bounding box of the vehicle, i.e. what to redraw on moves.
 
@@ -265,6 +318,12 @@ public:
 
 	SpriteID colourmap;                 ///< NOSAVE: cached colour mapping
 
+	Money profit_this_year;             ///< Profit this year << 8, low 8 bits are fract
+	Money profit_last_year;             ///< Profit last year << 8, low 8 bits are fract
+	Money value;                        ///< Value of the vehicle
+
+	CargoPayment *cargo_payment;        ///< The cargo payment we're currently in
+
 	/* Related to age and service time */
 	Year build_year;                    ///< Year the vehicle has been built.
 	Date age;                           ///< Age in days
@@ -277,36 +336,9 @@ public:
 	byte breakdowns_since_last_service; ///< Counter for the amount of breakdowns.
 	byte breakdown_chance;              ///< Current chance of breakdowns.
 
-	int32 x_pos;                        ///< x coordinate.
-	int32 y_pos;                        ///< y coordinate.
-	int32 z_pos;                        ///< z coordinate.
-	Direction direction;                ///< facing
-
-	Owner owner;                        ///< Which company owns the vehicle?
-	/**
-	 * currently displayed sprite index
-	 * 0xfd == custom sprite, 0xfe == custom second head sprite
-	 * 0xff == reserved for another custom sprite
-	 */
-	byte spritenum;
-	byte x_extent;                      ///< x-extent of vehicle bounding box
-	byte y_extent;                      ///< y-extent of vehicle bounding box
-	byte z_extent;                      ///< z-extent of vehicle bounding box
-	int8 x_bb_offs;                     ///< x offset of vehicle bounding box
-	int8 y_bb_offs;                     ///< y offset of vehicle bounding box
-	int8 x_offs;                        ///< x offset for vehicle sprite
-	int8 y_offs;                        ///< y offset for vehicle sprite
-	EngineID engine_type;               ///< The type of engine used for this vehicle.
-
 	TextEffectID fill_percent_te_id;    ///< a text-effect id to a loading indicator object
 	UnitID unitnumber;                  ///< unit number, for display purposes only
 
-	uint16 cur_speed;                   ///< current speed
-	byte subspeed;                      ///< fractional speed
-	byte acceleration;                  ///< used by train & aircraft
-	uint32 motion_counter;              ///< counter to occasionally play a vehicle sound.
-	byte progress;                      ///< The percentage (if divided by 256) this vehicle already crossed the tile unit.
-
 	byte random_bits;                   ///< Bits used for determining which randomized variational spritegroups to use when drawing.
 	byte waiting_triggers;              ///< Triggers to be yet matched before rerandomizing the random bits.
 
@@ -321,13 +353,6 @@ public:
 	uint16 cargo_age_counter;           ///< Ticks till cargo is aged next.
 	int8 trip_occupancy;                ///< NOSAVE: Occupancy of vehicle of the current trip (updated after leaving a station).
 
-	byte day_counter;                   ///< Increased by one for each day
-	byte tick_counter;                  ///< Increased by one for each tick
-	byte running_ticks;                 ///< Number of ticks this vehicle was not stopped this day
-
-	byte vehstatus;                     ///< Status
-	Order current_order;                ///< The current order (+ status, like: loading)
-
 	union {
 		OrderList *list;            ///< Pointer to the order list for this vehicle
 		Order     *old;             ///< Only used during conversion of old save games
@@ -362,8 +387,6 @@ public:
 
 	void HandleLoading(bool mode = false);
 
-	void GetConsistFreeCapacities(SmallMap<CargoID, uint> &capacities) const;
-
 	uint GetConsistTotalCapacity() const;
 
 	/**
@@ -1178,6 +1201,16 @@ struct SpecializedVehicle : public Vehicle {
 		return (const T *)v;
 	}
 
+	/**
+	 * Get the state the sprites of this vehicle depend on, if they do not depend on anything else but the direction.
+	 * @param[out] state The state of the vehicle.
+	 * @return True iff the vehicle has static sprites and \a state is filled.
+	 */
+	inline bool GetSpriteState(VehicleSpriteState *state) const
+	{
+		return false;
+	}
+
 	/**
 	 * Update vehicle sprite- and position caches
 	 * @param force_update Force updating the vehicle on the viewport.
@@ -1200,7 +1233,17 @@ struct SpecializedVehicle : public Vehicle {
 		 * there won't be enough change in bounding box or offsets to need
 		 * to resolve a new sprite.
 		 */
-		if (this->direction != this->sprite_cache.last_direction || this->sprite_cache.is_viewport_candidate) {
+		VehicleSpriteState state;
+		bool static_sprites = ((const T *)this)->T::GetSpriteState(&state);
+
+		/*
+		 * Vehicles with static sprites get exactly the same sprites for the
+		 * same direction and state, so there is nothing to resolve, not even
+		 * before drawing, when neither changed.
+		 */
+		if (static_sprites && this->direction == this->sprite_cache.last_direction && state == this->sprite_cache.last_state) {
+			/* Nothing changed. */
+		} else if (this->direction != this->sprite_cache.last_direction || this->sprite_cache.is_viewport_candidate || static_sprites) {
 			VehicleSpriteSeq seq;
 
 			((T*)this)->T::GetImage(this->direction, EIT_ON_MAP, &seq);
@@ -1210,6 +1253,7 @@ struct SpecializedVehicle : public Vehicle {
 			}
 
 			this->sprite_cache.last_direction = this->direction;
+			if (static_sprites) this->sprite_cache.last_state = state;
 			this->sprite_cache.revalidate_before_draw = false;
 		} else {
 			/*
@@ -104,6 +104,34 @@ void BuildDepotVehicleList(VehicleType type, TileIndex tile, VehicleList *engine
 	if (wagons != nullptr && wagons != engines) wagons->shrink_to_fit();
 }
 
+/**
+ * Add all vehicles of the given type that have an order matching a predicate to a list.
+ * Each shared order list is checked only once, instead of once per vehicle sharing it.
+ * The vehicles are added in order of their index, like when iterating over all vehicles.
+ * @param list The list to add the vehicles to.
+ * @param type The type of vehicles to add.
+ * @param predicate Function telling whether an order matches.
+ */
+template <class Tpredicate>
+static void AddVehiclesWithOrder(VehicleList *list, VehicleType type, Tpredicate predicate)
+{
+	for (const OrderList *orders : OrderList::Iterate()) {
+		const Vehicle *first = orders->GetFirstSharedVehicle();
+		if (first == nullptr || first->type != type) continue;
+
+		for (const Order *order = orders->GetFirstOrder(); order != nullptr; order = order->next) {
+			if (!predicate(order)) continue;
+
+			for (const Vehicle *v = first; v != nullptr; v = v->NextShared()) {
+				list->push_back(v);
+			}
+			break;
+		}
+	}
+
+	std::sort(list->begin(), list->end(), [](const Vehicle *a, const Vehicle *b) { return a->index < b->index; });
+}
+
 /**
  * Generate a list of vehicles based on window type.
  * @param list Pointer to list to add vehicles to
@@ -116,17 +144,10 @@ bool GenerateVehicleSortList(VehicleList *list, const VehicleListIdentifier &vli
 
 	switch (vli.type) {
 		case VL_STATION_LIST:
-			for (const Vehicle *v : Vehicle::Iterate()) {
-				if (v->type == vli.vtype && v->IsPrimaryVehicle()) {
-					for (const Order *order : v->Orders()) {
-						if ((order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT) || order->IsType(OT_IMPLICIT))
-								&& order->GetDestination() == vli.index) {
-							list->push_back(v);
-							break;
-						}
-					}
-				}
-			}
+			AddVehiclesWithOrder(list, vli.vtype, [&vli](const Order *order) {
+				return (order->IsType(OT_GOTO_STATION) || order->IsType(OT_GOTO_WAYPOINT) || order->IsType(OT_IMPLICIT))
+						&& order->GetDestination() == vli.index;
+			});
 			break;
 
 		case VL_SHARED_ORDERS: {
@@ -161,16 +182,9 @@ bool GenerateVehicleSortList(VehicleList *list, const VehicleListIdentifier &vli
 			break;
 
 		case VL_DEPOT_LIST:
-			for (const Vehicle *v : Vehicle::Iterate()) {
-				if (v->type == vli.vtype && v->IsPrimaryVehicle()) {
-					for (const Order *order : v->Orders()) {
-						if (order->IsType(OT_GOTO_DEPOT) && !(order->GetDepotActionType() & ODATFB_NEAREST_DEPOT) && order->GetDestination() == vli.index) {
-							list->push_back(v);
-							break;
-						}
-					}
-				}
-			}
+			AddVehiclesWithOrder(list, vli.vtype, [&vli](const Order *order) {
+				return order->IsType(OT_GOTO_DEPOT) && !(order->GetDepotActionType() & ODATFB_NEAREST_DEPOT) && order->GetDestination() == vli.index;
+			});
 			break;
 
 		default: return false;
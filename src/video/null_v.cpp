@@ -12,6 +12,10 @@
 #include "../blitter/factory.hpp"
 #include "../saveload/saveload.h"
 #include "../window_func.h"
+#include "../openttd.h"
+#include "../network/network.h"
+#include "../network/network_func.h"
+#include "../framerate_type.h"
 #include "null_v.h"
 
 #include "../safeguards.h"
@@ -29,6 +33,16 @@ const char *VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+	this->simulation = GetDriverParamBool(parm, "simulation");
+
+	/* Write the game state of every tick to a file, or compare it with a file written by an earlier run. */
+	const char *state_hash_file = GetDriverParam(parm, "statehash");
+	const char *state_hash_verify_file = GetDriverParam(parm, "statehash_verify");
+	this->state_hash = state_hash_file != nullptr || state_hash_verify_file != nullptr;
+	if (this->state_hash) {
+		bool verify = state_hash_verify_file != nullptr;
+		if (!NetworkStartStateHashLog(verify ? state_hash_verify_file : state_hash_file, verify)) return "Failed to open the state hash file";
+	}
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -40,16 +54,40 @@ const char *VideoDriver_Null::Start(const StringList &parm)
 	return nullptr;
 }
 
-void VideoDriver_Null::Stop() { }
+void VideoDriver_Null::Stop()
+{
+	NetworkStopStateHashLog();
+}
 
 void VideoDriver_Null::MakeDirty(int left, int top, int width, int height) {}
 
+/** Write or check the game state of the current tick, when requested. */
+/* static */ void VideoDriver_Null::StateHashLogTick()
+{
+	if (!NetworkStateHashLogTick()) usererror("The game state differs from the state hash file, see the 'desync' debug output.");
+}
+
 void VideoDriver_Null::MainLoop()
 {
-	uint i;
+	uint i = 0;
+
+	if (this->simulation) {
+		/* Let the game load or generate, then run the remaining ticks in one go. */
+		for (i = 0; i < this->ticks && _game_mode != GM_NORMAL && !_exit_game; i++) ::GameLoop();
+		if (i < this->ticks && !_networking) {
+			ResetPerformanceTree();
+			/* The state hash log is written every tick, so it is part of the measured rate. */
+			double rate = SimulateTicks(this->ticks - i, this->state_hash ? &VideoDriver_Null::StateHashLogTick : nullptr);
+			Debug(driver, 0, "Simulated {} ticks at {:.2f} ticks per second", this->ticks - i, rate);
+			PrintPerformanceTree([](const std::string &line) { Debug(driver, 0, "  {}", line); });
+			Debug(driver, 0, "Game state hash: {:08x}", NetworkCalculateGameStateHash());
+			i = this->ticks;
+		}
+	}
 
-	for (i = 0; i < this->ticks; i++) {
+	for (; i < this->ticks; i++) {
 		::GameLoop();
+		if (_game_mode == GM_NORMAL) VideoDriver_Null::StateHashLogTick();
 		::InputLoop();
 		::UpdateWindows();
 	}
@@ -15,7 +15,11 @@
 /** The null video driver. */
 class VideoDriver_Null : public VideoDriver {
 private:
-	uint ticks; ///< Amount of ticks to run.
+	uint ticks;      ///< Amount of ticks to run.
+	bool simulation; ///< Only run the simulation, do not update the windows.
+	bool state_hash; ///< Write or compare the hashes of the game state of every tick.
+
+	static void StateHashLogTick();
 
 public:
 	const char *Start(const StringList &param) override;
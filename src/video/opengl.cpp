@@ -1035,8 +1035,8 @@ void OpenGLBackend::UpdatePalette(const Colour *pal, uint first, uint length)
  */
 void OpenGLBackend::Paint()
 {
-	_glClear(GL_COLOR_BUFFER_BIT);
-
+	/* The video buffer is drawn without blending on a quad that covers the
+	 * whole window, so there is no need to clear the window first. */
 	_glDisable(GL_BLEND);
 
 	/* Blit video buffer to screen. */
@@ -99,6 +99,7 @@ void VideoDriver_SDL_OpenGL::DestroyContext()
 void VideoDriver_SDL_OpenGL::ToggleVsync(bool vsync)
 {
 	SDL_GL_SetSwapInterval(vsync);
+	this->UpdateVsyncInterval(vsync);
 }
 
 const char *VideoDriver_SDL_OpenGL::AllocateContext()
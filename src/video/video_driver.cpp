@@ -159,6 +159,23 @@ void VideoDriver::Tick()
 	}
 }
 
+/**
+ * Update the pacing of draw-ticks after vsync has been toggled.
+ * @param vsync Whether vsync is now active.
+ */
+void VideoDriver::UpdateVsyncInterval(bool vsync)
+{
+	this->vsync_interval = {};
+	if (!vsync) return;
+
+	std::vector<int> rates = this->GetListOfMonitorRefreshRates();
+	if (rates.empty()) return;
+
+	/* The window can be on any monitor; pace for the fastest so we never draw too slowly. */
+	int rate = *std::max_element(rates.begin(), rates.end());
+	if (rate > 0) this->vsync_interval = std::chrono::microseconds(1000000 / rate);
+}
+
 void VideoDriver::SleepTillNextTick()
 {
 	auto next_tick = this->next_draw_tick;
@@ -316,9 +316,19 @@ protected:
 
 	std::chrono::steady_clock::duration GetDrawInterval()
 	{
-		return std::chrono::microseconds(1000000 / _settings_client.gui.refresh_rate);
+		std::chrono::steady_clock::duration interval = std::chrono::microseconds(1000000 / _settings_client.gui.refresh_rate);
+
+		/* With vsync the buffer swap waits for the display, so run the draw
+		 * timer a bit faster and let the swap decide when a frame is drawn.
+		 * A timer at exactly the display rate drifts against the vertical
+		 * blank and every now and then misses one, causing a stutter. */
+		if (this->vsync_interval.count() != 0 && interval <= this->vsync_interval) return this->vsync_interval * 3 / 4;
+
+		return interval;
 	}
 
+	void UpdateVsyncInterval(bool vsync);
+
 	/** Execute all queued commands. */
 	void DrainCommandQueue()
 	{
@@ -339,6 +349,7 @@ protected:
 
 	std::chrono::steady_clock::time_point next_game_tick;
 	std::chrono::steady_clock::time_point next_draw_tick;
+	std::chrono::steady_clock::duration vsync_interval{}; ///< Time between two vertical blanks of the display if vsync is active, otherwise zero.
 
 	bool fast_forward_key_pressed; ///< The fast-forward key is being pressed.
 	bool fast_forward_via_key; ///< The fast-forward was enabled by key press.
@@ -1352,6 +1352,7 @@ void VideoDriver_Win32OpenGL::ToggleVsync(bool vsync)
 {
 	if (_wglSwapIntervalEXT != nullptr) {
 		_wglSwapIntervalEXT(vsync);
+		this->UpdateVsyncInterval(vsync);
 	} else if (vsync) {
 		Debug(driver, 0, "OpenGL: Vsync requested, but not supported by driver");
 	}
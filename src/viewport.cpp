@@ -88,10 +88,11 @@
 #include "command_func.h"
 #include "network/network_func.h"
 #include "framerate_type.h"
+#include "console_func.h"
+#include "elrail_func.h"
 
-#include <forward_list>
 #include <map>
-#include <stack>
+#include <chrono>
 
 #include "table/strings.h"
 #include "table/string_colours.h"
@@ -112,10 +113,10 @@ static const int MAX_TILE_EXTENT_BOTTOM = ZOOM_LVL_BASE * (TILE_PIXELS + 2 * TIL
 
 struct StringSpriteToDraw {
 	StringID string;
+	const std::string *text; ///< Formatted text of the string, owned by the sign.
 	Colours colour;
 	int32 x;
 	int32 y;
-	uint64 params[2];
 	uint16 width;
 };
 
@@ -847,15 +848,14 @@ void AddChildSpriteScreen(SpriteID image, PaletteID pal, int x, int y, bool tran
 	_vd.last_child = &cs.next;
 }
 
-static void AddStringToDraw(int x, int y, StringID string, uint64 params_1, uint64 params_2, Colours colour, uint16 width)
+static void AddStringToDraw(int x, int y, StringID string, const std::string &text, Colours colour, uint16 width)
 {
 	assert(width != 0);
 	StringSpriteToDraw &ss = _vd.string_sprites_to_draw.emplace_back();
 	ss.string = string;
+	ss.text = &text;
 	ss.x = x;
 	ss.y = y;
-	ss.params[0] = params_1;
-	ss.params[1] = params_2;
 	ss.width = width;
 	ss.colour = colour;
 }
@@ -1201,10 +1201,8 @@ static void ViewportAddLandscape()
 	bool last_row = false;
 	for (; !last_row; row++) {
 		last_row = true;
-		for (int column = left_column; column <= right_column; column++) {
-			/* Valid row/column? */
-			if ((row + column) % 2 != 0) continue;
-
+		/* Only visit valid row/column pairs, i.e. when both are even or both are odd. */
+		for (int column = left_column + ((row + left_column) & 1); column <= right_column; column += 2) {
 			Point tilecoord;
 			tilecoord.x = (row - column) / 2;
 			tilecoord.y = (row + column) / 2;
@@ -1311,14 +1309,14 @@ void ViewportAddString(const DrawPixelInfo *dpi, ZoomLevel small_from, const Vie
 	}
 
 	if (!small) {
-		AddStringToDraw(sign->center - sign_half_width, sign->top, string_normal, params_1, params_2, colour, sign->width_normal);
+		AddStringToDraw(sign->center - sign_half_width, sign->top, string_normal, sign->GetText(0, string_normal, params_1, params_2), colour, sign->width_normal);
 	} else {
 		int shadow_offset = 0;
 		if (string_small_shadow != STR_NULL) {
 			shadow_offset = 4;
-			AddStringToDraw(sign->center - sign_half_width + shadow_offset, sign->top, string_small_shadow, params_1, params_2, INVALID_COLOUR, sign->width_small);
+			AddStringToDraw(sign->center - sign_half_width + shadow_offset, sign->top, string_small_shadow, sign->GetText(2, string_small_shadow, params_1, params_2), INVALID_COLOUR, sign->width_small);
 		}
-		AddStringToDraw(sign->center - sign_half_width, sign->top - shadow_offset, string_small, params_1, params_2,
+		AddStringToDraw(sign->center - sign_half_width, sign->top - shadow_offset, string_small, sign->GetText(1, string_small, params_1, params_2),
 				colour, sign->width_small | 0x8000);
 	}
 }
@@ -1459,9 +1457,36 @@ void ViewportSign::UpdatePosition(int center, int top, StringID str, StringID st
 	}
 	this->width_small = VPSM_LEFT + Align(GetStringBoundingBox(buffer, FS_SMALL).width, 2) + VPSM_RIGHT;
 
+	/* The content of the sign may have changed, e.g. by a rename. */
+	for (CachedText &cached : this->cached_text) cached.string = STR_NULL;
+
 	this->MarkDirty();
 }
 
+/**
+ * Get the formatted text of a string of the sign.
+ * The text is only formatted again when the string or its parameters differ
+ * from the last time, or when the sign has been updated since.
+ * @param slot Which of the strings of the sign: 0 for normal, 1 for small and 2 for the small shadow.
+ * @param string The string to format.
+ * @param params_1 The first parameter of the string.
+ * @param params_2 The second parameter of the string.
+ * @return The formatted text; valid until the sign is updated or the same slot is requested with another string.
+ */
+const std::string &ViewportSign::GetText(uint slot, StringID string, uint64 params_1, uint64 params_2) const
+{
+	CachedText &cached = this->cached_text[slot];
+	if (cached.string != string || cached.params[0] != params_1 || cached.params[1] != params_2) {
+		SetDParam(0, params_1);
+		SetDParam(1, params_2);
+		cached.text = GetString(string);
+		cached.string = string;
+		cached.params[0] = params_1;
+		cached.params[1] = params_2;
+	}
+	return cached.text;
+}
+
 /**
  * Mark the sign dirty in all viewports.
  * @param maxzoom Maximum %ZoomLevel at which the text is visible.
@@ -1517,28 +1542,40 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 	 */
 	const uint32 ORDER_COMPARED = UINT32_MAX; // Sprite was compared but we still need to compare the ones preceding it
 	const uint32 ORDER_RETURNED = UINT32_MAX - 1; // Makr sorted sprite in case there are other occurrences of it in the stack
-	std::stack<ParentSpriteToDraw *> sprite_order;
+	/* The containers are static, so their memory is reused for every sort. */
+	static std::vector<ParentSpriteToDraw *> sprite_order; // Stack of sprites to handle
 	uint32 next_order = 0;
 
-	std::forward_list<std::pair<int64, ParentSpriteToDraw *>> sprite_list;  // We store sprites in a list sorted by xmin+ymin
+	/* We store sprites in a list sorted by xmin+ymin. It is a singly linked list over
+	 * the sorted vector, so sprites can be removed from it without moving the others.
+	 * Index sprite_list.size() of sprite_next is the head of the list and the end. */
+	static std::vector<std::pair<int64, ParentSpriteToDraw *>> sprite_list;
+	static std::vector<uint32> sprite_next;
+	sprite_order.clear();
+	sprite_list.clear();
 
 	/* Initialize sprite list and order. */
 	for (auto p = psdv->rbegin(); p != psdv->rend(); p++) {
-		sprite_list.push_front(std::make_pair((*p)->xmin + (*p)->ymin, *p));
-		sprite_order.push(*p);
+		sprite_list.emplace_back((*p)->xmin + (*p)->ymin, *p);
+		sprite_order.push_back(*p);
 		(*p)->order = next_order++;
 	}
 
-	sprite_list.sort();
+	std::sort(sprite_list.begin(), sprite_list.end());
 
-	std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current and their position in the list
-	auto preceding_prev = sprite_list.begin(); // Store iterator in case we need to delete a single preciding sprite
+	const uint32 list_end = (uint32)sprite_list.size();
+	sprite_next.resize(list_end + 1);
+	for (uint32 i = 0; i < list_end; i++) sprite_next[i] = i + 1;
+	sprite_next[list_end] = 0;
+
+	static std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current and their position in the list
+	uint32 preceding_prev = list_end; // Store position in case we need to delete a single preciding sprite
 	auto out = psdv->begin();  // Iterator to output sorted sprites
 
 	while (!sprite_order.empty()) {
 
-		auto s = sprite_order.top();
-		sprite_order.pop();
+		auto s = sprite_order.back();
+		sprite_order.pop_back();
 
 		/* Sprite is already sorted, ignore it. */
 		if (s->order == ORDER_RETURNED) continue;
@@ -1561,18 +1598,19 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 		 * to ensure that we iterate the current sprite as we need to remove it from the list.
 		 */
 		auto ssum = std::max(s->xmax, s->xmin) + std::max(s->ymax, s->ymin);
-		auto prev = sprite_list.before_begin();
-		auto x = sprite_list.begin();
-		while (x != sprite_list.end() && ((*x).first <= ssum)) {
-			auto p = (*x).second;
+		uint32 prev = list_end;
+		uint32 x = sprite_next[prev];
+		while (x != list_end && sprite_list[x].first <= ssum) {
+			auto p = sprite_list[x].second;
 			if (p == s) {
 				/* We found the current sprite, remove it and move on. */
-				x = sprite_list.erase_after(prev);
+				x = sprite_next[prev] = sprite_next[x];
 				continue;
 			}
 
-			auto p_prev = prev;
-			prev = x++;
+			uint32 p_prev = prev;
+			prev = x;
+			x = sprite_next[x];
 
 			if (s->xmax < p->xmin || s->ymax < p->ymin || s->zmax < p->zmin) continue;
 			if (s->xmin <= p->xmax && // overlap in X?
@@ -1601,7 +1639,7 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 			if (p->xmax <= s->xmax && p->ymax <= s->ymax && p->zmax <= s->zmax) {
 				p->order = ORDER_RETURNED;
 				s->order = ORDER_RETURNED;
-				sprite_list.erase_after(preceding_prev);
+				sprite_next[preceding_prev] = sprite_next[sprite_next[preceding_prev]];
 				*(out++) = p;
 				*(out++) = s;
 				continue;
@@ -1614,11 +1652,11 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 		});
 
 		s->order = ORDER_COMPARED;
-		sprite_order.push(s);  // Still need to output so push it back for now
+		sprite_order.push_back(s);  // Still need to output so push it back for now
 
 		for (auto p: preceding) {
 			p->order = next_order++;
-			sprite_order.push(p);
+			sprite_order.push_back(p);
 		}
 	}
 }
@@ -1689,9 +1727,6 @@ static void ViewportDrawStrings(ZoomLevel zoom, const StringSpriteToDrawVector *
 		int y = UnScaleByZoom(ss.y, zoom);
 		int h = VPSM_TOP + (small ? FONT_HEIGHT_SMALL : FONT_HEIGHT_NORMAL) + VPSM_BOTTOM;
 
-		SetDParam(0, ss.params[0]);
-		SetDParam(1, ss.params[1]);
-
 		if (ss.colour != INVALID_COLOUR) {
 			/* Do not draw signs nor station names if they are set invisible */
 			if (IsInvisibilitySet(TO_SIGNS) && ss.string != STR_WHITE_SIGN) continue;
@@ -1711,10 +1746,34 @@ static void ViewportDrawStrings(ZoomLevel zoom, const StringSpriteToDrawVector *
 			}
 		}
 
-		DrawString(x + VPSM_LEFT, x + w - 1 - VPSM_RIGHT, y + VPSM_TOP, ss.string, colour, SA_HOR_CENTER);
+		DrawString(x + VPSM_LEFT, x + w - 1 - VPSM_RIGHT, y + VPSM_TOP, *ss.text, colour, SA_HOR_CENTER);
 	}
 }
 
+/** Stages of drawing a viewport that are measured separately. */
+enum ViewportDrawStage {
+	VDS_COLLECT, ///< Collecting the sprites of everything in view.
+	VDS_SORT,    ///< Sorting the parent sprites.
+	VDS_DRAW,    ///< Drawing all sprites and strings with the blitter.
+	VDS_END,     ///< End marker.
+};
+
+/**
+ * Get the performance scope measuring a stage of drawing a viewport.
+ * @param stage The stage.
+ * @return The performance scope.
+ */
+static PerformanceScopeID GetViewportDrawScope(ViewportDrawStage stage)
+{
+	static const PerformanceScopeID scopes[] = {
+		RegisterPerformanceScope("Viewport sprite collecting"),
+		RegisterPerformanceScope("Viewport sprite sorting"),
+		RegisterPerformanceScope("Viewport sprite drawing"),
+	};
+	static_assert(lengthof(scopes) == VDS_END);
+	return scopes[stage];
+}
+
 void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom)
 {
 	DrawPixelInfo *old_dpi = _cur_dpi;
@@ -1737,20 +1796,31 @@ void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom
 
 	_vd.dpi.dst_ptr = BlitterFactory::GetCurrentBlitter()->MoveTo(old_dpi->dst_ptr, x - old_dpi->left, y - old_dpi->top);
 
-	ViewportAddLandscape();
-	ViewportAddVehicles(&_vd.dpi);
+	{
+		PerformanceScope profile(GetViewportDrawScope(VDS_COLLECT));
+		ViewportAddLandscape();
+		ViewportAddVehicles(&_vd.dpi);
+
+		ViewportAddKdtreeSigns(&_vd.dpi);
 
-	ViewportAddKdtreeSigns(&_vd.dpi);
+		DrawTextEffects(&_vd.dpi);
+	}
 
-	DrawTextEffects(&_vd.dpi);
+	if (_vd.tile_sprites_to_draw.size() != 0) {
+		PerformanceScope profile(GetViewportDrawScope(VDS_DRAW));
+		ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
+	}
 
-	if (_vd.tile_sprites_to_draw.size() != 0) ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
+	{
+		PerformanceScope profile(GetViewportDrawScope(VDS_SORT));
+		for (auto &psd : _vd.parent_sprites_to_draw) {
+			_vd.parent_sprites_to_sort.push_back(&psd);
+		}
 
-	for (auto &psd : _vd.parent_sprites_to_draw) {
-		_vd.parent_sprites_to_sort.push_back(&psd);
+		_vp_sprite_sorter(&_vd.parent_sprites_to_sort);
 	}
 
-	_vp_sprite_sorter(&_vd.parent_sprites_to_sort);
+	PerformanceScope profile(GetViewportDrawScope(VDS_DRAW));
 	ViewportDrawParentSprites(&_vd.parent_sprites_to_sort, &_vd.child_screen_sprites_to_draw);
 
 	if (_draw_bounding_boxes) ViewportDrawBoundingBoxes(&_vd.parent_sprites_to_sort);
@@ -1786,6 +1856,46 @@ void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom
 	_vd.child_screen_sprites_to_draw.clear();
 }
 
+/** Area, in world pixels, above which a part of a viewport is drawn in smaller parts. */
+static const int64 VIEWPORT_DRAW_MAX_AREA = 180000 * ZOOM_LVL_BASE * ZOOM_LVL_BASE;
+/** Size, in screen pixels, below which a part of a viewport is not split anymore. */
+static const int VIEWPORT_DRAW_MIN_SPLIT_SIZE = 128;
+
+/**
+ * Draw a part of a viewport, split in smaller parts when it contains
+ * a lot of the world. Sorting the parent sprites takes more than linear
+ * time in their number, so sorting smaller parts is quicker.
+ * @param vp The viewport to draw.
+ * @param left Left edge of the part, in screen coordinates.
+ * @param top Top edge of the part, in screen coordinates.
+ * @param right Right edge of the part, in screen coordinates.
+ * @param bottom Bottom edge of the part, in screen coordinates.
+ */
+static void ViewportDrawSplit(const Viewport *vp, int left, int top, int right, int bottom)
+{
+	int width = right - left;
+	int height = bottom - top;
+	if ((int64)ScaleByZoom(width, vp->zoom) * ScaleByZoom(height, vp->zoom) > VIEWPORT_DRAW_MAX_AREA && std::max(width, height) >= VIEWPORT_DRAW_MIN_SPLIT_SIZE) {
+		if (height > width) {
+			int t = (top + bottom) >> 1;
+			ViewportDrawSplit(vp, left, top, right, t);
+			ViewportDrawSplit(vp, left, t, right, bottom);
+		} else {
+			int t = (left + right) >> 1;
+			ViewportDrawSplit(vp, left, top, t, bottom);
+			ViewportDrawSplit(vp, t, top, right, bottom);
+		}
+		return;
+	}
+
+	ViewportDoDraw(vp,
+		ScaleByZoom(left - vp->left, vp->zoom) + vp->virtual_left,
+		ScaleByZoom(top - vp->top, vp->zoom) + vp->virtual_top,
+		ScaleByZoom(right - vp->left, vp->zoom) + vp->virtual_left,
+		ScaleByZoom(bottom - vp->top, vp->zoom) + vp->virtual_top
+	);
+}
+
 static inline void ViewportDraw(const Viewport *vp, int left, int top, int right, int bottom)
 {
 	if (right <= vp->left || bottom <= vp->top) return;
@@ -1800,12 +1910,7 @@ static inline void ViewportDraw(const Viewport *vp, int left, int top, int right
 	if (top < vp->top) top = vp->top;
 	if (bottom > vp->top + vp->height) bottom = vp->top + vp->height;
 
-	ViewportDoDraw(vp,
-		ScaleByZoom(left - vp->left, vp->zoom) + vp->virtual_left,
-		ScaleByZoom(top - vp->top, vp->zoom) + vp->virtual_top,
-		ScaleByZoom(right - vp->left, vp->zoom) + vp->virtual_left,
-		ScaleByZoom(bottom - vp->top, vp->zoom) + vp->virtual_top
-	);
+	ViewportDrawSplit(vp, left, top, right, bottom);
 }
 
 /**
@@ -1951,6 +2056,9 @@ static bool MarkViewportDirty(const Viewport *vp, int left, int top, int right,
  */
 bool MarkAllViewportsDirty(int left, int top, int right, int bottom)
 {
+	/* Nothing will be drawn until the simulation has finished. */
+	if (_simulation_only) return false;
+
 	bool dirty = false;
 
 	for (const Window *w : Window::Iterate()) {
@@ -1986,6 +2094,8 @@ void ConstrainAllViewportsZoom()
  */
 void MarkTileDirtyByTile(TileIndex tile, int bridge_level_offset, int tile_height_override)
 {
+	InvalidateCatenaryCache(tile);
+
 	Point pt = RemapCoords(TileX(tile) * TILE_SIZE, TileY(tile) * TILE_SIZE, tile_height_override * TILE_HEIGHT);
 	MarkAllViewportsDirty(
 			pt.x - MAX_TILE_EXTENT_LEFT,
@@ -3441,16 +3551,49 @@ Point GetViewportStationMiddle(const Viewport *vp, const Station *st)
 struct ViewportSSCSS {
 	VpSorterChecker fct_checker; ///< The check function.
 	VpSpriteSorter fct_sorter;   ///< The sorting function.
+	const char *name;            ///< Name of the sorter, for benchmarking.
 };
 
 /** List of sorters ordered from best to worst. */
 static ViewportSSCSS _vp_sprite_sorters[] = {
 #ifdef WITH_SSE
-	{ &ViewportSortParentSpritesSSE41Checker, &ViewportSortParentSpritesSSE41 },
+	{ &ViewportSortParentSpritesSSE41Checker, &ViewportSortParentSpritesSSE41, "sse4" },
 #endif
-	{ &ViewportSortParentSpritesChecker, &ViewportSortParentSprites }
+	{ &ViewportSortParentSpritesChecker, &ViewportSortParentSprites, "generic" }
 };
 
+/**
+ * Redraw the whole screen a number of times with every usable sprite sorter, and
+ * print how long collecting, sorting and drawing the viewport sprites took to the console.
+ * Only the current blitter, resolution and zoom level are measured; change those and
+ * run it again to compare them.
+ * @param iterations Number of times to redraw the screen with each sorter.
+ */
+void BenchmarkViewportDrawing(uint iterations)
+{
+	IConsolePrint(CC_DEFAULT, "Drawing {}x{} pixels {} times with blitter '{}':", _screen.width, _screen.height, iterations, BlitterFactory::GetCurrentBlitter()->GetName());
+
+	VpSpriteSorter old_sorter = _vp_sprite_sorter;
+	for (uint i = 0; i < lengthof(_vp_sprite_sorters); i++) {
+		if (!_vp_sprite_sorters[i].fct_checker()) continue;
+		_vp_sprite_sorter = _vp_sprite_sorters[i].fct_sorter;
+
+		double before[VDS_END];
+		for (uint stage = 0; stage < VDS_END; stage++) before[stage] = GetPerformanceScopeMilliseconds(GetViewportDrawScope((ViewportDrawStage)stage));
+
+		auto start = std::chrono::steady_clock::now();
+		for (uint j = 0; j < iterations; j++) RedrawScreenRect(0, 0, _screen.width, _screen.height);
+		std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - start;
+
+		double stages[VDS_END];
+		for (uint stage = 0; stage < VDS_END; stage++) stages[stage] = (GetPerformanceScopeMilliseconds(GetViewportDrawScope((ViewportDrawStage)stage)) - before[stage]) / iterations;
+
+		IConsolePrint(CC_DEFAULT, "  sorter '{}': {:.2f}ms per frame; collect {:.2f}ms, sort {:.2f}ms, draw {:.2f}ms",
+			_vp_sprite_sorters[i].name, total.count() / iterations, stages[VDS_COLLECT], stages[VDS_SORT], stages[VDS_DRAW]);
+	}
+	_vp_sprite_sorter = old_sorter;
+}
+
 /** Choose the "best" sprite sorter and set _vp_sprite_sorter. */
 void InitializeSpriteSorter()
 {
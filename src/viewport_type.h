@@ -13,6 +13,7 @@
 #include "zoom_type.h"
 #include "strings_type.h"
 #include "table/strings.h"
+#include <string>
 
 class LinkGraphOverlay;
 
@@ -49,8 +50,17 @@ struct ViewportSign {
 	uint16 width_normal; ///< The width when not zoomed out (normal font)
 	uint16 width_small;  ///< The width when zoomed out (small font)
 
+	/** Formatted text of one of the strings of the sign, so it does not have to be formatted every time the sign is drawn. */
+	struct CachedText {
+		StringID string = STR_NULL; ///< The string the text was formatted from.
+		uint64 params[2];           ///< The parameters the text was formatted with.
+		std::string text;           ///< The formatted text.
+	};
+	mutable CachedText cached_text[3]; ///< Formatted text of the normal, small and small shadow strings; reset by #UpdatePosition.
+
 	void UpdatePosition(int center, int top, StringID str, StringID str_small = STR_NULL);
 	void MarkDirty(ZoomLevel maxzoom = ZOOM_LVL_MAX) const;
+	const std::string &GetText(uint slot, StringID string, uint64 params_1, uint64 params_2) const;
 };
 
 /** Specialised ViewportSign that tracks whether it is valid for entering into a Kdtree */
@@ -1217,6 +1217,11 @@ static void DoDryUp(TileIndex tile)
  * Let a water tile floods its diagonal adjoining tiles
  * called from tunnelbridge_cmd, and by TileLoop_Industry() and TileLoop_Track()
  *
+ * For open sea the neighbour checks stop at the first test, as all neighbours
+ * are water as well. A precomputed set of tiles next to floodable land would
+ * have to be kept up to date by every command that changes a tile, which costs
+ * more than those few tests.
+ *
  * @param tile the water/shore tile that floods
  */
 void TileLoop_Water(TileIndex tile)
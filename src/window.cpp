@@ -59,6 +59,20 @@ WindowList _z_windows;
 /** List of closed windows to delete. */
 /* static */ std::vector<Window *> Window::closed_windows;
 
+/** Number of open windows of each window class. */
+static uint _window_class_count[WC_END];
+
+/**
+ * Check whether any window of the given class might be open. Lets the
+ * lookups by class return early without walking the window list.
+ * @param cls Window class.
+ * @return False if there is definitely no open window of this class.
+ */
+static inline bool MayHaveWindowsOfClass(WindowClass cls)
+{
+	return cls >= WC_END || _window_class_count[cls] != 0;
+}
+
 /**
  * Delete all closed windows.
  */
@@ -1095,6 +1109,8 @@ void Window::Close()
 	if (*this->z_position == nullptr) return;
 
 	*this->z_position = nullptr;
+	assert(_window_class_count[this->window_class] > 0);
+	_window_class_count[this->window_class]--;
 
 	if (_thd.window_class == this->window_class &&
 			_thd.window_number == this->window_number) {
@@ -1145,6 +1161,8 @@ Window::~Window()
  */
 Window *FindWindowById(WindowClass cls, WindowNumber number)
 {
+	if (!MayHaveWindowsOfClass(cls)) return nullptr;
+
 	for (Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) return w;
 	}
@@ -1426,6 +1444,22 @@ void Window::InitializeData(WindowNumber window_number)
 
 	/* Insert the window into the correct location in the z-ordering. */
 	BringWindowToFront(this, false);
+	assert(this->window_class < WC_END);
+	_window_class_count[this->window_class]++;
+}
+
+/**
+ * Change the class of a window after it has been initialised, e.g. when
+ * one window description is used for windows of different classes.
+ * @param window_class The new class of the window.
+ */
+void Window::ChangeWindowClass(WindowClass window_class)
+{
+	assert(window_class < WC_END);
+	assert(_window_class_count[this->window_class] > 0);
+	_window_class_count[this->window_class]--;
+	this->window_class = window_class;
+	_window_class_count[this->window_class]++;
 }
 
 /**
@@ -3118,6 +3152,8 @@ void UpdateWindows()
  */
 void SetWindowDirty(WindowClass cls, WindowNumber number)
 {
+	if (!MayHaveWindowsOfClass(cls)) return;
+
 	for (const Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) w->SetDirty();
 	}
@@ -3131,6 +3167,8 @@ void SetWindowDirty(WindowClass cls, WindowNumber number)
  */
 void SetWindowWidgetDirty(WindowClass cls, WindowNumber number, byte widget_index)
 {
+	if (!MayHaveWindowsOfClass(cls)) return;
+
 	for (const Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) {
 			w->SetWidgetDirty(widget_index);
@@ -3144,6 +3182,8 @@ void SetWindowWidgetDirty(WindowClass cls, WindowNumber number, byte widget_inde
  */
 void SetWindowClassesDirty(WindowClass cls)
 {
+	if (!MayHaveWindowsOfClass(cls)) return;
+
 	for (const Window *w : Window::Iterate()) {
 		if (w->window_class == cls) w->SetDirty();
 	}
@@ -3216,6 +3256,8 @@ void Window::ProcessHighlightedInvalidations()
  */
 void InvalidateWindowData(WindowClass cls, WindowNumber number, int data, bool gui_scope)
 {
+	if (!MayHaveWindowsOfClass(cls)) return;
+
 	for (Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) {
 			w->InvalidateData(data, gui_scope);
@@ -3233,6 +3275,8 @@ void InvalidateWindowData(WindowClass cls, WindowNumber number, int data, bool g
  */
 void InvalidateWindowClassesData(WindowClass cls, int data, bool gui_scope)
 {
+	if (!MayHaveWindowsOfClass(cls)) return;
+
 	for (Window *w : Window::Iterate()) {
 		if (w->window_class == cls) {
 			w->InvalidateData(data, gui_scope);
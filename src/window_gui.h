@@ -282,6 +282,7 @@ private:
 
 protected:
 	void InitializeData(WindowNumber window_number);
+	void ChangeWindowClass(WindowClass window_class);
 	void InitializePositionSize(int x, int y, int min_width, int min_height);
 	virtual void FindWindowPlacementAndResize(int def_width, int def_height);
 
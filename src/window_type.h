@@ -691,6 +691,7 @@ enum WindowClass {
 	 */
 	WC_SCREENSHOT,
 
+	WC_END,              ///< End of valid window classes.
 	WC_INVALID = 0xFFFF, ///< Invalid window.
 };
 